@@ -0,0 +1,158 @@
+#include "AdjacencyMatrix.hpp"
+
+/**
+ * @brief Construct a new empty Adjacency Matrix object.
+ */
+AdjacencyMatrix::AdjacencyMatrix() : bits(nullptr), rows(0), words(0) {}
+
+/**
+ * @brief Construct a new Adjacency Matrix object able to contain capacity rows, all the bits are cleared.
+ * @param capacity number of rows (and columns) of the matrix.
+ */
+AdjacencyMatrix::AdjacencyMatrix(unsigned int capacity) : AdjacencyMatrix() {
+    resize(capacity);
+}
+
+/**
+ * @brief Construct a new Adjacency Matrix object copying the content of another one.
+ * @param other matrix to be copied.
+ */
+AdjacencyMatrix::AdjacencyMatrix(const AdjacencyMatrix &other) : AdjacencyMatrix() {
+    *this = other;
+}
+
+/**
+ * @brief Copy the content of another matrix in the current one.
+ * @param other matrix to be copied.
+ * @return AdjacencyMatrix& reference to the current matrix.
+ */
+AdjacencyMatrix& AdjacencyMatrix::operator=(const AdjacencyMatrix &other) {
+    if(this != &other) {
+        clear();
+        if(other.rows > 0) {
+            bits = allocate(other.rows, other.words);
+            memcpy(bits, other.bits, (size_t) other.rows * other.words * sizeof(uint64_t));
+        }
+        rows = other.rows;
+        words = other.words;
+    }
+    return *this;
+}
+
+/**
+ * @brief Destroy the Adjacency Matrix object releasing the rows.
+ */
+AdjacencyMatrix::~AdjacencyMatrix() {
+    clear();
+}
+
+/**
+ * @brief Enlarge the matrix so that it can contain capacity rows, the bits already set are preserved.
+ * @param capacity new number of rows (and columns) of the matrix.
+ */
+void AdjacencyMatrix::resize(unsigned int capacity) {
+    if(capacity <= rows)
+        return;
+
+    // round the row up to a multiple of 512 bits, so that every row starts on a cache line
+    unsigned int new_words = ((capacity + 511) / 512) * 8;
+    uint64_t *new_bits = allocate(capacity, new_words);
+
+    for(unsigned int i = 0; i < rows; ++i)
+        memcpy(new_bits + (size_t) i * new_words, bits + (size_t) i * words, words * sizeof(uint64_t));
+
+    free(bits);
+    bits = new_bits;
+    rows = capacity;
+    words = new_words;
+}
+
+/**
+ * @brief Get the number of rows of the matrix.
+ * @return unsigned int number of rows.
+ */
+unsigned int AdjacencyMatrix::capacity() const {
+    return rows;
+}
+
+/**
+ * @brief Get the number of 64 bit words that compose a row, it is always a multiple of 8 (64 bytes).
+ * @return unsigned int number of words in a row.
+ */
+unsigned int AdjacencyMatrix::rowWords() const {
+    return words;
+}
+
+/**
+ * @brief Count the bits set in a row.
+ * @param i row index.
+ * @return unsigned int number of bits set.
+ */
+unsigned int AdjacencyMatrix::countRow(unsigned int i) {
+    const uint64_t *r = row(i);
+    unsigned int count = 0;
+    for(unsigned int k = 0; k < words; ++k)
+        count += __builtin_popcountll(r[k]);
+    return count;
+}
+
+/**
+ * @brief Clear all the bits of a row.
+ * @param i row index.
+ */
+void AdjacencyMatrix::clearRow(unsigned int i) {
+    memset(row(i), 0, words * sizeof(uint64_t));
+}
+
+/**
+ * @brief Clear all the bits of a column.
+ * @param j column index.
+ */
+void AdjacencyMatrix::clearColumn(unsigned int j) {
+    for(unsigned int i = 0; i < rows; ++i)
+        reset(i, j);
+}
+
+/**
+ * @brief Merge a set of bits inside a row, row(i) = row(i) | src. The bits that were not already set are written in added.
+ * @param i row index.
+ * @param src words to be merged, they must be rowWords() long.
+ * @param added output words, rowWords() long, that will contain src & ~row(i).
+ * @return unsigned int number of bits that have been added to the row.
+ */
+unsigned int AdjacencyMatrix::mergeRow(unsigned int i, const uint64_t *src, uint64_t *added) {
+    uint64_t *r = row(i);
+    unsigned int count = 0;
+
+    // branch-free loop over whole words, the compiler is free to vectorize it
+    for(unsigned int k = 0; k < words; ++k) {
+        uint64_t new_bits = src[k] & ~r[k];
+        r[k] |= src[k];
+        added[k] = new_bits;
+        count += __builtin_popcountll(new_bits);
+    }
+    return count;
+}
+
+/**
+ * @brief Remove all the rows of the matrix.
+ */
+void AdjacencyMatrix::clear() {
+    free(bits);
+    bits = nullptr;
+    rows = 0;
+    words = 0;
+}
+
+/**
+ * @brief Allocate a zeroed block of rows aligned to 64 bytes.
+ * @param num_rows number of rows to allocate.
+ * @param num_words number of words of each row.
+ * @return uint64_t* pointer to the block.
+ */
+uint64_t* AdjacencyMatrix::allocate(unsigned int num_rows, unsigned int num_words) {
+    size_t bytes = (size_t) num_rows * num_words * sizeof(uint64_t);
+    uint64_t *block = static_cast<uint64_t*>(aligned_alloc(64, bytes));
+    memset(block, 0, bytes);
+    return block;
+}
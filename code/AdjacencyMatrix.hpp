@@ -0,0 +1,189 @@
+#ifndef ADJACENCY_MATRIX_H_
+#define ADJACENCY_MATRIX_H_
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+/**
+ * @brief Auxiliary structure that stores the adjacency of a graph as a square matrix of bits. Every row is packed in 64 bit words
+ * and it starts on a 64-byte boundary, so that a pair of vertices costs a single bit and whole rows can be combined word by word.
+ * Rows and columns are addressed with dense indices in [0, capacity), the mapping toward the values of the vertices is left
+ * to the owner of the matrix.
+ */
+struct AdjacencyMatrix {
+public:
+    /**
+     * @brief Construct a new empty Adjacency Matrix object.
+     */
+    AdjacencyMatrix();
+
+    /**
+     * @brief Construct a new Adjacency Matrix object able to contain capacity rows, all the bits are cleared.
+     * @param capacity number of rows (and columns) of the matrix.
+     */
+    AdjacencyMatrix(unsigned int capacity);
+
+    /**
+     * @brief Construct a new Adjacency Matrix object copying the content of another one.
+     * @param other matrix to be copied.
+     */
+    AdjacencyMatrix(const AdjacencyMatrix &other);
+
+    /**
+     * @brief Copy the content of another matrix in the current one.
+     * @param other matrix to be copied.
+     * @return AdjacencyMatrix& reference to the current matrix.
+     */
+    AdjacencyMatrix& operator=(const AdjacencyMatrix &other);
+
+    /**
+     * @brief Destroy the Adjacency Matrix object releasing the rows.
+     */
+    ~AdjacencyMatrix();
+
+    /**
+     * @brief Enlarge the matrix so that it can contain capacity rows, the bits already set are preserved.
+     * @param capacity new number of rows (and columns) of the matrix.
+     */
+    void resize(unsigned int capacity);
+
+    /**
+     * @brief Get the number of rows of the matrix.
+     * @return unsigned int number of rows.
+     */
+    unsigned int capacity() const;
+
+    /**
+     * @brief Get the number of 64 bit words that compose a row, it is always a multiple of 8 (64 bytes).
+     * @return unsigned int number of words in a row.
+     */
+    unsigned int rowWords() const;
+
+    /**
+     * @brief Check if the bit in position (i, j) is set.
+     * @param i row index.
+     * @param j column index.
+     * @return true if the bit is set.
+     * @return false if the bit is not set.
+     */
+    bool test(unsigned int i, unsigned int j) const {
+        return (bits[(size_t) i * words + (j >> 6)] >> (j & 63)) & 1;
+    }
+
+    /**
+     * @brief Set the bit in position (i, j).
+     * @param i row index.
+     * @param j column index.
+     */
+    void set(unsigned int i, unsigned int j) {
+        bits[(size_t) i * words + (j >> 6)] |= (uint64_t) 1 << (j & 63);
+    }
+
+    /**
+     * @brief Clear the bit in position (i, j).
+     * @param i row index.
+     * @param j column index.
+     */
+    void reset(unsigned int i, unsigned int j) {
+        bits[(size_t) i * words + (j >> 6)] &= ~((uint64_t) 1 << (j & 63));
+    }
+
+    /**
+     * @brief Get the words that compose a row of the matrix.
+     * @param i row index.
+     * @return uint64_t* pointer to the first word of the row.
+     */
+    uint64_t* row(unsigned int i) {
+        return bits + (size_t) i * words;
+    }
+
+    /**
+     * @brief Get the words that compose a row of a read-only matrix.
+     * @param i row index.
+     * @return const uint64_t* pointer to the first word of the row.
+     */
+    const uint64_t* row(unsigned int i) const {
+        return bits + (size_t) i * words;
+    }
+
+    /**
+     * @brief Count the bits set in a row.
+     * @param i row index.
+     * @return unsigned int number of bits set.
+     */
+    unsigned int countRow(unsigned int i);
+
+    /**
+     * @brief Clear all the bits of a row.
+     * @param i row index.
+     */
+    void clearRow(unsigned int i);
+
+    /**
+     * @brief Clear all the bits of a column.
+     * @param j column index.
+     */
+    void clearColumn(unsigned int j);
+
+    /**
+     * @brief Merge a set of bits inside a row, row(i) = row(i) | src. The bits that were not already set are written in added.
+     * @param i row index.
+     * @param src words to be merged, they must be rowWords() long.
+     * @param added output words, rowWords() long, that will contain src & ~row(i).
+     * @return unsigned int number of bits that have been added to the row.
+     */
+    unsigned int mergeRow(unsigned int i, const uint64_t *src, uint64_t *added);
+
+    /**
+     * @brief Remove all the rows of the matrix.
+     */
+    void clear();
+
+    /**
+     * @brief Call f(j) for each bit j that is set in a & ~b. Each word is read once before visiting its bits, so f can safely
+     * set bits of b while the visit is in progress.
+     * @param a words to be visited.
+     * @param b words used as a mask, nullptr means that no mask is applied.
+     * @param num_words number of words of a and b.
+     * @param f function called with the index of the bits.
+     */
+    template<typename F>
+    static void forEachBit(const uint64_t *a, const uint64_t *b, unsigned int num_words, F f) {
+        for(unsigned int k = 0; k < num_words; ++k) {
+            uint64_t word = b == nullptr ? a[k] : a[k] & ~b[k];
+            while(word != 0) {
+                f((k << 6) + __builtin_ctzll(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief Allocate a zeroed block of rows aligned to 64 bytes.
+     * @param num_rows number of rows to allocate.
+     * @param num_words number of words of each row.
+     * @return uint64_t* pointer to the block.
+     */
+    static uint64_t* allocate(unsigned int num_rows, unsigned int num_words);
+
+    /**
+     * @brief Words of the matrix, row after row.
+     */
+    uint64_t *bits;
+
+    /**
+     * @brief Number of rows of the matrix.
+     */
+    unsigned int rows;
+
+    /**
+     * @brief Number of words in each row.
+     */
+    unsigned int words;
+};
+
+#endif
@@ -0,0 +1,258 @@
+#include "CSRGraph.hpp"
+#include "Tracer.hpp"
+
+/**
+ * @brief Construct a new empty CSRGraph object.
+ */
+CustomGraph::CSRGraph::CSRGraph() : ownedOffsets(1, 0) {
+    owned = true;
+    bindOwned();
+}
+
+/**
+ * @brief Construct a new CSRGraph object that owns a copy of the vertices and of the edges of a graph. The table of ids
+ * is omitted when the values of the vertices are already 0, 1, ..., n-1.
+ * @param graph graph to be copied.
+ */
+CustomGraph::CSRGraph::CSRGraph(Graph &graph) {
+    Tracer::Span span("CSRGraph::CSRGraph", "build");
+    ownedIds = graph.getVerticesKeys();
+    sort(ownedIds.begin(), ownedIds.end());
+
+    unordered_map<unsigned int, unsigned int> index;
+    for(unsigned int i = 0; i < ownedIds.size(); ++i)
+        index[ownedIds[i]] = i;
+
+    ownedOffsets.reserve(ownedIds.size() + 1);
+    ownedAdjacency.reserve(2 * (size_t) graph.edgeSize());
+    ownedOffsets.push_back(0);
+
+    for(auto v : ownedIds) {
+        size_t begin = ownedAdjacency.size();
+        graph.forEachAdjacent(v, [&](unsigned int w) {
+            ownedAdjacency.push_back(index[w]);
+        });
+        sort(ownedAdjacency.begin() + begin, ownedAdjacency.end());
+        ownedOffsets.push_back(ownedAdjacency.size());
+    }
+
+    if(!ownedIds.empty() && ownedIds.back() == ownedIds.size() - 1)
+        ownedIds.clear();
+
+    owned = true;
+    bindOwned();
+}
+
+/**
+ * @brief Construct a new CSRGraph object that takes the ownership of the arrays.
+ * @param offsets num_vertices+1 positions in the adjacency array.
+ * @param adjacency adjacent vertices of each vertex.
+ * @param ids values of the vertices, it can be empty.
+ */
+CustomGraph::CSRGraph::CSRGraph(vector<uint64_t> &&offsets, vector<unsigned int> &&adjacency, vector<unsigned int> &&ids)
+    : ownedOffsets(move(offsets)), ownedAdjacency(move(adjacency)), ownedIds(move(ids)) {
+    if(ownedOffsets.empty())
+        ownedOffsets.push_back(0);
+    owned = true;
+    bindOwned();
+}
+
+/**
+ * @brief Construct a new CSRGraph object that is a view of arrays stored somewhere else.
+ * @param num_vertices number of vertices.
+ * @param offsets num_vertices+1 positions in the adjacency array.
+ * @param adjacency adjacent vertices of each vertex.
+ * @param ids values of the vertices, nullptr if the values are the indices.
+ */
+CustomGraph::CSRGraph::CSRGraph(unsigned int num_vertices, const uint64_t *offsets, const unsigned int *adjacency, const unsigned int *ids)
+    : numVertices(num_vertices), offsets(offsets), adjacency(adjacency), ids(ids), owned(false) {}
+
+/**
+ * @brief Construct a new CSRGraph object copying another one, owned arrays are copied while views stay views.
+ * @param other graph to be copied.
+ */
+CustomGraph::CSRGraph::CSRGraph(const CSRGraph &other) {
+    *this = other;
+}
+
+/**
+ * @brief Copy another graph in the current one, owned arrays are copied while views stay views.
+ * @param other graph to be copied.
+ * @return CSRGraph& reference to the current graph.
+ */
+CustomGraph::CSRGraph& CustomGraph::CSRGraph::operator=(const CSRGraph &other) {
+    if(this == &other)
+        return *this;
+
+    ownedOffsets = other.ownedOffsets;
+    ownedAdjacency = other.ownedAdjacency;
+    ownedIds = other.ownedIds;
+    owned = other.owned;
+    numVertices = other.numVertices;
+    offsets = other.offsets;
+    adjacency = other.adjacency;
+    ids = other.ids;
+
+    if(owned)
+        bindOwned();
+    return *this;
+}
+
+/**
+ * @brief Get the number of vertices in the graph.
+ * @return unsigned int number of vertices.
+ */
+unsigned int CustomGraph::CSRGraph::size() {
+    return numVertices;
+}
+
+/**
+ * @brief Get the number of edges in the graph.
+ * @return unsigned int number of edges.
+ */
+unsigned int CustomGraph::CSRGraph::edgeSize() {
+    return offsets[numVertices] / 2;
+}
+
+/**
+ * @brief Get the dense index of a vertex.
+ * @param vertex value of the vertex.
+ * @return unsigned int dense index of the vertex, size() if it is not contained.
+ */
+unsigned int CustomGraph::CSRGraph::indexOf(unsigned int vertex) {
+    if(ids == nullptr)
+        return vertex < numVertices ? vertex : numVertices;
+
+    const unsigned int *it = lower_bound(ids, ids + numVertices, vertex);
+    if(it == ids + numVertices || *it != vertex)
+        return numVertices;
+    return it - ids;
+}
+
+/**
+ * @brief Check if the graph has a table of ids.
+ * @return true if the values of the vertices are stored in a table.
+ * @return false if the values of the vertices are their indices.
+ */
+bool CustomGraph::CSRGraph::hasIds() {
+    return ids != nullptr;
+}
+
+/**
+ * @brief Get the offsets array of the graph.
+ * @return const uint64_t* num_vertices+1 offsets.
+ */
+const uint64_t* CustomGraph::CSRGraph::getOffsets() {
+    return offsets;
+}
+
+/**
+ * @brief Get the adjacency array of the graph.
+ * @return const unsigned int* 2*edgeSize() adjacent vertices.
+ */
+const unsigned int* CustomGraph::CSRGraph::getAdjacency() {
+    return adjacency;
+}
+
+/**
+ * @brief Get the table of ids of the graph.
+ * @return const unsigned int* values of the vertices, nullptr if there is no table.
+ */
+const unsigned int* CustomGraph::CSRGraph::getIds() {
+    return ids;
+}
+
+/**
+ * @brief Get the values of the vertices in the graph.
+ * @return vector<unsigned int> values of the vertices in ascending order.
+ */
+vector<unsigned int> CustomGraph::CSRGraph::getVerticesKeys() {
+    vector<unsigned int> keys(numVertices);
+    for(unsigned int i = 0; i < numVertices; ++i)
+        keys[i] = vertexValue(i);
+    return keys;
+}
+
+/**
+ * @brief Create a Graph object with the same vertices and edges.
+ * @param graph graph that will receive the vertices and the edges, it is cleared before.
+ */
+void CustomGraph::CSRGraph::toGraph(Graph &graph) {
+    Tracer::Span span("CSRGraph::toGraph", "build");
+    graph.clear();
+    for(unsigned int i = 0; i < numVertices; ++i)
+        graph.addVertex(vertexValue(i));
+
+    vector<pair<unsigned int, unsigned int>> edges;
+    edges.reserve(edgeSize());
+    for(unsigned int i = 0; i < numVertices; ++i)
+        for(auto j : neighbors(i))
+            if(i < j)
+                edges.push_back(make_pair(vertexValue(i), vertexValue(j)));
+    graph.addEdgesBulk(edges);
+}
+
+/**
+ * @brief Check if the graph is connected.
+ * @return true if it is connected.
+ * @return false if it is not connected.
+ */
+bool CustomGraph::CSRGraph::isConnected() {
+    return OrderingEngines::isConnected(*this);
+}
+
+/**
+ * @brief Same algorithm of Graph::lex_p.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+ */
+vector<unsigned int> CustomGraph::CSRGraph::lex_p() {
+    return OrderingEngines::lex_p(*this);
+}
+
+/**
+ * @brief Same algorithm of Graph::lex_m, the graph is not modified and the fill edges are reported separately.
+ * @param fill if not null, it receives the edges of the minimal triangulation that are not in the graph.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+ */
+vector<unsigned int> CustomGraph::CSRGraph::lex_m(vector<pair<unsigned int, unsigned int>> *fill) {
+    return OrderingEngines::lex_m(*this, fill);
+}
+
+/**
+ * @brief Same as lex_p, the work done is counted in stats.
+ * @param stats it accumulates the cells created and destroyed and the refinements of the partition.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+ */
+vector<unsigned int> CustomGraph::CSRGraph::lex_p(OrderingStats &stats) {
+    return OrderingEngines::lex_p<true>(*this, &stats);
+}
+
+/**
+ * @brief Same as lex_m, the work done is counted in stats.
+ * @param stats it accumulates the pushes in the reach queues, the renumbered labels and the fill edges found.
+ * @param fill if not null, it receives the edges of the minimal triangulation that are not in the graph.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+ */
+vector<unsigned int> CustomGraph::CSRGraph::lex_m(OrderingStats &stats, vector<pair<unsigned int, unsigned int>> *fill) {
+    return OrderingEngines::lex_m<true>(*this, fill, &stats);
+}
+
+/**
+ * @brief Same as lex_m, but the run is bounded by control, see OrderingEngines::lex_m.
+ * @param control limits of the run, it receives the outcome.
+ * @param fill if not null, it receives the fill edges of the numbered vertices.
+ * @return vector<unsigned int> structure that contains the ordered vertices, minimal when control.status() is Completed.
+ */
+vector<unsigned int> CustomGraph::CSRGraph::lex_m(RunControl &control, vector<pair<unsigned int, unsigned int>> *fill) {
+    return OrderingEngines::lex_m(*this, control, fill);
+}
+
+/**
+ * @brief Point the arrays to the owned vectors.
+ */
+void CustomGraph::CSRGraph::bindOwned() {
+    numVertices = ownedOffsets.size() - 1;
+    offsets = ownedOffsets.data();
+    adjacency = ownedAdjacency.data();
+    ids = ownedIds.empty() ? nullptr : ownedIds.data();
+}
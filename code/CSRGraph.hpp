@@ -0,0 +1,245 @@
+#ifndef CSR_GRAPH_H_
+#define CSR_GRAPH_H_
+
+#include "Graph.hpp"
+#include "OrderingEngines.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Read-only graph in compressed sparse row format. The vertices have dense indices in [0, n), the adjacent vertices
+ * of the vertex i are adjacency[offsets[i]] ... adjacency[offsets[i+1]-1] in ascending order. An optional table of ids
+ * binds each index to the value of the vertex, the table must be sorted; without it the value of a vertex is its index.
+ * The arrays can be owned by the object or they can live in external memory (e.g. a memory mapped file), in that case the
+ * object is only a view and the memory must outlive it.
+ */
+struct CSRGraph {
+public:
+    /**
+     * @brief Range of adjacent vertices that can be used in a range-based for loop.
+     */
+    struct NeighborRange {
+        const unsigned int *first, *last;
+
+        const unsigned int* begin() const { return first; }
+        const unsigned int* end() const { return last; }
+    };
+
+    /**
+     * @brief Construct a new empty CSRGraph object.
+     */
+    CSRGraph();
+
+    /**
+     * @brief Construct a new CSRGraph object that owns a copy of the vertices and of the edges of a graph. The table of ids
+     * is omitted when the values of the vertices are already 0, 1, ..., n-1.
+     * @param graph graph to be copied.
+     */
+    CSRGraph(Graph &graph);
+
+    /**
+     * @brief Construct a new CSRGraph object that takes the ownership of the arrays.
+     * @param offsets num_vertices+1 positions in the adjacency array.
+     * @param adjacency adjacent vertices of each vertex.
+     * @param ids values of the vertices, it can be empty.
+     */
+    CSRGraph(vector<uint64_t> &&offsets, vector<unsigned int> &&adjacency, vector<unsigned int> &&ids);
+
+    /**
+     * @brief Construct a new CSRGraph object that is a view of arrays stored somewhere else.
+     * @param num_vertices number of vertices.
+     * @param offsets num_vertices+1 positions in the adjacency array.
+     * @param adjacency adjacent vertices of each vertex.
+     * @param ids values of the vertices, nullptr if the values are the indices.
+     */
+    CSRGraph(unsigned int num_vertices, const uint64_t *offsets, const unsigned int *adjacency, const unsigned int *ids);
+
+    /**
+     * @brief Construct a new CSRGraph object copying another one, owned arrays are copied while views stay views.
+     * @param other graph to be copied.
+     */
+    CSRGraph(const CSRGraph &other);
+
+    /**
+     * @brief Copy another graph in the current one, owned arrays are copied while views stay views.
+     * @param other graph to be copied.
+     * @return CSRGraph& reference to the current graph.
+     */
+    CSRGraph& operator=(const CSRGraph &other);
+
+    CSRGraph(CSRGraph &&other) = default;
+    CSRGraph& operator=(CSRGraph &&other) = default;
+
+    /**
+     * @brief Get the number of vertices in the graph.
+     * @return unsigned int number of vertices.
+     */
+    unsigned int size();
+
+    /**
+     * @brief Get the number of edges in the graph.
+     * @return unsigned int number of edges.
+     */
+    unsigned int edgeSize();
+
+    /**
+     * @brief Get the value of the vertex with a certain index.
+     * @param index dense index of the vertex.
+     * @return unsigned int value of the vertex.
+     */
+    unsigned int vertexValue(unsigned int index) {
+        return ids == nullptr ? index : ids[index];
+    }
+
+    /**
+     * @brief Get the dense index of a vertex.
+     * @param vertex value of the vertex.
+     * @return unsigned int dense index of the vertex, size() if it is not contained.
+     */
+    unsigned int indexOf(unsigned int vertex);
+
+    /**
+     * @brief Get the number of vertices adjacent to a vertex.
+     * @param index dense index of the vertex.
+     * @return unsigned int degree of the vertex.
+     */
+    unsigned int degree(unsigned int index) {
+        return offsets[index+1] - offsets[index];
+    }
+
+    /**
+     * @brief Get the vertices adjacent to a vertex, they are returned as dense indices in ascending order.
+     * @param index dense index of the vertex.
+     * @return NeighborRange range of adjacent vertices.
+     */
+    NeighborRange neighbors(unsigned int index) {
+        return NeighborRange{adjacency + offsets[index], adjacency + offsets[index+1]};
+    }
+
+    /**
+     * @brief Check if the graph has a table of ids.
+     * @return true if the values of the vertices are stored in a table.
+     * @return false if the values of the vertices are their indices.
+     */
+    bool hasIds();
+
+    /**
+     * @brief Get the offsets array of the graph.
+     * @return const uint64_t* num_vertices+1 offsets.
+     */
+    const uint64_t* getOffsets();
+
+    /**
+     * @brief Get the adjacency array of the graph.
+     * @return const unsigned int* 2*edgeSize() adjacent vertices.
+     */
+    const unsigned int* getAdjacency();
+
+    /**
+     * @brief Get the table of ids of the graph.
+     * @return const unsigned int* values of the vertices, nullptr if there is no table.
+     */
+    const unsigned int* getIds();
+
+    /**
+     * @brief Get the values of the vertices in the graph.
+     * @return vector<unsigned int> values of the vertices in ascending order.
+     */
+    vector<unsigned int> getVerticesKeys();
+
+    /**
+     * @brief Create a Graph object with the same vertices and edges.
+     * @param graph graph that will receive the vertices and the edges, it is cleared before.
+     */
+    void toGraph(Graph &graph);
+
+    /**
+     * @brief Check if the graph is connected.
+     * @return true if it is connected.
+     * @return false if it is not connected.
+     */
+    bool isConnected();
+
+    /**
+     * @brief Same algorithm of Graph::lex_p.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+     */
+    vector<unsigned int> lex_p();
+
+    /**
+     * @brief Same algorithm of Graph::lex_m, the graph is not modified and the fill edges are reported separately.
+     * @param fill if not null, it receives the edges of the minimal triangulation that are not in the graph.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+     */
+    vector<unsigned int> lex_m(vector<pair<unsigned int, unsigned int>> *fill = nullptr);
+
+    /**
+     * @brief Same as lex_p, the work done is counted in stats.
+     * @param stats it accumulates the cells created and destroyed and the refinements of the partition.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+     */
+    vector<unsigned int> lex_p(OrderingStats &stats);
+
+    /**
+     * @brief Same as lex_m, the work done is counted in stats.
+     * @param stats it accumulates the pushes in the reach queues, the renumbered labels and the fill edges found.
+     * @param fill if not null, it receives the edges of the minimal triangulation that are not in the graph.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+     */
+    vector<unsigned int> lex_m(OrderingStats &stats, vector<pair<unsigned int, unsigned int>> *fill = nullptr);
+
+    /**
+     * @brief Same as lex_m, but the run is bounded by control, see OrderingEngines::lex_m.
+     * @param control limits of the run, it receives the outcome.
+     * @param fill if not null, it receives the fill edges of the numbered vertices.
+     * @return vector<unsigned int> structure that contains the ordered vertices, minimal when control.status() is Completed.
+     */
+    vector<unsigned int> lex_m(RunControl &control, vector<pair<unsigned int, unsigned int>> *fill = nullptr);
+
+private:
+    /**
+     * @brief Point the arrays to the owned vectors.
+     */
+    void bindOwned();
+
+    /**
+     * @brief Number of vertices in the graph.
+     */
+    unsigned int numVertices;
+
+    /**
+     * @brief Positions of the adjacency lists.
+     */
+    const uint64_t *offsets;
+
+    /**
+     * @brief Adjacency lists of all the vertices.
+     */
+    const unsigned int *adjacency;
+
+    /**
+     * @brief Values of the vertices, nullptr if the values are the indices.
+     */
+    const unsigned int *ids;
+
+    /**
+     * @brief True if the arrays are stored in the vectors below.
+     */
+    bool owned;
+
+    /**
+     * @brief Storage of the arrays for the graphs that own them.
+     */
+    vector<uint64_t> ownedOffsets;
+    vector<unsigned int> ownedAdjacency;
+    vector<unsigned int> ownedIds;
+};
+
+}
+
+#endif
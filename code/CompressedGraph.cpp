@@ -0,0 +1,242 @@
+#include "CompressedGraph.hpp"
+#include "Tracer.hpp"
+
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+
+/**
+ * @brief Shuffle masks that move the bytes of a group in four 32 bit integers, one mask for each control byte.
+ */
+static struct ShuffleTable {
+    uint8_t masks[256][16];
+
+    ShuffleTable() {
+        for(unsigned int control = 0; control < 256; ++control) {
+            unsigned int byte = 0;
+            for(unsigned int j = 0; j < 4; ++j) {
+                unsigned int length = ((control >> (2*j)) & 3) + 1;
+                for(unsigned int b = 0; b < 4; ++b)
+                    masks[control][4*j + b] = b < length ? byte + b : 0x80;
+                byte += length;
+            }
+        }
+    }
+} shuffle_table;
+#endif
+
+/**
+ * @brief Construct a new Neighbor Iterator object.
+ * @param data first byte of the encoded list.
+ * @param remaining number of indices still to be read.
+ */
+CustomGraph::CompressedGraph::NeighborIterator::NeighborIterator(const uint8_t *data, unsigned int remaining)
+    : data(data), remaining(remaining), position(0) {
+    group[3] = 0;
+    if(remaining > 0)
+        decode();
+}
+
+/**
+ * @brief Move to the next adjacent vertex.
+ * @return NeighborIterator& the iterator itself.
+ */
+CustomGraph::CompressedGraph::NeighborIterator& CustomGraph::CompressedGraph::NeighborIterator::operator++() {
+    --remaining;
+    if(++position == 4 && remaining > 0)
+        decode();
+    return *this;
+}
+
+/**
+ * @brief Decode the next group of indices.
+ */
+void CustomGraph::CompressedGraph::NeighborIterator::decode() {
+    // the differences are relative to the last index of the previous group
+    uint32_t previous = group[3];
+    uint8_t control = *data++;
+    unsigned int count = remaining < 4 ? remaining : 4;
+
+#ifdef __SSSE3__
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    __m128i deltas = _mm_shuffle_epi8(bytes, _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle_table.masks[control])));
+
+    // prefix sum of the four differences
+    deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 4));
+    deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 8));
+    deltas = _mm_add_epi32(deltas, _mm_set1_epi32(previous));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(group), deltas);
+
+    for(unsigned int j = 0; j < count; ++j)
+        data += ((control >> (2*j)) & 3) + 1;
+#else
+    for(unsigned int j = 0; j < count; ++j) {
+        unsigned int length = ((control >> (2*j)) & 3) + 1;
+        uint32_t delta = 0;
+        for(unsigned int b = 0; b < length; ++b)
+            delta |= (uint32_t) data[b] << (8*b);
+        data += length;
+        previous += delta;
+        group[j] = previous;
+    }
+#endif
+    position = 0;
+}
+
+/**
+ * @brief Construct a new empty Compressed Graph object.
+ */
+CustomGraph::CompressedGraph::CompressedGraph() : offsets(1, 0), data(16, 0), numEdges(0) {}
+
+/**
+ * @brief Construct a new Compressed Graph object that contains the vertices and the edges of a graph.
+ * @param graph graph to be compressed.
+ */
+CustomGraph::CompressedGraph::CompressedGraph(Graph &graph) : numEdges(graph.edgeSize()) {
+    Tracer::Span span("CompressedGraph::CompressedGraph", "build");
+    values = graph.getVerticesKeys();
+    sort(values.begin(), values.end());
+
+    offsets.reserve(values.size() + 1);
+    degrees.reserve(values.size());
+    offsets.push_back(0);
+
+    vector<unsigned int> adjacent;
+    for(auto v : values) {
+        adjacent.clear();
+        graph.forEachAdjacent(v, [&](unsigned int w) {
+            adjacent.push_back(indexOf(w));
+        });
+        sort(adjacent.begin(), adjacent.end());
+
+        encode(adjacent);
+        degrees.push_back(adjacent.size());
+        offsets.push_back(data.size());
+    }
+
+    data.resize(data.size() + 16, 0);
+    data.shrink_to_fit();
+}
+
+/**
+ * @brief Get the number of vertices in the graph.
+ * @return unsigned int number of vertices.
+ */
+unsigned int CustomGraph::CompressedGraph::size() {
+    return values.size();
+}
+
+/**
+ * @brief Get the number of edges in the graph.
+ * @return unsigned int number of edges.
+ */
+unsigned int CustomGraph::CompressedGraph::edgeSize() {
+    return numEdges;
+}
+
+/**
+ * @brief Get the value of the vertex with a certain dense index.
+ * @param index dense index of the vertex.
+ * @return unsigned int value of the vertex.
+ */
+unsigned int CustomGraph::CompressedGraph::vertexValue(unsigned int index) {
+    return values[index];
+}
+
+/**
+ * @brief Get the dense index of a vertex, it uses a binary search over the sorted values.
+ * @param vertex value of the vertex.
+ * @return unsigned int dense index of the vertex, size() if it is not contained.
+ */
+unsigned int CustomGraph::CompressedGraph::indexOf(unsigned int vertex) {
+    auto it = lower_bound(values.begin(), values.end(), vertex);
+    if(it == values.end() || *it != vertex)
+        return values.size();
+    return it - values.begin();
+}
+
+/**
+ * @brief Get the number of vertices adjacent to a vertex.
+ * @param index dense index of the vertex.
+ * @return unsigned int degree of the vertex.
+ */
+unsigned int CustomGraph::CompressedGraph::degree(unsigned int index) {
+    return degrees[index];
+}
+
+/**
+ * @brief Get the vertices adjacent to a vertex, they are returned as dense indices in ascending order.
+ * @param index dense index of the vertex.
+ * @return NeighborRange range of adjacent vertices.
+ */
+CustomGraph::CompressedGraph::NeighborRange CustomGraph::CompressedGraph::neighbors(unsigned int index) {
+    const uint8_t *list = data.data() + offsets[index];
+    return NeighborRange{NeighborIterator(list, degrees[index]), NeighborIterator(list, 0)};
+}
+
+/**
+ * @brief Get the values of the vertices in the graph.
+ * @return vector<unsigned int> values of the vertices in ascending order.
+ */
+vector<unsigned int> CustomGraph::CompressedGraph::getVerticesKeys() {
+    return values;
+}
+
+/**
+ * @brief Get the number of bytes used by the structures of the graph.
+ * @return size_t bytes used.
+ */
+size_t CustomGraph::CompressedGraph::memoryUsage() {
+    return sizeof(*this) + values.capacity() * sizeof(unsigned int) + offsets.capacity() * sizeof(uint64_t)
+        + degrees.capacity() * sizeof(unsigned int) + data.capacity();
+}
+
+/**
+ * @brief Check if the graph is connected.
+ * @return true if it is connected.
+ * @return false if it is not connected.
+ */
+bool CustomGraph::CompressedGraph::isConnected() {
+    return OrderingEngines::isConnected(*this);
+}
+
+/**
+ * @brief Same algorithm of Graph::lex_p, the adjacent vertices are decoded directly from the compressed lists.
+ * @return vector<unsigned int> structure that contains the ordered vertices (values) of the perfect ordering procedure.
+ */
+vector<unsigned int> CustomGraph::CompressedGraph::lex_p() {
+    return OrderingEngines::lex_p(*this);
+}
+
+/**
+ * @brief Same as lex_p, the work done is counted in stats.
+ * @param stats it accumulates the cells created and destroyed and the refinements of the partition.
+ * @return vector<unsigned int> structure that contains the ordered vertices (values) of the perfect ordering procedure.
+ */
+vector<unsigned int> CustomGraph::CompressedGraph::lex_p(OrderingStats &stats) {
+    return OrderingEngines::lex_p<true>(*this, &stats);
+}
+
+/**
+ * @brief Append to the data the encoding of a sorted list of indices.
+ * @param sorted_indices indices to be encoded in ascending order.
+ */
+void CustomGraph::CompressedGraph::encode(const vector<unsigned int> &sorted_indices) {
+    uint32_t previous = 0;
+
+    for(unsigned int g = 0; g < sorted_indices.size(); g += 4) {
+        size_t control_position = data.size();
+        uint8_t control = 0;
+        data.push_back(0);
+
+        for(unsigned int j = 0; j < 4 && g + j < sorted_indices.size(); ++j) {
+            uint32_t delta = sorted_indices[g + j] - previous;
+            previous = sorted_indices[g + j];
+
+            unsigned int length = delta < (1u << 8) ? 1 : delta < (1u << 16) ? 2 : delta < (1u << 24) ? 3 : 4;
+            control |= (length - 1) << (2*j);
+            for(unsigned int b = 0; b < length; ++b)
+                data.push_back((delta >> (8*b)) & 0xFF);
+        }
+        data[control_position] = control;
+    }
+}
@@ -0,0 +1,231 @@
+#ifndef COMPRESSED_GRAPH_H_
+#define COMPRESSED_GRAPH_H_
+
+#include "Graph.hpp"
+#include "OrderingEngines.hpp"
+
+#include <cstdint>
+#include <vector>
+#include <iterator>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Read-only representation of a graph that needs a few bytes per edge. The vertices are renumbered with dense indices
+ * in [0, n) following the ascending order of their values, then the sorted adjacency list of each vertex is stored as the
+ * sequence of the differences between consecutive indices. The differences are written with a byte-oriented codec: groups
+ * of four integers are preceded by a control byte that contains the length (1 to 4 bytes) of each of them, so that a whole
+ * group can be decoded with a single shuffle when SSSE3 is available.
+ */
+struct CompressedGraph {
+public:
+    /**
+     * @brief Iterator over the adjacent vertices of a vertex, it decodes a group of four indices at a time.
+     */
+    struct NeighborIterator {
+    public:
+        using iterator_category = input_iterator_tag;
+        using value_type = unsigned int;
+        using difference_type = ptrdiff_t;
+        using pointer = const unsigned int*;
+        using reference = const unsigned int&;
+
+        /**
+         * @brief Construct a new Neighbor Iterator object.
+         * @param data first byte of the encoded list.
+         * @param remaining number of indices still to be read.
+         */
+        NeighborIterator(const uint8_t *data, unsigned int remaining);
+
+        /**
+         * @brief Get the index of the current adjacent vertex.
+         * @return unsigned int dense index of the vertex.
+         */
+        unsigned int operator*() const {
+            return group[position];
+        }
+
+        /**
+         * @brief Move to the next adjacent vertex.
+         * @return NeighborIterator& the iterator itself.
+         */
+        NeighborIterator& operator++();
+
+        /**
+         * @brief Two iterators of the same list are equal when they have the same number of indices still to be read.
+         * @param other iterator to be compared.
+         * @return true if the two iterators are in the same position.
+         * @return false otherwise.
+         */
+        bool operator==(const NeighborIterator &other) const {
+            return remaining == other.remaining;
+        }
+
+        /**
+         * @brief Negation of operator==.
+         * @param other iterator to be compared.
+         * @return true if the two iterators are in different positions.
+         * @return false otherwise.
+         */
+        bool operator!=(const NeighborIterator &other) const {
+            return remaining != other.remaining;
+        }
+
+    private:
+        /**
+         * @brief Decode the next group of indices.
+         */
+        void decode();
+
+        /**
+         * @brief Next byte to be decoded.
+         */
+        const uint8_t *data;
+
+        /**
+         * @brief Number of indices still to be read, the current one included.
+         */
+        unsigned int remaining;
+
+        /**
+         * @brief Position of the current index inside the decoded group.
+         */
+        unsigned int position;
+
+        /**
+         * @brief Last decoded group of indices.
+         */
+        uint32_t group[4];
+    };
+
+    /**
+     * @brief Range of adjacent vertices that can be used in a range-based for loop.
+     */
+    struct NeighborRange {
+        NeighborIterator first, last;
+
+        NeighborIterator begin() const { return first; }
+        NeighborIterator end() const { return last; }
+    };
+
+    /**
+     * @brief Construct a new empty Compressed Graph object.
+     */
+    CompressedGraph();
+
+    /**
+     * @brief Construct a new Compressed Graph object that contains the vertices and the edges of a graph.
+     * @param graph graph to be compressed.
+     */
+    CompressedGraph(Graph &graph);
+
+    /**
+     * @brief Get the number of vertices in the graph.
+     * @return unsigned int number of vertices.
+     */
+    unsigned int size();
+
+    /**
+     * @brief Get the number of edges in the graph.
+     * @return unsigned int number of edges.
+     */
+    unsigned int edgeSize();
+
+    /**
+     * @brief Get the value of the vertex with a certain dense index.
+     * @param index dense index of the vertex.
+     * @return unsigned int value of the vertex.
+     */
+    unsigned int vertexValue(unsigned int index);
+
+    /**
+     * @brief Get the dense index of a vertex, it uses a binary search over the sorted values.
+     * @param vertex value of the vertex.
+     * @return unsigned int dense index of the vertex, size() if it is not contained.
+     */
+    unsigned int indexOf(unsigned int vertex);
+
+    /**
+     * @brief Get the number of vertices adjacent to a vertex.
+     * @param index dense index of the vertex.
+     * @return unsigned int degree of the vertex.
+     */
+    unsigned int degree(unsigned int index);
+
+    /**
+     * @brief Get the vertices adjacent to a vertex, they are returned as dense indices in ascending order.
+     * @param index dense index of the vertex.
+     * @return NeighborRange range of adjacent vertices.
+     */
+    NeighborRange neighbors(unsigned int index);
+
+    /**
+     * @brief Get the values of the vertices in the graph.
+     * @return vector<unsigned int> values of the vertices in ascending order.
+     */
+    vector<unsigned int> getVerticesKeys();
+
+    /**
+     * @brief Get the number of bytes used by the structures of the graph.
+     * @return size_t bytes used.
+     */
+    size_t memoryUsage();
+
+    /**
+     * @brief Check if the graph is connected.
+     * @return true if it is connected.
+     * @return false if it is not connected.
+     */
+    bool isConnected();
+
+    /**
+     * @brief Same algorithm of Graph::lex_p, the adjacent vertices are decoded directly from the compressed lists.
+     * @return vector<unsigned int> structure that contains the ordered vertices (values) of the perfect ordering procedure.
+     */
+    vector<unsigned int> lex_p();
+
+    /**
+     * @brief Same as lex_p, the work done is counted in stats.
+     * @param stats it accumulates the cells created and destroyed and the refinements of the partition.
+     * @return vector<unsigned int> structure that contains the ordered vertices (values) of the perfect ordering procedure.
+     */
+    vector<unsigned int> lex_p(OrderingStats &stats);
+
+private:
+    /**
+     * @brief Append to the data the encoding of a sorted list of indices.
+     * @param sorted_indices indices to be encoded in ascending order.
+     */
+    void encode(const vector<unsigned int> &sorted_indices);
+
+    /**
+     * @brief Values of the vertices, the position of a value is its dense index.
+     */
+    vector<unsigned int> values;
+
+    /**
+     * @brief Position in data of the encoded list of each vertex, the last element is the end of the data.
+     */
+    vector<uint64_t> offsets;
+
+    /**
+     * @brief Degree of each vertex.
+     */
+    vector<unsigned int> degrees;
+
+    /**
+     * @brief Encoded adjacency lists, followed by a padding of 16 bytes so that a group can always be loaded at once.
+     */
+    vector<uint8_t> data;
+
+    /**
+     * @brief Number of edges in the graph.
+     */
+    unsigned int numEdges;
+};
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+#include "ConcurrentGraphBuilder.hpp"
+#include "GraphBuilder.hpp"
+#include "Parallel.hpp"
+#include "Tracer.hpp"
+
+/**
+ * @brief Source of the identifiers of the builders, an identifier is never reused.
+ */
+static atomic<uint64_t> nextBuilderId(1);
+
+/**
+ * @brief Buffer of the current thread in a builder.
+ */
+struct CachedBuffer {
+    uint64_t builderId;
+    void *buffer;
+};
+
+/**
+ * @brief Number of builders whose buffers are remembered by each thread.
+ */
+static const unsigned int CACHED_BUFFERS = 8;
+
+/**
+ * @brief Buffers last used by the current thread, from the most recent, with the identifiers of their builders. A
+ * thread that alternates between a few builders finds all of them here without taking any lock.
+ */
+static thread_local CachedBuffer cachedBuffers[CACHED_BUFFERS] = {};
+
+/**
+ * @brief Construct a new empty ConcurrentGraphBuilder object.
+ */
+CustomGraph::ConcurrentGraphBuilder::ConcurrentGraphBuilder() : id(nextBuilderId++) {}
+
+/**
+ * @brief Add a vertex, it can be called concurrently by different threads.
+ * @param vertex value of the vertex.
+ */
+void CustomGraph::ConcurrentGraphBuilder::addVertex(unsigned int vertex) {
+    localBuffer().vertices.push_back(vertex);
+}
+
+/**
+ * @brief Add an edge, it can be called concurrently by different threads. Duplicates and auto-rings are dropped by finalize.
+ * @param src source vertex of the edge.
+ * @param dst destination vertex of the edge.
+ */
+void CustomGraph::ConcurrentGraphBuilder::addEdge(unsigned int src, unsigned int dst) {
+    Buffer &buffer = localBuffer();
+    buffer.sources.push_back(src);
+    buffer.destinations.push_back(dst);
+}
+
+/**
+ * @brief Get the number of edges added so far, duplicates included. It is exact only when no producer is running.
+ * @return size_t number of edges added.
+ */
+size_t CustomGraph::ConcurrentGraphBuilder::pendingEdges() {
+    lock_guard<mutex> lock(buffersMutex);
+    size_t edges = 0;
+    for(auto &buffer : buffers)
+        edges += buffer->sources.size();
+    return edges;
+}
+
+/**
+ * @brief Build a graph with the vertices and the edges added so far, the builder keeps its content.
+ * @param graph graph that receives the vertices and the edges, it is cleared before.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ */
+void CustomGraph::ConcurrentGraphBuilder::finalize(Graph &graph, unsigned int num_threads) {
+    Tracer::Span span("ConcurrentGraphBuilder::finalize", "build");
+    vector<unsigned int> vertices, sources, destinations;
+    merge(vertices, sources, destinations, num_threads);
+    GraphBuilder::build(vertices, sources, destinations, graph, num_threads);
+}
+
+/**
+ * @brief Build a snapshot in compressed sparse row format with the vertices and the edges added so far, the builder
+ * keeps its content.
+ * @param csr graph that receives the vertices and the edges.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ */
+void CustomGraph::ConcurrentGraphBuilder::finalize(CSRGraph &csr, unsigned int num_threads) {
+    Tracer::Span span("ConcurrentGraphBuilder::finalize", "build");
+    vector<unsigned int> vertices, sources, destinations;
+    merge(vertices, sources, destinations, num_threads);
+    GraphBuilder::buildCSR(vertices, sources, destinations, csr, num_threads);
+}
+
+/**
+ * @brief Remove all the vertices and the edges added so far and release the buffers.
+ */
+void CustomGraph::ConcurrentGraphBuilder::clear() {
+    lock_guard<mutex> lock(buffersMutex);
+    buffers.clear();
+    id = nextBuilderId++;
+}
+
+/**
+ * @brief Get the buffer of the calling thread, it is created the first time the thread uses the builder. The buffer is
+ * looked up in the buffers remembered by the thread, then, under the mutex, among the buffers of the builder by the
+ * owner thread, so a thread has a single buffer per builder however many builders it alternates.
+ * @return Buffer& buffer of the calling thread.
+ */
+CustomGraph::ConcurrentGraphBuilder::Buffer& CustomGraph::ConcurrentGraphBuilder::localBuffer() {
+    if(cachedBuffers[0].builderId == id)
+        return *static_cast<Buffer*>(cachedBuffers[0].buffer);
+
+    CachedBuffer found = {id, nullptr};
+    unsigned int last = CACHED_BUFFERS - 1;
+    for(unsigned int i = 1; i < CACHED_BUFFERS; ++i)
+        if(cachedBuffers[i].builderId == id) {
+            found = cachedBuffers[i];
+            last = i;
+            break;
+        }
+
+    if(found.buffer == nullptr) {
+        thread::id self = this_thread::get_id();
+        lock_guard<mutex> lock(buffersMutex);
+        for(auto &buffer : buffers)
+            if(buffer->owner == self) {
+                found.buffer = buffer.get();
+                break;
+            }
+        if(found.buffer == nullptr) {
+            buffers.push_back(make_unique<Buffer>());
+            buffers.back()->owner = self;
+            found.buffer = buffers.back().get();
+        }
+    }
+
+    // the buffer becomes the most recent one, the least recent is forgotten if it was not found
+    for(unsigned int i = last; i > 0; --i)
+        cachedBuffers[i] = cachedBuffers[i-1];
+    cachedBuffers[0] = found;
+    return *static_cast<Buffer*>(found.buffer);
+}
+
+/**
+ * @brief Merge the buffers in three arrays, the endpoints of the edges are appended to the vertices.
+ * @param vertices values of the vertices.
+ * @param sources sources of the edges.
+ * @param destinations destinations of the edges.
+ * @param num_threads number of threads to be used.
+ */
+void CustomGraph::ConcurrentGraphBuilder::merge(vector<unsigned int> &vertices, vector<unsigned int> &sources, vector<unsigned int> &destinations,
+                                                unsigned int num_threads) {
+    lock_guard<mutex> lock(buffersMutex);
+
+    vector<size_t> edgeStarts(buffers.size() + 1, 0), vertexStarts(buffers.size() + 1, 0);
+    for(unsigned int i = 0; i < buffers.size(); ++i) {
+        edgeStarts[i+1] = edgeStarts[i] + buffers[i]->sources.size();
+        vertexStarts[i+1] = vertexStarts[i] + buffers[i]->vertices.size();
+    }
+
+    size_t num_edges = edgeStarts.back(), num_vertices = vertexStarts.back();
+    sources.resize(num_edges);
+    destinations.resize(num_edges);
+    vertices.resize(num_vertices + 2 * num_edges);
+
+    Parallel::forEach(buffers.size(), [&](unsigned int i) {
+        Buffer &buffer = *buffers[i];
+        copy(buffer.sources.begin(), buffer.sources.end(), sources.begin() + edgeStarts[i]);
+        copy(buffer.destinations.begin(), buffer.destinations.end(), destinations.begin() + edgeStarts[i]);
+        copy(buffer.vertices.begin(), buffer.vertices.end(), vertices.begin() + vertexStarts[i]);
+        copy(buffer.sources.begin(), buffer.sources.end(), vertices.begin() + num_vertices + edgeStarts[i]);
+        copy(buffer.destinations.begin(), buffer.destinations.end(), vertices.begin() + num_vertices + num_edges + edgeStarts[i]);
+    }, num_threads);
+}
@@ -0,0 +1,123 @@
+#ifndef CONCURRENT_GRAPH_BUILDER_H_
+#define CONCURRENT_GRAPH_BUILDER_H_
+
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Builder that collects vertices and edges from many producer threads at once. Every thread appends to its own
+ * buffer, the buffer is registered under a mutex only the first time a thread uses the builder, afterwards addEdge and
+ * addVertex do not take any lock and do not share any cache line with the other producers. Each thread remembers its
+ * buffers in the last few builders it used, so alternating between builders does not take the lock either.
+ * finalize merges the buffers and builds the graph in bulk with GraphBuilder; the endpoints of the edges become vertices
+ * of the graph, so edges can be added without declaring their vertices. finalize and clear must not run concurrently
+ * with the producers.
+ */
+struct ConcurrentGraphBuilder {
+public:
+    /**
+     * @brief Construct a new empty ConcurrentGraphBuilder object.
+     */
+    ConcurrentGraphBuilder();
+
+    ConcurrentGraphBuilder(const ConcurrentGraphBuilder &other) = delete;
+    ConcurrentGraphBuilder& operator=(const ConcurrentGraphBuilder &other) = delete;
+
+    /**
+     * @brief Add a vertex, it can be called concurrently by different threads.
+     * @param vertex value of the vertex.
+     */
+    void addVertex(unsigned int vertex);
+
+    /**
+     * @brief Add an edge, it can be called concurrently by different threads. Duplicates and auto-rings are dropped by finalize.
+     * @param src source vertex of the edge.
+     * @param dst destination vertex of the edge.
+     */
+    void addEdge(unsigned int src, unsigned int dst);
+
+    /**
+     * @brief Get the number of edges added so far, duplicates included. It is exact only when no producer is running.
+     * @return size_t number of edges added.
+     */
+    size_t pendingEdges();
+
+    /**
+     * @brief Build a graph with the vertices and the edges added so far, the builder keeps its content.
+     * @param graph graph that receives the vertices and the edges, it is cleared before.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     */
+    void finalize(Graph &graph, unsigned int num_threads = 0);
+
+    /**
+     * @brief Build a snapshot in compressed sparse row format with the vertices and the edges added so far, the builder
+     * keeps its content.
+     * @param csr graph that receives the vertices and the edges.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     */
+    void finalize(CSRGraph &csr, unsigned int num_threads = 0);
+
+    /**
+     * @brief Remove all the vertices and the edges added so far and release the buffers.
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Buffer written by a single producer thread, aligned to keep the producers on different cache lines.
+     */
+    struct alignas(64) Buffer {
+        vector<unsigned int> vertices;
+        vector<unsigned int> sources;
+        vector<unsigned int> destinations;
+        thread::id owner;
+    };
+
+    /**
+     * @brief Get the buffer of the calling thread, it is created the first time the thread uses the builder. The buffer is
+     * looked up in the buffers remembered by the thread, then, under the mutex, among the buffers of the builder by the
+     * owner thread, so a thread has a single buffer per builder however many builders it alternates.
+     * @return Buffer& buffer of the calling thread.
+     */
+    Buffer& localBuffer();
+
+    /**
+     * @brief Merge the buffers in three arrays, the endpoints of the edges are appended to the vertices.
+     * @param vertices values of the vertices.
+     * @param sources sources of the edges.
+     * @param destinations destinations of the edges.
+     * @param num_threads number of threads to be used.
+     */
+    void merge(vector<unsigned int> &vertices, vector<unsigned int> &sources, vector<unsigned int> &destinations, unsigned int num_threads);
+
+    /**
+     * @brief Identifier of the current content of the builder, it changes at every clear so the threads do not reuse
+     * buffers that have been released.
+     */
+    uint64_t id;
+
+    /**
+     * @brief Buffers of all the producer threads.
+     */
+    vector<unique_ptr<Buffer>> buffers;
+
+    /**
+     * @brief Mutex that protects the list of buffers.
+     */
+    mutex buffersMutex;
+};
+
+}
+
+#endif
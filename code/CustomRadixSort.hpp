@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <cstdint>
 
 using namespace std;
 
@@ -19,9 +20,10 @@ public:
      * @brief Function that reassigns to the vector an integer number of label values and that sorts the vector
      * according to the value of the labels. It implements a custom version of radix-sort.
      * @param vertices_and_labels vector to be ordered.
+     * @param renumbered if not null, it is incremented by the number of labels changed by the reassignment.
      * @return unsigned int new number of labels in the vector.
      */
-    unsigned int static sortByLabel(vector<pair<unsigned int, float>> &vertices_and_labels) {
+    unsigned int static sortByLabel(vector<pair<unsigned int, float>> &vertices_and_labels, uint64_t *renumbered = nullptr) {
         // count the number of different labels
         unordered_set<float> different_k;
         for(unsigned int i = 0; i < vertices_and_labels.size(); ++i) 
@@ -42,8 +44,11 @@ public:
         // assign new labels 
         for(auto &el : vertices_and_labels)
             for(auto &lb : label_binding)
-                if(el.second == lb.first)
+                if(el.second == lb.first) {
+                    if(renumbered != nullptr && el.second != lb.second)
+                        (*renumbered)++;
                     el.second = lb.second;
+                }
 
         //sort the vector using radix-sort
         unsigned int max = getMaxLabel(vertices_and_labels);
@@ -0,0 +1,388 @@
+#include "DaemonProtocol.hpp"
+#include "GraphFile.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Seals that make the content of a shared payload immutable.
+ */
+static const int DAEMON_SEALS = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL;
+
+/**
+ * @brief Round a size up to the next multiple of 8.
+ * @param bytes size in bytes.
+ * @return size_t aligned size.
+ */
+static size_t alignWord(size_t bytes) {
+    return (bytes + 7) & ~(size_t) 7;
+}
+
+/**
+ * @brief Write all the bytes of a buffer in a socket.
+ * @param socket connected socket.
+ * @param data bytes to be written.
+ * @param bytes number of bytes.
+ * @return true if all the bytes have been written.
+ */
+static bool writeAll(int socket, const char *data, size_t bytes) {
+    while(bytes > 0) {
+        ssize_t written = ::send(socket, data, bytes, MSG_NOSIGNAL);
+        if(written <= 0)
+            return false;
+        data += written;
+        bytes -= written;
+    }
+    return true;
+}
+
+/**
+ * @brief Read exactly a number of bytes from a socket.
+ * @param socket connected socket.
+ * @param data it receives the bytes.
+ * @param bytes number of bytes.
+ * @return true if all the bytes have been read.
+ */
+static bool readAll(int socket, char *data, size_t bytes) {
+    while(bytes > 0) {
+        ssize_t read = ::recv(socket, data, bytes, 0);
+        if(read <= 0)
+            return false;
+        data += read;
+        bytes -= read;
+    }
+    return true;
+}
+
+/**
+ * @brief Mix a word in a hash, the finalizer of splitmix64 applied to the running state.
+ * @param hash current hash.
+ * @param word word to be added.
+ * @return uint64_t new hash.
+ */
+static uint64_t mixWord(uint64_t hash, uint64_t word) {
+    hash ^= word + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+/**
+ * @brief Construct a new empty DaemonBuffer object.
+ */
+DaemonBuffer::DaemonBuffer() : mapping(nullptr), bytes(0), fd(-1) {}
+
+/**
+ * @brief Destroy the DaemonBuffer object, the shared memory is unmapped and closed.
+ */
+DaemonBuffer::~DaemonBuffer() {
+    clear();
+}
+
+DaemonBuffer::DaemonBuffer(DaemonBuffer &&other) : mapping(nullptr), bytes(0), fd(-1) {
+    *this = move(other);
+}
+
+DaemonBuffer& DaemonBuffer::operator=(DaemonBuffer &&other) {
+    if(this == &other)
+        return *this;
+    clear();
+    local = move(other.local);
+    mapping = other.mapping;
+    bytes = other.bytes;
+    fd = other.fd;
+    other.local.clear();
+    other.mapping = nullptr;
+    other.bytes = 0;
+    other.fd = -1;
+    return *this;
+}
+
+/**
+ * @brief Allocate a writable payload, in shared memory if it is at least SHARED_THRESHOLD bytes.
+ * @param bytes size of the payload.
+ * @return true if the payload has been allocated.
+ * @return false if the shared memory cannot be created.
+ */
+bool DaemonBuffer::allocate(size_t bytes) {
+    clear();
+    if(bytes < DaemonProtocol::SHARED_THRESHOLD) {
+        local.assign(bytes, 0);
+        this->bytes = bytes;
+        return true;
+    }
+
+    fd = memfd_create("cgraph-payload", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if(fd < 0)
+        return false;
+    void *address = MAP_FAILED;
+    if(ftruncate(fd, bytes) == 0)
+        address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(address == MAP_FAILED) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    mapping = static_cast<char*>(address);
+    this->bytes = bytes;
+    return true;
+}
+
+/**
+ * @brief Release the payload.
+ */
+void DaemonBuffer::clear() {
+    if(mapping != nullptr)
+        munmap(mapping, bytes);
+    if(fd >= 0)
+        ::close(fd);
+    local.clear();
+    mapping = nullptr;
+    bytes = 0;
+    fd = -1;
+}
+
+/**
+ * @brief Get the payload.
+ * @return char* first byte of the payload, it must not be written when the buffer has been received.
+ */
+char* DaemonBuffer::data() {
+    return fd >= 0 || mapping != nullptr ? mapping : local.data();
+}
+
+/**
+ * @brief Get the size of the payload.
+ * @return size_t number of bytes.
+ */
+size_t DaemonBuffer::size() {
+    return bytes;
+}
+
+/**
+ * @brief Check if the payload is in shared memory.
+ * @return true if it is passed as a descriptor.
+ * @return false if it is copied through the socket.
+ */
+bool DaemonBuffer::isShared() {
+    return fd >= 0 || mapping != nullptr;
+}
+
+/**
+ * @brief Send a message, a shared payload is sealed before and the buffer cannot be written anymore.
+ * @param socket connected socket.
+ * @param kind kind of the message.
+ * @param key key of the graph.
+ * @param payload payload of the message, it can be empty.
+ * @return true if the message has been sent.
+ */
+bool DaemonProtocol::send(int socket, uint16_t kind, uint64_t key, DaemonBuffer &payload) {
+    DaemonHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.kind = kind;
+    header.key = key;
+    header.size = payload.size();
+
+    struct iovec io;
+    io.iov_base = &header;
+    io.iov_len = sizeof(header);
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+
+    // the writable mapping must be removed before the write seal can be added
+    char control[CMSG_SPACE(sizeof(int))];
+    if(payload.isShared()) {
+        if(payload.fd < 0)
+            return false;
+        if(payload.mapping != nullptr) {
+            munmap(payload.mapping, payload.bytes);
+            payload.mapping = nullptr;
+            if(fcntl(payload.fd, F_ADD_SEALS, DAEMON_SEALS) != 0)
+                return false;
+        }
+        header.flags = SHARED;
+        memset(control, 0, sizeof(control));
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &payload.fd, sizeof(int));
+    }
+
+    ssize_t sent = sendmsg(socket, &message, MSG_NOSIGNAL);
+    if(sent <= 0)
+        return false;
+    if(!writeAll(socket, reinterpret_cast<const char*>(&header) + sent, sizeof(header) - sent))
+        return false;
+    return payload.isShared() || writeAll(socket, payload.data(), payload.size());
+}
+
+/**
+ * @brief Receive a message.
+ * @param socket connected socket.
+ * @param header it receives the header of the message.
+ * @param payload it receives the payload of the message.
+ * @return true if a valid message has been received.
+ * @return false if the connection has been closed or the message is not valid.
+ */
+bool DaemonProtocol::receive(int socket, DaemonHeader &header, DaemonBuffer &payload) {
+    payload.clear();
+
+    struct iovec io;
+    io.iov_base = &header;
+    io.iov_len = sizeof(header);
+    char control[CMSG_SPACE(sizeof(int))];
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = &io;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t read = recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+    if(read <= 0)
+        return false;
+
+    int fd = -1;
+    for(struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR(&message, cmsg))
+        if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+            memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    // the descriptor is owned by the buffer from now on, so it is closed on every error
+    payload.fd = fd;
+
+    if((message.msg_flags & MSG_CTRUNC) != 0)
+        return false;
+    if(!readAll(socket, reinterpret_cast<char*>(&header) + read, sizeof(header) - read))
+        return false;
+    if(header.magic != MAGIC || header.version != VERSION)
+        return false;
+
+    if(header.flags & SHARED) {
+        struct stat info;
+        if(fd < 0 || fstat(fd, &info) != 0 || (uint64_t) info.st_size < header.size)
+            return false;
+        int seals = fcntl(fd, F_GET_SEALS);
+        if(seals < 0 || (seals & (F_SEAL_SHRINK | F_SEAL_WRITE)) != (F_SEAL_SHRINK | F_SEAL_WRITE))
+            return false;
+        if(header.size > 0) {
+            void *address = mmap(nullptr, header.size, PROT_READ, MAP_SHARED, fd, 0);
+            if(address == MAP_FAILED)
+                return false;
+            payload.mapping = static_cast<char*>(address);
+        }
+        payload.bytes = header.size;
+        ::close(fd);
+        payload.fd = -1;
+        return true;
+    }
+
+    // the inline payloads are small, a larger size is a corrupted message
+    if(fd >= 0 || header.size >= SHARED_THRESHOLD)
+        return false;
+    payload.local.resize(header.size);
+    payload.bytes = header.size;
+    return readAll(socket, payload.local.data(), header.size);
+}
+
+/**
+ * @brief Compute the key of a graph, a 64 bit hash of its arrays. Two graphs with the same vertices and edges have
+ * the same arrays, so they have the same key.
+ * @param graph graph to be hashed.
+ * @return uint64_t content hash of the graph.
+ */
+uint64_t DaemonProtocol::contentHash(CustomGraph::CSRGraph &graph) {
+    unsigned int n = graph.size();
+    const uint64_t *offsets = graph.getOffsets();
+    const unsigned int *adjacency = graph.getAdjacency();
+    const unsigned int *ids = graph.getIds();
+    uint64_t num_adjacency = n == 0 ? 0 : offsets[n];
+
+    uint64_t hash = mixWord(n, graph.hasIds());
+    for(unsigned int i = 0; n > 0 && i <= n; ++i)
+        hash = mixWord(hash, offsets[i]);
+    for(uint64_t i = 0; i < num_adjacency; i += 2) {
+        uint64_t word = adjacency[i];
+        if(i + 1 < num_adjacency)
+            word |= (uint64_t) adjacency[i+1] << 32;
+        hash = mixWord(hash, word);
+    }
+    for(unsigned int i = 0; ids != nullptr && i < n; ++i)
+        hash = mixWord(hash, ids[i]);
+    return hash;
+}
+
+/**
+ * @brief Encode a graph as the payload of Put: the number of vertices, the number of adjacent vertices, 1 if there is
+ * a table of ids, then the offsets, the adjacency and the ids, each one padded to 8 bytes.
+ * @param graph graph to be encoded.
+ * @param payload it receives the encoding.
+ * @return true if the payload has been allocated.
+ */
+bool DaemonProtocol::writeGraph(CustomGraph::CSRGraph &graph, DaemonBuffer &payload) {
+    uint64_t n = graph.size();
+    uint64_t num_adjacency = n == 0 ? 0 : graph.getOffsets()[n];
+    uint64_t has_ids = graph.hasIds() ? 1 : 0;
+
+    size_t adjacency_position = 3 * sizeof(uint64_t) + (n + 1) * sizeof(uint64_t);
+    size_t ids_position = adjacency_position + alignWord(num_adjacency * sizeof(unsigned int));
+    size_t bytes = ids_position + (has_ids ? alignWord(n * sizeof(unsigned int)) : 0);
+    if(!payload.allocate(bytes))
+        return false;
+
+    char *base = payload.data();
+    uint64_t counts[3] = {n, num_adjacency, has_ids};
+    memcpy(base, counts, sizeof(counts));
+    if(n > 0)
+        memcpy(base + sizeof(counts), graph.getOffsets(), (n + 1) * sizeof(uint64_t));
+    else
+        memset(base + sizeof(counts), 0, sizeof(uint64_t));
+    memcpy(base + adjacency_position, graph.getAdjacency(), num_adjacency * sizeof(unsigned int));
+    if(has_ids)
+        memcpy(base + ids_position, graph.getIds(), n * sizeof(unsigned int));
+    return true;
+}
+
+/**
+ * @brief Decode the payload of Put. The graph is a view of the payload, which must outlive it; it is checked
+ * completely (offsets, sorted and symmetric rows, sorted ids) since it comes from another process.
+ * @param payload payload to be decoded.
+ * @param graph it receives the view of the graph.
+ * @return true if the payload contains a valid graph.
+ */
+bool DaemonProtocol::readGraph(DaemonBuffer &payload, CustomGraph::CSRGraph &graph) {
+    const char *base = payload.data();
+    size_t bytes = payload.size();
+    uint64_t counts[3];
+    if(bytes < sizeof(counts))
+        return false;
+    memcpy(counts, base, sizeof(counts));
+    uint64_t n = counts[0], num_adjacency = counts[1], has_ids = counts[2];
+    if(n > 0xFFFFFFFEu || num_adjacency > bytes || has_ids > 1)
+        return false;
+
+    size_t adjacency_position = sizeof(counts) + (n + 1) * sizeof(uint64_t);
+    size_t ids_position = adjacency_position + alignWord(num_adjacency * sizeof(unsigned int));
+    if(bytes != ids_position + (has_ids ? alignWord(n * sizeof(unsigned int)) : 0))
+        return false;
+
+    const uint64_t *offsets = reinterpret_cast<const uint64_t*>(base + sizeof(counts));
+    const unsigned int *adjacency = reinterpret_cast<const unsigned int*>(base + adjacency_position);
+    const unsigned int *ids = has_ids ? reinterpret_cast<const unsigned int*>(base + ids_position) : nullptr;
+
+    if(!CustomGraph::GraphFile::validGraph(n, num_adjacency, offsets, adjacency, ids))
+        return false;
+
+    graph = CustomGraph::CSRGraph(n, offsets, adjacency, ids);
+    return true;
+}
@@ -0,0 +1,192 @@
+#ifndef DAEMON_PROTOCOL_H_
+#define DAEMON_PROTOCOL_H_
+
+#include "CSRGraph.hpp"
+#include "GraphFingerprint.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Header of every message exchanged by OrderingClient and OrderingDaemon over their Unix socket. A message is the
+ * header followed by size bytes of payload. Small payloads follow the header in the socket; a payload of at least
+ * SHARED_THRESHOLD bytes is written in a sealed memfd whose descriptor is passed with the header (flag SHARED), so it
+ * is never copied through the socket and the receiver maps it read-only.
+ * - kind: a DaemonRequest in the requests, a DaemonStatus in the replies.
+ * - key: content hash of the graph the message refers to.
+ * All the numbers are in the byte order of the machine, client and daemon run on the same one.
+ */
+struct DaemonHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t kind;
+    uint64_t key;
+    uint64_t size;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+/**
+ * @brief Requests served by the daemon, the payloads are:
+ * - Put: a graph (see DaemonProtocol::writeGraph), the reply carries its key and no payload.
+ * - Load: the path of a graph file, mapped by the daemon with GraphFile; the reply carries its key.
+ * - Has: no payload, or the GraphFingerprint of the graph; the status tells if the graph is cached (and has that
+ *   fingerprint, so a client that computed the key locally does not use the graph of a colliding key).
+ * - Drop: no payload, the status tells if the graph was cached.
+ * - LexP, LexM, Order: no payload. FillIn, IsPerfect: an ordering (alpha-1) of unsigned 32 bit integers.
+ * The replies of the last five carry a DaemonReply.
+ */
+enum class DaemonRequest : uint16_t { Put, Load, Has, Drop, LexP, LexM, FillIn, Order, IsPerfect };
+
+/**
+ * @brief Status of a reply: UnknownGraph when the key is not cached (the client can Put the graph and retry),
+ * BadRequest when the message or its payload are not valid. ConnectionLost is never sent, OrderingClient returns it when
+ * the socket fails or the reply is not valid.
+ */
+enum class DaemonStatus : uint16_t { Ok, UnknownGraph, BadRequest, ConnectionLost };
+
+/**
+ * @brief Payload of the replies with an ordering: this header, the ordering (orderingSize unsigned 32 bit integers,
+ * alpha-1) and the fill edges (fillSize pairs of unsigned 32 bit integers). perfect is 1 when the ordering produces no
+ * fill (for Order when the graph is chordal).
+ */
+struct DaemonReply {
+    uint64_t orderingSize;
+    uint64_t fillSize;
+    uint32_t perfect;
+    uint32_t reserved;
+};
+
+/**
+ * @brief Payload of a message, either in local memory or in a shared memory object mapped by the process. The buffers
+ * that are received in shared memory are read-only views of the sender's memfd, that is sealed so their content cannot
+ * change anymore.
+ */
+struct DaemonBuffer {
+public:
+    /**
+     * @brief Construct a new empty DaemonBuffer object.
+     */
+    DaemonBuffer();
+
+    /**
+     * @brief Destroy the DaemonBuffer object, the shared memory is unmapped and closed.
+     */
+    ~DaemonBuffer();
+
+    DaemonBuffer(const DaemonBuffer &other) = delete;
+    DaemonBuffer& operator=(const DaemonBuffer &other) = delete;
+    DaemonBuffer(DaemonBuffer &&other);
+    DaemonBuffer& operator=(DaemonBuffer &&other);
+
+    /**
+     * @brief Allocate a writable payload, in shared memory if it is at least SHARED_THRESHOLD bytes.
+     * @param bytes size of the payload.
+     * @return true if the payload has been allocated.
+     * @return false if the shared memory cannot be created.
+     */
+    bool allocate(size_t bytes);
+
+    /**
+     * @brief Release the payload.
+     */
+    void clear();
+
+    /**
+     * @brief Get the payload.
+     * @return char* first byte of the payload, it must not be written when the buffer has been received.
+     */
+    char* data();
+
+    /**
+     * @brief Get the size of the payload.
+     * @return size_t number of bytes.
+     */
+    size_t size();
+
+    /**
+     * @brief Check if the payload is in shared memory.
+     * @return true if it is passed as a descriptor.
+     * @return false if it is copied through the socket.
+     */
+    bool isShared();
+
+private:
+    friend struct DaemonProtocol;
+
+    vector<char> local;
+    char *mapping;
+    size_t bytes;
+    int fd;
+};
+
+/**
+ * @brief Auxiliary structure with the encoding of the messages and of the graphs used by OrderingClient and OrderingDaemon.
+ * The functions return false on any error of the socket or of the message, the connection must be closed in that case.
+ */
+struct DaemonProtocol {
+public:
+    static const uint32_t MAGIC = 0x444f5243;
+    static const uint16_t VERSION = 1;
+
+    /**
+     * @brief Flag of the header set when the payload is passed in shared memory.
+     */
+    static const uint32_t SHARED = 1;
+
+    /**
+     * @brief Size from which a payload is passed in shared memory.
+     */
+    static const size_t SHARED_THRESHOLD = 64 * 1024;
+
+    /**
+     * @brief Send a message, a shared payload is sealed before and the buffer cannot be written anymore.
+     * @param socket connected socket.
+     * @param kind kind of the message.
+     * @param key key of the graph.
+     * @param payload payload of the message, it can be empty.
+     * @return true if the message has been sent.
+     */
+    static bool send(int socket, uint16_t kind, uint64_t key, DaemonBuffer &payload);
+
+    /**
+     * @brief Receive a message.
+     * @param socket connected socket.
+     * @param header it receives the header of the message.
+     * @param payload it receives the payload of the message.
+     * @return true if a valid message has been received.
+     * @return false if the connection has been closed or the message is not valid.
+     */
+    static bool receive(int socket, DaemonHeader &header, DaemonBuffer &payload);
+
+    /**
+     * @brief Compute the key of a graph, a 64 bit hash of its arrays. Two graphs with the same vertices and edges have
+     * the same arrays, so they have the same key.
+     * @param graph graph to be hashed.
+     * @return uint64_t content hash of the graph.
+     */
+    static uint64_t contentHash(CustomGraph::CSRGraph &graph);
+
+    /**
+     * @brief Encode a graph as the payload of Put: the number of vertices, the number of adjacent vertices, 1 if there is
+     * a table of ids, then the offsets, the adjacency and the ids, each one padded to 8 bytes.
+     * @param graph graph to be encoded.
+     * @param payload it receives the encoding.
+     * @return true if the payload has been allocated.
+     */
+    static bool writeGraph(CustomGraph::CSRGraph &graph, DaemonBuffer &payload);
+
+    /**
+     * @brief Decode the payload of Put. The graph is a view of the payload, which must outlive it; it is checked
+     * completely (offsets, sorted and symmetric rows, sorted ids) since it comes from another process.
+     * @param payload payload to be decoded.
+     * @param graph it receives the view of the graph.
+     * @return true if the payload contains a valid graph.
+     */
+    static bool readGraph(DaemonBuffer &payload, CustomGraph::CSRGraph &graph);
+};
+
+#endif
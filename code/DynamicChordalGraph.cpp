@@ -0,0 +1,591 @@
+#include "DynamicChordalGraph.hpp"
+#include "OrderingEngines.hpp"
+#include "Tracer.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+/**
+ * @brief Construct a new DynamicChordalGraph object with vertices 0, 1, ..., num_vertices-1 and no edges.
+ * @param num_vertices number of vertices.
+ */
+CustomGraph::DynamicChordalGraph::DynamicChordalGraph(unsigned int num_vertices)
+    : adjacency(num_vertices), region(num_vertices), position(num_vertices, 0), numEdges(0), nonChordal(0), workDone(0),
+      mark(num_vertices, 0), generation(0), onWitness(num_vertices, false) {
+    // every vertex is a chordal region with a trivial ordering
+    for(unsigned int v = 0; v < num_vertices; ++v) {
+        region[v] = v;
+        regions.push_back({{v}, true, true, true, 0, 0});
+    }
+}
+
+/**
+ * @brief Construct a new DynamicChordalGraph object with the vertices and the edges of a CSRGraph, the orderings of its
+ * components are computed once here.
+ * @param csr graph to be copied.
+ */
+CustomGraph::DynamicChordalGraph::DynamicChordalGraph(CSRGraph &csr)
+    : adjacency(csr.size()), region(csr.size(), 0), position(csr.size(), 0), numEdges(csr.edgeSize()), nonChordal(0),
+      workDone(0), mark(csr.size(), 0), generation(0), onWitness(csr.size(), false) {
+    Tracer::Span span("DynamicChordalGraph::DynamicChordalGraph", "build");
+    unsigned int n = csr.size();
+    if(csr.hasIds())
+        ids.assign(csr.getIds(), csr.getIds() + n);
+    for(unsigned int v = 0; v < n; ++v) {
+        CSRGraph::NeighborRange range = csr.neighbors(v);
+        adjacency[v].insert(range.begin(), range.end());
+    }
+
+    if(n == 0)
+        return;
+    unsigned int r = newRegion();
+    for(unsigned int v = 0; v < n; ++v)
+        regions[r].members.push_back(v);
+    refresh(r, false);
+    workDone = 0;
+}
+
+/**
+ * @brief Get the number of vertices.
+ * @return unsigned int number of vertices.
+ */
+unsigned int CustomGraph::DynamicChordalGraph::size() {
+    return adjacency.size();
+}
+
+/**
+ * @brief Get the number of edges.
+ * @return unsigned int number of edges.
+ */
+unsigned int CustomGraph::DynamicChordalGraph::edgeSize() {
+    return numEdges;
+}
+
+/**
+ * @brief Check if two vertices are adjacent.
+ * @param first value of the first vertex.
+ * @param second value of the second vertex.
+ * @return true if the edge {first, second} is in the graph.
+ * @return false if the edge is not in the graph.
+ */
+bool CustomGraph::DynamicChordalGraph::isAdjacent(unsigned int first, unsigned int second) {
+    unsigned int u = indexOf(first), v = indexOf(second);
+    return u != size() && v != size() && adjacency[u].count(v) != 0;
+}
+
+/**
+ * @brief Add an edge and update the chordality and the ordering of its region.
+ * An edge between two regions is a bridge: the merged ordering puts first the region of an endpoint that has no adjacent
+ * vertex after it, so that endpoint has only the other one after it. Inside a chordal region the ordering stays perfect
+ * if the endpoint eliminated later is adjacent to the vertices after the other endpoint, otherwise the searches decide
+ * if the graph is still chordal.
+ * @param src value of the source vertex.
+ * @param dst value of the destination vertex.
+ * @return Update outcome of the insertion.
+ */
+CustomGraph::DynamicChordalGraph::Update CustomGraph::DynamicChordalGraph::addEdge(unsigned int src, unsigned int dst) {
+    unsigned int u = indexOf(src), v = indexOf(dst);
+    if(u == size() || v == size() || u == v || adjacency[u].count(v) != 0)
+        return Update::Unchanged;
+
+    unsigned int ru = region[u], rv = region[v];
+    if(ru != rv) {
+        bool chordal = regions[ru].chordal && regions[rv].chordal;
+        bool valid = regions[ru].valid && regions[rv].valid;
+        bool u_first = valid && !hasHigherNeighbor(u);
+        bool v_first = valid && !u_first && !hasHigherNeighbor(v);
+
+        adjacency[u].insert(v);
+        adjacency[v].insert(u);
+        numEdges++;
+        if(v_first)
+            merge(rv, ru, true);
+        else
+            merge(ru, rv, u_first);
+        if(!chordal)
+            return Update::NotChordal;
+        return u_first || v_first ? Update::Perfect : Update::Chordal;
+    }
+
+    if(!regions[ru].chordal) {
+        adjacency[u].insert(v);
+        adjacency[v].insert(u);
+        numEdges++;
+        return recheck(ru, u, v);
+    }
+
+    if(regions[ru].valid) {
+        unsigned int lower = position[u] < position[v] ? u : v, higher = lower == u ? v : u;
+        bool perfect = true;
+        for(auto w : adjacency[lower]) {
+            workDone++;
+            if(position[w] > position[lower] && adjacency[higher].count(w) == 0) {
+                perfect = false;
+                break;
+            }
+        }
+        if(perfect) {
+            adjacency[u].insert(v);
+            adjacency[v].insert(u);
+            numEdges++;
+            return Update::Perfect;
+        }
+    }
+
+    bool chordal = separated(u, v);
+    vector<unsigned int> cycle;
+    if(!chordal) {
+        // {u,v} closes a chordless cycle with the shortest path that avoids the common neighbours
+        generation++;
+        for(auto w : adjacency[u])
+            if(adjacency[v].count(w) != 0)
+                mark[w] = 3 * generation + 2;
+        inducedPath(u, v, cycle);
+    }
+    adjacency[u].insert(v);
+    adjacency[v].insert(u);
+    numEdges++;
+    regions[ru].valid = false;
+    if(chordal)
+        return Update::Chordal;
+    regions[ru].chordal = false;
+    nonChordal++;
+    setWitness(ru, move(cycle));
+    return Update::NotChordal;
+}
+
+/**
+ * @brief Delete an edge and update the chordality and the ordering of its region.
+ * The common neighbours of the endpoints are collected from the endpoint with the smaller degree: the ordering stays
+ * perfect if none of them is eliminated before both the endpoints, otherwise the region is still chordal iff they form
+ * a clique.
+ * @param src value of the source vertex.
+ * @param dst value of the destination vertex.
+ * @return Update outcome of the deletion.
+ */
+CustomGraph::DynamicChordalGraph::Update CustomGraph::DynamicChordalGraph::deleteEdge(unsigned int src, unsigned int dst) {
+    unsigned int u = indexOf(src), v = indexOf(dst);
+    if(u == size() || v == size() || adjacency[u].count(v) == 0)
+        return Update::Unchanged;
+
+    unsigned int r = region[u];
+    adjacency[u].erase(v);
+    adjacency[v].erase(u);
+    numEdges--;
+    if(!regions[r].chordal)
+        return recheck(r, u, v);
+
+    unsigned int small = adjacency[u].size() <= adjacency[v].size() ? u : v, big = small == u ? v : u;
+    int64_t before = min(position[u], position[v]);
+    bool perfect = regions[r].valid;
+    vector<unsigned int> common;
+    for(auto w : adjacency[small]) {
+        workDone++;
+        if(adjacency[big].count(w) != 0) {
+            common.push_back(w);
+            if(position[w] < before)
+                perfect = false;
+        }
+    }
+    if(perfect)
+        return Update::Perfect;
+
+    regions[r].valid = false;
+    for(unsigned int i = 0; i < common.size(); ++i)
+        for(unsigned int j = i + 1; j < common.size(); ++j) {
+            workDone++;
+            if(adjacency[common[i]].count(common[j]) == 0) {
+                regions[r].chordal = false;
+                nonChordal++;
+                setWitness(r, {u, common[i], v, common[j]});
+                return Update::NotChordal;
+            }
+        }
+    return Update::Chordal;
+}
+
+/**
+ * @brief Check if the whole graph is chordal, it is known after every update without any search.
+ * @return true if every region is chordal.
+ * @return false if some region is not chordal.
+ */
+bool CustomGraph::DynamicChordalGraph::isChordal() {
+    return nonChordal == 0;
+}
+
+/**
+ * @brief Get the elimination ordering of the graph, the regions changed since the last call are reordered first.
+ * The regions are independent, so their orderings are concatenated.
+ * @return vector<unsigned int> values of the vertices in elimination order, a perfect ordering when the graph is
+ * chordal, otherwise the regions that are not chordal have a minimal ordering.
+ */
+vector<unsigned int> CustomGraph::DynamicChordalGraph::ordering() {
+    Tracer::Span span("DynamicChordalGraph::ordering", "ordering");
+    uint64_t work = workDone;
+    for(unsigned int r = 0; r < regions.size(); ++r)
+        if(regions[r].alive && !regions[r].valid)
+            refresh(r, true);
+    workDone = work;
+
+    vector<unsigned int> alphaInverse;
+    alphaInverse.reserve(size());
+    for(auto &reg : regions) {
+        if(!reg.alive)
+            continue;
+        size_t first = alphaInverse.size();
+        alphaInverse.insert(alphaInverse.end(), reg.members.begin(), reg.members.end());
+        sort(alphaInverse.begin() + first, alphaInverse.end(), [this](unsigned int a, unsigned int b) {
+            return position[a] < position[b];
+        });
+    }
+    if(!ids.empty())
+        for(auto &v : alphaInverse)
+            v = ids[v];
+    return alphaInverse;
+}
+
+/**
+ * @brief Copy the graph in a CSRGraph.
+ * @return CSRGraph graph with the same vertices and edges.
+ */
+CustomGraph::CSRGraph CustomGraph::DynamicChordalGraph::toCSR() {
+    vector<uint64_t> offsets(size() + 1, 0);
+    vector<unsigned int> adj;
+    adj.reserve(2 * (size_t) numEdges);
+    for(unsigned int v = 0; v < size(); ++v) {
+        size_t first = adj.size();
+        adj.insert(adj.end(), adjacency[v].begin(), adjacency[v].end());
+        sort(adj.begin() + first, adj.end());
+        offsets[v + 1] = adj.size();
+    }
+    vector<unsigned int> values = ids;
+    return CSRGraph(move(offsets), move(adj), move(values));
+}
+
+/**
+ * @brief Get the work done by the updates so far: adjacent vertices scanned by the checks and by the searches, pairs
+ * tested for the cliques and vertices and edges of the regions checked again. ordering() is not counted.
+ * @return uint64_t units of work done by the updates.
+ */
+uint64_t CustomGraph::DynamicChordalGraph::work() {
+    return workDone;
+}
+
+/**
+ * @brief Get the dense index of a vertex.
+ * @param vertex value of the vertex.
+ * @return unsigned int dense index of the vertex, size() if it is not contained.
+ */
+unsigned int CustomGraph::DynamicChordalGraph::indexOf(unsigned int vertex) {
+    if(ids.empty())
+        return vertex < size() ? vertex : size();
+
+    auto it = lower_bound(ids.begin(), ids.end(), vertex);
+    if(it == ids.end() || *it != vertex)
+        return size();
+    return it - ids.begin();
+}
+
+/**
+ * @brief Check if a vertex has an adjacent vertex eliminated after it.
+ * @param v index of the vertex.
+ * @return true if some adjacent vertex has a higher position.
+ */
+bool CustomGraph::DynamicChordalGraph::hasHigherNeighbor(unsigned int v) {
+    for(auto w : adjacency[v]) {
+        workDone++;
+        if(position[w] > position[v])
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Check if u and v are disconnected once their common neighbours are removed. The searches from u and from v
+ * advance one vertex each in turn and stop when they meet or when one of them runs out of vertices, so the work is
+ * bounded by the side of the smaller component.
+ * @param u index of the first vertex.
+ * @param v index of the second vertex.
+ * @return true if every path from u to v passes through a common neighbour.
+ */
+bool CustomGraph::DynamicChordalGraph::separated(unsigned int u, unsigned int v) {
+    generation++;
+    uint64_t base = 3 * generation;
+
+    // the common neighbours are marked as removed
+    unsigned int small = adjacency[u].size() <= adjacency[v].size() ? u : v, big = small == u ? v : u;
+    for(auto w : adjacency[small]) {
+        workDone++;
+        if(adjacency[big].count(w) != 0)
+            mark[w] = base + 2;
+    }
+
+    mark[u] = base;
+    mark[v] = base + 1;
+    queues[0].assign(1, u);
+    queues[1].assign(1, v);
+    size_t head[2] = {0, 0};
+    while(true) {
+        for(unsigned int side = 0; side < 2; ++side) {
+            if(head[side] == queues[side].size())
+                return true;
+
+            unsigned int x = queues[side][head[side]++];
+            for(auto y : adjacency[x]) {
+                workDone++;
+                if(mark[y] < base) {
+                    mark[y] = base + side;
+                    queues[side].push_back(y);
+                } else if(mark[y] == base + 1 - side)
+                    return false;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Find the shortest path between two vertices that avoids the vertices excluded by the caller, which are
+ * marked with 3 * generation + 2. The path is induced, so it closes a chordless cycle with vertices adjacent only to
+ * its ends.
+ * @param from index of the first vertex.
+ * @param to index of the last vertex.
+ * @param path it receives the indices of the path, from to to from.
+ * @return true if the vertices are connected without the excluded vertices.
+ */
+bool CustomGraph::DynamicChordalGraph::inducedPath(unsigned int from, unsigned int to, vector<unsigned int> &path) {
+    uint64_t base = 3 * generation;
+    unordered_map<unsigned int, unsigned int> parent;
+    mark[from] = base;
+    queues[0].assign(1, from);
+    for(size_t head = 0; head < queues[0].size(); ++head) {
+        unsigned int x = queues[0][head];
+        for(auto y : adjacency[x]) {
+            workDone++;
+            if(mark[y] >= base)
+                continue;
+            mark[y] = base;
+            parent[y] = x;
+            if(y == to) {
+                path.clear();
+                for(unsigned int z = to; z != from; z = parent[z])
+                    path.push_back(z);
+                path.push_back(from);
+                return true;
+            }
+            queues[0].push_back(y);
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Find a chordless cycle in a component whose positions are the ordering of lex_p and are not perfect: a vertex
+ * x whose follower f is not adjacent to another vertex w after x closes the cycle x, f, ..., w with an induced path
+ * from f to w that avoids x and its other neighbours.
+ * @param component indices of the vertices of the component.
+ * @return vector<unsigned int> vertices of the cycle, empty if none has been found.
+ */
+vector<unsigned int> CustomGraph::DynamicChordalGraph::findWitness(const vector<unsigned int> &component) {
+    for(auto x : component) {
+        unsigned int f = size();
+        for(auto w : adjacency[x])
+            if(position[w] > position[x] && (f == size() || position[w] < position[f]))
+                f = w;
+        if(f == size())
+            continue;
+
+        for(auto w : adjacency[x]) {
+            if(w == f || position[w] < position[x] || adjacency[f].count(w) != 0)
+                continue;
+            generation++;
+            uint64_t base = 3 * generation;
+            mark[x] = base + 2;
+            for(auto y : adjacency[x])
+                if(y != f && y != w)
+                    mark[y] = base + 2;
+            vector<unsigned int> cycle;
+            if(!inducedPath(f, w, cycle))
+                return {};
+            cycle.push_back(x);
+            return cycle;
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Replace the witness of a region.
+ * @param r region of the witness.
+ * @param cycle vertices of a chordless cycle of the region, empty to remove the witness.
+ */
+void CustomGraph::DynamicChordalGraph::setWitness(unsigned int r, vector<unsigned int> &&cycle) {
+    for(auto m : regions[r].witness)
+        onWitness[m] = false;
+    regions[r].witness = move(cycle);
+    for(auto m : regions[r].witness)
+        onWitness[m] = true;
+}
+
+/**
+ * @brief Merge two regions, the members of the smaller one move to the larger one.
+ * @param a first region, eliminated before b when ordered is true.
+ * @param b second region.
+ * @param ordered if true the positions of the smaller region are shifted so that a precedes b and the merged ordering
+ * stays valid.
+ */
+void CustomGraph::DynamicChordalGraph::merge(unsigned int a, unsigned int b, bool ordered) {
+    bool a_smaller = regions[a].members.size() <= regions[b].members.size();
+    unsigned int keep = a_smaller ? b : a, gone = a_smaller ? a : b;
+    Region &kept = regions[keep], &moved = regions[gone];
+
+    if(ordered) {
+        int64_t shift = a_smaller ? regions[b].first - 1 - regions[a].last : regions[a].last + 1 - regions[b].first;
+        for(auto m : moved.members)
+            position[m] += shift;
+        moved.first += shift;
+        moved.last += shift;
+    }
+
+    for(auto m : moved.members) {
+        region[m] = keep;
+        kept.members.push_back(m);
+    }
+    workDone += moved.members.size();
+    kept.first = min(kept.first, moved.first);
+    kept.last = max(kept.last, moved.last);
+    kept.valid = ordered;
+
+    nonChordal -= !kept.chordal + !moved.chordal;
+    kept.chordal = kept.chordal && moved.chordal;
+    nonChordal += !kept.chordal;
+    // the new edge joins two regions, so a chordless cycle of either one is still chordless
+    if(!moved.chordal && kept.witness.empty())
+        swap(kept.witness, moved.witness);
+    setWitness(gone, {});
+    moved.members.clear();
+    moved.chordal = true;
+    freeRegion(gone);
+}
+
+/**
+ * @brief Split a region in its connected components and compute their orderings with lex_p, the ones that are not
+ * chordal get the ordering of lex_m when withOrdering is true. Every component is copied in a CSRGraph whose values are
+ * the indices of the vertices, the ordering of lex_p is perfect iff the component is chordal.
+ * @param r region to be recomputed.
+ * @param withOrdering if false the regions that are not chordal are left without ordering.
+ */
+void CustomGraph::DynamicChordalGraph::refresh(unsigned int r, bool withOrdering) {
+    Tracer::Span span("DynamicChordalGraph::refresh", "ordering");
+    vector<unsigned int> members = move(regions[r].members);
+    setWitness(r, {});
+    if(!regions[r].chordal)
+        nonChordal--;
+    regions[r].members.clear();
+    regions[r].chordal = true;
+    freeRegion(r);
+
+    generation++;
+    uint64_t base = 3 * generation;
+    for(auto root : members) {
+        if(mark[root] >= base)
+            continue;
+
+        // connected component of root
+        vector<unsigned int> component(1, root);
+        mark[root] = base;
+        uint64_t edges = 0;
+        for(size_t head = 0; head < component.size(); ++head)
+            for(auto w : adjacency[component[head]]) {
+                edges++;
+                if(mark[w] < base) {
+                    mark[w] = base;
+                    component.push_back(w);
+                }
+            }
+        workDone += component.size() + edges;
+        sort(component.begin(), component.end());
+
+        vector<uint64_t> offsets(component.size() + 1, 0);
+        vector<unsigned int> adj;
+        adj.reserve(edges);
+        for(unsigned int i = 0; i < component.size(); ++i) {
+            for(auto w : adjacency[component[i]])
+                adj.push_back(lower_bound(component.begin(), component.end(), w) - component.begin());
+            sort(adj.begin() + offsets[i], adj.end());
+            offsets[i + 1] = adj.size();
+        }
+        vector<unsigned int> values = component;
+        CSRGraph csr(move(offsets), move(adj), move(values));
+
+        vector<unsigned int> order = csr.lex_p();
+        bool chordal = OrderingEngines::isPerfectOrdering(csr, order);
+        for(unsigned int i = 0; i < order.size(); ++i)
+            position[order[i]] = i;
+        vector<unsigned int> cycle;
+        if(!chordal) {
+            cycle = findWitness(component);
+            if(withOrdering) {
+                order = csr.lex_m();
+                for(unsigned int i = 0; i < order.size(); ++i)
+                    position[order[i]] = i;
+            }
+        }
+
+        unsigned int c = newRegion();
+        for(auto m : component)
+            region[m] = c;
+        regions[c].members = move(component);
+        regions[c].chordal = chordal;
+        regions[c].valid = chordal || withOrdering;
+        regions[c].first = 0;
+        regions[c].last = (int64_t) order.size() - 1;
+        if(!chordal) {
+            nonChordal++;
+            setWitness(c, move(cycle));
+        }
+    }
+}
+
+/**
+ * @brief Check again a region that is not chordal after an update of {u,v}. If u and v are not both on the witness of
+ * the region the cycle is still chordless and nothing is searched: a deleted edge is not one of its edges and an added
+ * edge is not one of its chords.
+ * @param r region of the update.
+ * @param u one endpoint of the update.
+ * @param v the other endpoint of the update.
+ * @return Update Perfect if the region of u has become chordal, NotChordal otherwise.
+ */
+CustomGraph::DynamicChordalGraph::Update CustomGraph::DynamicChordalGraph::recheck(unsigned int r, unsigned int u, unsigned int v) {
+    if(!regions[r].witness.empty() && !(onWitness[u] && onWitness[v])) {
+        regions[r].valid = false;
+        return Update::NotChordal;
+    }
+    refresh(r, false);
+    return regions[region[u]].chordal ? Update::Perfect : Update::NotChordal;
+}
+
+/**
+ * @brief Get a free region.
+ * @return unsigned int index of the region.
+ */
+unsigned int CustomGraph::DynamicChordalGraph::newRegion() {
+    if(!freeRegions.empty()) {
+        unsigned int r = freeRegions.back();
+        freeRegions.pop_back();
+        regions[r].alive = true;
+        return r;
+    }
+    regions.push_back({{}, true, true, true, 0, 0});
+    return regions.size() - 1;
+}
+
+/**
+ * @brief Release a region, its members must have been moved.
+ * @param r region to be released.
+ */
+void CustomGraph::DynamicChordalGraph::freeRegion(unsigned int r) {
+    regions[r].alive = false;
+    regions[r].valid = true;
+    regions[r].members.shrink_to_fit();
+    freeRegions.push_back(r);
+}
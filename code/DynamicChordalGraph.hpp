@@ -0,0 +1,270 @@
+#ifndef DYNAMIC_CHORDAL_GRAPH_H_
+#define DYNAMIC_CHORDAL_GRAPH_H_
+
+#include "CSRGraph.hpp"
+
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Graph that keeps a perfect elimination ordering up to date while edges are added and deleted, so lex_p does not
+ * have to run again after every batch. The vertices are fixed at construction, with dense indices as in CSRGraph.
+ * The vertices are grouped in regions, each one made of whole connected components, with its own ordering, kept as
+ * positions that grow towards the vertices eliminated last. An update first checks if the ordering of its region is
+ * still perfect, looking only at the endpoints and at their neighbours:
+ * - adding {u,v}, with u eliminated before v, keeps it perfect iff v is adjacent to the vertices after u adjacent to u;
+ * - deleting {u,v} keeps it perfect iff no common neighbour of u and v is eliminated before both.
+ * Otherwise the chordality of the new graph is decided with the dynamic characterizations of chordal graphs:
+ * - a chordal graph plus {u,v} is chordal iff u and v are disconnected once their common neighbours are removed, which is
+ *   checked by two searches from u and v that stop as soon as the smaller side is exhausted;
+ * - a chordal graph minus {u,v} is chordal iff the common neighbours of u and v form a clique.
+ * An edge between two regions merges them and never breaks chordality. When the ordering is no longer perfect the region
+ * is reordered by ordering(), and only the regions changed since the last call are recomputed. A region that is not
+ * chordal keeps a chordless cycle as witness: an update without both its endpoints on the cycle leaves it chordless,
+ * so the region stays not chordal without any search, and only an update that breaks the witness checks the region
+ * again in linear time. ordering() gives the regions that are not chordal the minimal ordering of lex_m.
+ */
+struct DynamicChordalGraph {
+public:
+    /**
+     * @brief Outcome of an update.
+     * - Unchanged: the edge was already there (or missing), it is an auto-ring or an endpoint is not in the graph.
+     * - Perfect: the region is chordal and its ordering is still perfect.
+     * - Chordal: the region is chordal, its ordering will be recomputed by ordering().
+     * - NotChordal: the update left the region not chordal.
+     */
+    enum class Update { Unchanged, Perfect, Chordal, NotChordal };
+
+    /**
+     * @brief Construct a new DynamicChordalGraph object with vertices 0, 1, ..., num_vertices-1 and no edges.
+     * @param num_vertices number of vertices.
+     */
+    DynamicChordalGraph(unsigned int num_vertices);
+
+    /**
+     * @brief Construct a new DynamicChordalGraph object with the vertices and the edges of a CSRGraph, the orderings of its
+     * components are computed once here.
+     * @param csr graph to be copied.
+     */
+    DynamicChordalGraph(CSRGraph &csr);
+
+    /**
+     * @brief Get the number of vertices.
+     * @return unsigned int number of vertices.
+     */
+    unsigned int size();
+
+    /**
+     * @brief Get the number of edges.
+     * @return unsigned int number of edges.
+     */
+    unsigned int edgeSize();
+
+    /**
+     * @brief Check if two vertices are adjacent.
+     * @param first value of the first vertex.
+     * @param second value of the second vertex.
+     * @return true if the edge {first, second} is in the graph.
+     * @return false if the edge is not in the graph.
+     */
+    bool isAdjacent(unsigned int first, unsigned int second);
+
+    /**
+     * @brief Add an edge and update the chordality and the ordering of its region.
+     * @param src value of the source vertex.
+     * @param dst value of the destination vertex.
+     * @return Update outcome of the insertion.
+     */
+    Update addEdge(unsigned int src, unsigned int dst);
+
+    /**
+     * @brief Delete an edge and update the chordality and the ordering of its region.
+     * @param src value of the source vertex.
+     * @param dst value of the destination vertex.
+     * @return Update outcome of the deletion.
+     */
+    Update deleteEdge(unsigned int src, unsigned int dst);
+
+    /**
+     * @brief Check if the whole graph is chordal, it is known after every update without any search.
+     * @return true if every region is chordal.
+     * @return false if some region is not chordal.
+     */
+    bool isChordal();
+
+    /**
+     * @brief Get the elimination ordering of the graph, the regions changed since the last call are reordered first.
+     * @return vector<unsigned int> values of the vertices in elimination order, a perfect ordering when the graph is
+     * chordal, otherwise the regions that are not chordal have a minimal ordering.
+     */
+    vector<unsigned int> ordering();
+
+    /**
+     * @brief Copy the graph in a CSRGraph.
+     * @return CSRGraph graph with the same vertices and edges.
+     */
+    CSRGraph toCSR();
+
+    /**
+     * @brief Get the work done by the updates so far: adjacent vertices scanned by the checks and by the searches, pairs
+     * tested for the cliques and vertices and edges of the regions checked again. ordering() is not counted.
+     * @return uint64_t units of work done by the updates.
+     */
+    uint64_t work();
+
+private:
+    /**
+     * @brief Group of connected components with an ordering. valid is true when the positions of the members are the
+     * ordering returned by ordering(), first and last are the lowest and the highest position. A region that is not
+     * chordal has the vertices of a chordless cycle in witness, or no witness if none has been found yet.
+     */
+    struct Region {
+        vector<unsigned int> members;
+        bool chordal;
+        bool valid;
+        bool alive;
+        int64_t first;
+        int64_t last;
+        vector<unsigned int> witness;
+    };
+
+    /**
+     * @brief Get the dense index of a vertex.
+     * @param vertex value of the vertex.
+     * @return unsigned int dense index of the vertex, size() if it is not contained.
+     */
+    unsigned int indexOf(unsigned int vertex);
+
+    /**
+     * @brief Check if a vertex has an adjacent vertex eliminated after it.
+     * @param v index of the vertex.
+     * @return true if some adjacent vertex has a higher position.
+     */
+    bool hasHigherNeighbor(unsigned int v);
+
+    /**
+     * @brief Check if u and v are disconnected once their common neighbours are removed. The searches from u and from v
+     * advance one vertex each in turn and stop when they meet or when one of them runs out of vertices.
+     * @param u index of the first vertex.
+     * @param v index of the second vertex.
+     * @return true if every path from u to v passes through a common neighbour.
+     */
+    bool separated(unsigned int u, unsigned int v);
+
+    /**
+     * @brief Find the shortest path between two vertices that avoids the vertices excluded by the caller, which are
+     * marked with 3 * generation + 2. The path is induced, so it closes a chordless cycle with vertices adjacent only to
+     * its ends.
+     * @param from index of the first vertex.
+     * @param to index of the last vertex.
+     * @param path it receives the indices of the path, from to to from.
+     * @return true if the vertices are connected without the excluded vertices.
+     */
+    bool inducedPath(unsigned int from, unsigned int to, vector<unsigned int> &path);
+
+    /**
+     * @brief Find a chordless cycle in a component whose positions are the ordering of lex_p and are not perfect: a vertex
+     * x whose follower f is not adjacent to another vertex w after x closes the cycle x, f, ..., w with an induced path
+     * from f to w that avoids x and its other neighbours.
+     * @param component indices of the vertices of the component.
+     * @return vector<unsigned int> vertices of the cycle, empty if none has been found.
+     */
+    vector<unsigned int> findWitness(const vector<unsigned int> &component);
+
+    /**
+     * @brief Replace the witness of a region.
+     * @param r region of the witness.
+     * @param cycle vertices of a chordless cycle of the region, empty to remove the witness.
+     */
+    void setWitness(unsigned int r, vector<unsigned int> &&cycle);
+
+    /**
+     * @brief Merge two regions, the members of the smaller one move to the larger one.
+     * @param a first region, eliminated before b when ordered is true.
+     * @param b second region.
+     * @param ordered if true the positions of the smaller region are shifted so that a precedes b and the merged ordering
+     * stays valid.
+     */
+    void merge(unsigned int a, unsigned int b, bool ordered);
+
+    /**
+     * @brief Split a region in its connected components and compute their orderings with lex_p, the ones that are not
+     * chordal get the ordering of lex_m when withOrdering is true.
+     * @param r region to be recomputed.
+     * @param withOrdering if false the regions that are not chordal are left without ordering.
+     */
+    void refresh(unsigned int r, bool withOrdering);
+
+    /**
+     * @brief Check again a region that is not chordal after an update of {u,v}. If u and v are not both on the witness of
+     * the region the cycle is still chordless and nothing is searched.
+     * @param r region of the update.
+     * @param u one endpoint of the update.
+     * @param v the other endpoint of the update.
+     * @return Update Perfect if the region of u has become chordal, NotChordal otherwise.
+     */
+    Update recheck(unsigned int r, unsigned int u, unsigned int v);
+
+    /**
+     * @brief Get a free region.
+     * @return unsigned int index of the region.
+     */
+    unsigned int newRegion();
+
+    /**
+     * @brief Release a region, its members must have been moved.
+     * @param r region to be released.
+     */
+    void freeRegion(unsigned int r);
+
+    /**
+     * @brief Adjacent vertices of each vertex.
+     */
+    vector<unordered_set<unsigned int>> adjacency;
+
+    /**
+     * @brief Value of each vertex, empty when the values are the indices.
+     */
+    vector<unsigned int> ids;
+
+    /**
+     * @brief Region and position of each vertex.
+     */
+    vector<unsigned int> region;
+    vector<int64_t> position;
+
+    /**
+     * @brief Regions, the ones not alive are in freeRegions.
+     */
+    vector<Region> regions;
+    vector<unsigned int> freeRegions;
+
+    /**
+     * @brief Number of edges, of regions that are not chordal and units of work done by the updates.
+     */
+    unsigned int numEdges;
+    unsigned int nonChordal;
+    uint64_t workDone;
+
+    /**
+     * @brief Marks of the searches: a vertex is visited by the current search when its mark is at least 3 * generation,
+     * the mark tells the side of the search (or that it is a common neighbour).
+     */
+    vector<uint64_t> mark;
+    uint64_t generation;
+    vector<unsigned int> queues[2];
+
+    /**
+     * @brief True for the vertices on the witness of their region.
+     */
+    vector<bool> onWitness;
+};
+
+}
+
+#endif
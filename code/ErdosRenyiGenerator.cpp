@@ -0,0 +1,307 @@
+#include "ErdosRenyiGenerator.hpp"
+#include "GraphBuilder.hpp"
+#include "RandomStream.hpp"
+#include "Parallel.hpp"
+#include "Tracer.hpp"
+
+#include <cmath>
+#include <numeric>
+
+/**
+ * @brief Number of vertices that choose their parent in the tree in each parallel task.
+ */
+static const unsigned int TREE_BLOCK = 1 << 16;
+
+/**
+ * @brief Approximate number of pairs scanned by each parallel sampling task.
+ */
+static const uint64_t PAIR_RANGE = 1 << 22;
+
+/**
+ * @brief First stream of each phase, the phases never share a stream.
+ */
+static const uint64_t TREE_STREAM = 1;
+static const uint64_t SAMPLE_STREAM = (uint64_t) 1 << 32;
+static const uint64_t ADJUST_STREAM = (uint64_t) 1 << 33;
+
+typedef vector<pair<unsigned int, unsigned int>> EdgeList;
+
+/**
+ * @brief Get the index of the first pair {u, v} with u < v in the lexicographic order of the pairs.
+ * @param n number of vertices.
+ * @param u smaller vertex of the pair.
+ * @return uint64_t index of the pair {u, u+1}.
+ */
+static uint64_t rowStart(uint64_t n, uint64_t u) {
+    return (uint64_t) (((unsigned __int128) u * (2 * n - u - 1)) / 2);
+}
+
+/**
+ * @brief Remove random elements from a sorted list, the remaining ones stay sorted.
+ * @param edges list of edges.
+ * @param count number of elements to be removed.
+ * @param random random stream.
+ */
+static void dropRandom(EdgeList &edges, size_t count, CustomGraph::RandomStream &random) {
+    size_t size = edges.size();
+    // rejection is efficient when less than half of the elements are marked, otherwise the kept ones are marked
+    bool markKept = count > size / 2;
+    size_t marks = markKept ? size - count : count;
+
+    vector<char> marked(size, 0);
+    for(size_t chosen = 0; chosen < marks; ) {
+        size_t i = random.below(size);
+        if(!marked[i]) {
+            marked[i] = 1;
+            chosen++;
+        }
+    }
+
+    size_t last = 0;
+    for(size_t i = 0; i < size; ++i)
+        if((bool) marked[i] == markKept)
+            edges[last++] = edges[i];
+    edges.resize(last);
+}
+
+/**
+ * @brief Get the pairs of distinct vertices that are in none of two sorted lists, walking all the pairs in order.
+ * @param n number of vertices.
+ * @param first sorted list of edges.
+ * @param second sorted list of edges without the edges of first.
+ * @return EdgeList missing pairs normalized and sorted.
+ */
+static EdgeList complementPairs(unsigned int n, const EdgeList &first, const EdgeList &second) {
+    EdgeList pairs;
+    uint64_t all = (uint64_t) n * (n == 0 ? 0 : n - 1) / 2;
+    pairs.reserve(all - first.size() - second.size());
+    auto a = first.begin(), b = second.begin();
+    for(unsigned int u = 0; u < n; ++u)
+        for(unsigned int v = u + 1; v < n; ++v) {
+            pair<unsigned int, unsigned int> edge(u, v);
+            if(a != first.end() && *a == edge)
+                ++a;
+            else if(b != second.end() && *b == edge)
+                ++b;
+            else
+                pairs.push_back(edge);
+        }
+    return pairs;
+}
+
+/**
+ * @brief Get the number of pairs of distinct vertices.
+ * @param num_vertices number of vertices.
+ * @return uint64_t n(n-1)/2, the maximum number of edges.
+ */
+uint64_t CustomGraph::ErdosRenyiGenerator::maxEdges(unsigned int num_vertices) {
+    return (uint64_t) num_vertices * (num_vertices == 0 ? 0 : num_vertices - 1) / 2;
+}
+
+/**
+ * @brief Generate the edges of a connected random graph over the vertices 0, ..., n-1.
+ * @param num_vertices number of vertices.
+ * @param num_edges number of edges, between n-1 and n(n-1)/2.
+ * @param seed seed of the random streams.
+ * @param edges edges of the graph, normalized as {min, max} and sorted.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ * @return true if the edges have been generated.
+ * @return false if the number of edges is out of range.
+ */
+bool CustomGraph::ErdosRenyiGenerator::generateEdges(unsigned int num_vertices, uint64_t num_edges, uint64_t seed,
+                                                     vector<pair<unsigned int, unsigned int>> &edges, unsigned int num_threads) {
+    Tracer::Span span("ErdosRenyiGenerator::generateEdges", "build");
+    edges.clear();
+    uint64_t tree_edges = num_vertices == 0 ? 0 : num_vertices - 1;
+    if(num_edges < tree_edges || num_edges > maxEdges(num_vertices))
+        return false;
+
+    EdgeList tree = spanningTree(num_vertices, seed, num_threads);
+    uint64_t missing = num_edges - tree_edges;
+    if(missing == 0) {
+        edges.swap(tree);
+        return true;
+    }
+
+    double probability = (double) missing / (double) (maxEdges(num_vertices) - tree_edges);
+    EdgeList extra = samplePairs(num_vertices, probability, tree, seed, num_threads);
+    adjust(num_vertices, missing, tree, extra, seed, num_threads);
+
+    edges.resize(num_edges);
+    merge(tree.begin(), tree.end(), extra.begin(), extra.end(), edges.begin());
+    return true;
+}
+
+/**
+ * @brief Generate a connected random graph over the vertices 0, ..., n-1 directly in compressed sparse row format.
+ * @param num_vertices number of vertices.
+ * @param num_edges number of edges, between n-1 and n(n-1)/2.
+ * @param seed seed of the random streams.
+ * @param csr graph that receives the vertices and the edges.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ * @return true if the graph has been generated.
+ * @return false if the number of edges is out of range.
+ */
+bool CustomGraph::ErdosRenyiGenerator::generate(unsigned int num_vertices, uint64_t num_edges, uint64_t seed, CSRGraph &csr, unsigned int num_threads) {
+    EdgeList edges;
+    if(!generateEdges(num_vertices, num_edges, seed, edges, num_threads))
+        return false;
+
+    vector<uint64_t> offsets;
+    vector<unsigned int> adjacency;
+    GraphBuilder::fillRows(num_vertices, edges, offsets, adjacency);
+    csr = CSRGraph(move(offsets), move(adjacency), vector<unsigned int>());
+    return true;
+}
+
+/**
+ * @brief Generate a random recursive tree over a random permutation of the vertices.
+ * @param num_vertices number of vertices.
+ * @param seed seed of the random streams.
+ * @param num_threads number of threads to be used.
+ * @return vector<pair<unsigned int, unsigned int>> n-1 edges normalized and sorted.
+ */
+vector<pair<unsigned int, unsigned int>> CustomGraph::ErdosRenyiGenerator::spanningTree(unsigned int num_vertices, uint64_t seed, unsigned int num_threads) {
+    if(num_vertices < 2)
+        return EdgeList();
+
+    vector<unsigned int> permutation(num_vertices);
+    iota(permutation.begin(), permutation.end(), 0);
+    RandomStream shuffler(seed, 0);
+    for(unsigned int i = num_vertices - 1; i > 0; --i)
+        swap(permutation[i], permutation[shuffler.below(i + 1)]);
+
+    // the i-th vertex of the permutation is attached to one of the previous ones
+    EdgeList tree(num_vertices - 1);
+    unsigned int blocks = (num_vertices + TREE_BLOCK - 1) / TREE_BLOCK;
+    Parallel::forEach(blocks, [&](unsigned int b) {
+        RandomStream random(seed, TREE_STREAM + b);
+        unsigned int last = min(num_vertices, (b + 1) * TREE_BLOCK);
+        for(unsigned int i = max(1u, b * TREE_BLOCK); i < last; ++i) {
+            unsigned int u = permutation[i], v = permutation[random.below(i)];
+            tree[i-1] = u < v ? make_pair(u, v) : make_pair(v, u);
+        }
+    }, num_threads);
+
+    Parallel::sort(tree, num_threads);
+    return tree;
+}
+
+/**
+ * @brief Draw with skip sampling each pair not in the tree with probability p.
+ * @param num_vertices number of vertices.
+ * @param probability probability p of each pair.
+ * @param tree sorted edges of the spanning tree.
+ * @param seed seed of the random streams.
+ * @param num_threads number of threads to be used.
+ * @return vector<pair<unsigned int, unsigned int>> sampled edges normalized and sorted.
+ */
+vector<pair<unsigned int, unsigned int>> CustomGraph::ErdosRenyiGenerator::samplePairs(unsigned int num_vertices, double probability,
+                                                                                      const vector<pair<unsigned int, unsigned int>> &tree,
+                                                                                      uint64_t seed, unsigned int num_threads) {
+    uint64_t pairs = maxEdges(num_vertices);
+    unsigned int ranges = (unsigned int) min<uint64_t>(4096, max<uint64_t>(1, pairs / PAIR_RANGE));
+    double log_skip = probability < 1.0 ? log1p(-probability) : 0.0;
+
+    vector<EdgeList> sampled(ranges);
+    Parallel::forEach(ranges, [&](unsigned int r) {
+        RandomStream random(seed, SAMPLE_STREAM + r);
+        uint64_t first = (uint64_t) (((unsigned __int128) pairs * r) / ranges);
+        uint64_t last = (uint64_t) (((unsigned __int128) pairs * (r + 1)) / ranges);
+        EdgeList &out = sampled[r];
+        out.reserve((size_t) ((last - first) * probability * 1.05) + 16);
+
+        // row u of the current pair, found by binary search on the first pair of the range
+        uint64_t low = 0, high = num_vertices - 1;
+        while(low < high) {
+            uint64_t middle = (low + high + 1) / 2;
+            if(rowStart(num_vertices, middle) <= first)
+                low = middle;
+            else
+                high = middle - 1;
+        }
+        uint64_t u = low, next_row = rowStart(num_vertices, u + 1);
+
+        for(uint64_t position = first; position < last; ++position) {
+            if(probability < 1.0) {
+                double gap = floor(log1p(-random.uniform()) / log_skip);
+                if(gap >= (double) (last - position))
+                    break;
+                position += (uint64_t) gap;
+            }
+            while(position >= next_row) {
+                u++;
+                next_row = rowStart(num_vertices, u + 1);
+            }
+
+            pair<unsigned int, unsigned int> edge((unsigned int) u, (unsigned int) (u + 1 + position - rowStart(num_vertices, u)));
+            if(!binary_search(tree.begin(), tree.end(), edge))
+                out.push_back(edge);
+        }
+    }, num_threads);
+
+    // the ranges are consecutive, so their concatenation is sorted
+    size_t total = 0;
+    for(auto &range : sampled)
+        total += range.size();
+    EdgeList extra;
+    extra.reserve(total);
+    for(auto &range : sampled) {
+        extra.insert(extra.end(), range.begin(), range.end());
+        EdgeList().swap(range);
+    }
+    return extra;
+}
+
+/**
+ * @brief Bring the number of sampled edges to the requested one, dropping random edges or adding random pairs. The pairs
+ * are drawn with rejection while most of them are free, then the missing edges are chosen among the free pairs.
+ * @param num_vertices number of vertices.
+ * @param target number of edges requested.
+ * @param tree sorted edges of the spanning tree.
+ * @param extra sorted edges that are not in the tree, they are corrected in place.
+ * @param seed seed of the random streams.
+ * @param num_threads number of threads to be used.
+ */
+void CustomGraph::ErdosRenyiGenerator::adjust(unsigned int num_vertices, uint64_t target, const vector<pair<unsigned int, unsigned int>> &tree,
+                                              vector<pair<unsigned int, unsigned int>> &extra, uint64_t seed, unsigned int num_threads) {
+    RandomStream random(seed, ADJUST_STREAM);
+
+    if(extra.size() > target) {
+        dropRandom(extra, extra.size() - target, random);
+        return;
+    }
+
+    while(extra.size() < target) {
+        size_t missing = target - extra.size();
+        // when at least half of the pairs are taken a random pair is rejected more often than not, near a complete graph
+        // the rounds would be many: the missing edges are chosen among the free pairs instead
+        if(2 * (tree.size() + extra.size()) >= maxEdges(num_vertices)) {
+            EdgeList candidates = complementPairs(num_vertices, tree, extra);
+            dropRandom(candidates, candidates.size() - missing, random);
+            size_t middle = extra.size();
+            extra.insert(extra.end(), candidates.begin(), candidates.end());
+            inplace_merge(extra.begin(), extra.begin() + middle, extra.end());
+            return;
+        }
+
+        EdgeList candidates(missing + missing / 4 + 16);
+        for(auto &edge : candidates) {
+            unsigned int u = random.below(num_vertices), v = random.below(num_vertices - 1);
+            if(v >= u)
+                v++;
+            edge = u < v ? make_pair(u, v) : make_pair(v, u);
+        }
+
+        GraphBuilder::normalizeEdges(candidates, num_threads);
+        candidates.erase(remove_if(candidates.begin(), candidates.end(), [&](const pair<unsigned int, unsigned int> &edge) {
+            return binary_search(tree.begin(), tree.end(), edge) || binary_search(extra.begin(), extra.end(), edge);
+        }), candidates.end());
+        if(candidates.size() > missing)
+            dropRandom(candidates, candidates.size() - missing, random);
+
+        size_t middle = extra.size();
+        extra.insert(extra.end(), candidates.begin(), candidates.end());
+        inplace_merge(extra.begin(), extra.begin() + middle, extra.end());
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef ERDOS_RENYI_GENERATOR_H_
+#define ERDOS_RENYI_GENERATOR_H_
+
+#include "CSRGraph.hpp"
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Auxiliary structure that generates connected random graphs with n vertices and exactly m edges, a G(n, m) graph
+ * conditioned to contain a random spanning tree. The tree is a random recursive tree over a random permutation of the
+ * vertices, so the graph is connected by construction. The other edges are drawn with skip sampling: the n(n-1)/2 pairs are
+ * split in fixed ranges, each range walks over its pairs jumping ahead by geometric gaps, so the cost is proportional to
+ * the number of edges and not to the number of pairs. The small excess or deficit of the sampling is corrected by
+ * dropping random edges or adding random pairs, with rejection on sparse graphs and chosen among the free pairs when at
+ * least half of the pairs are taken.
+ * Each range has its own random stream, so the graph depends only on (n, m, seed), whatever the number of threads.
+ */
+struct ErdosRenyiGenerator {
+public:
+    /**
+     * @brief Get the number of pairs of distinct vertices.
+     * @param num_vertices number of vertices.
+     * @return uint64_t n(n-1)/2, the maximum number of edges.
+     */
+    static uint64_t maxEdges(unsigned int num_vertices);
+
+    /**
+     * @brief Generate the edges of a connected random graph over the vertices 0, ..., n-1.
+     * @param num_vertices number of vertices.
+     * @param num_edges number of edges, between n-1 and n(n-1)/2.
+     * @param seed seed of the random streams.
+     * @param edges edges of the graph, normalized as {min, max} and sorted.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     * @return true if the edges have been generated.
+     * @return false if the number of edges is out of range.
+     */
+    static bool generateEdges(unsigned int num_vertices, uint64_t num_edges, uint64_t seed,
+                              vector<pair<unsigned int, unsigned int>> &edges, unsigned int num_threads = 0);
+
+    /**
+     * @brief Generate a connected random graph over the vertices 0, ..., n-1 directly in compressed sparse row format.
+     * @param num_vertices number of vertices.
+     * @param num_edges number of edges, between n-1 and n(n-1)/2.
+     * @param seed seed of the random streams.
+     * @param csr graph that receives the vertices and the edges.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     * @return true if the graph has been generated.
+     * @return false if the number of edges is out of range.
+     */
+    static bool generate(unsigned int num_vertices, uint64_t num_edges, uint64_t seed, CSRGraph &csr, unsigned int num_threads = 0);
+
+private:
+    /**
+     * @brief Generate a random recursive tree over a random permutation of the vertices.
+     * @param num_vertices number of vertices.
+     * @param seed seed of the random streams.
+     * @param num_threads number of threads to be used.
+     * @return vector<pair<unsigned int, unsigned int>> n-1 edges normalized and sorted.
+     */
+    static vector<pair<unsigned int, unsigned int>> spanningTree(unsigned int num_vertices, uint64_t seed, unsigned int num_threads);
+
+    /**
+     * @brief Draw with skip sampling each pair not in the tree with probability p.
+     * @param num_vertices number of vertices.
+     * @param probability probability p of each pair.
+     * @param tree sorted edges of the spanning tree.
+     * @param seed seed of the random streams.
+     * @param num_threads number of threads to be used.
+     * @return vector<pair<unsigned int, unsigned int>> sampled edges normalized and sorted.
+     */
+    static vector<pair<unsigned int, unsigned int>> samplePairs(unsigned int num_vertices, double probability,
+                                                                const vector<pair<unsigned int, unsigned int>> &tree,
+                                                                uint64_t seed, unsigned int num_threads);
+
+    /**
+     * @brief Bring the number of sampled edges to the requested one, dropping random edges or adding random pairs. The pairs
+     * are drawn with rejection while most of them are free, then the missing edges are chosen among the free pairs.
+     * @param num_vertices number of vertices.
+     * @param target number of edges requested.
+     * @param tree sorted edges of the spanning tree.
+     * @param extra sorted edges that are not in the tree, they are corrected in place.
+     * @param seed seed of the random streams.
+     * @param num_threads number of threads to be used.
+     */
+    static void adjust(unsigned int num_vertices, uint64_t target, const vector<pair<unsigned int, unsigned int>> &tree,
+                       vector<pair<unsigned int, unsigned int>> &extra, uint64_t seed, unsigned int num_threads);
+};
+
+}
+
+#endif
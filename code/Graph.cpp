@@ -1,29 +1,49 @@
  #include "Graph.hpp"
+#include "GraphBuilder.hpp"
+#include "CSRGraph.hpp"
+#include "OrderingEngines.hpp"
+#include "ErdosRenyiGenerator.hpp"
+#include "RandomStream.hpp"
+#include "PerfCounters.hpp"
+#include "Tracer.hpp"
+
+#include <cmath>
+#include <queue>
+#include <climits>
 
 /**
  * @brief Construct a new empty Graph object.
  */
-CustomGraph::Graph::Graph() : numEdges(0) {}
+CustomGraph::Graph::Graph() : numEdges(0), storage(Storage::Sparse) {}
+
+/**
+ * @brief Construct a new empty Graph object that stores its edges with the specified backend.
+ * @param storage backend used to store the edges.
+ */
+CustomGraph::Graph::Graph(Storage storage) : numEdges(0), storage(storage) {}
 
 /**
  * @brief Construct a new Graph object with verticies specified.
  * @param vertices vector of verticies that will compose the graph.
+ * @param storage backend used to store the edges.
  */
-CustomGraph::Graph::Graph(const vector<unsigned int> &vertices) : numEdges(0) {
+CustomGraph::Graph::Graph(const vector<unsigned int> &vertices, Storage storage) : numEdges(0), storage(storage) {
     for(auto vertex : vertices) 
         addVertex(vertex);
 }
 
 /**
- * @brief Construct a new Graph object with verticies and edges specified.
+ * @brief Construct a new Graph object with verticies and edges specified. The graph is built in bulk by GraphBuilder, duplicated edges
+ * and auto-rings are ignored.
  * @param vertices vector of verticies that will compose the graph.
  * @param sources vector of souces of the edges
  * @param destinations vector of destinations of the edges.
+ * @param storage backend used to store the edges.
  */
-CustomGraph::Graph::Graph(const vector<unsigned int>  &vertices, const vector<unsigned int> &sources, const vector<unsigned int> &destinations) : Graph(vertices) {
-    if(sources.size() == destinations.size())
-        for(unsigned int i = 0; i < sources.size(); ++i)
-            addEdge(sources[i], destinations[i]);            
+CustomGraph::Graph::Graph(const vector<unsigned int>  &vertices, const vector<unsigned int> &sources, const vector<unsigned int> &destinations, Storage storage) : numEdges(0), storage(storage) {
+    if(!GraphBuilder::build(vertices, sources, destinations, *this))
+        for(auto vertex : vertices)
+            addVertex(vertex);
 }
 
 /**
@@ -40,8 +60,15 @@ void CustomGraph::Graph::addVertex(unsigned int vertex) {
  * @param vertex object that represents the vertex.
  */
 void CustomGraph::Graph::addVertex(const Vertex &vertex) {
-    if(!isInside(vertex))
-        vertices[vertex.value] = vertex;
+    if(!isInside(vertex)) {
+        if(storage == Storage::Dense) {
+            // the adjacency of the dense backend lives in the matrix
+            vertices[vertex.value] = Vertex(vertex.value);
+            denseSlot(vertex.value);
+        } else
+            vertices[vertex.value] = vertex;
+        record(Change::Kind::AddVertex, vertex.value);
+    }
 }
 
 /**
@@ -50,11 +77,23 @@ void CustomGraph::Graph::addVertex(const Vertex &vertex) {
  * @param second destination vertex of the edge.
  */
 void CustomGraph::Graph::addEdge(unsigned int src, unsigned int dst) {
+    if(storage == Storage::Dense) {
+        auto it_src = denseIndex.find(src), it_dst = denseIndex.find(dst);
+        if(it_src != denseIndex.end() && it_dst != denseIndex.end() && src != dst)
+            if(!matrix.test(it_src->second, it_dst->second)) {
+                matrix.set(it_src->second, it_dst->second);
+                matrix.set(it_dst->second, it_src->second);
+                numEdges++;
+                record(Change::Kind::AddEdge, src, dst);
+            }
+        return;
+    }
+
     if(isInside(src) && isInside(dst) && src != dst)
-        if(!vertices[src].isAdjacent(dst) && !vertices[dst].isAdjacent(src)) {
-            vertices[src].addAdjacentVertex(dst);
+        if(vertices[src].getAdjVertices().insert(dst).second) {
             vertices[dst].addAdjacentVertex(src);
             numEdges++;
+            record(Change::Kind::AddEdge, src, dst);
         }
 }
 
@@ -67,6 +106,46 @@ void CustomGraph::Graph::addEdge(const Vertex &first, const Vertex &second) {
     addEdge(first.value, second.value);
 }
 
+/**
+ * @brief Add many edges to the graph at once. The adjacency sets are enlarged once for all according to the degrees,
+ * then each edge is inserted with a single hash lookup per endpoint instead of the checks done by addEdge.
+ * Edges that are already in the graph, auto-rings and edges with endpoints not in the graph are ignored.
+ * @param edges edges to be added.
+ */
+void CustomGraph::Graph::addEdgesBulk(const vector<pair<unsigned int, unsigned int>> &edges) {
+    Tracer::Span span("Graph::addEdgesBulk", "build");
+    if(storage == Storage::Dense) {
+        for(auto &edge : edges)
+            addEdge(edge.first, edge.second);
+        return;
+    }
+
+    unordered_map<unsigned int, unsigned int> degrees;
+    for(auto &edge : edges)
+        if(edge.first != edge.second) {
+            degrees[edge.first]++;
+            degrees[edge.second]++;
+        }
+
+    for(auto &degree : degrees) {
+        auto it = vertices.find(degree.first);
+        if(it != vertices.end())
+            it->second.getAdjVertices().reserve(it->second.getAdjVertices().size() + degree.second);
+    }
+
+    for(auto &edge : edges) {
+        auto it_src = vertices.find(edge.first), it_dst = vertices.find(edge.second);
+        if(it_src == vertices.end() || it_dst == vertices.end() || edge.first == edge.second)
+            continue;
+
+        if(it_src->second.getAdjVertices().insert(edge.second).second) {
+            it_dst->second.getAdjVertices().insert(edge.first);
+            numEdges++;
+            record(Change::Kind::AddEdge, edge.first, edge.second);
+        }
+    }
+}
+
 /**
  * @brief Get the number of verticies in the graph.
  * @return unsigned int number of verticies.
@@ -88,6 +167,25 @@ unsigned int CustomGraph::Graph::edgeSize() {
  * @param v vertex to be removed.
  */
 void CustomGraph::Graph::deleteVertex(unsigned int v) {
+    if(!undoMarks.empty() && isInside(v)) {
+        record(Change::Kind::DeleteVertex, v);
+        forEachAdjacent(v, [&](unsigned int w) { undoLog.back().neighbors.push_back(w); });
+    }
+
+    if(storage == Storage::Dense) {
+        auto it = denseIndex.find(v);
+        if(it != denseIndex.end()) {
+            unsigned int slot = it->second;
+            numEdges -= matrix.countRow(slot);
+            matrix.clearRow(slot);
+            matrix.clearColumn(slot);
+            freeSlots.push_back(slot);
+            denseIndex.erase(it);
+        }
+        vertices.erase(v);
+        return;
+    }
+
     for(auto &w : vertices)
         if(w.second.isAdjacent(v)) {
             w.second.getAdjVertices().erase(v);
@@ -96,8 +194,86 @@ void CustomGraph::Graph::deleteVertex(unsigned int v) {
     vertices.erase(v);
 }
 
+/**
+ * @brief Start recording the changes of the graph in an undo log: every vertex added, edge added (by addEdge,
+ * addEdgesBulk, fill_in and lex_m) and vertex deleted, with its edges. The checkpoints can be nested, each rollback
+ * or commit closes the last one. clear and the bulk builders discard the log and all the checkpoints.
+ */
+void CustomGraph::Graph::checkpoint() {
+    undoMarks.push_back(undoLog.size());
+}
+
+/**
+ * @brief Revert the changes recorded since the last checkpoint, in reverse order, and close it. The cost is
+ * proportional to the number of changes, e.g. to the fill of an ordering, instead of a copy of the graph.
+ * @return true if the changes have been reverted.
+ * @return false if there is no checkpoint.
+ */
+bool CustomGraph::Graph::rollback() {
+    if(undoMarks.empty())
+        return false;
+
+    size_t mark = undoMarks.back();
+    undoMarks.pop_back();
+    while(undoLog.size() > mark) {
+        revert(undoLog.back());
+        undoLog.pop_back();
+    }
+    return true;
+}
+
+/**
+ * @brief Keep the changes recorded since the last checkpoint and close it, they are still reverted by the rollback
+ * of an outer checkpoint.
+ * @return true if the checkpoint has been closed.
+ * @return false if there is no checkpoint.
+ */
+bool CustomGraph::Graph::commit() {
+    if(undoMarks.empty())
+        return false;
+
+    undoMarks.pop_back();
+    if(undoMarks.empty())
+        undoLog.clear();
+    return true;
+}
+
+/**
+ * @brief Get the number of open checkpoints.
+ * @return unsigned int number of checkpoints not yet rolled back or committed, 0 when the changes are not recorded.
+ */
+unsigned int CustomGraph::Graph::checkpoints() {
+    return undoMarks.size();
+}
+
+/**
+ * @brief Check if two vertices of the graph are adjacent, it works with both the storage backends.
+ * @param first value of the first vertex.
+ * @param second value of the second vertex.
+ * @return true if the edge {first, second} is in the graph.
+ * @return false if the edge is not in the graph.
+ */
+bool CustomGraph::Graph::isAdjacent(unsigned int first, unsigned int second) {
+    if(storage == Storage::Dense) {
+        auto it_first = denseIndex.find(first), it_second = denseIndex.find(second);
+        return it_first != denseIndex.end() && it_second != denseIndex.end() && matrix.test(it_first->second, it_second->second);
+    }
+
+    auto it = vertices.find(first);
+    return it != vertices.end() && it->second.isAdjacent(second);
+}
+
+/**
+ * @brief Get the backend used to store the edges of the graph.
+ * @return Storage backend of the graph.
+ */
+CustomGraph::Storage CustomGraph::Graph::getStorage() {
+    return storage;
+}
+
 /**
  * @brief Get the Vertices object that bind values of the vertices to the corresponding object.
+ * With the dense backend the vertex objects do not contain the adjacent vertices, use isAdjacent and forEachAdjacent.
  * @return unordered_map<unsigned int, Vertex>& data structure that stores the vertices. 
  */
 unordered_map<unsigned int, Vertex>& CustomGraph::Graph::getVertices() {
@@ -141,20 +317,25 @@ bool CustomGraph::Graph::isInside(const Vertex &vertex) {
  * @return false if it is not connected.
  */
 bool CustomGraph::Graph::isConnected() {
-    vector<pair<Vertex, bool>> visited_vertices(vertices.size());
+    Tracer::Span span("Graph::isConnected", "connectivity");
+    if(vertices.size() == 0)
+        return true;
 
-    int i = 0;
-    for(auto it = vertices.begin(); it != vertices.end(); ++it, ++i) {
-        pair<Vertex, bool> temp_pair((*it).second, false);
-        visited_vertices[i] = temp_pair;
-    }
+    // iterative depth first search from an arbitrary vertex
+    unordered_set<unsigned int> visited_vertices;
+    vector<unsigned int> stack(1, vertices.begin()->first);
+    visited_vertices.insert(stack.back());
 
-    DFS(0, visited_vertices);
+    while(!stack.empty()) {
+        unsigned int v = stack.back();
+        stack.pop_back();
 
-    for(unsigned int i = 0; i < visited_vertices.size(); ++i) 
-        if(!visited_vertices[i].second)
-            return false;    
-    return true;
+        forEachAdjacent(v, [&](unsigned int w) {
+            if(visited_vertices.insert(w).second)
+                stack.push_back(w);
+        });
+    }
+    return visited_vertices.size() == vertices.size();
 }
 
 /**
@@ -172,6 +353,12 @@ void CustomGraph::Graph::connect() {
 void CustomGraph::Graph::clear() {
     vertices.clear();
     numEdges = 0;
+    matrix.clear();
+    denseIndex.clear();
+    denseValue.clear();
+    freeSlots.clear();
+    undoLog.clear();
+    undoMarks.clear();
 }
 
 /**
@@ -179,27 +366,208 @@ void CustomGraph::Graph::clear() {
  */
 void CustomGraph::Graph::printGraph() {
     cout << "Graph adjacency list: " << endl;
-    for(auto &vertex : vertices) 
-        vertex.second.printAdjacentVertices();
+    for(auto &vertex : vertices) {
+        if(storage == Storage::Dense) {
+            cout << "Vertex: " << vertex.first << endl;
+            forEachAdjacent(vertex.first, [](unsigned int w) {
+                cout << " -> " << w;
+            });
+            cout << endl;
+        } else
+            vertex.second.printAdjacentVertices();
+    }
 }
 
 /**
- * @brief Auxiliary function that is used to perform a depth first search in the graph to check if it is connected. It is called
- * in the connect function and it is part of its logic.
- * @param v vertex to be searched.
- * @param visited_vertices vertices visited and not of the graph.
+ * @brief Fill-in is a function that starting from a graph creates an elimination graph, the algorithm is described in fill_in_impl.
+ * @param bijFunction object used to define a bijection function that associates each vertex to a natural number. It is used
+ * to assign an ordering to the graph.
  */
-void CustomGraph::Graph::DFS(unsigned int v, vector<pair<Vertex, bool>> &visited_vertices) {
-    visited_vertices[v].second = true;
+void CustomGraph::Graph::fill_in(BijectionFunction &bijFunction) {
+    fill_in_impl<false>(bijFunction, nullptr, nullptr);
+}
 
-    Vertex &vertex = visited_vertices[v].first;
-    for(auto it = vertex.getAdjVertices().begin(); it != vertex.getAdjVertices().end(); ++it) {
-        
-        for(unsigned int i = 0; i < visited_vertices.size(); ++i)
-            if(visited_vertices[i].first.value == (*it))
-                if(visited_vertices[i].second == false)
-                    DFS(i, visited_vertices);
+/**
+ * @brief Same as fill_in, the work done is counted in stats.
+ * @param bijFunction object used to define a bijection function that associates each vertex to a natural number.
+ * @param stats it accumulates the adjacent vertices scanned and the fill edges added.
+ */
+void CustomGraph::Graph::fill_in(BijectionFunction &bijFunction, OrderingStats &stats) {
+    fill_in_impl<true>(bijFunction, &stats, nullptr);
+}
+
+/**
+ * @brief Same as fill_in, but the run is bounded by control, which is checked before the elimination of each vertex
+ * with the fill added so far and once more at the end with the whole fill. When the run is stopped the vertices
+ * alpha(0), ..., alpha(control.steps()-1) have been eliminated and their fill stays in the graph, a checkpoint taken
+ * before the call allows to discard it.
+ * @param bijFunction object used to define a bijection function that associates each vertex to a natural number.
+ * @param control limits of the run, it receives the outcome.
+ * @return true if all the vertices have been eliminated within the limits.
+ * @return false if the run has been stopped or its fill went beyond the budget, control.status() tells why.
+ */
+bool CustomGraph::Graph::fill_in(BijectionFunction &bijFunction, RunControl &control) {
+    return fill_in_impl<false>(bijFunction, nullptr, &control);
+}
+
+/**
+ * @brief Add edges to a graph already filled by fill_in with the same ordering and add only the fill they cause.
+ * The changed vertices wait in a min-heap of alpha-1: a vertex only adds edges between vertices that follow it, so
+ * when it is extracted no later change can reach it and it is processed once.
+ * @param bijFunction ordering used by the previous fill_in.
+ * @param edges edges to be added, the ones already there, the auto-rings and the ones with endpoints not in the graph
+ * are ignored.
+ * @return vector<pair<unsigned int, unsigned int>> fill edges added, without the input edges.
+ */
+vector<pair<unsigned int, unsigned int>> CustomGraph::Graph::fill_in_incremental(BijectionFunction &bijFunction,
+                                                                                  const vector<pair<unsigned int, unsigned int>> &edges) {
+    Tracer::Span span("Graph::fill_in_incremental", "fill");
+    priority_queue<pair<unsigned int, unsigned int>, vector<pair<unsigned int, unsigned int>>, greater<pair<unsigned int, unsigned int>>> changed;
+    unordered_set<unsigned int> queued;
+    auto enqueue = [&](unsigned int v) {
+        if(queued.insert(v).second)
+            changed.push(make_pair(bijFunction.alphaInverse(v), v));
+    };
+
+    for(auto &edge : edges) {
+        unsigned int before = numEdges;
+        addEdge(edge.first, edge.second);
+        if(numEdges != before)
+            enqueue(bijFunction.alphaInverse(edge.first) < bijFunction.alphaInverse(edge.second) ? edge.first : edge.second);
+    }
+
+    vector<pair<unsigned int, unsigned int>> fill;
+    vector<unsigned int> higher;
+    while(!changed.empty()) {
+        unsigned int order = changed.top().first, v = changed.top().second;
+        changed.pop();
+
+        // higher neighbours of v and its parent m(v)
+        higher.clear();
+        unsigned int m = v, m_order = UINT_MAX;
+        forEachAdjacent(v, [&](unsigned int w) {
+            unsigned int w_order = bijFunction.alphaInverse(w);
+            if(w_order > order) {
+                higher.push_back(w);
+                if(w_order < m_order) {
+                    m = w;
+                    m_order = w_order;
+                }
+            }
+        });
+
+        PerfCounters::Scope phase(PerfCounters::FillInsertion);
+        for(auto w : higher)
+            if(w != m && !isAdjacent(m, w)) {
+                addEdge(m, w);
+                fill.push_back(make_pair(m, w));
+                enqueue(m);
+            }
     }
+    return fill;
+}
+
+/**
+ * @brief Lex_p is a function that tries to find a perfect ordering inside a graph, the algorithm is described in lex_p_impl.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+ */
+vector<unsigned int> CustomGraph::Graph::lex_p() {
+    return lex_p_impl<false>(nullptr);
+}
+
+/**
+ * @brief Same as lex_p, the work done is counted in stats.
+ * @param stats it accumulates the cells created and destroyed and the refinements of the partition.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+ */
+vector<unsigned int> CustomGraph::Graph::lex_p(OrderingStats &stats) {
+    return lex_p_impl<true>(&stats);
+}
+
+/**
+ * @brief Lex_m is a function that finds a minimal ordering inside a graph, the algorithm is described in lex_m_impl.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+ */
+vector<unsigned int> CustomGraph::Graph::lex_m() {
+    return lex_m_impl<false>(nullptr, nullptr);
+}
+
+/**
+ * @brief Same as lex_m, the work done is counted in stats.
+ * @param stats it accumulates the pushes in the reach queues, the renumbered labels and the calls of addEdge.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+ */
+vector<unsigned int> CustomGraph::Graph::lex_m(OrderingStats &stats) {
+    return lex_m_impl<true>(&stats, nullptr);
+}
+
+/**
+ * @brief Same as lex_m, but the run is bounded by control, which is checked before the numbering of each vertex with
+ * the fill added so far and once more at the end with the whole fill. When the run is stopped the last control.steps()
+ * positions hold the vertices numbered by lex_m, and the others get the lower positions in the order of their current
+ * labels, the order in which lex_m would try them next: the result is always an ordering of all the vertices, only the
+ * fill of the numbered vertices is added.
+ * @param control limits of the run, it receives the outcome.
+ * @return vector<unsigned int> structure that contains the ordered vertices, minimal when control.status() is Completed.
+ */
+vector<unsigned int> CustomGraph::Graph::lex_m(RunControl &control) {
+    return lex_m_impl<false>(nullptr, &control);
+}
+
+/**
+ * @brief Same as lex_m, but the graph is not modified, so several threads can order the same graph at once. The
+ * temporary state lives in the workspace of the caller and the fill edges of the minimal triangulation are returned
+ * in fill instead of being added to the graph: the graph plus the fill is the graph left by the other lex_m.
+ * @param workspace temporary state of the search, it can be reused by the following calls of the same thread.
+ * @param fill it receives the fill edges, its previous content is discarded.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+ */
+vector<unsigned int> CustomGraph::Graph::lex_m(LexMWorkspace &workspace, vector<pair<unsigned int, unsigned int>> &fill) const {
+    fill.clear();
+    if(storage == Storage::Dense)
+        return lex_m_dense<false>(workspace, nullptr, nullptr, [&](unsigned int v, const vector<unsigned int> &step_fill) {
+            for(auto z : step_fill)
+                fill.push_back(make_pair(denseValue[v], denseValue[z]));
+        });
+    return lex_m_search<false>(workspace, nullptr, nullptr, [&](unsigned int v, const vector<unsigned int> &step_fill) {
+        for(auto z : step_fill)
+            fill.push_back(make_pair(v, z));
+    });
+}
+
+/**
+ * @brief Front door of the orderings: it returns a minimal ordering with the fastest engine for this graph, which is
+ * not modified. The graph is copied in a CSRGraph, whose profile gives vertices, edges, density, degrees and components
+ * in one pass. A graph is chordal if and only if the ordering of lex_p is perfect, and both lex_p and the check are
+ * linear, so the chordal graphs never pay for lex_m. The other graphs are ordered by lex_m on a dense copy when the
+ * density is at least DENSE_ORDER_DENSITY and the bit matrix is small enough, and by the CSR engine otherwise; the
+ * sparse backend of Graph is never chosen because the CSR engine is faster at every density.
+ * @param choice if not null, it receives the statistics and the engine chosen.
+ * @return vector<unsigned int> structure that contains the ordered vertices, perfect when the graph is chordal.
+ */
+vector<unsigned int> CustomGraph::Graph::order(OrderingChoice *choice) {
+    Tracer::Span span("Graph::order", "ordering");
+    OrderingChoice local;
+    OrderingChoice &decision = choice != nullptr ? *choice : local;
+
+    CSRGraph csr(*this);
+    decision.profile = OrderingEngines::profile(csr);
+    decision.method = OrderingChoice::Method::LexP;
+    decision.storage = Storage::Sparse;
+
+    vector<unsigned int> ordering = csr.lex_p();
+    decision.chordal = OrderingEngines::isPerfectOrdering(csr, ordering);
+    if(decision.chordal)
+        return ordering;
+
+    decision.method = OrderingChoice::Method::LexM;
+    if(decision.profile.density >= DENSE_ORDER_DENSITY && decision.profile.n <= DENSE_ORDER_MAX_VERTICES) {
+        decision.storage = Storage::Dense;
+        Graph dense(Storage::Dense);
+        csr.toGraph(dense);
+        return dense.lex_m();
+    }
+    return csr.lex_m();
 }
 
 /**
@@ -213,24 +581,49 @@ void CustomGraph::Graph::DFS(unsigned int v, vector<pair<Vertex, bool>> &visited
  *   vertices of m(v) 
  * @param bijFunction object used to define a bijection function that associates each vertex to a natural number. It is used
  * to assign an ordering to the graph.
+ * @param stats counters of the work done (adjacent vertices scanned, fill edges added), used only when CollectStats is true.
+ * @param control limits of the run, null when it is not bounded.
+ * @return true if all the vertices have been eliminated.
  */
-void CustomGraph::Graph::fill_in(BijectionFunction &bijFunction) {
+template<bool CollectStats>
+bool CustomGraph::Graph::fill_in_impl(BijectionFunction &bijFunction, OrderingStats *stats, RunControl *control) {
+    Tracer::Span span("Graph::fill_in", "fill");
+    if(control != nullptr)
+        control->start();
+    if(storage == Storage::Dense)
+        return fill_in_dense<CollectStats>(bijFunction, stats, control);
+
     unsigned int n = vertices.size();
+    unsigned int edges = numEdges;
 
     for(unsigned int i = 0; i < n-1; ++i) {
+        if(control != nullptr && !control->proceed(numEdges - edges))
+            return false;
+
         unsigned int k = n-1;
         unsigned int v = bijFunction.alpha(i);
 
         for(auto w : vertices[v].getAdjVertices()) 
-            if(bijFunction.alphaInverse(v) < bijFunction.alphaInverse(w))
-                k = min(k, bijFunction.alphaInverse(w));         
+            if(bijFunction.alphaInverse(v) < bijFunction.alphaInverse(w)) {
+                k = min(k, bijFunction.alphaInverse(w));
+                if constexpr(CollectStats)
+                    stats->neighbor_scans++;
+            }
                 
         unsigned int m = k;
 
+        PerfCounters::Scope phase(PerfCounters::FillInsertion);
         for(auto w : vertices[v].getAdjVertices()) 
-            if(bijFunction.alphaInverse(w) > m)
-                addEdge(bijFunction.alpha(m), w);
+            if(bijFunction.alphaInverse(w) > m) {
+                if constexpr(CollectStats) {
+                    unsigned int before = numEdges;
+                    addEdge(bijFunction.alpha(m), w);
+                    stats->fill_edges += numEdges - before;
+                } else
+                    addEdge(bijFunction.alpha(m), w);
+            }
     }
+    return control == nullptr || control->finish(numEdges - edges);
 }
 
 /**
@@ -250,9 +643,12 @@ void CustomGraph::Graph::fill_in(BijectionFunction &bijFunction) {
  * -      Delete the cell of w from its set
  * -      Move w in the set with the successive order, checking if it already existent
  * -      Update the position of w
+ * @param stats counters of the work done (cells created and destroyed, refinements), used only when CollectStats is true.
  * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
  */
-vector<unsigned int> CustomGraph::Graph::lex_p() {
+template<bool CollectStats>
+vector<unsigned int> CustomGraph::Graph::lex_p_impl(OrderingStats *stats) {
+    Tracer::Span span("Graph::lex_p", "ordering");
     vector<unsigned int> alphaInverse(vertices.size());
     unordered_set<unsigned int> ordered_vertices;
     vector<unsigned int> v_k = getVerticesKeys();
@@ -260,7 +656,9 @@ vector<unsigned int> CustomGraph::Graph::lex_p() {
     Sets sets(v_t);
 
     for(int i = vertices.size()-1; i >= 0; --i) {
-        sets.clearEmptyCells();
+        unsigned int deleted = sets.clearEmptyCells();
+        if constexpr(CollectStats)
+            stats->cells_destroyed += deleted;
         
         // pick next vertex to number
         unsigned int v = sets.get();
@@ -272,11 +670,11 @@ vector<unsigned int> CustomGraph::Graph::lex_p() {
         alphaInverse[i] = v;
         ordered_vertices.insert(v);
 
+        PerfCounters::Scope phase(PerfCounters::PartitionRefinement);
         unordered_set<Cell*> fixlist;
 
         // for each w adjacent to v
-        for(auto it_w = vertices[v].getAdjVertices().begin(); it_w != vertices[v].getAdjVertices().end(); ++it_w) {
-            unsigned int w = *it_w;
+        forEachAdjacent(v, [&](unsigned int w) {
             // that has not been selected yet
             if(ordered_vertices.find(w) == ordered_vertices.end()) {
                 //delete cell of w from set
@@ -287,17 +685,47 @@ vector<unsigned int> CustomGraph::Graph::lex_p() {
                 // if h is an old set then create a new set
                 if(h == fixlist.end()) {
                     sets.addSet(prev_cell, w);
+                    if constexpr(CollectStats)
+                        stats->cells_created++;
                 } else {
                     sets.addCell(prev_cell->next, w);
                 }
                 fixlist.insert(prev_cell);
+                if constexpr(CollectStats)
+                    stats->refinements++;
             }
-        }
+        });
         fixlist.clear();
     }
     return alphaInverse;
 }
 
+/**
+ * @brief Implementation of the overloads of lex_m that add the fill to the graph, with both the backends. The counters
+ * of stats are updated only when CollectStats is true, otherwise the counting is compiled out.
+ * @param stats counters of the work done, used only when CollectStats is true.
+ * @param control limits of the run, null when it is not bounded.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+ */
+template<bool CollectStats>
+vector<unsigned int> CustomGraph::Graph::lex_m_impl(OrderingStats *stats, RunControl *control) {
+    LexMWorkspace workspace;
+    if(storage == Storage::Dense)
+        return lex_m_dense<CollectStats>(workspace, stats, control, [this](unsigned int v, const vector<unsigned int> &fill) {
+            for(auto z : fill)
+                if(!matrix.test(v, z)) {
+                    matrix.set(v, z);
+                    matrix.set(z, v);
+                    numEdges++;
+                    record(Change::Kind::AddEdge, denseValue[v], denseValue[z]);
+                }
+        });
+    return lex_m_search<CollectStats>(workspace, stats, control, [this](unsigned int v, const vector<unsigned int> &fill) {
+        for(auto z : fill)
+            addEdge(v, z);
+    });
+}
+
 /**
  * @brief Lex_m is a function that finds a minimal ordering inside a graph.
  * Alpha is a minimal ordering if adding some edges I can eliminate the graph.
@@ -319,19 +747,42 @@ vector<unsigned int> CustomGraph::Graph::lex_p() {
  * -            Else
  * -                Add z to the reached vertices at level j
  * -    Sort unnumbered vertices by label value and redefine k appropriately               
+ * The graph is not modified: the fill vertices found by each step are passed to insert(v, fill) at the end of the step,
+ * v is numbered so the fill cannot change the next searches.
+ * @param workspace temporary state of the search.
+ * @param stats counters of the work done (pushes in the reach queues, renumbered labels, calls of addEdge), used only when
+ * CollectStats is true.
+ * @param control limits of the run, null when it is not bounded. When it stops the run the unnumbered vertices take the
+ * positions left in the order of their labels.
+ * @param insert function called with the value of the numbered vertex and the values of its fill vertices.
  * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
  */
-vector<unsigned int> CustomGraph::Graph::lex_m() {
+template<bool CollectStats, typename F>
+vector<unsigned int> CustomGraph::Graph::lex_m_search(LexMWorkspace &workspace, OrderingStats *stats, RunControl *control, F insert) const {
+    Tracer::Span span("Graph::lex_m", "ordering");
     vector<unsigned int> alphaInverse(vertices.size());
-    vector<pair<unsigned int, float>> vertices_and_label(vertices.size());
+    vector<pair<unsigned int, float>> &vertices_and_label = workspace.vertices_and_label;
+    unordered_map<unsigned int, list<unsigned int>> &reach = workspace.reach;
+    unordered_set<unsigned int> &reached = workspace.reached;
+    vector<unsigned int> &fill = workspace.fill;
+    vertices_and_label.resize(vertices.size());
 
     int i = 0;
     for(auto v = vertices.begin(); v != vertices.end(); ++v, ++i) 
         vertices_and_label[i] = make_pair(v->first, 1);
 
     unsigned int k = 1;
+    uint64_t found = 0;
+    if(control != nullptr)
+        control->start();
 
     for(int i = vertices.size(); i > 0; --i) {
+        if(control != nullptr && !control->proceed(found)) {
+            for(unsigned int j = 0; j < vertices_and_label.size(); ++j)
+                alphaInverse[i-1-j] = vertices_and_label[j].first;
+            break;
+        }
+
         //pick an unnumbered vertex v with label(v) = k
         unsigned int v = vertices_and_label[0].first;
 
@@ -341,16 +792,20 @@ vector<unsigned int> CustomGraph::Graph::lex_m() {
         // assign v the number i
         alphaInverse[i-1] = v;
 
-        unordered_map<unsigned int, list<unsigned int>> reach;
-        unordered_set<unsigned int> reached;
+        PerfCounters::Scope phase(PerfCounters::ReachSearch);
+
+        // fill edges {v,z} found by the search, they are inserted after it: v is numbered, so they cannot change the search
+        fill.clear();
+        reached.clear();
         reached.insert(alphaInverse.begin(), alphaInverse.end());
 
-        // Initialize the lists for each level j up to k
+        // Initialize the lists for each level j up to k, the lists left by the previous step are empty
         for(unsigned int j = 1; j <= k; ++j)
-            reach[j] = list<unsigned int>();
+            reach[j].clear();
 
         //mark all unnumbered vertices unreached
-        for(auto it_w = vertices[v].getAdjVertices().begin(); it_w != vertices[v].getAdjVertices().end(); ++it_w) {
+        const unordered_set<unsigned int> &adj_v = vertices.at(v).getAdjVertices();
+        for(auto it_w = adj_v.begin(); it_w != adj_v.end(); ++it_w) {
             unsigned int w = *it_w;
 
             auto it = find_if(vertices_and_label.begin(), vertices_and_label.end(), [w](pair<unsigned int, float> &p) {
@@ -360,8 +815,9 @@ vector<unsigned int> CustomGraph::Graph::lex_m() {
             if(it != vertices_and_label.end()) {
                 reach[it->second].push_back(w);
                 reached.insert(w);  
+                if constexpr(CollectStats)
+                    stats->reachPush((unsigned int) it->second);
                 it->second +=  0.5;
-                addEdge(v,w);
             }
         }
 
@@ -371,7 +827,8 @@ vector<unsigned int> CustomGraph::Graph::lex_m() {
                 unsigned int w = reach[j].front();
                 reach[j].pop_front();
 
-                for(auto it_z = vertices[w].getAdjVertices().begin(); it_z != vertices[w].getAdjVertices().end(); ++it_z) {
+                const unordered_set<unsigned int> &adj_w = vertices.at(w).getAdjVertices();
+                for(auto it_z = adj_w.begin(); it_z != adj_w.end(); ++it_z) {
                     unsigned int z = *it_z;
                     if(reached.find(z) == reached.end()) { 
                         reached.insert(z);
@@ -382,81 +839,357 @@ vector<unsigned int> CustomGraph::Graph::lex_m() {
                         
                         if(it->second > j) {
                             reach[it->second].push_back(z);
+                            if constexpr(CollectStats)
+                                stats->reachPush((unsigned int) it->second);
                             it->second += 0.5;
-                            addEdge(v,z);
-                        } else
+                            fill.push_back(z);
+                        } else {
                             reach[j].push_back(z);
+                            if constexpr(CollectStats)
+                                stats->reachPush(j);
+                        }
                     }
                 }
             }
         }
 
+        phase.next(PerfCounters::FillInsertion);
+        insert(v, fill);
+        found += fill.size();
+        if constexpr(CollectStats)
+            stats->add_edge_calls += fill.size();
+
         //sort unnumbered vertices by label(w) value
+        phase.next(PerfCounters::LabelSort);
         if(vertices_and_label.size() != 0)
-            k = CustomRadixSort::sortByLabel(vertices_and_label);
+            k = CustomRadixSort::sortByLabel(vertices_and_label, CollectStats ? &stats->label_renumberings : nullptr);
+    }
+    if(control != nullptr)
+        control->finish(found);
+    return alphaInverse;
+}
+
+/**
+ * @brief Version of fill_in for the dense backend. The vertices are eliminated in order and the higher neighbours of each
+ * vertex are merged in the row of m(v) with a single row operation.
+ * @param bijFunction object used to define a bijection function that associates each vertex to a natural number.
+ * @param stats counters of the work done, used only when CollectStats is true.
+ * @param control limits of the run, null when it is not bounded.
+ * @return true if all the vertices have been eliminated.
+ */
+template<bool CollectStats>
+bool CustomGraph::Graph::fill_in_dense(BijectionFunction &bijFunction, OrderingStats *stats, RunControl *control) {
+    unsigned int n = vertices.size();
+    unsigned int words = matrix.rowWords();
+    unsigned int edges = numEdges;
+
+    vector<uint64_t> eliminated(words, 0), higher(words), added(words);
+
+    for(unsigned int i = 0; i + 1 < n; ++i) {
+        if(control != nullptr && !control->proceed(numEdges - edges))
+            return false;
+
+        unsigned int v = denseIndex[bijFunction.alpha(i)];
+        eliminated[v >> 6] |= (uint64_t) 1 << (v & 63);
+
+        // higher neighbours of v are the ones that have not been eliminated yet
+        const uint64_t *row_v = matrix.row(v);
+        for(unsigned int word = 0; word < words; ++word)
+            higher[word] = row_v[word] & ~eliminated[word];
+
+        // m(v) is the higher neighbour with the minimum alpha-1
+        unsigned int k = n-1, m = 0;
+        bool found = false;
+        AdjacencyMatrix::forEachBit(higher.data(), nullptr, words, [&](unsigned int w) {
+            unsigned int position = bijFunction.alphaInverse(denseValue[w]);
+            if constexpr(CollectStats)
+                stats->neighbor_scans++;
+            if(!found || position < k) {
+                k = position;
+                m = w;
+                found = true;
+            }
+        });
+
+        if(!found)
+            continue;
+
+        // make the other higher neighbours adjacent to m(v) with one row merge, then mirror the new bits
+        PerfCounters::Scope phase(PerfCounters::FillInsertion);
+        higher[m >> 6] &= ~((uint64_t) 1 << (m & 63));
+        unsigned int merged = matrix.mergeRow(m, higher.data(), added.data());
+        numEdges += merged;
+        if constexpr(CollectStats)
+            stats->fill_edges += merged;
+        AdjacencyMatrix::forEachBit(added.data(), nullptr, words, [&](unsigned int w) {
+            matrix.set(w, m);
+            record(Change::Kind::AddEdge, denseValue[m], denseValue[w]);
+        });
+    }
+    return control == nullptr || control->finish(numEdges - edges);
+}
+
+/**
+ * @brief Search of lex_m for the dense backend, it does not modify the graph. Reached and numbered vertices are kept
+ * as bit rows, so the unreached neighbours of a vertex are obtained word by word from its row.
+ * @param workspace temporary state of the search.
+ * @param stats counters of the work done, used only when CollectStats is true.
+ * @param control limits of the run, null when it is not bounded. When it stops the run the unnumbered vertices take the
+ * positions left in the order of their labels.
+ * @param insert function called with the row of the numbered vertex and the rows of its fill vertices.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+ */
+template<bool CollectStats, typename F>
+vector<unsigned int> CustomGraph::Graph::lex_m_dense(LexMWorkspace &workspace, OrderingStats *stats, RunControl *control, F insert) const {
+    Tracer::Span span("Graph::lex_m_dense", "ordering");
+    unsigned int words = matrix.rowWords();
+    vector<unsigned int> alphaInverse(vertices.size());
+    vector<pair<unsigned int, float>> &vertices_and_label = workspace.vertices_and_label;
+    vector<float> &label = workspace.label;
+    vector<uint64_t> &numbered = workspace.numbered, &reached = workspace.reached_rows;
+    vector<vector<unsigned int>> &reach = workspace.reach_rows;
+    vector<unsigned int> &reach_head = workspace.reach_heads;
+    vector<unsigned int> &fill = workspace.fill;
+    vertices_and_label.clear();
+    label.assign(matrix.capacity(), 1);
+    numbered.assign(words, 0);
+
+    for(auto &slot : denseIndex)
+        vertices_and_label.push_back(make_pair(slot.second, 1));
+
+    unsigned int k = 1;
+    uint64_t found = 0;
+    if(control != nullptr)
+        control->start();
+
+    for(int i = vertices.size(); i > 0; --i) {
+        if(control != nullptr && !control->proceed(found)) {
+            for(unsigned int j = 0; j < vertices_and_label.size(); ++j)
+                alphaInverse[i-1-j] = denseValue[vertices_and_label[j].first];
+            break;
+        }
+
+        //pick an unnumbered vertex v with label(v) = k
+        unsigned int v = vertices_and_label[0].first;
+        vertices_and_label.erase(vertices_and_label.begin());
+
+        // assign v the number i
+        alphaInverse[i-1] = denseValue[v];
+        numbered[v >> 6] |= (uint64_t) 1 << (v & 63);
+
+        PerfCounters::Scope phase(PerfCounters::ReachSearch);
+
+        // only the numbered vertices are reached at the beginning of the search
+        reached = numbered;
+        if(reach.size() < k+1)
+            reach.resize(k+1);
+        for(unsigned int j = 0; j <= k; ++j)
+            reach[j].clear();
+        reach_head.assign(k+1, 0);
+        fill.clear();
+
+        AdjacencyMatrix::forEachBit(matrix.row(v), reached.data(), words, [&](unsigned int w) {
+            reach[(unsigned int) label[w]].push_back(w);
+            if constexpr(CollectStats)
+                stats->reachPush((unsigned int) label[w]);
+            reached[w >> 6] |= (uint64_t) 1 << (w & 63);
+            label[w] += 0.5;
+        });
+
+        for(unsigned int j = 1; j <= k; ++j) {
+            while(reach_head[j] < reach[j].size()) {
+                // delete a vertex w from reach(j)
+                unsigned int w = reach[j][reach_head[j]++];
+
+                AdjacencyMatrix::forEachBit(matrix.row(w), reached.data(), words, [&](unsigned int z) {
+                    reached[z >> 6] |= (uint64_t) 1 << (z & 63);
+
+                    if(label[z] > j) {
+                        reach[(unsigned int) label[z]].push_back(z);
+                        if constexpr(CollectStats)
+                            stats->reachPush((unsigned int) label[z]);
+                        label[z] += 0.5;
+                        fill.push_back(z);
+                    } else {
+                        reach[j].push_back(z);
+                        if constexpr(CollectStats)
+                            stats->reachPush(j);
+                    }
+                });
+            }
+        }
+
+        phase.next(PerfCounters::FillInsertion);
+        if constexpr(CollectStats)
+            stats->add_edge_calls += fill.size();
+        insert(v, fill);
+        found += fill.size();
+
+        //sort unnumbered vertices by label(w) value
+        phase.next(PerfCounters::LabelSort);
+        if(vertices_and_label.size() != 0) {
+            for(auto &el : vertices_and_label)
+                el.second = label[el.first];
+
+            k = CustomRadixSort::sortByLabel(vertices_and_label, CollectStats ? &stats->label_renumberings : nullptr);
+
+            for(auto &el : vertices_and_label)
+                label[el.first] = el.second;
+        }
     }
+    if(control != nullptr)
+        control->finish(found);
     return alphaInverse;
 }
 
+/**
+ * @brief Revert a change of the undo log without recording it. The later changes have already been reverted, so an
+ * added vertex has no edges and the adjacent vertices of a deleted one are in the graph.
+ * @param change change to be reverted.
+ */
+void CustomGraph::Graph::revert(Change &change) {
+    unsigned int v = change.first;
+    switch(change.kind) {
+    case Change::Kind::AddEdge:
+        if(storage == Storage::Dense) {
+            unsigned int first = denseIndex[v], second = denseIndex[change.second];
+            matrix.reset(first, second);
+            matrix.reset(second, first);
+        } else {
+            vertices[v].getAdjVertices().erase(change.second);
+            vertices[change.second].getAdjVertices().erase(v);
+        }
+        numEdges--;
+        break;
+
+    case Change::Kind::AddVertex:
+        if(storage == Storage::Dense) {
+            auto it = denseIndex.find(v);
+            freeSlots.push_back(it->second);
+            denseIndex.erase(it);
+        }
+        vertices.erase(v);
+        break;
+
+    case Change::Kind::DeleteVertex:
+        vertices[v] = Vertex(v);
+        if(storage == Storage::Dense) {
+            unsigned int slot = denseSlot(v);
+            for(auto w : change.neighbors) {
+                unsigned int other = denseIndex[w];
+                matrix.set(slot, other);
+                matrix.set(other, slot);
+            }
+        } else
+            for(auto w : change.neighbors) {
+                vertices[v].getAdjVertices().insert(w);
+                vertices[w].getAdjVertices().insert(v);
+            }
+        numEdges += change.neighbors.size();
+        break;
+    }
+}
+
+/**
+ * @brief Get the row of the adjacency matrix assigned to a vertex, a new row is assigned if the vertex has none.
+ * @param vertex value of the vertex.
+ * @return unsigned int index of the row.
+ */
+unsigned int CustomGraph::Graph::denseSlot(unsigned int vertex) {
+    auto it = denseIndex.find(vertex);
+    if(it != denseIndex.end())
+        return it->second;
+
+    unsigned int slot;
+    if(!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        denseValue[slot] = vertex;
+    } else {
+        slot = denseValue.size();
+        denseValue.push_back(vertex);
+        // grow geometrically, the rows are copied only when the capacity doubles
+        if(slot >= matrix.capacity())
+            matrix.resize(max(64u, 2 * matrix.capacity()));
+    }
+
+    denseIndex[vertex] = slot;
+    return slot;
+}
+
 /**
  * @brief Utility function used to create a random graph from scratch. It exploits the Erdos-Renyi model for creation of
  * random connected graphs, the only parameter specified is the number of vertices, the function will generate edges randomly.
+ * The seed is taken from the random device, use the overload with the seed to obtain reproducible graphs.
  * @param num_vertices number of vertices that will compose the graph.
  */
 void CustomGraph::Graph::generateRandomGraph(unsigned int num_vertices) {
-    RandomGraphGenerator rg(num_vertices);
-    rg.generate();
-
-    vector<unsigned int> rg_vertices = rg.getVertices();
-    for(auto it = rg_vertices.begin(); it != rg_vertices.end(); ++it) 
-        addVertex(*it);
+    random_device rd;
+    generateRandomGraph(num_vertices, ((uint64_t) rd() << 32) | rd());
+}
 
-    vector<unsigned int> rg_edges_src = rg.getEdgesSrc();
-    vector<unsigned int> rg_edges_dst = rg.getEdgesDst();
+/**
+ * @brief Utility function used to create a reproducible random graph from scratch. The number of edges is drawn
+ * between n-1 and n(n-1)/2, then the graph is generated by ErdosRenyiGenerator, which is connected by construction.
+ * @param num_vertices number of vertices that will compose the graph.
+ * @param seed seed of the generator, the same seed always produces the same graph.
+ */
+void CustomGraph::Graph::generateRandomGraph(unsigned int num_vertices, uint64_t seed) {
+    RandomGraphGenerator rg(num_vertices, seed);
+    rg.generate();
 
+    vector<unsigned int> &rg_edges_src = rg.getEdgesSrc();
+    vector<unsigned int> &rg_edges_dst = rg.getEdgesDst();
+    vector<pair<unsigned int, unsigned int>> edges(rg_edges_src.size());
     for(unsigned int i = 0; i < rg_edges_src.size(); ++i)
-        addEdge(rg_edges_src[i], rg_edges_dst[i]);
+        edges[i] = make_pair(rg_edges_src[i], rg_edges_dst[i]);
 
-    if(!isConnected())
-        connect();
+    vertices.reserve(vertices.size() + num_vertices);
+    for(auto v : rg.getVertices())
+        addVertex(v);
+    addEdgesBulk(edges);
 }
 
 /**
  * @brief Utility function used to create a random graph from scratch. It exploits the Erdos-Renyi model for creation of
  * random connected graphs, the input parameter indicates the sum between the number of vertices and the number of edges.
  * The function will then produce a graph which sum between number of vertices and number of edges is equal to num_elements.
+ * The seed is taken from the random device, use the overload with the seed to obtain reproducible graphs.
  * @param num_elements number of elements in the graph, it is given by the sum of the number of vertices and the number of edges.
  */
 void CustomGraph::Graph::generateRandomGraphPrecise(unsigned int num_elements) {
-    typedef boost::adjacency_list<> Graph;
-    typedef boost::erdos_renyi_iterator<boost::minstd_rand, Graph> ERGen;
-
     random_device rd;
-    mt19937 gen(rd());
+    generateRandomGraphPrecise(num_elements, ((uint64_t) rd() << 32) | rd());
+}
 
-    unsigned int num_vertices = 1;
-    
-    while(num_vertices + ((num_vertices * (num_vertices - 1)) / 2) < num_elements) {
-        uniform_int_distribution<> distr_vertices(num_vertices, num_elements / 2);
-        num_vertices = distr_vertices(gen);
-    }
-    
-    unsigned int num_edges = num_elements - num_vertices;
-
-    boost::minstd_rand graph_gen;
-    boost::graph_traits<Graph>::vertices_size_type n(num_vertices);
-    boost::graph_traits<Graph>::edges_size_type m(num_edges);
-
-    boost::adjacency_list<> g(ERGen(graph_gen, n, m, false), ERGen(), n);
-
-    boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
-    for(boost::tie(vi, vi_end) = boost::vertices(g); vi != vi_end; ++vi)
-        addVertex((unsigned int) *vi);
-
-    boost::graph_traits<Graph>::edge_iterator ei, ei_end;
-    for(boost::tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei)
-        addEdge((unsigned int) (*ei).m_source, (unsigned int) (*ei).m_target);
-    
-    if(!isConnected())
-        connect();
-}
\ No newline at end of file
+/**
+ * @brief Utility function used to create a reproducible random graph from scratch with num_elements vertices plus edges.
+ * The number of vertices is drawn once among the values that allow a connected graph, then the graph is generated by
+ * ErdosRenyiGenerator. When num_elements is too small for a connected graph (e.g. 2) an edge more is added.
+ * @param num_elements number of elements in the graph, it is given by the sum of the number of vertices and the number of edges.
+ * @param seed seed of the generator, the same seed always produces the same graph.
+ */
+void CustomGraph::Graph::generateRandomGraphPrecise(unsigned int num_elements, uint64_t seed) {
+    if(num_elements == 0)
+        return;
+
+    // the fewest vertices that can hold the edges, n + n(n-1)/2 >= num_elements, and the most that keep it connected, 2n-1 <= num_elements
+    uint64_t min_vertices = (uint64_t) sqrt(2.0 * num_elements);
+    while(min_vertices > 1 && min_vertices - 1 + ErdosRenyiGenerator::maxEdges(min_vertices - 1) >= num_elements)
+        min_vertices--;
+    while(min_vertices + ErdosRenyiGenerator::maxEdges(min_vertices) < num_elements)
+        min_vertices++;
+    uint64_t max_vertices = max(min_vertices, ((uint64_t) num_elements + 1) / 2);
+
+    RandomStream random(seed);
+    unsigned int num_vertices = min_vertices + random.below(max_vertices - min_vertices + 1);
+    uint64_t num_edges = max<uint64_t>(num_elements - num_vertices, num_vertices - 1);
+
+    vector<pair<unsigned int, unsigned int>> edges;
+    ErdosRenyiGenerator::generateEdges(num_vertices, num_edges, random.next(), edges);
+
+    vertices.reserve(vertices.size() + num_vertices);
+    for(unsigned int v = 0; v < num_vertices; ++v)
+        addVertex(v);
+    addEdgesBulk(edges);
+}
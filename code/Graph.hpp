@@ -6,17 +6,46 @@
 #include "RandomGraphGenerator.hpp"
 #include "Sets.hpp"
 #include "CustomRadixSort.hpp"
+#include "AdjacencyMatrix.hpp"
+#include "OrderingStats.hpp"
+#include "GraphProfile.hpp"
+#include "LexMWorkspace.hpp"
+#include "RunControl.hpp"
 
 #include <iostream>
 #include <vector>
 #include <algorithm>
 #include <iterator>
 #include <unordered_map>
+#include <cstdint>
 
 using namespace std;
 
 namespace CustomGraph {
 
+/**
+ * @brief Backends that can be used to store the edges of a graph.
+ * - Sparse: each vertex keeps the set of its adjacent vertices, the memory is proportional to the number of edges.
+ * - Dense: the edges are stored in a bit matrix, one bit for each pair of vertices. Convenient to keep a graph with
+ *   a density above 30%, in that case addEdge and isAdjacent are single bit operations and fill_in and lex_m work on whole rows.
+ *   The threshold is for the storage of a graph that is updated and queried; a single run of lex_m pays off on a dense
+ *   copy from a much lower density, see Graph::DENSE_ORDER_DENSITY.
+ */
+enum class Storage { Sparse, Dense };
+
+/**
+ * @brief Decision taken by Graph::order: the statistics of the graph, whether it is chordal, the algorithm and the
+ * backend that produced the ordering (Sparse means the CSR engine, Dense a copy of the graph with the bit matrix).
+ */
+struct OrderingChoice {
+    enum class Method { LexP, LexM };
+
+    GraphProfile profile;
+    bool chordal = false;
+    Method method = Method::LexP;
+    Storage storage = Storage::Sparse;
+};
+
 /**
  * @brief Main class of the project, it contains the three functions to be tested (fill_in, lex_p, lex_m) and all the functions
  * necessary to manage in a handy way a graph. An instance of this class will represent an undirected and connected graph, also auto-ring
@@ -29,19 +58,28 @@ public:
      */
     Graph();
 
+    /**
+     * @brief Construct a new empty Graph object that stores its edges with the specified backend.
+     * @param storage backend used to store the edges.
+     */
+    Graph(Storage storage);
+
     /**
      * @brief Construct a new Graph object with verticies specified.
      * @param vertices vector of verticies that will compose the graph.
+     * @param storage backend used to store the edges.
      */
-    Graph(const vector<unsigned int> &vertices);
+    Graph(const vector<unsigned int> &vertices, Storage storage = Storage::Sparse);
 
     /**
-     * @brief Construct a new Graph object with verticies and edges specified.
+     * @brief Construct a new Graph object with verticies and edges specified. The graph is built in bulk by GraphBuilder, duplicated edges
+     * and auto-rings are ignored.
      * @param vertices vector of verticies that will compose the graph.
      * @param sources vector of souces of the edges
      * @param destinations vector of destinations of the edges.
+     * @param storage backend used to store the edges.
      */
-    Graph(const vector<unsigned int> &vertices, const vector<unsigned int> &sources, const vector<unsigned int> &destinations); 
+    Graph(const vector<unsigned int> &vertices, const vector<unsigned int> &sources, const vector<unsigned int> &destinations, Storage storage = Storage::Sparse); 
  
     /**
      * @brief Add a new vertex to the graph.
@@ -69,6 +107,14 @@ public:
      */
     void addEdge(const Vertex &first, const Vertex &second);
 
+    /**
+     * @brief Add many edges to the graph at once. The adjacency sets are enlarged once for all according to the degrees,
+     * then each edge is inserted with a single hash lookup per endpoint instead of the checks done by addEdge.
+     * Edges that are already in the graph, auto-rings and edges with endpoints not in the graph are ignored.
+     * @param edges edges to be added.
+     */
+    void addEdgesBulk(const vector<pair<unsigned int, unsigned int>> &edges);
+
     /**
      * @brief Get the number of verticies in the graph.
      * @return unsigned int number of verticies.
@@ -87,8 +133,75 @@ public:
      */
     void deleteVertex(unsigned int v);
 
+    /**
+     * @brief Start recording the changes of the graph in an undo log: every vertex added, edge added (by addEdge,
+     * addEdgesBulk, fill_in and lex_m) and vertex deleted, with its edges. The checkpoints can be nested, each rollback
+     * or commit closes the last one. clear and the bulk builders discard the log and all the checkpoints.
+     */
+    void checkpoint();
+
+    /**
+     * @brief Revert the changes recorded since the last checkpoint, in reverse order, and close it. The cost is
+     * proportional to the number of changes, e.g. to the fill of an ordering, instead of a copy of the graph.
+     * @return true if the changes have been reverted.
+     * @return false if there is no checkpoint.
+     */
+    bool rollback();
+
+    /**
+     * @brief Keep the changes recorded since the last checkpoint and close it, they are still reverted by the rollback
+     * of an outer checkpoint.
+     * @return true if the checkpoint has been closed.
+     * @return false if there is no checkpoint.
+     */
+    bool commit();
+
+    /**
+     * @brief Get the number of open checkpoints.
+     * @return unsigned int number of checkpoints not yet rolled back or committed, 0 when the changes are not recorded.
+     */
+    unsigned int checkpoints();
+
+    /**
+     * @brief Check if two vertices of the graph are adjacent, it works with both the storage backends.
+     * @param first value of the first vertex.
+     * @param second value of the second vertex.
+     * @return true if the edge {first, second} is in the graph.
+     * @return false if the edge is not in the graph.
+     */
+    bool isAdjacent(unsigned int first, unsigned int second);
+
+    /**
+     * @brief Call f(w) for each vertex w adjacent to the input vertex, it works with both the storage backends.
+     * The adjacency of the input vertex must not be modified by f.
+     * @param vertex value of the vertex.
+     * @param f function called with the value of each adjacent vertex.
+     */
+    template<typename F>
+    void forEachAdjacent(unsigned int vertex, F f) {
+        if(storage == Storage::Dense) {
+            auto it = denseIndex.find(vertex);
+            if(it != denseIndex.end())
+                AdjacencyMatrix::forEachBit(matrix.row(it->second), nullptr, matrix.rowWords(), [&](unsigned int j) {
+                    f(denseValue[j]);
+                });
+        } else {
+            auto it = vertices.find(vertex);
+            if(it != vertices.end())
+                for(auto w : it->second.getAdjVertices())
+                    f(w);
+        }
+    }
+
+    /**
+     * @brief Get the backend used to store the edges of the graph.
+     * @return Storage backend of the graph.
+     */
+    Storage getStorage();
+
     /**
      * @brief Get the Vertices object that bind values of the vertices to the corresponding object.
+     * With the dense backend the vertex objects do not contain the adjacent vertices, use isAdjacent and forEachAdjacent.
      * @return unordered_map<unsigned int, Vertex>& data structure that stores the vertices. 
      */
     unordered_map<unsigned int, Vertex>& getVertices();
@@ -152,6 +265,40 @@ public:
      */
     void fill_in(BijectionFunction &bijFunction);
 
+    /**
+     * @brief Same as fill_in, the work done is counted in stats.
+     * @param bijFunction object used to define a bijection function that associates each vertex to a natural number.
+     * @param stats it accumulates the adjacent vertices scanned and the fill edges added.
+     */
+    void fill_in(BijectionFunction &bijFunction, OrderingStats &stats);
+
+    /**
+     * @brief Same as fill_in, but the run is bounded by control, which is checked before the elimination of each vertex
+     * with the fill added so far and once more at the end with the whole fill. When the run is stopped the vertices
+     * alpha(0), ..., alpha(control.steps()-1) have been eliminated and their fill stays in the graph, a checkpoint
+     * taken before the call allows to discard it.
+     * @param bijFunction object used to define a bijection function that associates each vertex to a natural number.
+     * @param control limits of the run, it receives the outcome.
+     * @return true if all the vertices have been eliminated within the limits.
+     * @return false if the run has been stopped or its fill went beyond the budget, control.status() tells why.
+     */
+    bool fill_in(BijectionFunction &bijFunction, RunControl &control);
+
+    /**
+     * @brief Add edges to a graph already filled by fill_in with the same ordering and add only the fill they cause.
+     * In the filled graph the parent of v in the elimination tree is m(v), its higher neighbour with the minimum
+     * alpha-1, and the fill of v is its higher neighbours added to m(v). A new edge changes the higher neighbours of its
+     * lower endpoint only, so the new fill is propagated up the elimination tree from the lower endpoints: the changed
+     * vertices are taken in ascending order, each one adds its higher neighbours to its (possibly new) parent and marks
+     * it as changed when some edge is added. The vertices that do not change are never visited, and the result is the
+     * graph that fill_in would produce from the original graph plus the new edges.
+     * @param bijFunction ordering used by the previous fill_in.
+     * @param edges edges to be added, the ones already there, the auto-rings and the ones with endpoints not in the graph
+     * are ignored.
+     * @return vector<pair<unsigned int, unsigned int>> fill edges added, without the input edges.
+     */
+    vector<pair<unsigned int, unsigned int>> fill_in_incremental(BijectionFunction &bijFunction, const vector<pair<unsigned int, unsigned int>> &edges);
+
     /**
      * @brief Lex_p is a function that tries to find a perfect ordering inside a graph.
      * Alpha is a perfect ordering if it's not necessary to add any other edge to eliminate the graph.
@@ -173,6 +320,13 @@ public:
      */
     vector<unsigned int> lex_p();
 
+    /**
+     * @brief Same as lex_p, the work done is counted in stats.
+     * @param stats it accumulates the cells created and destroyed and the refinements of the partition.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+     */
+    vector<unsigned int> lex_p(OrderingStats &stats);
+
     /**
      * @brief Lex_m is a function that finds a minimal ordering inside a graph.
      * Alpha is a minimal ordering if adding some edges I can eliminate the graph.
@@ -197,31 +351,197 @@ public:
      * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
      */
     vector<unsigned int> lex_m();
+
+    /**
+     * @brief Same as lex_m, the work done is counted in stats.
+     * @param stats it accumulates the pushes in the reach queues, the renumbered labels and the calls of addEdge.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+     */
+    vector<unsigned int> lex_m(OrderingStats &stats);
+
+    /**
+     * @brief Same as lex_m, but the run is bounded by control, which is checked before the numbering of each vertex
+     * with the fill added so far and once more at the end with the whole fill. When the run is stopped the last
+     * control.steps() positions hold the vertices numbered by lex_m, and the others get the lower positions in the
+     * order of their current labels, the order in which lex_m would try them next: the result is always an ordering of
+     * all the vertices, only the fill of the numbered vertices is added.
+     * @param control limits of the run, it receives the outcome.
+     * @return vector<unsigned int> structure that contains the ordered vertices, minimal when control.status() is Completed.
+     */
+    vector<unsigned int> lex_m(RunControl &control);
+
+    /**
+     * @brief Same as lex_m, but the graph is not modified, so several threads can order the same graph at once. The
+     * temporary state lives in the workspace of the caller and the fill edges of the minimal triangulation are returned
+     * in fill instead of being added to the graph: the graph plus the fill is the graph left by the other lex_m.
+     * @param workspace temporary state of the search, it can be reused by the following calls of the same thread.
+     * @param fill it receives the fill edges, its previous content is discarded.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+     */
+    vector<unsigned int> lex_m(LexMWorkspace &workspace, vector<pair<unsigned int, unsigned int>> &fill) const;
+
+    /**
+     * @brief Front door of the orderings: it returns a minimal ordering with the fastest engine for this graph, which is
+     * not modified. The statistics of the graph are computed in one linear pass, then the ordering of lex_p is checked
+     * in linear time: if it produces no fill the graph is chordal and that perfect ordering is returned. Otherwise lex_m
+     * runs on a dense copy when the density is at least DENSE_ORDER_DENSITY and the bit matrix is small enough, and on
+     * the CSR engine in the other cases.
+     * @param choice if not null, it receives the statistics and the engine chosen.
+     * @return vector<unsigned int> structure that contains the ordered vertices, perfect when the graph is chordal.
+     */
+    vector<unsigned int> order(OrderingChoice *choice = nullptr);
+
+    /**
+     * @brief Density from which order runs lex_m on a dense copy of the graph. It compares one run of lex_m on the CSR
+     * engine with one on the dense backend, copy included, so it is lower than the 30% suggested by Storage for keeping
+     * a graph dense. Calibrated with the "order" and "csr_lex_m" engines of test/temporal/ordering_benchmark.cpp on the
+     * Erdos-Renyi graphs with n from 250 to 2000: the two engines tie below density 0.05, the dense backend is 1.3 times
+     * faster at 0.05, 1.6 times at 0.1 and 3 to 8 times at 0.2-0.4; 0.08 sits past the tie with a margin for noise.
+     */
+    static constexpr double DENSE_ORDER_DENSITY = 0.08;
+
+    /**
+     * @brief Maximum number of vertices of the dense copy made by order, its bit matrix takes n^2/8 bytes (128 MiB).
+     */
+    static const unsigned int DENSE_ORDER_MAX_VERTICES = 1 << 15;
     
     /**
      * @brief Utility function used to create a random graph from scratch. It exploits the Erdos-Renyi model for creation of
      * random connected graphs, the only parameter specified is the number of vertices, the function will generate edges randomly.
+     * The seed is taken from the random device, use the overload with the seed to obtain reproducible graphs.
      * @param num_vertices number of vertices that will compose the graph.
      */
     void generateRandomGraph(unsigned int num_vertices);
 
+    /**
+     * @brief Utility function used to create a reproducible random graph from scratch. The number of edges is drawn
+     * between n-1 and n(n-1)/2, then the graph is generated by ErdosRenyiGenerator, which is connected by construction.
+     * @param num_vertices number of vertices that will compose the graph.
+     * @param seed seed of the generator, the same seed always produces the same graph.
+     */
+    void generateRandomGraph(unsigned int num_vertices, uint64_t seed);
+
     /**
      * @brief Utility function used to create a random graph from scratch. It exploits the Erdos-Renyi model for creation of
      * random connected graphs, the input parameter indicates the sum between the number of vertices and the number of edges.
      * The function will then produce a graph which sum between number of vertices and number of edges is equal to num_elements.
+     * The seed is taken from the random device, use the overload with the seed to obtain reproducible graphs.
      * @param num_elements number of elements in the graph, it is given by the sum of the number of vertices and the number of edges.
      */
     void generateRandomGraphPrecise(unsigned int num_elements);
 
+    /**
+     * @brief Utility function used to create a reproducible random graph from scratch with num_elements vertices plus edges.
+     * The number of vertices is drawn once among the values that allow a connected graph, then the graph is generated by
+     * ErdosRenyiGenerator. When num_elements is too small for a connected graph (e.g. 2) an edge more is added.
+     * @param num_elements number of elements in the graph, it is given by the sum of the number of vertices and the number of edges.
+     * @param seed seed of the generator, the same seed always produces the same graph.
+     */
+    void generateRandomGraphPrecise(unsigned int num_elements, uint64_t seed);
+
 private:
+    friend struct GraphBuilder;
+
+    /**
+     * @brief Change recorded in the undo log. An added edge is first-second, a deleted vertex keeps its adjacent vertices.
+     */
+    struct Change {
+        enum class Kind { AddVertex, AddEdge, DeleteVertex };
+
+        Kind kind;
+        unsigned int first;
+        unsigned int second;
+        vector<unsigned int> neighbors;
+    };
+
+    /**
+     * @brief Append a change to the undo log, only when there is an open checkpoint.
+     * @param kind kind of the change.
+     * @param first vertex added or deleted, or first endpoint of the edge.
+     * @param second second endpoint of the edge.
+     */
+    void record(Change::Kind kind, unsigned int first, unsigned int second = 0) {
+        if(!undoMarks.empty())
+            undoLog.push_back({kind, first, second, {}});
+    }
+
+    /**
+     * @brief Revert a change of the undo log without recording it.
+     * @param change change to be reverted.
+     */
+    void revert(Change &change);
+
+    /**
+     * @brief Implementation of fill_in, shared by its overloads. The counters of stats are updated only when CollectStats
+     * is true, otherwise the counting is compiled out.
+     * @param bijFunction object used to define a bijection function that associates each vertex to a natural number.
+     * @param stats counters of the work done, used only when CollectStats is true.
+     * @param control limits of the run, null when it is not bounded.
+     * @return true if all the vertices have been eliminated.
+     */
+    template<bool CollectStats>
+    bool fill_in_impl(BijectionFunction &bijFunction, OrderingStats *stats, RunControl *control);
+
+    /**
+     * @brief Implementation of lex_p, shared by its overloads. The counters of stats are updated only when CollectStats
+     * is true, otherwise the counting is compiled out.
+     * @param stats counters of the work done, used only when CollectStats is true.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+     */
+    template<bool CollectStats>
+    vector<unsigned int> lex_p_impl(OrderingStats *stats);
+
+    /**
+     * @brief Implementation of the overloads of lex_m that add the fill to the graph, with both the backends. The counters
+     * of stats are updated only when CollectStats is true, otherwise the counting is compiled out.
+     * @param stats counters of the work done, used only when CollectStats is true.
+     * @param control limits of the run, null when it is not bounded.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+     */
+    template<bool CollectStats>
+    vector<unsigned int> lex_m_impl(OrderingStats *stats, RunControl *control);
 
     /**
-     * @brief Auxiliary function that is used to perform a depth first search in the graph to check if it is connected. It is called
-     * in the connect function and it is part of its logic.
-     * @param v vertex to be searched.
-     * @param visited_vertices vertices visited and not of the graph.
+     * @brief Search of lex_m for the sparse backend, it does not modify the graph. The fill vertices found by each step
+     * are passed to insert(v, fill) at the end of the step: v is numbered, so the fill cannot change the next searches.
+     * @param workspace temporary state of the search.
+     * @param stats counters of the work done, used only when CollectStats is true.
+     * @param control limits of the run, null when it is not bounded.
+     * @param insert function called with the value of the numbered vertex and the values of its fill vertices.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+     */
+    template<bool CollectStats, typename F>
+    vector<unsigned int> lex_m_search(LexMWorkspace &workspace, OrderingStats *stats, RunControl *control, F insert) const;
+
+    /**
+     * @brief Version of fill_in for the dense backend. The vertices are eliminated in order and the higher neighbours of each
+     * vertex are merged in the row of m(v) with a single row operation.
+     * @param bijFunction object used to define a bijection function that associates each vertex to a natural number.
+     * @param stats counters of the work done, used only when CollectStats is true.
+     * @param control limits of the run, null when it is not bounded.
+     * @return true if all the vertices have been eliminated.
+     */
+    template<bool CollectStats>
+    bool fill_in_dense(BijectionFunction &bijFunction, OrderingStats *stats, RunControl *control);
+
+    /**
+     * @brief Search of lex_m for the dense backend, it does not modify the graph. Reached and numbered vertices are kept
+     * as bit rows, so the unreached neighbours of a vertex are obtained word by word from its row.
+     * @param workspace temporary state of the search.
+     * @param stats counters of the work done, used only when CollectStats is true.
+     * @param control limits of the run, null when it is not bounded.
+     * @param insert function called with the row of the numbered vertex and the rows of its fill vertices.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
      */
-    void DFS(unsigned int v, vector<pair<Vertex, bool>> &visited_vertices);
+    template<bool CollectStats, typename F>
+    vector<unsigned int> lex_m_dense(LexMWorkspace &workspace, OrderingStats *stats, RunControl *control, F insert) const;
+
+    /**
+     * @brief Get the row of the adjacency matrix assigned to a vertex, a new row is assigned if the vertex has none.
+     * @param vertex value of the vertex.
+     * @return unsigned int index of the row.
+     */
+    unsigned int denseSlot(unsigned int vertex);
 
     /**
      * @brief Structure that binds the value of the vertex with the corresponding vertex object.
@@ -232,6 +552,41 @@ private:
      * @brief Number of edges in the graph.
      */
     unsigned int numEdges;
+
+    /**
+     * @brief Backend used to store the edges.
+     */
+    Storage storage;
+
+    /**
+     * @brief Bit matrix of the edges, used only by the dense backend.
+     */
+    AdjacencyMatrix matrix;
+
+    /**
+     * @brief Structure that binds the value of a vertex with its row in the matrix, used only by the dense backend.
+     */
+    unordered_map<unsigned int, unsigned int> denseIndex;
+
+    /**
+     * @brief Value of the vertex assigned to each row of the matrix, used only by the dense backend.
+     */
+    vector<unsigned int> denseValue;
+
+    /**
+     * @brief Rows of the matrix released by deleted vertices that can be assigned again.
+     */
+    vector<unsigned int> freeSlots;
+
+    /**
+     * @brief Changes recorded since the first open checkpoint.
+     */
+    vector<Change> undoLog;
+
+    /**
+     * @brief Size of the undo log when each open checkpoint was taken.
+     */
+    vector<size_t> undoMarks;
 };
 
 }
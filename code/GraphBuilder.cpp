@@ -0,0 +1,187 @@
+#include "GraphBuilder.hpp"
+#include "Parallel.hpp"
+#include "Tracer.hpp"
+
+/**
+ * @brief Number of edges processed by each parallel task.
+ */
+static const size_t EDGE_BLOCK = 1 << 16;
+
+/**
+ * @brief Get the number of blocks needed to cover a number of elements.
+ * @param elements number of elements.
+ * @return unsigned int number of blocks of EDGE_BLOCK elements.
+ */
+static unsigned int edgeBlocks(size_t elements) {
+    return (elements + EDGE_BLOCK - 1) / EDGE_BLOCK;
+}
+
+/**
+ * @brief Normalize a list of edges as {min, max}, sort it and remove duplicates and auto-rings.
+ * @param edges edges to be normalized, they are replaced by the normalized ones.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ */
+void CustomGraph::GraphBuilder::normalizeEdges(vector<pair<unsigned int, unsigned int>> &edges, unsigned int num_threads) {
+    Tracer::Span span("GraphBuilder::normalizeEdges", "build");
+    Parallel::forEach(edgeBlocks(edges.size()), [&](unsigned int b) {
+        size_t last = min(edges.size(), (b + 1) * EDGE_BLOCK);
+        for(size_t i = b * EDGE_BLOCK; i < last; ++i)
+            if(edges[i].first > edges[i].second)
+                swap(edges[i].first, edges[i].second);
+    }, num_threads);
+
+    edges.erase(remove_if(edges.begin(), edges.end(), [](const pair<unsigned int, unsigned int> &edge) {
+        return edge.first == edge.second;
+    }), edges.end());
+
+    Parallel::sort(edges, num_threads);
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+}
+
+/**
+ * @brief Build a graph in compressed sparse row format. The edge i is {sources[i], destinations[i]}.
+ * @param vertices values of the vertices, duplicates are ignored.
+ * @param sources sources of the edges.
+ * @param destinations destinations of the edges.
+ * @param csr graph that receives the vertices and the edges.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ * @return true if the graph has been built.
+ * @return false if sources and destinations have different sizes.
+ */
+bool CustomGraph::GraphBuilder::buildCSR(const vector<unsigned int> &vertices, const vector<unsigned int> &sources, const vector<unsigned int> &destinations,
+                                         CSRGraph &csr, unsigned int num_threads) {
+    Tracer::Span span("GraphBuilder::buildCSR", "build");
+    if(sources.size() != destinations.size())
+        return false;
+
+    vector<unsigned int> ids(vertices);
+    Parallel::sort(ids, num_threads);
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+
+    vector<pair<unsigned int, unsigned int>> edges = indexEdges(ids, sources, destinations, num_threads);
+    vector<uint64_t> offsets;
+    vector<unsigned int> adjacency;
+    fillRows(ids.size(), edges, offsets, adjacency);
+
+    // the table of ids is omitted when the values are 0, 1, ..., n-1
+    if(!ids.empty() && ids.back() == ids.size() - 1)
+        ids.clear();
+    csr = CSRGraph(move(offsets), move(adjacency), move(ids));
+    return true;
+}
+
+/**
+ * @brief Build a graph. The edge i is {sources[i], destinations[i]}. With the sparse backend every adjacency set is
+ * reserved with its final degree and filled in parallel, with the dense backend the sorted edges are added one by one.
+ * @param vertices values of the vertices, duplicates are ignored.
+ * @param sources sources of the edges.
+ * @param destinations destinations of the edges.
+ * @param graph graph that receives the vertices and the edges, it is cleared before.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ * @return true if the graph has been built.
+ * @return false if sources and destinations have different sizes.
+ */
+bool CustomGraph::GraphBuilder::build(const vector<unsigned int> &vertices, const vector<unsigned int> &sources, const vector<unsigned int> &destinations,
+                                      Graph &graph, unsigned int num_threads) {
+    Tracer::Span span("GraphBuilder::build", "build");
+    if(sources.size() != destinations.size())
+        return false;
+
+    vector<unsigned int> ids(vertices);
+    Parallel::sort(ids, num_threads);
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+
+    graph.clear();
+    graph.vertices.reserve(ids.size());
+    for(auto v : ids)
+        graph.addVertex(v);
+
+    vector<pair<unsigned int, unsigned int>> edges = indexEdges(ids, sources, destinations, num_threads);
+    if(graph.storage == Storage::Dense) {
+        for(auto &edge : edges)
+            graph.addEdge(ids[edge.first], ids[edge.second]);
+        return true;
+    }
+
+    vector<uint64_t> offsets;
+    vector<unsigned int> adjacency;
+    fillRows(ids.size(), edges, offsets, adjacency);
+
+    // the references to the elements of an unordered_map are stable, so each task fills its own sets
+    vector<Vertex*> rows(ids.size());
+    for(unsigned int i = 0; i < ids.size(); ++i)
+        rows[i] = &graph.vertices[ids[i]];
+
+    Parallel::forEach(edgeBlocks(ids.size()), [&](unsigned int b) {
+        size_t last = min(ids.size(), (b + 1) * EDGE_BLOCK);
+        for(size_t i = b * EDGE_BLOCK; i < last; ++i) {
+            unordered_set<unsigned int> &adjacent = rows[i]->getAdjVertices();
+            adjacent.reserve(offsets[i+1] - offsets[i]);
+            for(uint64_t k = offsets[i]; k < offsets[i+1]; ++k)
+                adjacent.insert(ids[adjacency[k]]);
+        }
+    }, num_threads);
+
+    graph.numEdges = edges.size();
+    return true;
+}
+
+/**
+ * @brief Translate the endpoints of the edges to the indices of the sorted vertices and normalize the edges.
+ * @param ids sorted values of the vertices without duplicates.
+ * @param sources sources of the edges.
+ * @param destinations destinations of the edges.
+ * @param num_threads number of threads to be used.
+ * @return vector<pair<unsigned int, unsigned int>> normalized edges between indices.
+ */
+vector<pair<unsigned int, unsigned int>> CustomGraph::GraphBuilder::indexEdges(const vector<unsigned int> &ids, const vector<unsigned int> &sources,
+                                                                              const vector<unsigned int> &destinations, unsigned int num_threads) {
+    bool identity = !ids.empty() && ids.back() == ids.size() - 1;
+    auto index = [&](unsigned int value) -> long long {
+        if(identity)
+            return value < ids.size() ? (long long) value : -1;
+        auto it = lower_bound(ids.begin(), ids.end(), value);
+        return it != ids.end() && *it == value ? (long long) (it - ids.begin()) : -1;
+    };
+
+    // edges with an endpoint that is not a vertex become auto-rings, so the normalization drops them
+    vector<pair<unsigned int, unsigned int>> edges(sources.size());
+    Parallel::forEach(edgeBlocks(edges.size()), [&](unsigned int b) {
+        size_t last = min(edges.size(), (b + 1) * EDGE_BLOCK);
+        for(size_t i = b * EDGE_BLOCK; i < last; ++i) {
+            long long src = index(sources[i]), dst = index(destinations[i]);
+            edges[i] = src < 0 || dst < 0 ? make_pair(0u, 0u) : make_pair((unsigned int) src, (unsigned int) dst);
+        }
+    }, num_threads);
+
+    normalizeEdges(edges, num_threads);
+    return edges;
+}
+
+/**
+ * @brief Compute the offsets and the adjacency of the compressed sparse row format from normalized edges,
+ * as produced by normalizeEdges.
+ * @param num_vertices number of vertices.
+ * @param edges normalized edges between indices.
+ * @param offsets num_vertices+1 positions in the adjacency array.
+ * @param adjacency adjacent vertices of each vertex, in ascending order.
+ */
+void CustomGraph::GraphBuilder::fillRows(unsigned int num_vertices, const vector<pair<unsigned int, unsigned int>> &edges,
+                                         vector<uint64_t> &offsets, vector<unsigned int> &adjacency) {
+    offsets.assign(num_vertices + 1, 0);
+    for(auto &edge : edges) {
+        offsets[edge.first + 1]++;
+        offsets[edge.second + 1]++;
+    }
+    for(unsigned int i = 0; i < num_vertices; ++i)
+        offsets[i+1] += offsets[i];
+
+    // the edges are sorted by {min, max}: the smaller neighbors of a vertex are written before the larger ones and
+    // both groups are in ascending order, so every row comes out sorted
+    vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+    adjacency.resize(offsets[num_vertices]);
+    for(auto &edge : edges) {
+        adjacency[cursor[edge.first]++] = edge.second;
+        adjacency[cursor[edge.second]++] = edge.first;
+    }
+}
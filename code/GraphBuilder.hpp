@@ -0,0 +1,81 @@
+#ifndef GRAPH_BUILDER_H_
+#define GRAPH_BUILDER_H_
+
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+
+#include <vector>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Auxiliary structure that builds a graph from arrays of edges in bulk. The endpoints are translated to dense
+ * indices, the edges are normalized as {min, max}, sorted in parallel and de-duplicated; auto-rings and edges with
+ * endpoints that are not vertices of the graph are dropped. The degrees are then counted and turned into offsets with
+ * a prefix sum, so the adjacency of every vertex is written in a single pass, already sorted, with no membership check.
+ */
+struct GraphBuilder {
+public:
+    /**
+     * @brief Normalize a list of edges as {min, max}, sort it and remove duplicates and auto-rings.
+     * @param edges edges to be normalized, they are replaced by the normalized ones.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     */
+    static void normalizeEdges(vector<pair<unsigned int, unsigned int>> &edges, unsigned int num_threads = 0);
+
+    /**
+     * @brief Build a graph in compressed sparse row format. The edge i is {sources[i], destinations[i]}.
+     * @param vertices values of the vertices, duplicates are ignored.
+     * @param sources sources of the edges.
+     * @param destinations destinations of the edges.
+     * @param csr graph that receives the vertices and the edges.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     * @return true if the graph has been built.
+     * @return false if sources and destinations have different sizes.
+     */
+    static bool buildCSR(const vector<unsigned int> &vertices, const vector<unsigned int> &sources, const vector<unsigned int> &destinations,
+                         CSRGraph &csr, unsigned int num_threads = 0);
+
+    /**
+     * @brief Build a graph. The edge i is {sources[i], destinations[i]}. With the sparse backend every adjacency set is
+     * reserved with its final degree and filled in parallel, with the dense backend the sorted edges are added one by one.
+     * @param vertices values of the vertices, duplicates are ignored.
+     * @param sources sources of the edges.
+     * @param destinations destinations of the edges.
+     * @param graph graph that receives the vertices and the edges, it is cleared before.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     * @return true if the graph has been built.
+     * @return false if sources and destinations have different sizes.
+     */
+    static bool build(const vector<unsigned int> &vertices, const vector<unsigned int> &sources, const vector<unsigned int> &destinations,
+                      Graph &graph, unsigned int num_threads = 0);
+
+    /**
+     * @brief Compute the offsets and the adjacency of the compressed sparse row format from normalized edges,
+     * as produced by normalizeEdges.
+     * @param num_vertices number of vertices.
+     * @param edges normalized edges between indices.
+     * @param offsets num_vertices+1 positions in the adjacency array.
+     * @param adjacency adjacent vertices of each vertex, in ascending order.
+     */
+    static void fillRows(unsigned int num_vertices, const vector<pair<unsigned int, unsigned int>> &edges,
+                         vector<uint64_t> &offsets, vector<unsigned int> &adjacency);
+
+private:
+    /**
+     * @brief Translate the endpoints of the edges to the indices of the sorted vertices and normalize the edges.
+     * @param ids sorted values of the vertices without duplicates.
+     * @param sources sources of the edges.
+     * @param destinations destinations of the edges.
+     * @param num_threads number of threads to be used.
+     * @return vector<pair<unsigned int, unsigned int>> normalized edges between indices.
+     */
+    static vector<pair<unsigned int, unsigned int>> indexEdges(const vector<unsigned int> &ids, const vector<unsigned int> &sources,
+                                                               const vector<unsigned int> &destinations, unsigned int num_threads);
+};
+
+}
+
+#endif
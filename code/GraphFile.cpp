@@ -0,0 +1,251 @@
+#include "GraphFile.hpp"
+#include "Tracer.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Magic string at the beginning of every graph file.
+ */
+static const char GRAPH_FILE_MAGIC[8] = {'C', 'G', 'R', 'A', 'P', 'H', 0, 0};
+
+/**
+ * @brief Value written in the header to detect files written with a different byte order.
+ */
+static const uint32_t GRAPH_FILE_BYTE_ORDER = 0x01020304;
+
+/**
+ * @brief Round a position up to the next multiple of 64.
+ * @param position position in the file.
+ * @return uint64_t aligned position.
+ */
+static uint64_t alignSection(uint64_t position) {
+    return (position + 63) & ~(uint64_t) 63;
+}
+
+/**
+ * @brief Write a graph in a binary file.
+ * @param path path of the file, it is overwritten if it exists.
+ * @param graph graph to be written.
+ * @return true if the file has been written.
+ * @return false if an error occurred.
+ */
+bool CustomGraph::GraphFile::write(const string &path, CSRGraph &graph) {
+    Tracer::Span span("GraphFile::write", "build");
+    GraphFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.flags = graph.hasIds() ? HAS_IDS : 0;
+    header.byteOrder = GRAPH_FILE_BYTE_ORDER;
+    header.numVertices = graph.size();
+    header.numAdjacency = graph.getOffsets()[graph.size()];
+    header.offsetsPosition = alignSection(sizeof(header));
+    header.adjacencyPosition = alignSection(header.offsetsPosition + (header.numVertices + 1) * sizeof(uint64_t));
+    header.idsPosition = alignSection(header.adjacencyPosition + header.numAdjacency * sizeof(unsigned int));
+    header.fileSize = graph.hasIds() ? header.idsPosition + header.numVertices * sizeof(unsigned int) : header.idsPosition;
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if(!out)
+        return false;
+
+    const char padding[64] = {0};
+    auto section = [&](uint64_t position, const void *data, size_t bytes) {
+        out.write(padding, position - out.tellp());
+        out.write(static_cast<const char*>(data), bytes);
+    };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    section(header.offsetsPosition, graph.getOffsets(), (header.numVertices + 1) * sizeof(uint64_t));
+    section(header.adjacencyPosition, graph.getAdjacency(), header.numAdjacency * sizeof(unsigned int));
+    if(graph.hasIds())
+        section(header.idsPosition, graph.getIds(), header.numVertices * sizeof(unsigned int));
+    else
+        out.write(padding, header.idsPosition - out.tellp());
+
+    return out.good();
+}
+
+/**
+ * @brief Write a graph in a binary file.
+ * @param path path of the file, it is overwritten if it exists.
+ * @param graph graph to be written.
+ * @return true if the file has been written.
+ * @return false if an error occurred.
+ */
+bool CustomGraph::GraphFile::write(const string &path, Graph &graph) {
+    CSRGraph csr(graph);
+    return write(path, csr);
+}
+
+/**
+ * @brief Construct a new Graph File object that is not associated with any file.
+ */
+CustomGraph::GraphFile::GraphFile() : mapping(nullptr), mappingSize(0) {}
+
+/**
+ * @brief Destroy the Graph File object, the file is unmapped.
+ */
+CustomGraph::GraphFile::~GraphFile() {
+    close();
+}
+
+/**
+ * @brief Map a binary graph file in memory and check its header and its arrays. A file already open is closed before.
+ * @param path path of the file.
+ * @return true if the file has been mapped and it contains a valid graph.
+ * @return false if the file cannot be opened or it is not a valid graph file of this version.
+ */
+bool CustomGraph::GraphFile::open(const string &path) {
+    Tracer::Span span("GraphFile::open", "build");
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(GraphFileHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void *address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(address == MAP_FAILED)
+        return false;
+
+    const GraphFileHeader &header = *static_cast<const GraphFileHeader*>(address);
+    if(!validHeader(header, info.st_size)) {
+        munmap(address, info.st_size);
+        return false;
+    }
+
+    const char *base = static_cast<const char*>(address);
+    const uint64_t *offsets = reinterpret_cast<const uint64_t*>(base + header.offsetsPosition);
+    const unsigned int *adjacency = reinterpret_cast<const unsigned int*>(base + header.adjacencyPosition);
+    const unsigned int *ids = header.flags & HAS_IDS ? reinterpret_cast<const unsigned int*>(base + header.idsPosition) : nullptr;
+    if(!validGraph(header.numVertices, header.numAdjacency, offsets, adjacency, ids)) {
+        munmap(address, info.st_size);
+        return false;
+    }
+
+    mapping = address;
+    mappingSize = info.st_size;
+    view = CSRGraph(header.numVertices, offsets, adjacency, ids);
+    return true;
+}
+
+/**
+ * @brief Unmap the file, the graph returned by graph() must not be used anymore.
+ */
+void CustomGraph::GraphFile::close() {
+    if(mapping != nullptr)
+        munmap(mapping, mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+    view = CSRGraph();
+}
+
+/**
+ * @brief Check if a file is currently mapped.
+ * @return true if a file is mapped.
+ * @return false otherwise.
+ */
+bool CustomGraph::GraphFile::isOpen() {
+    return mapping != nullptr;
+}
+
+/**
+ * @brief Get the graph contained in the mapped file.
+ * @return CSRGraph& view of the mapped file, it is empty if no file is open.
+ */
+CustomGraph::CSRGraph& CustomGraph::GraphFile::graph() {
+    return view;
+}
+
+/**
+ * @brief Check that a section of count items of the given size starting at position ends within end, without overflows.
+ * @param position position of the section.
+ * @param count number of items.
+ * @param item size of an item in bytes.
+ * @param end end of the space available.
+ * @return true if the section is contained.
+ * @return false otherwise.
+ */
+static bool sectionFits(uint64_t position, uint64_t count, uint64_t item, uint64_t end) {
+    return position <= end && count <= (end - position) / item;
+}
+
+/**
+ * @brief Check that the header is consistent with the size of the mapped file.
+ * @param header header to be checked.
+ * @param size size of the file in bytes.
+ * @return true if the header is valid.
+ * @return false otherwise.
+ */
+bool CustomGraph::GraphFile::validHeader(const GraphFileHeader &header, size_t size) {
+    if(memcmp(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic)) != 0)
+        return false;
+    if(header.version != VERSION || header.byteOrder != GRAPH_FILE_BYTE_ORDER || header.fileSize > size)
+        return false;
+    if(header.numVertices > 0xFFFFFFFEu || (header.flags & ~HAS_IDS) != 0)
+        return false;
+
+    // every section must be aligned, after the header, not overlapping the next one and contained in the file
+    if(header.offsetsPosition % 64 != 0 || header.adjacencyPosition % 64 != 0 || header.idsPosition % 64 != 0)
+        return false;
+    if(header.offsetsPosition < sizeof(GraphFileHeader))
+        return false;
+    if(!sectionFits(header.offsetsPosition, header.numVertices + 1, sizeof(uint64_t), header.adjacencyPosition))
+        return false;
+    if(!sectionFits(header.adjacencyPosition, header.numAdjacency, sizeof(unsigned int), header.fileSize))
+        return false;
+    if((header.flags & HAS_IDS) && (header.idsPosition < header.adjacencyPosition + header.numAdjacency * sizeof(unsigned int) ||
+                                    !sectionFits(header.idsPosition, header.numVertices, sizeof(unsigned int), header.fileSize)))
+        return false;
+    return true;
+}
+
+/**
+ * @brief Check that the arrays of a graph form a valid CSR: the offsets start at 0, do not decrease and end at
+ * numAdjacency, every row is sorted without repetitions, self-loops or indices out of range, every edge is stored in both
+ * its rows and the ids, if any, are ascending. The arrays come from outside the process (a file or another process), so
+ * they are checked before any engine reads them.
+ * @param numVertices number of vertices.
+ * @param numAdjacency number of entries of the adjacency array.
+ * @param offsets numVertices+1 offsets of the rows.
+ * @param adjacency numAdjacency adjacent vertices.
+ * @param ids numVertices ids, null if the vertices are the indices.
+ * @return true if the arrays are a valid graph.
+ * @return false otherwise.
+ */
+bool CustomGraph::GraphFile::validGraph(uint64_t numVertices, uint64_t numAdjacency, const uint64_t *offsets,
+                                        const unsigned int *adjacency, const unsigned int *ids) {
+    Tracer::Span span("GraphFile::validGraph", "build");
+    uint64_t n = numVertices;
+    if(offsets[0] != 0 || offsets[n] != numAdjacency)
+        return false;
+    for(uint64_t i = 0; i < n; ++i) {
+        if(offsets[i] > offsets[i+1] || offsets[i+1] > numAdjacency)
+            return false;
+        for(uint64_t j = offsets[i]; j < offsets[i+1]; ++j)
+            if(adjacency[j] >= n || adjacency[j] == i || (j > offsets[i] && adjacency[j] <= adjacency[j-1]))
+                return false;
+        if(ids != nullptr && i > 0 && ids[i] <= ids[i-1])
+            return false;
+    }
+    // every edge is stored in both its rows
+    for(uint64_t i = 0; i < n; ++i)
+        for(uint64_t j = offsets[i]; j < offsets[i+1]; ++j) {
+            unsigned int w = adjacency[j];
+            if(!binary_search(adjacency + offsets[w], adjacency + offsets[w+1], (unsigned int) i))
+                return false;
+        }
+    return true;
+}
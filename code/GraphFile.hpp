@@ -0,0 +1,154 @@
+#ifndef GRAPH_FILE_H_
+#define GRAPH_FILE_H_
+
+#include "CSRGraph.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Header of a binary graph file. The file is made of the header followed by three sections, each one starting on
+ * a 64-byte boundary:
+ * - offsets: numVertices+1 unsigned 64 bit integers.
+ * - adjacency: numAdjacency unsigned 32 bit integers (each edge appears twice).
+ * - ids: numVertices unsigned 32 bit integers in ascending order, present only if flags contains HAS_IDS.
+ * All the numbers are stored in the byte order of the machine that wrote the file, byteOrder allows to detect a mismatch.
+ */
+struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t byteOrder;
+    uint32_t reserved;
+    uint64_t numVertices;
+    uint64_t numAdjacency;
+    uint64_t offsetsPosition;
+    uint64_t adjacencyPosition;
+    uint64_t idsPosition;
+    uint64_t fileSize;
+};
+
+/**
+ * @brief Auxiliary structure to save a graph in a binary file and to load it back with mmap. Loading does not copy nor parse
+ * anything: the CSRGraph returned by graph() is a view of the mapped pages. The header and the arrays are checked in a
+ * single read-only pass when the file is opened, so a corrupt or crafted file is refused instead of being read out of
+ * bounds by the engines.
+ */
+struct GraphFile {
+public:
+    /**
+     * @brief Current version of the format.
+     */
+    static const uint32_t VERSION = 1;
+
+    /**
+     * @brief Flag of the header that indicates the presence of the ids section.
+     */
+    static const uint32_t HAS_IDS = 1;
+
+    /**
+     * @brief Write a graph in a binary file.
+     * @param path path of the file, it is overwritten if it exists.
+     * @param graph graph to be written.
+     * @return true if the file has been written.
+     * @return false if an error occurred.
+     */
+    static bool write(const string &path, CSRGraph &graph);
+
+    /**
+     * @brief Write a graph in a binary file.
+     * @param path path of the file, it is overwritten if it exists.
+     * @param graph graph to be written.
+     * @return true if the file has been written.
+     * @return false if an error occurred.
+     */
+    static bool write(const string &path, Graph &graph);
+
+    /**
+     * @brief Construct a new Graph File object that is not associated with any file.
+     */
+    GraphFile();
+
+    /**
+     * @brief Destroy the Graph File object, the file is unmapped.
+     */
+    ~GraphFile();
+
+    GraphFile(const GraphFile &other) = delete;
+    GraphFile& operator=(const GraphFile &other) = delete;
+
+    /**
+     * @brief Map a binary graph file in memory and check its header and its arrays. A file already open is closed before.
+     * @param path path of the file.
+     * @return true if the file has been mapped and it contains a valid graph.
+     * @return false if the file cannot be opened or it is not a valid graph file of this version.
+     */
+    bool open(const string &path);
+
+    /**
+     * @brief Unmap the file, the graph returned by graph() must not be used anymore.
+     */
+    void close();
+
+    /**
+     * @brief Check if a file is currently mapped.
+     * @return true if a file is mapped.
+     * @return false otherwise.
+     */
+    bool isOpen();
+
+    /**
+     * @brief Get the graph contained in the mapped file.
+     * @return CSRGraph& view of the mapped file, it is empty if no file is open.
+     */
+    CSRGraph& graph();
+
+    /**
+     * @brief Check that the arrays of a graph form a valid CSR: the offsets start at 0, do not decrease and end at
+     * numAdjacency, every row is sorted without repetitions, self-loops or indices out of range, every edge is stored in
+     * both its rows and the ids, if any, are ascending. The arrays come from outside the process (a file or another
+     * process), so they are checked before any engine reads them.
+     * @param numVertices number of vertices.
+     * @param numAdjacency number of entries of the adjacency array.
+     * @param offsets numVertices+1 offsets of the rows.
+     * @param adjacency numAdjacency adjacent vertices.
+     * @param ids numVertices ids, null if the vertices are the indices.
+     * @return true if the arrays are a valid graph.
+     * @return false otherwise.
+     */
+    static bool validGraph(uint64_t numVertices, uint64_t numAdjacency, const uint64_t *offsets, const unsigned int *adjacency,
+                           const unsigned int *ids);
+
+private:
+    /**
+     * @brief Check that the header is consistent with the size of the mapped file.
+     * @param header header to be checked.
+     * @param size size of the file in bytes.
+     * @return true if the header is valid.
+     * @return false otherwise.
+     */
+    static bool validHeader(const GraphFileHeader &header, size_t size);
+
+    /**
+     * @brief Address of the mapped file.
+     */
+    void *mapping;
+
+    /**
+     * @brief Size of the mapped file in bytes.
+     */
+    size_t mappingSize;
+
+    /**
+     * @brief View of the graph contained in the mapped file.
+     */
+    CSRGraph view;
+};
+
+}
+
+#endif
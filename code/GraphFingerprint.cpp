@@ -0,0 +1,209 @@
+#include "GraphFingerprint.hpp"
+#include "Tracer.hpp"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Finalizer of murmur3 on 32 bits.
+ * @param h value to be mixed.
+ * @return uint32_t mixed value.
+ */
+static inline uint32_t mix32(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * @brief Hash of an edge, two independent 32 bit mixes of its endpoints.
+ * @param first smaller endpoint.
+ * @param second larger endpoint.
+ * @return uint64_t hash of the edge.
+ */
+static inline uint64_t edgeHash(uint32_t first, uint32_t second) {
+    uint32_t low = mix32((first * 0x9e3779b1u) ^ second);
+    uint32_t high = mix32((second * 0x27d4eb2fu + first) ^ 0x165667b1u);
+    return ((uint64_t) high << 32) | low;
+}
+
+/**
+ * @brief Hash of a vertex, kept apart from the hashes of the edges.
+ * @param vertex value of the vertex.
+ * @return uint64_t hash of the vertex.
+ */
+static inline uint64_t vertexHash(uint32_t vertex) {
+    return edgeHash(vertex, vertex ^ 0x5bd1e995u);
+}
+
+#ifdef __SSE2__
+/**
+ * @brief Product of the 32 bit lanes modulo 2^32, SSE2 has only the product of the even lanes.
+ * @param a first factors.
+ * @param b second factors.
+ * @return __m128i low 32 bits of the products.
+ */
+static inline __m128i mul32(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/**
+ * @brief mix32 on four lanes.
+ * @param h values to be mixed.
+ * @return __m128i mixed values.
+ */
+static inline __m128i mix32x4(__m128i h) {
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+    h = mul32(h, _mm_set1_epi32((int) 0x85ebca6bu));
+    h = _mm_xor_si128(h, _mm_srli_epi32(h, 13));
+    h = mul32(h, _mm_set1_epi32((int) 0xc2b2ae35u));
+    return _mm_xor_si128(h, _mm_srli_epi32(h, 16));
+}
+
+/**
+ * @brief Add the hashes of the edges {value, first[j]} with first[j] > value of a row without ids, four at a time; the
+ * rest of the row is left to the scalar loop.
+ * @param value value (and index) of the vertex of the row.
+ * @param first adjacent vertices of the row.
+ * @param degree number of adjacent vertices.
+ * @param edge_sum sum of the hashes of the edges.
+ * @param num_edges number of edges.
+ * @return size_t number of adjacent vertices processed.
+ */
+static size_t rowHashes(uint32_t value, const unsigned int *first, size_t degree, uint64_t &edge_sum, uint64_t &num_edges) {
+    const __m128i sign = _mm_set1_epi32((int) 0x80000000u);
+    const __m128i low_seed = _mm_set1_epi32((int) (value * 0x9e3779b1u));
+    const __m128i high_factor = _mm_set1_epi32((int) 0x27d4eb2fu);
+    const __m128i high_seed = _mm_set1_epi32((int) value);
+    const __m128i high_xor = _mm_set1_epi32((int) 0x165667b1u);
+    const __m128i bound = _mm_xor_si128(_mm_set1_epi32((int) value), sign);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i low_sum = zero, high_sum = zero, count = zero;
+
+    size_t j = 0;
+    for(; j + 4 <= degree; j += 4) {
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + j));
+        // unsigned w > value with a signed comparison
+        __m128i mask = _mm_cmpgt_epi32(_mm_xor_si128(w, sign), bound);
+        __m128i low = _mm_and_si128(mix32x4(_mm_xor_si128(low_seed, w)), mask);
+        __m128i high = _mm_and_si128(mix32x4(_mm_xor_si128(_mm_add_epi32(mul32(w, high_factor), high_seed), high_xor)), mask);
+        low_sum = _mm_add_epi64(low_sum, _mm_add_epi64(_mm_unpacklo_epi32(low, zero), _mm_unpackhi_epi32(low, zero)));
+        high_sum = _mm_add_epi64(high_sum, _mm_add_epi64(_mm_unpacklo_epi32(high, zero), _mm_unpackhi_epi32(high, zero)));
+        count = _mm_sub_epi32(count, mask);
+    }
+
+    uint64_t lows[2], highs[2];
+    uint32_t counts[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lows), low_sum);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(highs), high_sum);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(counts), count);
+    edge_sum += lows[0] + lows[1] + ((highs[0] + highs[1]) << 32);
+    num_edges += (uint64_t) counts[0] + counts[1] + counts[2] + counts[3];
+    return j;
+}
+#endif
+
+/**
+ * @brief Add a vertex to the fingerprint.
+ * @param vertex value of the vertex.
+ */
+void GraphFingerprint::addVertex(unsigned int vertex) {
+    vertices++;
+    vertexSum += vertexHash(vertex);
+}
+
+/**
+ * @brief Add an edge to the fingerprint, each edge must be added once.
+ * @param first value of an endpoint.
+ * @param second value of the other endpoint.
+ */
+void GraphFingerprint::addEdge(unsigned int first, unsigned int second) {
+    edges++;
+    edgeSum += first < second ? edgeHash(first, second) : edgeHash(second, first);
+}
+
+/**
+ * @brief Compute the fingerprint of a graph in one pass over its vertices and edges.
+ * @param graph graph to be hashed.
+ * @return GraphFingerprint fingerprint of the graph.
+ */
+GraphFingerprint GraphFingerprint::of(CustomGraph::Graph &graph) {
+    Tracer::Span span("GraphFingerprint::of", "build");
+    GraphFingerprint fingerprint;
+    for(auto v : graph.getVerticesKeys()) {
+        fingerprint.addVertex(v);
+        graph.forEachAdjacent(v, [&](unsigned int w) {
+            if(v < w)
+                fingerprint.addEdge(v, w);
+        });
+    }
+    return fingerprint;
+}
+
+/**
+ * @brief Compute the fingerprint of a graph in one pass over its arrays. The ids are sorted, so the order of the indices
+ * is the order of the values and each edge is taken in the row of its smaller endpoint; the mask replaces the branch.
+ * Without ids the rows are hashed four edges at a time with SSE2, which every x86-64 target has.
+ * @param graph graph to be hashed.
+ * @return GraphFingerprint fingerprint of the graph.
+ */
+GraphFingerprint GraphFingerprint::of(CustomGraph::CSRGraph &graph) {
+    Tracer::Span span("GraphFingerprint::of", "build");
+    GraphFingerprint fingerprint;
+    unsigned int n = graph.size();
+    if(n == 0)
+        return fingerprint;
+
+    const uint64_t *offsets = graph.getOffsets();
+    const unsigned int *adjacency = graph.getAdjacency();
+    const unsigned int *ids = graph.getIds();
+    uint64_t vertex_sum = 0, edge_sum = 0, num_edges = 0;
+
+    for(unsigned int i = 0; i < n; ++i) {
+        const unsigned int *first = adjacency + offsets[i], *last = adjacency + offsets[i+1];
+        size_t degree = last - first;
+        uint32_t value = ids == nullptr ? i : ids[i];
+        vertex_sum += vertexHash(value);
+
+        if(ids == nullptr) {
+            size_t j = 0;
+#ifdef __SSE2__
+            j = rowHashes(value, first, degree, edge_sum, num_edges);
+#endif
+            for(; j < degree; ++j) {
+                uint64_t mask = -(uint64_t) (first[j] > i);
+                edge_sum += edgeHash(value, first[j]) & mask;
+                num_edges -= mask;
+            }
+        } else
+            for(size_t j = 0; j < degree; ++j) {
+                uint64_t mask = -(uint64_t) (first[j] > i);
+                edge_sum += edgeHash(value, ids[first[j]]) & mask;
+                num_edges -= mask;
+            }
+    }
+
+    fingerprint.vertices = n;
+    fingerprint.edges = num_edges;
+    fingerprint.vertexSum = vertex_sum;
+    fingerprint.edgeSum = edge_sum;
+    return fingerprint;
+}
+
+/**
+ * @brief Fold the fingerprint in a single word, e.g. for a hash table.
+ * @return uint64_t hash of the four words.
+ */
+uint64_t GraphFingerprint::hash() const {
+    uint64_t h = edgeSum ^ (vertexSum * 0x9e3779b97f4a7c15ULL);
+    h ^= (vertices << 32 | (edges & 0xFFFFFFFFu)) + 0xbf58476d1ce4e5b9ULL + (h << 6) + (h >> 2);
+    h ^= h >> 31;
+    h *= 0x94d049bb133111ebULL;
+    return h ^ (h >> 29);
+}
@@ -0,0 +1,69 @@
+#ifndef GRAPH_FINGERPRINT_H_
+#define GRAPH_FINGERPRINT_H_
+
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief Fingerprint of a graph that does not depend on the order in which its vertices and edges are visited: each vertex
+ * and each edge {u, v} (u < v) is hashed on its own and the hashes are added, so a Graph built in any insertion order,
+ * its CSRGraph and a stream of its edges all give the same fingerprint. Two graphs with the same vertex values and edges
+ * have the same fingerprint, a different vertex or edge changes it (with the probability of a 64 bit collision per sum).
+ * The hash of an edge is made of two 32 bit mixes with no 64 bit multiplication: the rows of a CSRGraph without ids are
+ * hashed four edges at a time with SSE2 intrinsics (the baseline of x86-64), and the rest of each row, the graphs with
+ * ids and the targets without SSE2 take a branch-free scalar loop that gives the same sums.
+ */
+struct GraphFingerprint {
+public:
+    uint64_t vertices = 0;
+    uint64_t edges = 0;
+    uint64_t vertexSum = 0;
+    uint64_t edgeSum = 0;
+
+    /**
+     * @brief Add a vertex to the fingerprint.
+     * @param vertex value of the vertex.
+     */
+    void addVertex(unsigned int vertex);
+
+    /**
+     * @brief Add an edge to the fingerprint, each edge must be added once.
+     * @param first value of an endpoint.
+     * @param second value of the other endpoint.
+     */
+    void addEdge(unsigned int first, unsigned int second);
+
+    /**
+     * @brief Compute the fingerprint of a graph in one pass over its vertices and edges.
+     * @param graph graph to be hashed.
+     * @return GraphFingerprint fingerprint of the graph.
+     */
+    static GraphFingerprint of(CustomGraph::Graph &graph);
+
+    /**
+     * @brief Compute the fingerprint of a graph in one pass over its arrays.
+     * @param graph graph to be hashed.
+     * @return GraphFingerprint fingerprint of the graph.
+     */
+    static GraphFingerprint of(CustomGraph::CSRGraph &graph);
+
+    /**
+     * @brief Fold the fingerprint in a single word, e.g. for a hash table.
+     * @return uint64_t hash of the four words.
+     */
+    uint64_t hash() const;
+
+    bool operator==(const GraphFingerprint &other) const {
+        return vertices == other.vertices && edges == other.edges && vertexSum == other.vertexSum && edgeSum == other.edgeSum;
+    }
+
+    bool operator!=(const GraphFingerprint &other) const {
+        return !(*this == other);
+    }
+};
+
+#endif
@@ -0,0 +1,389 @@
+#include "GraphLoader.hpp"
+#include "GraphBuilder.hpp"
+#include "Parallel.hpp"
+#include "Tracer.hpp"
+
+#include <cstring>
+#include <cctype>
+#include <cstdint>
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+/**
+ * @brief Text file mapped in memory, it is unmapped when the object is destroyed.
+ */
+struct MappedText {
+    const char *begin = nullptr, *end = nullptr;
+    void *mapping = nullptr;
+    size_t size = 0;
+
+    bool open(const string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            return false;
+
+        struct stat info;
+        if(fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        size = info.st_size;
+        if(size > 0) {
+            mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapping == MAP_FAILED) {
+                mapping = nullptr;
+                ::close(fd);
+                return false;
+            }
+            madvise(mapping, size, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+
+        begin = static_cast<const char*>(mapping);
+        end = begin + size;
+        return true;
+    }
+
+    ~MappedText() {
+        if(mapping != nullptr)
+            munmap(mapping, size);
+    }
+};
+
+typedef vector<pair<unsigned int, unsigned int>> EdgeChunk;
+
+}
+
+/**
+ * @brief Skip spaces, tabs and carriage returns, the scanner stops on the end of the line.
+ * @param p current position, it is moved after the blanks.
+ * @param end end of the text.
+ */
+static inline void skipBlanks(const char *&p, const char *end) {
+    while(p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+}
+
+/**
+ * @brief Read a non-negative integer.
+ * @param p current position, it is moved after the integer.
+ * @param end end of the text.
+ * @param value integer that has been read.
+ * @return true if an integer that fits in 32 bits has been read.
+ * @return false if the next token is not an integer.
+ */
+static inline bool readUnsigned(const char *&p, const char *end, uint64_t &value) {
+    skipBlanks(p, end);
+    if(p == end || *p < '0' || *p > '9')
+        return false;
+
+    uint64_t v = 0;
+    while(p < end && *p >= '0' && *p <= '9' && v <= 0xFFFFFFFFu)
+        v = v * 10 + (*p++ - '0');
+    value = v;
+    return v <= 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Skip the next token, whatever it contains.
+ * @param p current position, it is moved after the token.
+ * @param end end of the text.
+ */
+static inline void skipToken(const char *&p, const char *end) {
+    skipBlanks(p, end);
+    while(p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n')
+        ++p;
+}
+
+/**
+ * @brief Check if the rest of the line is empty.
+ * @param p current position, it is moved after the blanks.
+ * @param end end of the text.
+ * @return true if there are no more tokens in the line.
+ */
+static inline bool endOfLine(const char *&p, const char *end) {
+    skipBlanks(p, end);
+    return p == end || *p == '\n';
+}
+
+/**
+ * @brief Get the beginning of the next line.
+ * @param p position inside the current line.
+ * @param end end of the text.
+ * @return const char* first character of the next line, end if there are no more lines.
+ */
+static inline const char* nextLine(const char *p, const char *end) {
+    const char *newline = static_cast<const char*>(memchr(p, '\n', end - p));
+    return newline == nullptr ? end : newline + 1;
+}
+
+/**
+ * @brief Split a text in chunks that begin at the start of a line.
+ * @param begin beginning of the text.
+ * @param end end of the text.
+ * @param num_chunks maximum number of chunks.
+ * @return vector<const char*> boundaries of the chunks, chunk i is [bounds[i], bounds[i+1]).
+ */
+static vector<const char*> splitLines(const char *begin, const char *end, unsigned int num_chunks) {
+    vector<const char*> bounds(1, begin);
+    size_t size = end - begin;
+
+    for(unsigned int i = 1; i < num_chunks; ++i) {
+        const char *p = begin + size * i / num_chunks;
+        if(p <= bounds.back())
+            continue;
+        p = nextLine(p - 1, end);
+        if(p > bounds.back() && p < end)
+            bounds.push_back(p);
+    }
+    bounds.push_back(end);
+    return bounds;
+}
+
+/**
+ * @brief Merge the edges parsed by the chunks, remove the duplicates and fill the graph.
+ * @param chunks edges parsed by each chunk, they are released.
+ * @param graph graph that will receive the vertices and the edges, it is cleared before.
+ * @param num_vertices number of vertices 0, ..., n-1 of the graph, 0 means that the vertices are the endpoints of the edges.
+ * @param num_threads number of threads to be used.
+ */
+static void buildGraph(vector<EdgeChunk> &chunks, CustomGraph::Graph &graph, unsigned int num_vertices, unsigned int num_threads) {
+    vector<size_t> starts(chunks.size() + 1, 0);
+    for(unsigned int i = 0; i < chunks.size(); ++i)
+        starts[i+1] = starts[i] + chunks[i].size();
+
+    // copy the edges of the chunks in a single array
+    EdgeChunk edges(starts.back());
+    Parallel::forEach(chunks.size(), [&](unsigned int i) {
+        copy(chunks[i].begin(), chunks[i].end(), edges.begin() + starts[i]);
+        EdgeChunk().swap(chunks[i]);
+    }, num_threads);
+
+    graph.clear();
+    if(num_vertices == 0) {
+        vector<unsigned int> endpoints;
+        endpoints.reserve(2 * edges.size());
+        for(auto &edge : edges) {
+            endpoints.push_back(edge.first);
+            endpoints.push_back(edge.second);
+        }
+        Parallel::sort(endpoints, num_threads);
+        endpoints.erase(unique(endpoints.begin(), endpoints.end()), endpoints.end());
+        for(auto v : endpoints)
+            graph.addVertex(v);
+    } else
+        for(unsigned int v = 0; v < num_vertices; ++v)
+            graph.addVertex(v);
+
+    CustomGraph::GraphBuilder::normalizeEdges(edges, num_threads);
+    graph.addEdgesBulk(edges);
+}
+
+/**
+ * @brief Load a list of edges, one for each line, written as two non-negative integers separated by blanks. Other
+ * tokens on the same line (e.g. weights) are ignored, lines that start with '#' or '%' are comments.
+ * The vertices of the graph are the values that appear in the edges.
+ * @param path path of the file.
+ * @param graph graph that will receive the vertices and the edges, it is cleared before.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ * @return true if the file has been loaded.
+ * @return false if the file cannot be read or it is malformed.
+ */
+bool CustomGraph::GraphLoader::loadEdgeList(const string &path, Graph &graph, unsigned int num_threads) {
+    Tracer::Span span("GraphLoader::loadEdgeList", "build");
+    graph.clear();
+    MappedText text;
+    if(!text.open(path))
+        return false;
+
+    num_threads = Parallel::numThreads(num_threads);
+    vector<const char*> bounds = splitLines(text.begin, text.end, 4 * num_threads);
+    vector<EdgeChunk> chunks(bounds.size() - 1);
+    atomic<bool> malformed(false);
+
+    Parallel::forEach(chunks.size(), [&](unsigned int i) {
+        const char *end = bounds[i+1];
+        for(const char *p = bounds[i]; p < end; p = nextLine(p, end)) {
+            if(endOfLine(p, end) || *p == '#' || *p == '%')
+                continue;
+
+            uint64_t src, dst;
+            if(!readUnsigned(p, end, src) || !readUnsigned(p, end, dst)) {
+                malformed = true;
+                return;
+            }
+            chunks[i].push_back(make_pair(src, dst));
+        }
+    }, num_threads);
+
+    if(malformed)
+        return false;
+
+    buildGraph(chunks, graph, 0, num_threads);
+    return true;
+}
+
+/**
+ * @brief Load the sparsity pattern of a square matrix in Matrix Market coordinate format. Each entry (i, j) becomes the edge
+ * {i-1, j-1}, the values of the entries are ignored and non-symmetric patterns are symmetrized.
+ * The vertices of the graph are 0, ..., n-1 where n is the number of rows.
+ * @param path path of the file.
+ * @param graph graph that will receive the vertices and the edges, it is cleared before.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ * @return true if the file has been loaded.
+ * @return false if the file cannot be read or it is malformed, also when the entries are not as many as the header says.
+ */
+bool CustomGraph::GraphLoader::loadMatrixMarket(const string &path, Graph &graph, unsigned int num_threads) {
+    Tracer::Span span("GraphLoader::loadMatrixMarket", "build");
+    graph.clear();
+    MappedText text;
+    if(!text.open(path))
+        return false;
+
+    // banner: %%MatrixMarket matrix coordinate <field> <symmetry>
+    const char *p = text.begin;
+    const char *banner_end = nextLine(p, text.end);
+    string banner(p, banner_end);
+    transform(banner.begin(), banner.end(), banner.begin(), ::tolower);
+    if(banner.rfind("%%matrixmarket", 0) != 0 || banner.find("coordinate") == string::npos)
+        return false;
+
+    // skip the comments and read the size line
+    p = banner_end;
+    while(p < text.end && (endOfLine(p, text.end) || *p == '%'))
+        p = nextLine(p, text.end);
+
+    uint64_t rows, columns, entries;
+    if(!readUnsigned(p, text.end, rows) || !readUnsigned(p, text.end, columns) || !readUnsigned(p, text.end, entries))
+        return false;
+    if(rows != columns)
+        return false;
+    p = nextLine(p, text.end);
+
+    num_threads = Parallel::numThreads(num_threads);
+    vector<const char*> bounds = splitLines(p, text.end, 4 * num_threads);
+    vector<EdgeChunk> chunks(bounds.size() - 1);
+    atomic<bool> malformed(false);
+
+    Parallel::forEach(chunks.size(), [&](unsigned int i) {
+        const char *end = bounds[i+1];
+        // an entry takes at least 4 bytes ("i j\n"), so a wrong count in the header cannot ask for more than the file holds
+        chunks[i].reserve(min<uint64_t>(entries / chunks.size(), (end - bounds[i]) / 4) + 1);
+        for(const char *q = bounds[i]; q < end; q = nextLine(q, end)) {
+            if(endOfLine(q, end) || *q == '%')
+                continue;
+
+            uint64_t row, column;
+            if(!readUnsigned(q, end, row) || !readUnsigned(q, end, column) || row == 0 || column == 0 || row > rows || column > rows) {
+                malformed = true;
+                return;
+            }
+            chunks[i].push_back(make_pair(row - 1, column - 1));
+        }
+    }, num_threads);
+
+    if(malformed)
+        return false;
+
+    uint64_t parsed = 0;
+    for(auto &chunk : chunks)
+        parsed += chunk.size();
+    if(parsed != entries)
+        return false;
+
+    buildGraph(chunks, graph, rows, num_threads);
+    return true;
+}
+
+/**
+ * @brief Load a graph in the METIS format: a header "n m [fmt [ncon]]" followed by one line for each vertex that lists
+ * its adjacent vertices numbered from 1. Vertex sizes, vertex weights and edge weights declared by fmt are skipped.
+ * The vertices of the graph are 0, ..., n-1.
+ * @param path path of the file.
+ * @param graph graph that will receive the vertices and the edges, it is cleared before.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ * @return true if the file has been loaded.
+ * @return false if the file cannot be read or it is malformed.
+ */
+bool CustomGraph::GraphLoader::loadMETIS(const string &path, Graph &graph, unsigned int num_threads) {
+    Tracer::Span span("GraphLoader::loadMETIS", "build");
+    graph.clear();
+    MappedText text;
+    if(!text.open(path))
+        return false;
+
+    const char *p = text.begin;
+    while(p < text.end && (endOfLine(p, text.end) || *p == '%'))
+        p = nextLine(p, text.end);
+
+    uint64_t n, m, fmt = 0, ncon = 1;
+    if(!readUnsigned(p, text.end, n) || !readUnsigned(p, text.end, m))
+        return false;
+    if(!endOfLine(p, text.end)) {
+        readUnsigned(p, text.end, fmt);
+        if(!endOfLine(p, text.end))
+            readUnsigned(p, text.end, ncon);
+    }
+    bool edge_weights = fmt % 10 == 1, vertex_weights = (fmt / 10) % 10 == 1, vertex_sizes = (fmt / 100) % 10 == 1;
+    p = nextLine(p, text.end);
+
+    num_threads = Parallel::numThreads(num_threads);
+    vector<const char*> bounds = splitLines(p, text.end, 4 * num_threads);
+    unsigned int num_chunks = bounds.size() - 1;
+
+    // the vertex of a line is given by the number of lines before it, count them for each chunk
+    vector<uint64_t> first_vertex(num_chunks + 1, 0);
+    Parallel::forEach(num_chunks, [&](unsigned int i) {
+        for(const char *q = bounds[i]; q < bounds[i+1]; q = nextLine(q, bounds[i+1]))
+            if(*q != '%')
+                first_vertex[i+1]++;
+    }, num_threads);
+    for(unsigned int i = 0; i < num_chunks; ++i)
+        first_vertex[i+1] += first_vertex[i];
+
+    if(first_vertex[num_chunks] != n)
+        return false;
+
+    vector<EdgeChunk> chunks(num_chunks);
+    atomic<bool> malformed(false);
+
+    Parallel::forEach(num_chunks, [&](unsigned int i) {
+        const char *end = bounds[i+1];
+        uint64_t vertex = first_vertex[i];
+
+        for(const char *q = bounds[i]; q < end; q = nextLine(q, end)) {
+            if(*q == '%')
+                continue;
+
+            if(vertex_sizes)
+                skipToken(q, end);
+            if(vertex_weights)
+                for(unsigned int c = 0; c < ncon; ++c)
+                    skipToken(q, end);
+
+            while(!endOfLine(q, end)) {
+                uint64_t adjacent;
+                if(!readUnsigned(q, end, adjacent) || adjacent == 0 || adjacent > n) {
+                    malformed = true;
+                    return;
+                }
+                chunks[i].push_back(make_pair(vertex, adjacent - 1));
+                if(edge_weights)
+                    skipToken(q, end);
+            }
+            vertex++;
+        }
+    }, num_threads);
+
+    if(malformed)
+        return false;
+
+    buildGraph(chunks, graph, n, num_threads);
+    return true;
+}
@@ -0,0 +1,61 @@
+#ifndef GRAPH_LOADER_H_
+#define GRAPH_LOADER_H_
+
+#include "Graph.hpp"
+
+#include <string>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Auxiliary structure that loads a graph from the most common text formats. The file is mapped in memory and split
+ * in chunks that end on a line boundary, the chunks are parsed in parallel with a scanner that reads the integers directly
+ * from the mapped bytes. The edges of all the chunks are then normalized, sorted in parallel and de-duplicated, so the graph
+ * can be filled with Graph::addEdgesBulk instead of checking every edge with addEdge.
+ * In every format auto-rings are dropped and duplicated edges (also in opposite directions) are inserted only once.
+ * The functions return false, leaving the graph empty, if the file cannot be read or it is malformed.
+ */
+struct GraphLoader {
+public:
+    /**
+     * @brief Load a list of edges, one for each line, written as two non-negative integers separated by blanks. Other
+     * tokens on the same line (e.g. weights) are ignored, lines that start with '#' or '%' are comments.
+     * The vertices of the graph are the values that appear in the edges.
+     * @param path path of the file.
+     * @param graph graph that will receive the vertices and the edges, it is cleared before.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     * @return true if the file has been loaded.
+     * @return false if the file cannot be read or it is malformed.
+     */
+    static bool loadEdgeList(const string &path, Graph &graph, unsigned int num_threads = 0);
+
+    /**
+     * @brief Load the sparsity pattern of a square matrix in Matrix Market coordinate format. Each entry (i, j) becomes the edge
+     * {i-1, j-1}, the values of the entries are ignored and non-symmetric patterns are symmetrized.
+     * The vertices of the graph are 0, ..., n-1 where n is the number of rows.
+     * @param path path of the file.
+     * @param graph graph that will receive the vertices and the edges, it is cleared before.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     * @return true if the file has been loaded.
+     * @return false if the file cannot be read or it is malformed, also when the entries are not as many as the header says.
+     */
+    static bool loadMatrixMarket(const string &path, Graph &graph, unsigned int num_threads = 0);
+
+    /**
+     * @brief Load a graph in the METIS format: a header "n m [fmt [ncon]]" followed by one line for each vertex that lists
+     * its adjacent vertices numbered from 1. Vertex sizes, vertex weights and edge weights declared by fmt are skipped.
+     * The vertices of the graph are 0, ..., n-1.
+     * @param path path of the file.
+     * @param graph graph that will receive the vertices and the edges, it is cleared before.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     * @return true if the file has been loaded.
+     * @return false if the file cannot be read or it is malformed.
+     */
+    static bool loadMETIS(const string &path, Graph &graph, unsigned int num_threads = 0);
+};
+
+}
+
+#endif
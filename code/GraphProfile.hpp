@@ -0,0 +1,26 @@
+#ifndef GRAPH_PROFILE_H_
+#define GRAPH_PROFILE_H_
+
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief Cheap statistics of a graph, computed in one linear pass by OrderingEngines::profile. Graph::order uses them to
+ * choose the ordering engine and the storage backend.
+ */
+struct GraphProfile {
+    // number of vertices and of edges
+    unsigned int n = 0;
+    uint64_t m = 0;
+    // m over the n(n-1)/2 possible edges, 0 when n < 2
+    double density = 0;
+    // highest and mean degree, the skew is their ratio (1 for regular graphs, 0 without edges)
+    unsigned int max_degree = 0;
+    double mean_degree = 0;
+    double degree_skew = 0;
+    // number of connected components
+    unsigned int components = 0;
+};
+
+#endif
@@ -0,0 +1,206 @@
+#include "JobEngine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+/**
+ * @brief State of a queued job, shared by submit and the task of the pool.
+ */
+struct JobEngine::Job {
+    CustomGraph::CSRGraph graph;
+    Engine engine;
+    Options options;
+    uint64_t id;
+    chrono::steady_clock::time_point queued;
+    promise<Result> result;
+};
+
+/**
+ * @brief Construct a new JobEngine object that runs its jobs on a pool.
+ * @param pool pool of the workers, it must outlive the JobEngine.
+ */
+JobEngine::JobEngine(ThreadPool &pool) : pool(pool), numSubmitted(0), numCompleted(0) {}
+
+/**
+ * @brief Destroy the JobEngine object after its jobs have ended.
+ */
+JobEngine::~JobEngine() {
+    wait();
+}
+
+/**
+ * @brief Queue a job.
+ * @param graph graph to be ordered, owned by the job (move it in to avoid a copy).
+ * @param engine algorithm to be run.
+ * @param options options of the job.
+ * @return future<Result> result of the job.
+ */
+future<JobEngine::Result> JobEngine::submit(CustomGraph::CSRGraph graph, Engine engine, Options options) {
+    unsigned int client = options.client;
+    shared_ptr<Job> job(new Job{move(graph), engine, move(options), numSubmitted++, chrono::steady_clock::now(), {}});
+    future<Result> future = job->result.get_future();
+
+    pool.submit([this, job]() {
+        auto start = chrono::steady_clock::now();
+        Result result;
+        exception_ptr error;
+        try {
+            run(*job, result);
+        } catch(...) {
+            error = current_exception();
+        }
+        auto end = chrono::steady_clock::now();
+
+        result.stats.id = job->id;
+        result.stats.client = job->options.client;
+        result.stats.engine = job->engine;
+        result.stats.worker = ThreadPool::currentWorker();
+        result.stats.queued_nanoseconds = chrono::duration_cast<chrono::nanoseconds>(start - job->queued).count();
+        result.stats.run_nanoseconds = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+        if(job->options.control != nullptr)
+            result.stats.status = job->options.control->status();
+
+        if(error)
+            job->result.set_exception(error);
+        else
+            job->result.set_value(move(result));
+
+        // the last access to this, wait can return as soon as the counter is seen
+        lock_guard<mutex> lock(doneLock);
+        numCompleted++;
+        done.notify_all();
+    }, client);
+    return future;
+}
+
+/**
+ * @brief Same as submit, with the default options.
+ * @param graph graph to be ordered, owned by the job.
+ * @param engine algorithm to be run.
+ * @return future<Result> result of the job.
+ */
+future<JobEngine::Result> JobEngine::submit(CustomGraph::CSRGraph graph, Engine engine) {
+    return submit(move(graph), engine, Options());
+}
+
+/**
+ * @brief Wait until all the jobs submitted so far have ended.
+ */
+void JobEngine::wait() {
+    uint64_t target = numSubmitted.load();
+    unique_lock<mutex> lock(doneLock);
+    done.wait(lock, [&]() { return numCompleted.load() >= target; });
+}
+
+/**
+ * @brief Get the number of jobs submitted.
+ * @return uint64_t number of calls of submit.
+ */
+uint64_t JobEngine::submitted() {
+    return numSubmitted.load();
+}
+
+/**
+ * @brief Get the number of jobs ended.
+ * @return uint64_t number of jobs whose result is ready.
+ */
+uint64_t JobEngine::completed() {
+    return numCompleted.load();
+}
+
+/**
+ * @brief Run a job in the calling worker, through the cache of its options if there is one.
+ * @param job job to be run.
+ * @param result it receives the result, the statistics are filled by the caller.
+ */
+void JobEngine::run(Job &job, Result &result) {
+    OrderingCache *cache = job.options.cache;
+    if(cache == nullptr) {
+        compute(job, result);
+        return;
+    }
+
+    if(job.engine == Engine::FillIn && job.options.ordering.empty())
+        job.options.ordering = job.graph.getVerticesKeys();
+    OrderingCacheKey key;
+    key.graph = GraphFingerprint::of(job.graph);
+    key.engine = (uint32_t) job.engine;
+    key.options = job.engine == Engine::FillIn ? OrderingCache::orderingHash(job.options.ordering) : 0;
+
+    OrderingCacheEntry entry;
+    if(cache->lookup(key, entry)) {
+        result.ordering = move(entry.ordering);
+        result.fill = move(entry.fill);
+        result.choice.chordal = (entry.flags & OrderingCacheEntry::CHORDAL) != 0;
+        result.choice.method = (entry.flags & OrderingCacheEntry::LEX_M) != 0 ? CustomGraph::OrderingChoice::Method::LexM
+                                                                               : CustomGraph::OrderingChoice::Method::LexP;
+        result.stats.cached = true;
+        return;
+    }
+
+    compute(job, result);
+
+    // a run stopped by its RunControl is not the result of the engine
+    RunControl *control = job.options.control;
+    if(control != nullptr && control->status() != RunControl::Status::Completed)
+        return;
+    entry.ordering = result.ordering;
+    entry.fill = result.fill;
+    entry.flags = (result.choice.chordal ? OrderingCacheEntry::CHORDAL : 0) |
+                  (result.choice.method == CustomGraph::OrderingChoice::Method::LexM ? OrderingCacheEntry::LEX_M : 0);
+    cache->store(key, entry);
+}
+
+/**
+ * @brief Compute the result of a job.
+ * @param job job to be run.
+ * @param result it receives the result.
+ */
+void JobEngine::compute(Job &job, Result &result) {
+    CustomGraph::CSRGraph &csr = job.graph;
+    RunControl *control = job.options.control;
+
+    switch(job.engine) {
+        case Engine::LexP:
+            result.ordering = csr.lex_p(result.stats.counters);
+            break;
+
+        case Engine::LexM:
+            if(control != nullptr)
+                result.ordering = csr.lex_m(*control, &result.fill);
+            else
+                result.ordering = csr.lex_m(result.stats.counters, &result.fill);
+            break;
+
+        case Engine::FillIn: {
+            CustomGraph::Graph g(job.options.storage);
+            csr.toGraph(g);
+            result.ordering = job.options.ordering;
+            if(result.ordering.empty())
+                result.ordering = csr.getVerticesKeys();
+            BijectionFunction bf(result.ordering);
+            if(control != nullptr)
+                g.fill_in(bf, *control);
+            else
+                g.fill_in(bf, result.stats.counters);
+
+            // the fill edges are the edges of the filled copy that are not in the graph of the job
+            for(auto v : csr.getVerticesKeys()) {
+                auto adjacent = csr.neighbors(csr.indexOf(v));
+                g.forEachAdjacent(v, [&](unsigned int w) {
+                    if(v < w && !binary_search(adjacent.begin(), adjacent.end(), csr.indexOf(w)))
+                        result.fill.push_back(make_pair(v, w));
+                });
+            }
+            break;
+        }
+
+        case Engine::Order: {
+            CustomGraph::Graph g;
+            csr.toGraph(g);
+            result.ordering = g.order(&result.choice);
+            break;
+        }
+    }
+}
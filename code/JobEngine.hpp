@@ -0,0 +1,156 @@
+#ifndef JOB_ENGINE_H_
+#define JOB_ENGINE_H_
+
+#include "CSRGraph.hpp"
+#include "ThreadPool.hpp"
+#include "RunControl.hpp"
+#include "OrderingStats.hpp"
+#include "OrderingCache.hpp"
+
+#include <vector>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief Auxiliary structure that runs ordering jobs asynchronously on a ThreadPool, by default the shared one that also
+ * runs the parallel loops of the library. submit takes the graph (the job owns it, so the caller can go on) and returns a
+ * future of the result. The jobs of each client are queued in a FIFO and the clients are served round robin, so a client
+ * that submits many jobs does not delay the others. Each job is single threaded, the parallelism comes from running many
+ * of them at once; a job that uses Parallel inside spawns its tasks on the same pool, where they come before the queued
+ * jobs. Every result carries the statistics of its job.
+ * The JobEngine waits for its jobs when it is destroyed.
+ */
+struct JobEngine {
+public:
+    /**
+     * @brief Algorithm run by a job.
+     * - LexP, LexM: the orderings of OrderingEngines, LexM also returns its fill.
+     * - FillIn: the fill of an ordering, computed by Graph::fill_in on a copy of the graph.
+     * - Order: Graph::order, the engine chosen from the statistics of the graph.
+     */
+    enum class Engine { LexP, LexM, FillIn, Order };
+
+    /**
+     * @brief Options of a job.
+     * - client: key of the queue of the job, the clients are served round robin.
+     * - control: if not null it bounds the run of LexM and FillIn, it must live until the job ends.
+     * - ordering: ordering eliminated by FillIn (alpha-1, the first vertex is eliminated first), empty means the
+     *   values of the vertices in ascending order.
+     * - storage: backend of the copy used by FillIn.
+     * - cache: if not null, the result is looked up in it (by the fingerprint of the graph, the engine and the ordering of
+     *   FillIn) before the run, and a complete result is stored in it after the run.
+     */
+    struct Options {
+        unsigned int client = 0;
+        RunControl *control = nullptr;
+        vector<unsigned int> ordering;
+        CustomGraph::Storage storage = CustomGraph::Storage::Sparse;
+        OrderingCache *cache = nullptr;
+    };
+
+    /**
+     * @brief Statistics of a job: its number, client and engine, the worker that ran it, the time spent in the queue and
+     * running, the counters of the algorithm (only without a RunControl and when the result is computed), the outcome of
+     * the RunControl and whether the result comes from the OrderingCache.
+     */
+    struct JobStats {
+        uint64_t id = 0;
+        unsigned int client = 0;
+        Engine engine = Engine::LexP;
+        int worker = -1;
+        uint64_t queued_nanoseconds = 0;
+        uint64_t run_nanoseconds = 0;
+        OrderingStats counters;
+        RunControl::Status status = RunControl::Status::Completed;
+        bool cached = false;
+    };
+
+    /**
+     * @brief Result of a job: the ordering (for FillIn the one eliminated), the fill edges of LexM and FillIn, the choice
+     * of Order and the statistics of the job.
+     */
+    struct Result {
+        vector<unsigned int> ordering;
+        vector<pair<unsigned int, unsigned int>> fill;
+        CustomGraph::OrderingChoice choice;
+        JobStats stats;
+    };
+
+    /**
+     * @brief Construct a new JobEngine object that runs its jobs on a pool.
+     * @param pool pool of the workers, it must outlive the JobEngine.
+     */
+    JobEngine(ThreadPool &pool = ThreadPool::shared());
+
+    JobEngine(const JobEngine &other) = delete;
+    JobEngine& operator=(const JobEngine &other) = delete;
+
+    /**
+     * @brief Destroy the JobEngine object after its jobs have ended.
+     */
+    ~JobEngine();
+
+    /**
+     * @brief Queue a job.
+     * @param graph graph to be ordered, owned by the job (move it in to avoid a copy).
+     * @param engine algorithm to be run.
+     * @param options options of the job.
+     * @return future<Result> result of the job.
+     */
+    future<Result> submit(CustomGraph::CSRGraph graph, Engine engine, Options options);
+
+    /**
+     * @brief Same as submit, with the default options.
+     * @param graph graph to be ordered, owned by the job.
+     * @param engine algorithm to be run.
+     * @return future<Result> result of the job.
+     */
+    future<Result> submit(CustomGraph::CSRGraph graph, Engine engine);
+
+    /**
+     * @brief Wait until all the jobs submitted so far have ended.
+     */
+    void wait();
+
+    /**
+     * @brief Get the number of jobs submitted.
+     * @return uint64_t number of calls of submit.
+     */
+    uint64_t submitted();
+
+    /**
+     * @brief Get the number of jobs ended.
+     * @return uint64_t number of jobs whose result is ready.
+     */
+    uint64_t completed();
+
+private:
+    struct Job;
+
+    /**
+     * @brief Run a job in the calling worker, through the cache of its options if there is one.
+     * @param job job to be run.
+     * @param result it receives the result, the statistics are filled by the caller.
+     */
+    static void run(Job &job, Result &result);
+
+    /**
+     * @brief Compute the result of a job.
+     * @param job job to be run.
+     * @param result it receives the result.
+     */
+    static void compute(Job &job, Result &result);
+
+    ThreadPool &pool;
+    atomic<uint64_t> numSubmitted;
+    atomic<uint64_t> numCompleted;
+    mutex doneLock;
+    condition_variable done;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef LEX_M_WORKSPACE_H_
+#define LEX_M_WORKSPACE_H_
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief Temporary state of lex_m, owned by the caller of the const version of Graph::lex_m. The containers are cleared
+ * and not released between the steps and between the calls, so a workspace reused by a thread stops allocating once it
+ * has grown to the largest graph. Each thread that orders a shared graph needs its own workspace.
+ */
+struct LexMWorkspace {
+    // unnumbered vertices (values with the sparse backend, rows of the matrix with the dense one) and their labels
+    vector<pair<unsigned int, float>> vertices_and_label;
+    // vertices z of the fill edges {v,z} found by the search of a step
+    vector<unsigned int> fill;
+
+    // sparse backend: reach queue of each label level and reached vertices
+    unordered_map<unsigned int, list<unsigned int>> reach;
+    unordered_set<unsigned int> reached;
+
+    // dense backend: label of each row, numbered and reached rows as bits, reach queue of each level and its head
+    vector<float> label;
+    vector<uint64_t> numbered;
+    vector<uint64_t> reached_rows;
+    vector<vector<unsigned int>> reach_rows;
+    vector<unsigned int> reach_heads;
+};
+
+#endif
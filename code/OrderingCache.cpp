@@ -0,0 +1,369 @@
+#include "OrderingCache.hpp"
+#include "Tracer.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Header at the beginning of the file, padded to 64 bytes.
+ */
+struct OrderingCacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    char reserved[48];
+};
+
+/**
+ * @brief Header of a record, followed by the ordering, the fill edges and a padding to 8 bytes. The checksum covers the
+ * header (with the checksum set to 0) and the arrays.
+ */
+struct OrderingCacheRecord {
+    uint32_t magic;
+    uint32_t engine;
+    uint64_t vertices;
+    uint64_t edges;
+    uint64_t vertexSum;
+    uint64_t edgeSum;
+    uint64_t options;
+    uint64_t orderingSize;
+    uint64_t fillSize;
+    uint32_t flags;
+    uint32_t checksum;
+};
+
+static const char ORDERING_CACHE_MAGIC[8] = {'C', 'G', 'C', 'A', 'C', 'H', 'E', 0};
+static const uint32_t ORDERING_CACHE_BYTE_ORDER = 0x01020304;
+static const uint32_t ORDERING_CACHE_RECORD_MAGIC = 0x43455243;
+
+/**
+ * @brief Mix a word in a running hash.
+ * @param hash current hash.
+ * @param word word to be added.
+ * @return uint64_t new hash.
+ */
+static inline uint64_t mixWord(uint64_t hash, uint64_t word) {
+    hash = (hash ^ word) * 0x100000001b3ULL;
+    return hash ^ (hash >> 29);
+}
+
+/**
+ * @brief Checksum of a record.
+ * @param record header of the record, its checksum is ignored.
+ * @param words ordering and fill edges of the record.
+ * @param num_words number of words.
+ * @return uint32_t checksum.
+ */
+static uint32_t recordChecksum(OrderingCacheRecord record, const unsigned int *words, uint64_t num_words) {
+    record.checksum = 0;
+    uint64_t fields[sizeof(OrderingCacheRecord) / sizeof(uint64_t)];
+    memcpy(fields, &record, sizeof(record));
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(auto field : fields)
+        hash = mixWord(hash, field);
+    for(uint64_t i = 0; i < num_words; ++i)
+        hash = mixWord(hash, words[i]);
+    return (uint32_t) (hash ^ (hash >> 32));
+}
+
+/**
+ * @brief Round a size up to the next multiple of 8.
+ * @param bytes size in bytes.
+ * @return uint64_t aligned size.
+ */
+static uint64_t alignWord(uint64_t bytes) {
+    return (bytes + 7) & ~(uint64_t) 7;
+}
+
+/**
+ * @brief Construct a new OrderingCache object that is not associated with any file.
+ */
+OrderingCache::OrderingCache() : fd(-1), mapping(nullptr), mappingSize(0), indexed(0), numHits(0), numMisses(0) {}
+
+/**
+ * @brief Destroy the OrderingCache object, the file is unmapped and closed.
+ */
+OrderingCache::~OrderingCache() {
+    close();
+}
+
+/**
+ * @brief Open a cache file, it is created if it does not exist. A file already open is closed before.
+ * @param path path of the file.
+ * @return true if the file has been opened.
+ * @return false if it cannot be opened or it is not a cache file of this version.
+ */
+bool OrderingCache::open(const string &path) {
+    Tracer::Span span("OrderingCache::open", "build");
+    close();
+    lock_guard<mutex> guard(lock);
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if(fd < 0)
+        return false;
+    flock(fd, LOCK_EX);
+
+    bool valid = true;
+    struct stat info;
+    if(fstat(fd, &info) != 0)
+        valid = false;
+    else if(info.st_size == 0) {
+        OrderingCacheHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, ORDERING_CACHE_MAGIC, sizeof(header.magic));
+        header.version = VERSION;
+        header.byteOrder = ORDERING_CACHE_BYTE_ORDER;
+        valid = pwrite(fd, &header, sizeof(header), 0) == (ssize_t) sizeof(header);
+    } else {
+        OrderingCacheHeader header;
+        valid = pread(fd, &header, sizeof(header), 0) == (ssize_t) sizeof(header) &&
+                memcmp(header.magic, ORDERING_CACHE_MAGIC, sizeof(header.magic)) == 0 && header.version == VERSION &&
+                header.byteOrder == ORDERING_CACHE_BYTE_ORDER;
+    }
+
+    indexed = sizeof(OrderingCacheHeader);
+    valid = valid && refresh(true);
+    flock(fd, LOCK_UN);
+    if(!valid) {
+        if(mapping != nullptr)
+            munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+        ::close(fd);
+        fd = -1;
+        index.clear();
+    }
+    return valid;
+}
+
+/**
+ * @brief Close the file.
+ */
+void OrderingCache::close() {
+    lock_guard<mutex> guard(lock);
+    if(mapping != nullptr)
+        munmap(mapping, mappingSize);
+    if(fd >= 0)
+        ::close(fd);
+    fd = -1;
+    mapping = nullptr;
+    mappingSize = 0;
+    indexed = 0;
+    index.clear();
+    numHits = 0;
+    numMisses = 0;
+}
+
+/**
+ * @brief Check if a file is open.
+ * @return true if a file is open.
+ */
+bool OrderingCache::isOpen() {
+    lock_guard<mutex> guard(lock);
+    return fd >= 0;
+}
+
+/**
+ * @brief Look for a result.
+ * @param key key of the result.
+ * @param entry it receives the result, read from the mapped file.
+ * @return true if the result is cached.
+ */
+bool OrderingCache::lookup(const OrderingCacheKey &key, OrderingCacheEntry &entry) {
+    lock_guard<mutex> guard(lock);
+    if(fd < 0)
+        return false;
+
+    auto it = index.find(key);
+    if(it == index.end()) {
+        // another process may have stored it
+        flock(fd, LOCK_SH);
+        refresh(false);
+        flock(fd, LOCK_UN);
+        it = index.find(key);
+    }
+    if(it == index.end()) {
+        numMisses++;
+        return false;
+    }
+
+    OrderingCacheRecord record;
+    memcpy(&record, mapping + it->second, sizeof(record));
+    const unsigned int *words = reinterpret_cast<const unsigned int*>(mapping + it->second + sizeof(record));
+    entry.ordering.assign(words, words + record.orderingSize);
+    entry.fill.resize(record.fillSize);
+    words += record.orderingSize;
+    for(uint64_t i = 0; i < record.fillSize; ++i)
+        entry.fill[i] = make_pair(words[2*i], words[2*i+1]);
+    entry.flags = record.flags;
+    numHits++;
+    return true;
+}
+
+/**
+ * @brief Append a result to the file, nothing is written if the key is already cached.
+ * @param key key of the result.
+ * @param entry result to be stored.
+ * @return true if the result is cached after the call.
+ * @return false if the file cannot be written.
+ */
+bool OrderingCache::store(const OrderingCacheKey &key, const OrderingCacheEntry &entry) {
+    lock_guard<mutex> guard(lock);
+    if(fd < 0)
+        return false;
+    if(index.find(key) != index.end())
+        return true;
+
+    OrderingCacheRecord record;
+    memset(&record, 0, sizeof(record));
+    record.magic = ORDERING_CACHE_RECORD_MAGIC;
+    record.engine = key.engine;
+    record.vertices = key.graph.vertices;
+    record.edges = key.graph.edges;
+    record.vertexSum = key.graph.vertexSum;
+    record.edgeSum = key.graph.edgeSum;
+    record.options = key.options;
+    record.orderingSize = entry.ordering.size();
+    record.fillSize = entry.fill.size();
+    record.flags = entry.flags;
+
+    uint64_t num_words = record.orderingSize + 2 * record.fillSize;
+    vector<char> bytes(sizeof(record) + alignWord(num_words * sizeof(unsigned int)), 0);
+    unsigned int *words = reinterpret_cast<unsigned int*>(bytes.data() + sizeof(record));
+    memcpy(words, entry.ordering.data(), record.orderingSize * sizeof(unsigned int));
+    for(uint64_t i = 0; i < record.fillSize; ++i) {
+        words[record.orderingSize + 2*i] = entry.fill[i].first;
+        words[record.orderingSize + 2*i + 1] = entry.fill[i].second;
+    }
+    record.checksum = recordChecksum(record, words, num_words);
+    memcpy(bytes.data(), &record, sizeof(record));
+
+    flock(fd, LOCK_EX);
+    // the records of the other processes are indexed first, the new one goes after the last valid record
+    bool stored = refresh(true);
+    if(stored && index.find(key) == index.end()) {
+        size_t written = 0;
+        while(stored && written < bytes.size()) {
+            ssize_t w = pwrite(fd, bytes.data() + written, bytes.size() - written, indexed + written);
+            stored = w > 0;
+            written += stored ? w : 0;
+        }
+        stored = refresh(true) && stored && index.find(key) != index.end();
+    }
+    flock(fd, LOCK_UN);
+    return stored;
+}
+
+/**
+ * @brief Get the number of cached results.
+ * @return size_t number of records in the index.
+ */
+size_t OrderingCache::size() {
+    lock_guard<mutex> guard(lock);
+    return index.size();
+}
+
+/**
+ * @brief Get the number of lookups that found their result since the file was opened.
+ * @return uint64_t number of hits.
+ */
+uint64_t OrderingCache::hits() {
+    lock_guard<mutex> guard(lock);
+    return numHits;
+}
+
+/**
+ * @brief Get the number of lookups that did not find their result since the file was opened.
+ * @return uint64_t number of misses.
+ */
+uint64_t OrderingCache::misses() {
+    lock_guard<mutex> guard(lock);
+    return numMisses;
+}
+
+/**
+ * @brief Hash of an ordering, used as the options of the key of FillIn.
+ * @param ordering ordering to be hashed.
+ * @return uint64_t hash of the ordering, it depends on the order of the vertices.
+ */
+uint64_t OrderingCache::orderingHash(const vector<unsigned int> &ordering) {
+    uint64_t hash = mixWord(0xcbf29ce484222325ULL, ordering.size());
+    for(auto v : ordering)
+        hash = mixWord(hash, v);
+    return hash;
+}
+
+size_t OrderingCache::KeyHash::operator()(const OrderingCacheKey &key) const {
+    return mixWord(mixWord(key.graph.hash(), key.engine), key.options);
+}
+
+/**
+ * @brief Map the file up to its current size and index the records after the indexed ones, called with the lock
+ * of the file held. A record that is not complete or valid ends the scan and, if truncate is true, it is cut.
+ * @param truncate true if the file is locked exclusively and the invalid tail can be removed.
+ * @return true if the file has been mapped.
+ */
+bool OrderingCache::refresh(bool truncate) {
+    struct stat info;
+    if(fstat(fd, &info) != 0)
+        return false;
+    uint64_t size = info.st_size;
+    if(size != mappingSize) {
+        if(mapping != nullptr)
+            munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+        void *address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if(address == MAP_FAILED)
+            return false;
+        mapping = static_cast<char*>(address);
+        mappingSize = size;
+    }
+
+    // a shorter file has been cut by another process, the index is rebuilt
+    if(indexed > size) {
+        index.clear();
+        indexed = sizeof(OrderingCacheHeader);
+    }
+
+    while(indexed + sizeof(OrderingCacheRecord) <= size) {
+        OrderingCacheRecord record;
+        memcpy(&record, mapping + indexed, sizeof(record));
+        uint64_t limit = (size - indexed - sizeof(record)) / sizeof(unsigned int);
+        if(record.magic != ORDERING_CACHE_RECORD_MAGIC || record.orderingSize > limit || record.fillSize > limit ||
+           record.orderingSize + 2 * record.fillSize > limit)
+            break;
+        uint64_t num_words = record.orderingSize + 2 * record.fillSize;
+        const unsigned int *words = reinterpret_cast<const unsigned int*>(mapping + indexed + sizeof(record));
+        if(recordChecksum(record, words, num_words) != record.checksum)
+            break;
+
+        OrderingCacheKey key;
+        key.graph.vertices = record.vertices;
+        key.graph.edges = record.edges;
+        key.graph.vertexSum = record.vertexSum;
+        key.graph.edgeSum = record.edgeSum;
+        key.engine = record.engine;
+        key.options = record.options;
+        index.emplace(key, indexed);
+        indexed += sizeof(record) + alignWord(num_words * sizeof(unsigned int));
+    }
+
+    if(truncate && indexed < size) {
+        if(ftruncate(fd, indexed) != 0)
+            return false;
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+        mappingSize = 0;
+        void *address = mmap(nullptr, indexed, PROT_READ, MAP_SHARED, fd, 0);
+        if(address == MAP_FAILED)
+            return false;
+        mapping = static_cast<char*>(address);
+        mappingSize = indexed;
+    }
+    return true;
+}
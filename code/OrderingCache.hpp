@@ -0,0 +1,151 @@
+#ifndef ORDERING_CACHE_H_
+#define ORDERING_CACHE_H_
+
+#include "GraphFingerprint.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+using namespace std;
+
+/**
+ * @brief Key of a cached result: the fingerprint of the graph, the engine (a JobEngine::Engine) and a hash of the options
+ * that change the result (the ordering of FillIn, 0 for the other engines).
+ */
+struct OrderingCacheKey {
+    GraphFingerprint graph;
+    uint32_t engine = 0;
+    uint64_t options = 0;
+
+    bool operator==(const OrderingCacheKey &other) const {
+        return graph == other.graph && engine == other.engine && options == other.options;
+    }
+};
+
+/**
+ * @brief Cached result: the ordering (alpha-1), the fill edges and the flags of the choice of Graph::order.
+ */
+struct OrderingCacheEntry {
+    static const uint32_t CHORDAL = 1;
+    static const uint32_t LEX_M = 2;
+
+    vector<unsigned int> ordering;
+    vector<pair<unsigned int, unsigned int>> fill;
+    uint32_t flags = 0;
+};
+
+/**
+ * @brief Persistent cache of ordering results, stored in an append-only file that is mapped in memory. Every record holds
+ * its key, the result and a checksum; open scans the file once to build the index, so the cache survives the restarts of
+ * the process, and a record cut by a crash is detected by its checksum and dropped. Several processes can share the file:
+ * the appends are serialized with flock and a lookup that misses rescans the records appended by the others. A key is
+ * stored once, the file is never compacted (remove it to reset the cache).
+ */
+struct OrderingCache {
+public:
+    /**
+     * @brief Current version of the format.
+     */
+    static const uint32_t VERSION = 1;
+
+    /**
+     * @brief Construct a new OrderingCache object that is not associated with any file.
+     */
+    OrderingCache();
+
+    /**
+     * @brief Destroy the OrderingCache object, the file is unmapped and closed.
+     */
+    ~OrderingCache();
+
+    OrderingCache(const OrderingCache &other) = delete;
+    OrderingCache& operator=(const OrderingCache &other) = delete;
+
+    /**
+     * @brief Open a cache file, it is created if it does not exist. A file already open is closed before.
+     * @param path path of the file.
+     * @return true if the file has been opened.
+     * @return false if it cannot be opened or it is not a cache file of this version.
+     */
+    bool open(const string &path);
+
+    /**
+     * @brief Close the file.
+     */
+    void close();
+
+    /**
+     * @brief Check if a file is open.
+     * @return true if a file is open.
+     */
+    bool isOpen();
+
+    /**
+     * @brief Look for a result.
+     * @param key key of the result.
+     * @param entry it receives the result, read from the mapped file.
+     * @return true if the result is cached.
+     */
+    bool lookup(const OrderingCacheKey &key, OrderingCacheEntry &entry);
+
+    /**
+     * @brief Append a result to the file, nothing is written if the key is already cached.
+     * @param key key of the result.
+     * @param entry result to be stored.
+     * @return true if the result is cached after the call.
+     * @return false if the file cannot be written.
+     */
+    bool store(const OrderingCacheKey &key, const OrderingCacheEntry &entry);
+
+    /**
+     * @brief Get the number of cached results.
+     * @return size_t number of records in the index.
+     */
+    size_t size();
+
+    /**
+     * @brief Get the number of lookups that found their result since the file was opened.
+     * @return uint64_t number of hits.
+     */
+    uint64_t hits();
+
+    /**
+     * @brief Get the number of lookups that did not find their result since the file was opened.
+     * @return uint64_t number of misses.
+     */
+    uint64_t misses();
+
+    /**
+     * @brief Hash of an ordering, used as the options of the key of FillIn.
+     * @param ordering ordering to be hashed.
+     * @return uint64_t hash of the ordering, it depends on the order of the vertices.
+     */
+    static uint64_t orderingHash(const vector<unsigned int> &ordering);
+
+private:
+    struct KeyHash {
+        size_t operator()(const OrderingCacheKey &key) const;
+    };
+
+    /**
+     * @brief Map the file up to its current size and index the records after the indexed ones, called with the lock
+     * of the file held. A record that is not complete or valid ends the scan and, if truncate is true, it is cut.
+     * @param truncate true if the file is locked exclusively and the invalid tail can be removed.
+     * @return true if the file has been mapped.
+     */
+    bool refresh(bool truncate);
+
+    mutex lock;
+    int fd;
+    char *mapping;
+    size_t mappingSize;
+    uint64_t indexed;
+    unordered_map<OrderingCacheKey, uint64_t, KeyHash> index;
+    uint64_t numHits;
+    uint64_t numMisses;
+};
+
+#endif
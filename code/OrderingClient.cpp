@@ -0,0 +1,279 @@
+#include "OrderingClient.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * @brief Get the number of vertices in the ordering.
+ * @return uint64_t size of the ordering, 0 for IsPerfect.
+ */
+uint64_t OrderingReply::orderingSize() {
+    return header.orderingSize;
+}
+
+/**
+ * @brief Get the ordering (alpha-1, the first vertex is eliminated first).
+ * @return const unsigned int* orderingSize() values of the vertices.
+ */
+const unsigned int* OrderingReply::ordering() {
+    return reinterpret_cast<const unsigned int*>(payload.data() + sizeof(DaemonReply));
+}
+
+/**
+ * @brief Get the number of fill edges.
+ * @return uint64_t number of fill edges of LexM and FillIn.
+ */
+uint64_t OrderingReply::fillSize() {
+    return header.fillSize;
+}
+
+/**
+ * @brief Get the fill edges.
+ * @return const unsigned int* fillSize() pairs of values of vertices.
+ */
+const unsigned int* OrderingReply::fill() {
+    return ordering() + header.orderingSize;
+}
+
+/**
+ * @brief Check if the ordering produces no fill (for Order, if the graph is chordal).
+ * @return true if the ordering is perfect.
+ */
+bool OrderingReply::perfect() {
+    return header.perfect != 0;
+}
+
+/**
+ * @brief Copy the ordering in a vector.
+ * @return vector<unsigned int> ordering.
+ */
+vector<unsigned int> OrderingReply::orderingVector() {
+    return vector<unsigned int>(ordering(), ordering() + orderingSize());
+}
+
+/**
+ * @brief Copy the fill edges in a vector.
+ * @return vector<pair<unsigned int, unsigned int>> fill edges.
+ */
+vector<pair<unsigned int, unsigned int>> OrderingReply::fillVector() {
+    vector<pair<unsigned int, unsigned int>> edges(fillSize());
+    const unsigned int *f = fill();
+    for(uint64_t i = 0; i < edges.size(); ++i)
+        edges[i] = make_pair(f[2*i], f[2*i+1]);
+    return edges;
+}
+
+/**
+ * @brief Check that the payload has the layout of a DaemonReply.
+ * @return true if the sizes in the header match the payload.
+ */
+bool OrderingReply::valid() {
+    if(payload.size() < sizeof(DaemonReply))
+        return false;
+    memcpy(&header, payload.data(), sizeof(header));
+    uint64_t words = (payload.size() - sizeof(DaemonReply)) / sizeof(unsigned int);
+    return header.orderingSize <= words && header.fillSize <= words &&
+           sizeof(DaemonReply) + (header.orderingSize + 2 * header.fillSize) * sizeof(unsigned int) == payload.size();
+}
+
+/**
+ * @brief Construct a new OrderingClient object that is not connected.
+ */
+OrderingClient::OrderingClient() : socket(-1) {}
+
+/**
+ * @brief Destroy the OrderingClient object, the connection is closed.
+ */
+OrderingClient::~OrderingClient() {
+    close();
+}
+
+/**
+ * @brief Connect to a daemon, a previous connection is closed before.
+ * @param socket_path path of the Unix socket of the daemon.
+ * @return true if the connection has been opened.
+ */
+bool OrderingClient::connect(const string &socket_path) {
+    close();
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(socket_path.size() >= sizeof(address.sun_path))
+        return false;
+    memcpy(address.sun_path, socket_path.c_str(), socket_path.size());
+
+    socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(socket < 0)
+        return false;
+    if(::connect(socket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Close the connection.
+ */
+void OrderingClient::close() {
+    if(socket >= 0)
+        ::close(socket);
+    socket = -1;
+}
+
+/**
+ * @brief Check if the client is connected.
+ * @return true if the connection is open.
+ */
+bool OrderingClient::isConnected() {
+    return socket >= 0;
+}
+
+/**
+ * @brief Send a graph to the daemon, which caches it.
+ * @param graph graph to be sent.
+ * @param key it receives the key of the graph.
+ * @return DaemonStatus status of the reply.
+ */
+DaemonStatus OrderingClient::put(CustomGraph::CSRGraph &graph, uint64_t &key) {
+    DaemonBuffer payload;
+    if(!DaemonProtocol::writeGraph(graph, payload))
+        return DaemonStatus::BadRequest;
+    key = 0;
+    return exchange(DaemonRequest::Put, key, payload);
+}
+
+/**
+ * @brief Ask the daemon to map a graph file (see GraphFile) and to cache it, the graph does not pass through the client.
+ * @param path path of the file, relative paths are resolved by the client.
+ * @param key it receives the key of the graph.
+ * @return DaemonStatus status of the reply.
+ */
+DaemonStatus OrderingClient::load(const string &path, uint64_t &key) {
+    char resolved[PATH_MAX];
+    if(realpath(path.c_str(), resolved) == nullptr)
+        return DaemonStatus::BadRequest;
+    size_t length = strlen(resolved);
+    DaemonBuffer payload;
+    if(!payload.allocate(length))
+        return DaemonStatus::BadRequest;
+    memcpy(payload.data(), resolved, length);
+    key = 0;
+    return exchange(DaemonRequest::Load, key, payload);
+}
+
+/**
+ * @brief Check if the daemon has a graph.
+ * @param key key of the graph.
+ * @return DaemonStatus Ok if the graph is cached, UnknownGraph otherwise.
+ */
+DaemonStatus OrderingClient::has(uint64_t key) {
+    DaemonBuffer payload;
+    return exchange(DaemonRequest::Has, key, payload);
+}
+
+/**
+ * @brief Check if the daemon has a graph with the given fingerprint under a key.
+ * @param key key of the graph.
+ * @param fingerprint fingerprint of the graph.
+ * @return DaemonStatus Ok if the graph is cached with that fingerprint, UnknownGraph otherwise.
+ */
+DaemonStatus OrderingClient::has(uint64_t key, const GraphFingerprint &fingerprint) {
+    DaemonBuffer payload;
+    if(!payload.allocate(sizeof(fingerprint)))
+        return DaemonStatus::BadRequest;
+    memcpy(payload.data(), &fingerprint, sizeof(fingerprint));
+    return exchange(DaemonRequest::Has, key, payload);
+}
+
+/**
+ * @brief Remove a graph from the cache of the daemon.
+ * @param key key of the graph.
+ * @return DaemonStatus Ok if the graph was cached, UnknownGraph otherwise.
+ */
+DaemonStatus OrderingClient::drop(uint64_t key) {
+    DaemonBuffer payload;
+    return exchange(DaemonRequest::Drop, key, payload);
+}
+
+/**
+ * @brief Run an ordering on a cached graph.
+ * @param key key of the graph.
+ * @param request one of LexP, LexM, FillIn, Order and IsPerfect.
+ * @param reply it receives the result.
+ * @param ordering ordering of FillIn and IsPerfect (alpha-1).
+ * @return DaemonStatus status of the reply.
+ */
+DaemonStatus OrderingClient::order(uint64_t key, DaemonRequest request, OrderingReply &reply, const vector<unsigned int> *ordering) {
+    if(request == DaemonRequest::Put || request == DaemonRequest::Load || request == DaemonRequest::Has || request == DaemonRequest::Drop)
+        return DaemonStatus::BadRequest;
+    if((request == DaemonRequest::FillIn || request == DaemonRequest::IsPerfect) != (ordering != nullptr))
+        return DaemonStatus::BadRequest;
+
+    DaemonBuffer &payload = reply.payload;
+    payload.clear();
+    if(ordering != nullptr) {
+        if(!payload.allocate(ordering->size() * sizeof(unsigned int)))
+            return DaemonStatus::BadRequest;
+        memcpy(payload.data(), ordering->data(), payload.size());
+    }
+
+    DaemonStatus status = exchange(request, key, payload);
+    if(status == DaemonStatus::Ok && !reply.valid()) {
+        close();
+        return DaemonStatus::ConnectionLost;
+    }
+    return status;
+}
+
+/**
+ * @brief Run an ordering on a graph, which is sent to the daemon only if it is not cached yet. The key computed locally
+ * is used only if the daemon has a graph with the same fingerprint under it, otherwise the graph is sent and the daemon
+ * tells its key (another one if the content hash collides with a different graph).
+ * @param graph graph to be ordered.
+ * @param request one of LexP, LexM, FillIn, Order and IsPerfect.
+ * @param reply it receives the result.
+ * @param ordering ordering of FillIn and IsPerfect (alpha-1).
+ * @return DaemonStatus status of the reply.
+ */
+DaemonStatus OrderingClient::order(CustomGraph::CSRGraph &graph, DaemonRequest request, OrderingReply &reply, const vector<unsigned int> *ordering) {
+    uint64_t key = DaemonProtocol::contentHash(graph);
+    DaemonStatus status = has(key, GraphFingerprint::of(graph));
+    if(status == DaemonStatus::Ok) {
+        status = order(key, request, reply, ordering);
+        if(status != DaemonStatus::UnknownGraph)
+            return status;
+    } else if(status != DaemonStatus::UnknownGraph)
+        return status;
+
+    // the graph may have been evicted between the two requests, in that case UnknownGraph is returned
+    status = put(graph, key);
+    if(status != DaemonStatus::Ok)
+        return status;
+    return order(key, request, reply, ordering);
+}
+
+/**
+ * @brief Send a request and receive its reply.
+ * @param request kind of the request.
+ * @param key key of the request, it receives the key of the reply.
+ * @param payload payload of the request, it receives the payload of the reply.
+ * @return DaemonStatus status of the reply, ConnectionLost if the exchange fails (the connection is closed).
+ */
+DaemonStatus OrderingClient::exchange(DaemonRequest request, uint64_t &key, DaemonBuffer &payload) {
+    if(socket < 0)
+        return DaemonStatus::ConnectionLost;
+
+    DaemonHeader header;
+    if(!DaemonProtocol::send(socket, (uint16_t) request, key, payload) || !DaemonProtocol::receive(socket, header, payload) ||
+       header.kind > (uint16_t) DaemonStatus::BadRequest) {
+        close();
+        return DaemonStatus::ConnectionLost;
+    }
+    key = header.key;
+    return (DaemonStatus) header.kind;
+}
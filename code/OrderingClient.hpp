@@ -0,0 +1,184 @@
+#ifndef ORDERING_CLIENT_H_
+#define ORDERING_CLIENT_H_
+
+#include "DaemonProtocol.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief Result of an ordering request served by OrderingDaemon. The arrays are read in place from the payload of the
+ * reply, which is a shared memory mapping for the large results, so they are not copied unless the vector accessors are
+ * used.
+ */
+struct OrderingReply {
+public:
+    /**
+     * @brief Get the number of vertices in the ordering.
+     * @return uint64_t size of the ordering, 0 for IsPerfect.
+     */
+    uint64_t orderingSize();
+
+    /**
+     * @brief Get the ordering (alpha-1, the first vertex is eliminated first).
+     * @return const unsigned int* orderingSize() values of the vertices.
+     */
+    const unsigned int* ordering();
+
+    /**
+     * @brief Get the number of fill edges.
+     * @return uint64_t number of fill edges of LexM and FillIn.
+     */
+    uint64_t fillSize();
+
+    /**
+     * @brief Get the fill edges.
+     * @return const unsigned int* fillSize() pairs of values of vertices.
+     */
+    const unsigned int* fill();
+
+    /**
+     * @brief Check if the ordering produces no fill (for Order, if the graph is chordal).
+     * @return true if the ordering is perfect.
+     */
+    bool perfect();
+
+    /**
+     * @brief Copy the ordering in a vector.
+     * @return vector<unsigned int> ordering.
+     */
+    vector<unsigned int> orderingVector();
+
+    /**
+     * @brief Copy the fill edges in a vector.
+     * @return vector<pair<unsigned int, unsigned int>> fill edges.
+     */
+    vector<pair<unsigned int, unsigned int>> fillVector();
+
+private:
+    friend struct OrderingClient;
+
+    /**
+     * @brief Check that the payload has the layout of a DaemonReply.
+     * @return true if the sizes in the header match the payload.
+     */
+    bool valid();
+
+    DaemonReply header;
+    DaemonBuffer payload;
+};
+
+/**
+ * @brief Connection to an OrderingDaemon. The graphs are sent once and then referred to by their key, order(graph, ...)
+ * does that transparently: it asks for the key computed locally, checking the fingerprint of the graph, and sends the
+ * graph only when the daemon does not have it. A client must be used by one thread at a time, the threads of a process can open a connection each.
+ */
+struct OrderingClient {
+public:
+    /**
+     * @brief Construct a new OrderingClient object that is not connected.
+     */
+    OrderingClient();
+
+    /**
+     * @brief Destroy the OrderingClient object, the connection is closed.
+     */
+    ~OrderingClient();
+
+    OrderingClient(const OrderingClient &other) = delete;
+    OrderingClient& operator=(const OrderingClient &other) = delete;
+
+    /**
+     * @brief Connect to a daemon, a previous connection is closed before.
+     * @param socket_path path of the Unix socket of the daemon.
+     * @return true if the connection has been opened.
+     */
+    bool connect(const string &socket_path);
+
+    /**
+     * @brief Close the connection.
+     */
+    void close();
+
+    /**
+     * @brief Check if the client is connected.
+     * @return true if the connection is open.
+     */
+    bool isConnected();
+
+    /**
+     * @brief Send a graph to the daemon, which caches it.
+     * @param graph graph to be sent.
+     * @param key it receives the key of the graph.
+     * @return DaemonStatus status of the reply.
+     */
+    DaemonStatus put(CustomGraph::CSRGraph &graph, uint64_t &key);
+
+    /**
+     * @brief Ask the daemon to map a graph file (see GraphFile) and to cache it, the graph does not pass through the client.
+     * @param path path of the file, relative paths are resolved by the client.
+     * @param key it receives the key of the graph.
+     * @return DaemonStatus status of the reply.
+     */
+    DaemonStatus load(const string &path, uint64_t &key);
+
+    /**
+     * @brief Check if the daemon has a graph.
+     * @param key key of the graph.
+     * @return DaemonStatus Ok if the graph is cached, UnknownGraph otherwise.
+     */
+    DaemonStatus has(uint64_t key);
+
+    /**
+     * @brief Check if the daemon has a graph with the given fingerprint under a key.
+     * @param key key of the graph.
+     * @param fingerprint fingerprint of the graph.
+     * @return DaemonStatus Ok if the graph is cached with that fingerprint, UnknownGraph otherwise.
+     */
+    DaemonStatus has(uint64_t key, const GraphFingerprint &fingerprint);
+
+    /**
+     * @brief Remove a graph from the cache of the daemon.
+     * @param key key of the graph.
+     * @return DaemonStatus Ok if the graph was cached, UnknownGraph otherwise.
+     */
+    DaemonStatus drop(uint64_t key);
+
+    /**
+     * @brief Run an ordering on a cached graph.
+     * @param key key of the graph.
+     * @param request one of LexP, LexM, FillIn, Order and IsPerfect.
+     * @param reply it receives the result.
+     * @param ordering ordering of FillIn and IsPerfect (alpha-1).
+     * @return DaemonStatus status of the reply.
+     */
+    DaemonStatus order(uint64_t key, DaemonRequest request, OrderingReply &reply, const vector<unsigned int> *ordering = nullptr);
+
+    /**
+     * @brief Run an ordering on a graph, which is sent to the daemon only if it is not cached yet. The key computed locally
+     * is used only if the daemon has a graph with the same fingerprint under it, otherwise the graph is sent and the daemon
+     * tells its key (another one if the content hash collides with a different graph).
+     * @param graph graph to be ordered.
+     * @param request one of LexP, LexM, FillIn, Order and IsPerfect.
+     * @param reply it receives the result.
+     * @param ordering ordering of FillIn and IsPerfect (alpha-1).
+     * @return DaemonStatus status of the reply.
+     */
+    DaemonStatus order(CustomGraph::CSRGraph &graph, DaemonRequest request, OrderingReply &reply, const vector<unsigned int> *ordering = nullptr);
+
+private:
+    /**
+     * @brief Send a request and receive its reply.
+     * @param request kind of the request.
+     * @param key key of the request, it receives the key of the reply.
+     * @param payload payload of the request, it receives the payload of the reply.
+     * @return DaemonStatus status of the reply, ConnectionLost if the exchange fails (the connection is closed).
+     */
+    DaemonStatus exchange(DaemonRequest request, uint64_t &key, DaemonBuffer &payload);
+
+    int socket;
+};
+
+#endif
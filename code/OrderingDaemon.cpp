@@ -0,0 +1,420 @@
+#include "OrderingDaemon.hpp"
+#include "OrderingEngines.hpp"
+#include "Tracer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ * @brief Default capacity of the cache, 4 GiB.
+ */
+static const uint64_t DEFAULT_CAPACITY = (uint64_t) 4 << 30;
+
+/**
+ * @brief Get the memory of the arrays of a graph.
+ * @param graph graph to be measured.
+ * @return uint64_t bytes of the offsets, of the adjacency and of the ids.
+ */
+static uint64_t graphBytes(CustomGraph::CSRGraph &graph) {
+    uint64_t n = graph.size();
+    uint64_t num_adjacency = n == 0 ? 0 : graph.getOffsets()[n];
+    return (n + 1) * sizeof(uint64_t) + num_adjacency * sizeof(unsigned int) + (graph.hasIds() ? n * sizeof(unsigned int) : 0);
+}
+
+/**
+ * @brief Check if two graphs have the same arrays, used when their keys are equal.
+ * @param first first graph.
+ * @param second second graph.
+ * @return true if the offsets, the adjacency and the ids are equal.
+ */
+static bool sameGraph(CustomGraph::CSRGraph &first, CustomGraph::CSRGraph &second) {
+    uint64_t n = first.size();
+    if(n != second.size() || first.hasIds() != second.hasIds())
+        return false;
+    if(n == 0)
+        return true;
+    uint64_t num_adjacency = first.getOffsets()[n];
+    return memcmp(first.getOffsets(), second.getOffsets(), (n + 1) * sizeof(uint64_t)) == 0 &&
+           memcmp(first.getAdjacency(), second.getAdjacency(), num_adjacency * sizeof(unsigned int)) == 0 &&
+           (!first.hasIds() || memcmp(first.getIds(), second.getIds(), n * sizeof(unsigned int)) == 0);
+}
+
+/**
+ * @brief Construct a new OrderingDaemon object, it does not listen until start is called.
+ * @param socket_path path of the Unix socket.
+ * @param pool pool that runs the orderings, it must outlive the daemon.
+ */
+OrderingDaemon::OrderingDaemon(const string &socket_path, ThreadPool &pool)
+    : path(socket_path), engine(pool), listener(-1), nextClient(0), stopping(false), capacity(DEFAULT_CAPACITY), bytes(0),
+      results(nullptr), numServed(0) {}
+
+/**
+ * @brief Destroy the OrderingDaemon object, it is stopped.
+ */
+OrderingDaemon::~OrderingDaemon() {
+    stop();
+}
+
+/**
+ * @brief Bind the socket (an old socket file at the same path is replaced) and start accepting connections.
+ * @return true if the daemon is listening.
+ * @return false if the socket cannot be created.
+ */
+bool OrderingDaemon::start() {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if(listener >= 0 || path.size() >= sizeof(address.sun_path))
+        return false;
+    memcpy(address.sun_path, path.c_str(), path.size());
+
+    listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(listener < 0)
+        return false;
+    unlink(path.c_str());
+    if(bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 64) != 0) {
+        ::close(listener);
+        listener = -1;
+        return false;
+    }
+
+    stopping = false;
+    acceptor = thread(&OrderingDaemon::accept, this);
+    return true;
+}
+
+/**
+ * @brief Close the socket and all the connections, and wait for the requests in progress.
+ */
+void OrderingDaemon::stop() {
+    if(listener < 0)
+        return;
+
+    map<int, thread> open;
+    {
+        lock_guard<mutex> lock(connectionsLock);
+        stopping = true;
+        shutdown(listener, SHUT_RDWR);
+        for(auto &connection : connections)
+            shutdown(connection.first, SHUT_RDWR);
+    }
+    acceptor.join();
+    {
+        lock_guard<mutex> lock(connectionsLock);
+        open = move(connections);
+        connections.clear();
+    }
+    for(auto &connection : open) {
+        connection.second.join();
+        ::close(connection.first);
+    }
+
+    ::close(listener);
+    listener = -1;
+    unlink(path.c_str());
+    engine.wait();
+}
+
+/**
+ * @brief Set the size of the cache, the least recently used graphs are evicted when it is exceeded. A graph in use by
+ * a request stays alive until the request ends.
+ * @param bytes capacity in bytes of the payloads and of the files of the cached graphs.
+ */
+void OrderingDaemon::setCapacity(uint64_t bytes) {
+    lock_guard<mutex> lock(cacheLock);
+    capacity = bytes;
+    evict();
+}
+
+/**
+ * @brief Keep the results of the orderings in a persistent cache, so a request already served, also by a previous run
+ * of the daemon, does not run the engine again.
+ * @param cache open cache, null to disable it; it must outlive the daemon.
+ */
+void OrderingDaemon::setResultCache(OrderingCache *cache) {
+    lock_guard<mutex> lock(cacheLock);
+    results = cache;
+}
+
+/**
+ * @brief Get the number of cached graphs.
+ * @return size_t number of graphs.
+ */
+size_t OrderingDaemon::cachedGraphs() {
+    lock_guard<mutex> lock(cacheLock);
+    return cache.size();
+}
+
+/**
+ * @brief Get the memory of the cached graphs.
+ * @return uint64_t bytes of the payloads and of the files of the cached graphs.
+ */
+uint64_t OrderingDaemon::cachedBytes() {
+    lock_guard<mutex> lock(cacheLock);
+    return bytes;
+}
+
+/**
+ * @brief Get the number of requests served.
+ * @return uint64_t number of replies sent.
+ */
+uint64_t OrderingDaemon::served() {
+    return numServed.load();
+}
+
+/**
+ * @brief Accept the connections until the socket is closed.
+ */
+void OrderingDaemon::accept() {
+    while(true) {
+        int connection = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        lock_guard<mutex> lock(connectionsLock);
+        if(stopping) {
+            if(connection >= 0)
+                ::close(connection);
+            return;
+        }
+        if(connection < 0) {
+            if(errno == EINTR || errno == ECONNABORTED)
+                continue;
+            return;
+        }
+        connections[connection] = thread(&OrderingDaemon::serve, this, connection, nextClient++);
+    }
+}
+
+/**
+ * @brief Serve the requests of a connection until it is closed.
+ * @param connection connected socket.
+ * @param client key of the connection in the fair queue of the engine.
+ */
+void OrderingDaemon::serve(int connection, unsigned int client) {
+    DaemonHeader header;
+    DaemonBuffer payload;
+    while(DaemonProtocol::receive(connection, header, payload)) {
+        uint64_t key = header.key;
+        DaemonBuffer reply;
+        DaemonStatus status = handle(header, payload, client, key, reply);
+        payload.clear();
+        if(!DaemonProtocol::send(connection, (uint16_t) status, key, reply))
+            break;
+        numServed++;
+    }
+
+    // a connection closed by the client is forgotten at once, the ones closed by stop are joined there
+    lock_guard<mutex> lock(connectionsLock);
+    if(stopping)
+        return;
+    auto it = connections.find(connection);
+    it->second.detach();
+    connections.erase(it);
+    ::close(connection);
+}
+
+/**
+ * @brief Serve a request.
+ * @param header header of the request.
+ * @param payload payload of the request.
+ * @param client key of the connection.
+ * @param key it receives the key of the reply.
+ * @param reply it receives the payload of the reply.
+ * @return DaemonStatus status of the reply.
+ */
+DaemonStatus OrderingDaemon::handle(DaemonHeader &header, DaemonBuffer &payload, unsigned int client, uint64_t &key, DaemonBuffer &reply) {
+    Tracer::Span span("OrderingDaemon::request", "daemon");
+    DaemonRequest request = (DaemonRequest) header.kind;
+
+    switch(request) {
+        case DaemonRequest::Put: {
+            shared_ptr<Entry> entry = make_shared<Entry>();
+            entry->payload = move(payload);
+            if(!DaemonProtocol::readGraph(entry->payload, entry->graph))
+                return DaemonStatus::BadRequest;
+            entry->bytes = entry->payload.size();
+            key = insert(entry);
+            return DaemonStatus::Ok;
+        }
+
+        case DaemonRequest::Load: {
+            if(payload.size() == 0)
+                return DaemonStatus::BadRequest;
+            shared_ptr<Entry> entry = make_shared<Entry>();
+            string file(payload.data(), payload.size());
+            // open checks the arrays as readGraph does, any peer of the socket can name the file
+            if(!entry->file.open(file))
+                return DaemonStatus::BadRequest;
+            entry->graph = entry->file.graph();
+            entry->bytes = graphBytes(entry->graph);
+            key = insert(entry);
+            return DaemonStatus::Ok;
+        }
+
+        case DaemonRequest::Has: {
+            if(payload.size() != 0 && payload.size() != sizeof(GraphFingerprint))
+                return DaemonStatus::BadRequest;
+            shared_ptr<Entry> entry = find(key);
+            if(entry == nullptr)
+                return DaemonStatus::UnknownGraph;
+            if(payload.size() != 0) {
+                GraphFingerprint fingerprint;
+                memcpy(&fingerprint, payload.data(), sizeof(fingerprint));
+                if(fingerprint != entry->fingerprint)
+                    return DaemonStatus::UnknownGraph;
+            }
+            return DaemonStatus::Ok;
+        }
+
+        case DaemonRequest::Drop: {
+            lock_guard<mutex> lock(cacheLock);
+            auto it = cache.find(key);
+            if(it == cache.end())
+                return DaemonStatus::UnknownGraph;
+            bytes -= it->second.first->bytes;
+            recent.erase(it->second.second);
+            cache.erase(it);
+            return DaemonStatus::Ok;
+        }
+
+        case DaemonRequest::LexP:
+        case DaemonRequest::LexM:
+        case DaemonRequest::FillIn:
+        case DaemonRequest::Order:
+        case DaemonRequest::IsPerfect: {
+            shared_ptr<Entry> entry = find(key);
+            if(entry == nullptr)
+                return DaemonStatus::UnknownGraph;
+            return order(*entry, request, payload, client, reply);
+        }
+    }
+    return DaemonStatus::BadRequest;
+}
+
+/**
+ * @brief Run an ordering on a cached graph and encode its result.
+ * @param entry cached graph.
+ * @param request ordering to be run, one of LexP, LexM, FillIn, Order and IsPerfect.
+ * @param payload ordering of FillIn and IsPerfect.
+ * @param client key of the connection.
+ * @param reply it receives the DaemonReply.
+ * @return DaemonStatus status of the reply.
+ */
+DaemonStatus OrderingDaemon::order(Entry &entry, DaemonRequest request, DaemonBuffer &payload, unsigned int client, DaemonBuffer &reply) {
+    CustomGraph::CSRGraph &graph = entry.graph;
+    JobEngine::Options options;
+    options.client = client;
+    {
+        lock_guard<mutex> lock(cacheLock);
+        options.cache = results;
+    }
+
+    if(request == DaemonRequest::FillIn || request == DaemonRequest::IsPerfect) {
+        if(payload.size() != (size_t) graph.size() * sizeof(unsigned int))
+            return DaemonStatus::BadRequest;
+        options.ordering.resize(graph.size());
+        memcpy(options.ordering.data(), payload.data(), payload.size());
+    }
+
+    DaemonReply counts;
+    memset(&counts, 0, sizeof(counts));
+    if(request == DaemonRequest::IsPerfect) {
+        counts.perfect = OrderingEngines::isPerfectOrdering(graph, options.ordering) ? 1 : 0;
+        if(!reply.allocate(sizeof(counts)))
+            return DaemonStatus::BadRequest;
+        memcpy(reply.data(), &counts, sizeof(counts));
+        return DaemonStatus::Ok;
+    }
+
+    // fill_in needs a permutation of the vertices
+    if(request == DaemonRequest::FillIn) {
+        vector<unsigned int> sorted = options.ordering;
+        sort(sorted.begin(), sorted.end());
+        if(sorted != graph.getVerticesKeys())
+            return DaemonStatus::BadRequest;
+    }
+
+    JobEngine::Engine job = JobEngine::Engine::LexP;
+    if(request == DaemonRequest::LexM)
+        job = JobEngine::Engine::LexM;
+    else if(request == DaemonRequest::FillIn)
+        job = JobEngine::Engine::FillIn;
+    else if(request == DaemonRequest::Order)
+        job = JobEngine::Engine::Order;
+
+    // the graph is a view, the job copies only its pointers
+    JobEngine::Result result = engine.submit(graph, job, move(options)).get();
+
+    counts.orderingSize = result.ordering.size();
+    counts.fillSize = result.fill.size();
+    if(request == DaemonRequest::LexP)
+        counts.perfect = OrderingEngines::isPerfectOrdering(graph, result.ordering) ? 1 : 0;
+    else if(request == DaemonRequest::Order)
+        counts.perfect = result.choice.chordal ? 1 : 0;
+    else
+        counts.perfect = result.fill.empty() ? 1 : 0;
+
+    size_t ordering_bytes = counts.orderingSize * sizeof(unsigned int);
+    if(!reply.allocate(sizeof(counts) + ordering_bytes + counts.fillSize * 2 * sizeof(unsigned int)))
+        return DaemonStatus::BadRequest;
+    char *base = reply.data();
+    memcpy(base, &counts, sizeof(counts));
+    memcpy(base + sizeof(counts), result.ordering.data(), ordering_bytes);
+    unsigned int *fill = reinterpret_cast<unsigned int*>(base + sizeof(counts) + ordering_bytes);
+    for(auto &e : result.fill) {
+        *fill++ = e.first;
+        *fill++ = e.second;
+    }
+    return DaemonStatus::Ok;
+}
+
+/**
+ * @brief Add a graph to the cache, or refresh it if the same graph is already there. The key is the content hash of
+ * the graph; if it is taken by a different graph (a collision) the next free key is used.
+ * @param entry graph to be cached.
+ * @return uint64_t key of the graph.
+ */
+uint64_t OrderingDaemon::insert(shared_ptr<Entry> entry) {
+    uint64_t key = DaemonProtocol::contentHash(entry->graph);
+    entry->fingerprint = GraphFingerprint::of(entry->graph);
+    lock_guard<mutex> lock(cacheLock);
+    for(auto it = cache.find(key); it != cache.end(); it = cache.find(++key))
+        if(sameGraph(it->second.first->graph, entry->graph)) {
+            recent.splice(recent.begin(), recent, it->second.second);
+            return key;
+        }
+    recent.push_front(key);
+    cache[key] = make_pair(entry, recent.begin());
+    bytes += entry->bytes;
+    evict();
+    return key;
+}
+
+/**
+ * @brief Get a cached graph and mark it as the most recently used.
+ * @param key key of the graph.
+ * @return shared_ptr<Entry> the graph, null if it is not cached.
+ */
+shared_ptr<OrderingDaemon::Entry> OrderingDaemon::find(uint64_t key) {
+    lock_guard<mutex> lock(cacheLock);
+    auto it = cache.find(key);
+    if(it == cache.end())
+        return nullptr;
+    recent.splice(recent.begin(), recent, it->second.second);
+    return it->second.first;
+}
+
+/**
+ * @brief Evict the least recently used graphs until the cache fits in its capacity, called with cacheLock held. The most
+ * recent graph is always kept, even if it is larger than the capacity.
+ */
+void OrderingDaemon::evict() {
+    while(bytes > capacity && recent.size() > 1) {
+        auto it = cache.find(recent.back());
+        bytes -= it->second.first->bytes;
+        cache.erase(it);
+        recent.pop_back();
+    }
+}
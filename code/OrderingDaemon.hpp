@@ -0,0 +1,183 @@
+#ifndef ORDERING_DAEMON_H_
+#define ORDERING_DAEMON_H_
+
+#include "DaemonProtocol.hpp"
+#include "GraphFile.hpp"
+#include "JobEngine.hpp"
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+using namespace std;
+
+/**
+ * @brief Local service that keeps graphs resident and orders them for other processes, so a graph is loaded and built
+ * once per machine instead of once per process. The daemon listens on a Unix socket and speaks DaemonProtocol: the
+ * clients Put a graph (or Load a graph file) once, then they refer to it by its key, the content hash of its arrays (the
+ * arrays are compared when two graphs have the same hash). Every graph is validated before it is cached, since any
+ * process that can reach the socket sends it.
+ * The cached graphs are views of the received payload or of the mapped file, nothing is copied nor rebuilt; they are
+ * evicted in least recently used order beyond the capacity. The requests run on a JobEngine, each connection is a client
+ * of its fair queue; the large replies travel in shared memory.
+ */
+struct OrderingDaemon {
+public:
+    /**
+     * @brief Construct a new OrderingDaemon object, it does not listen until start is called.
+     * @param socket_path path of the Unix socket.
+     * @param pool pool that runs the orderings, it must outlive the daemon.
+     */
+    OrderingDaemon(const string &socket_path, ThreadPool &pool = ThreadPool::shared());
+
+    OrderingDaemon(const OrderingDaemon &other) = delete;
+    OrderingDaemon& operator=(const OrderingDaemon &other) = delete;
+
+    /**
+     * @brief Destroy the OrderingDaemon object, it is stopped.
+     */
+    ~OrderingDaemon();
+
+    /**
+     * @brief Bind the socket (an old socket file at the same path is replaced) and start accepting connections.
+     * @return true if the daemon is listening.
+     * @return false if the socket cannot be created.
+     */
+    bool start();
+
+    /**
+     * @brief Close the socket and all the connections, and wait for the requests in progress.
+     */
+    void stop();
+
+    /**
+     * @brief Set the size of the cache, the least recently used graphs are evicted when it is exceeded. A graph in use by
+     * a request stays alive until the request ends.
+     * @param bytes capacity in bytes of the payloads and of the files of the cached graphs.
+     */
+    void setCapacity(uint64_t bytes);
+
+    /**
+     * @brief Keep the results of the orderings in a persistent cache, so a request already served, also by a previous run
+     * of the daemon, does not run the engine again.
+     * @param cache open cache, null to disable it; it must outlive the daemon.
+     */
+    void setResultCache(OrderingCache *cache);
+
+    /**
+     * @brief Get the number of cached graphs.
+     * @return size_t number of graphs.
+     */
+    size_t cachedGraphs();
+
+    /**
+     * @brief Get the memory of the cached graphs.
+     * @return uint64_t bytes of the payloads and of the files of the cached graphs.
+     */
+    uint64_t cachedBytes();
+
+    /**
+     * @brief Get the number of requests served.
+     * @return uint64_t number of replies sent.
+     */
+    uint64_t served();
+
+private:
+    /**
+     * @brief Cached graph: the graph is a view of the payload of Put or of the file of Load.
+     */
+    struct Entry {
+        DaemonBuffer payload;
+        CustomGraph::GraphFile file;
+        CustomGraph::CSRGraph graph;
+        GraphFingerprint fingerprint;
+        uint64_t bytes = 0;
+    };
+
+    /**
+     * @brief Accept the connections until the socket is closed.
+     */
+    void accept();
+
+    /**
+     * @brief Serve the requests of a connection until it is closed.
+     * @param connection connected socket.
+     * @param client key of the connection in the fair queue of the engine.
+     */
+    void serve(int connection, unsigned int client);
+
+    /**
+     * @brief Serve a request.
+     * @param header header of the request.
+     * @param payload payload of the request.
+     * @param client key of the connection.
+     * @param key it receives the key of the reply.
+     * @param reply it receives the payload of the reply.
+     * @return DaemonStatus status of the reply.
+     */
+    DaemonStatus handle(DaemonHeader &header, DaemonBuffer &payload, unsigned int client, uint64_t &key, DaemonBuffer &reply);
+
+    /**
+     * @brief Run an ordering on a cached graph and encode its result.
+     * @param entry cached graph.
+     * @param request ordering to be run, one of LexP, LexM, FillIn, Order and IsPerfect.
+     * @param payload ordering of FillIn and IsPerfect.
+     * @param client key of the connection.
+     * @param reply it receives the DaemonReply.
+     * @return DaemonStatus status of the reply.
+     */
+    DaemonStatus order(Entry &entry, DaemonRequest request, DaemonBuffer &payload, unsigned int client, DaemonBuffer &reply);
+
+    /**
+     * @brief Add a graph to the cache, or refresh it if the same graph is already there. The key is the content hash of
+     * the graph; if it is taken by a different graph (a collision) the next free key is used.
+     * @param entry graph to be cached.
+     * @return uint64_t key of the graph.
+     */
+    uint64_t insert(shared_ptr<Entry> entry);
+
+    /**
+     * @brief Get a cached graph and mark it as the most recently used.
+     * @param key key of the graph.
+     * @return shared_ptr<Entry> the graph, null if it is not cached.
+     */
+    shared_ptr<Entry> find(uint64_t key);
+
+    /**
+     * @brief Evict the least recently used graphs until the cache fits in its capacity, called with cacheLock held. The most
+     * recent graph is always kept, even if it is larger than the capacity.
+     */
+    void evict();
+
+    string path;
+    JobEngine engine;
+    int listener;
+    thread acceptor;
+
+    /**
+     * @brief Open connections and their threads.
+     */
+    mutex connectionsLock;
+    map<int, thread> connections;
+    unsigned int nextClient;
+    bool stopping;
+
+    /**
+     * @brief Cache of the graphs, recent holds the keys from the most to the least recently used.
+     */
+    mutex cacheLock;
+    unordered_map<uint64_t, pair<shared_ptr<Entry>, list<uint64_t>::iterator>> cache;
+    list<uint64_t> recent;
+    uint64_t capacity;
+    uint64_t bytes;
+    OrderingCache *results;
+
+    atomic<uint64_t> numServed;
+};
+
+#endif
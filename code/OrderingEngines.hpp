@@ -0,0 +1,240 @@
+#ifndef ORDERING_ENGINES_H_
+#define ORDERING_ENGINES_H_
+
+#include "OrderingStream.hpp"
+#include "RunControl.hpp"
+#include "PerfCounters.hpp"
+#include "OrderingStats.hpp"
+#include "Tracer.hpp"
+#include "GraphProfile.hpp"
+
+#include <vector>
+#include <unordered_set>
+#include <utility>
+
+using namespace std;
+
+/**
+ * @brief Auxiliary structure that contains the versions of the algorithms that work on read-only graphs with dense indices
+ * (CompressedGraph, CSRGraph). A graph type G must provide:
+ * - unsigned int size(), number of vertices, indexed from 0 to size()-1.
+ * - unsigned int vertexValue(unsigned int index), value of the vertex with a certain index.
+ * - neighbors(unsigned int index), range of the indices of the adjacent vertices.
+ * - unsigned int indexOf(unsigned int vertex), index of a value (only for isPerfectOrdering).
+ * The results are expressed with the values of the vertices, as the functions of Graph do.
+ * As in Graph, the orderings count their work in an OrderingStats only when they are instantiated with CollectStats = true.
+ */
+struct OrderingEngines {
+public:
+
+    /**
+     * @brief Check if the graph is connected with an iterative depth first search.
+     * @param graph graph to be checked.
+     * @return true if it is connected.
+     * @return false if it is not connected.
+     */
+    template<typename G>
+    static bool isConnected(G &graph) {
+        Tracer::Span span("OrderingEngines::isConnected", "connectivity");
+        unsigned int n = graph.size();
+        if(n == 0)
+            return true;
+
+        vector<bool> visited(n, false);
+        vector<unsigned int> stack(1, 0);
+        unsigned int num_visited = 1;
+        visited[0] = true;
+
+        while(!stack.empty()) {
+            unsigned int v = stack.back();
+            stack.pop_back();
+
+            for(auto w : graph.neighbors(v))
+                if(!visited[w]) {
+                    visited[w] = true;
+                    num_visited++;
+                    stack.push_back(w);
+                }
+        }
+        return num_visited == n;
+    }
+
+    /**
+     * @brief Compute the statistics of the graph in one pass: the degrees are counted while the components are visited
+     * with an iterative depth first search.
+     * @param graph graph to be measured.
+     * @return GraphProfile vertices, edges, density, degrees and components of the graph.
+     */
+    template<typename G>
+    static GraphProfile profile(G &graph) {
+        Tracer::Span span("OrderingEngines::profile", "connectivity");
+        GraphProfile profile;
+        unsigned int n = graph.size();
+        profile.n = n;
+
+        vector<bool> visited(n, false);
+        vector<unsigned int> stack;
+        uint64_t degree_sum = 0;
+        for(unsigned int root = 0; root < n; ++root) {
+            if(visited[root])
+                continue;
+            profile.components++;
+            visited[root] = true;
+            stack.push_back(root);
+
+            while(!stack.empty()) {
+                unsigned int v = stack.back();
+                stack.pop_back();
+
+                unsigned int degree = 0;
+                for(auto w : graph.neighbors(v)) {
+                    degree++;
+                    if(!visited[w]) {
+                        visited[w] = true;
+                        stack.push_back(w);
+                    }
+                }
+                degree_sum += degree;
+                profile.max_degree = max(profile.max_degree, degree);
+            }
+        }
+
+        profile.m = degree_sum / 2;
+        if(n >= 2)
+            profile.density = (double) profile.m / ((double) n * (n - 1) / 2);
+        if(n > 0)
+            profile.mean_degree = (double) degree_sum / n;
+        if(profile.mean_degree > 0)
+            profile.degree_skew = profile.max_degree / profile.mean_degree;
+        return profile;
+    }
+
+    /**
+     * @brief Check in linear time if an ordering is a perfect elimination ordering, i.e. if fill_in would not add any edge
+     * (Tarjan and Yannakakis). The vertices are eliminated from alphaInverse[0]: for each vertex v, its follower f is the
+     * first neighbour eliminated after v, and every other neighbour eliminated after v must be adjacent to f. The
+     * requirements are grouped by follower, so the neighbours of each follower are marked only once.
+     * A graph is chordal if and only if the ordering of lex_p passes this check.
+     * @param graph graph to be checked.
+     * @param alphaInverse values of the vertices in elimination order, as returned by lex_p and lex_m.
+     * @return true if the ordering produces no fill.
+     * @return false if the ordering produces fill or it is not a permutation of the vertices.
+     */
+    template<typename G>
+    static bool isPerfectOrdering(G &graph, const vector<unsigned int> &alphaInverse) {
+        Tracer::Span span("OrderingEngines::isPerfectOrdering", "connectivity");
+        unsigned int n = graph.size();
+        if(alphaInverse.size() != n)
+            return false;
+
+        vector<unsigned int> position(n, n);
+        for(unsigned int i = 0; i < n; ++i) {
+            unsigned int index = graph.indexOf(alphaInverse[i]);
+            if(index >= n || position[index] != n)
+                return false;
+            position[index] = i;
+        }
+
+        // follower of each vertex and the vertices that must be adjacent to it, bucketed by follower
+        vector<unsigned int> follower(n, n);
+        vector<unsigned int> start(n + 1, 0);
+        for(unsigned int v = 0; v < n; ++v) {
+            for(auto w : graph.neighbors(v))
+                if(position[w] > position[v] && (follower[v] == n || position[w] < position[follower[v]]))
+                    follower[v] = w;
+            if(follower[v] != n)
+                for(auto w : graph.neighbors(v))
+                    if(position[w] > position[v] && w != follower[v])
+                        start[follower[v] + 1]++;
+        }
+        for(unsigned int v = 0; v < n; ++v)
+            start[v + 1] += start[v];
+
+        vector<unsigned int> required(start[n]);
+        vector<unsigned int> next(start.begin(), start.end() - 1);
+        for(unsigned int v = 0; v < n; ++v)
+            if(follower[v] != n)
+                for(auto w : graph.neighbors(v))
+                    if(position[w] > position[v] && w != follower[v])
+                        required[next[follower[v]]++] = w;
+
+        vector<unsigned int> mark(n, n);
+        for(unsigned int f = 0; f < n; ++f) {
+            if(start[f] == start[f + 1])
+                continue;
+            for(auto z : graph.neighbors(f))
+                mark[z] = f;
+            for(unsigned int i = start[f]; i < start[f + 1]; ++i)
+                if(mark[required[i]] != f)
+                    return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Same algorithm of Graph::lex_p, the sets are indexed with the dense indices of the vertices.
+     * @param graph graph to be ordered.
+     * @param stats counters of the work done, used only when CollectStats is true.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+     */
+    template<bool CollectStats = false, typename G>
+    static vector<unsigned int> lex_p(G &graph, OrderingStats *stats = nullptr) {
+        Tracer::Span span("OrderingEngines::lex_p", "ordering");
+        vector<unsigned int> alphaInverse(graph.size());
+        LexPStream<G, CollectStats> stream(graph, stats);
+        unsigned int vertex;
+        while(stream.next(vertex))
+            alphaInverse[stream.remaining()] = vertex;
+        return alphaInverse;
+    }
+
+    /**
+     * @brief Same algorithm of Graph::lex_m, but the graph is not modified. The numbered vertices are always reached, so the
+     * edges {v,z} added by the search never change the following iterations and they can be reported instead of inserted.
+     * @param graph graph to be ordered.
+     * @param fill if not null, it receives the edges of the minimal triangulation that are not in the graph.
+     * @param stats counters of the work done, used only when CollectStats is true; the fill edges are counted as calls of addEdge.
+     * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+     */
+    template<bool CollectStats = false, typename G>
+    static vector<unsigned int> lex_m(G &graph, vector<pair<unsigned int, unsigned int>> *fill = nullptr, OrderingStats *stats = nullptr) {
+        Tracer::Span span("OrderingEngines::lex_m", "ordering");
+        vector<unsigned int> alphaInverse(graph.size());
+        LexMStream<G, CollectStats> stream(graph, fill, stats);
+        unsigned int vertex;
+        while(stream.next(vertex))
+            alphaInverse[stream.remaining()] = vertex;
+        return alphaInverse;
+    }
+
+    /**
+     * @brief Same as lex_m, but the run is bounded by control, which is checked before the numbering of each vertex
+     * with the fill found so far and once more at the end with the whole fill. When the run is stopped the vertices not
+     * numbered get the lower positions with LexMStream::fallback, so the result is always an ordering of all the
+     * vertices.
+     * @param graph graph to be ordered.
+     * @param control limits of the run, it receives the outcome.
+     * @param fill if not null, it receives the fill edges of the numbered vertices.
+     * @return vector<unsigned int> structure that contains the ordered vertices, minimal when control.status() is Completed.
+     */
+    template<typename G>
+    static vector<unsigned int> lex_m(G &graph, RunControl &control, vector<pair<unsigned int, unsigned int>> *fill = nullptr) {
+        Tracer::Span span("OrderingEngines::lex_m", "ordering");
+        vector<unsigned int> alphaInverse(graph.size());
+        LexMStream<G> stream(graph, fill);
+        control.start();
+        unsigned int vertex;
+        while(stream.remaining() > 0) {
+            if(!control.proceed(stream.fillSize())) {
+                stream.fallback(alphaInverse);
+                break;
+            }
+            stream.next(vertex);
+            alphaInverse[stream.remaining()] = vertex;
+        }
+        control.finish(stream.fillSize());
+        return alphaInverse;
+    }
+};
+
+#endif
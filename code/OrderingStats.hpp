@@ -0,0 +1,56 @@
+#ifndef ORDERING_STATS_H_
+#define ORDERING_STATS_H_
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief Counters of the work done by lex_p, lex_m and fill_in, filled by the overloads that take an OrderingStats.
+ * The algorithms are templates on a CollectStats flag: the overloads without stats instantiate them with false, so the
+ * counting is compiled out of the usual calls. The counters are accumulated, so the same object can collect several calls.
+ */
+struct OrderingStats {
+    // lex_m: vertices pushed in the reach queue of each label level, reach_pushes[j] for the level j
+    vector<uint64_t> reach_pushes;
+    // lex_m: labels changed by the renumbering that follows each step
+    uint64_t label_renumberings = 0;
+    // lex_m: fill edges inserted (by addEdge, by the matrix insertion of the dense backend) or reported by the CSR engine,
+    // the same count in every backend
+    uint64_t add_edge_calls = 0;
+
+    // lex_p: cells of the partition created and destroyed
+    uint64_t cells_created = 0;
+    uint64_t cells_destroyed = 0;
+    // lex_p: vertices moved to a refined cell
+    uint64_t refinements = 0;
+
+    // fill_in: higher adjacent vertices (after the eliminated vertex in the ordering) scanned, the same in every backend
+    uint64_t neighbor_scans = 0;
+    // fill_in: edges actually added to the graph
+    uint64_t fill_edges = 0;
+
+    /**
+     * @brief Count a push in the reach queue of a level.
+     * @param level label level of the queue.
+     */
+    void reachPush(unsigned int level) {
+        if(level >= reach_pushes.size())
+            reach_pushes.resize(level + 1, 0);
+        reach_pushes[level]++;
+    }
+
+    /**
+     * @brief Get the total number of pushes in the reach queues.
+     * @return uint64_t sum of the pushes of all the levels.
+     */
+    uint64_t totalReachPushes() const {
+        uint64_t total = 0;
+        for(auto pushes : reach_pushes)
+            total += pushes;
+        return total;
+    }
+};
+
+#endif
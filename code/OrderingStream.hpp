@@ -0,0 +1,253 @@
+#ifndef ORDERING_STREAM_H_
+#define ORDERING_STREAM_H_
+
+#include "Sets.hpp"
+#include "CustomRadixSort.hpp"
+#include "PerfCounters.hpp"
+#include "OrderingStats.hpp"
+
+#include <vector>
+#include <unordered_set>
+#include <utility>
+
+using namespace std;
+
+/**
+ * @brief Lazy version of lex_p on a read-only graph G with dense indices (see OrderingEngines for the interface of G).
+ * Each call of next numbers one vertex, from n-1 down to 0, and returns it at once, so the consumer can start working on
+ * the ordering, or stop it, before it is finished. The search state is the whole buffer: no vertex is numbered before it
+ * is asked for. The graph must not change while the stream is used. OrderingEngines::lex_p is this stream run to the end.
+ */
+template<typename G, bool CollectStats = false>
+struct LexPStream {
+public:
+    /**
+     * @brief Construct a new LexPStream object, all the vertices are in the first set.
+     * @param graph graph to be ordered.
+     * @param stats counters of the work done, used only when CollectStats is true.
+     */
+    LexPStream(G &graph, OrderingStats *stats = nullptr)
+        : graph(graph), stats(stats), ordered_vertices(graph.size(), false), sets(allIndices(graph.size())), i(graph.size()) {}
+
+    LexPStream(const LexPStream &other) = delete;
+    LexPStream& operator=(const LexPStream &other) = delete;
+
+    /**
+     * @brief Number the next vertex.
+     * @param vertex it receives the value of the vertex, whose number is remaining() after the call.
+     * @return true if a vertex has been numbered.
+     * @return false if all the vertices are already numbered.
+     */
+    bool next(unsigned int &vertex) {
+        if(i == 0)
+            return false;
+        --i;
+
+        unsigned int deleted = sets.clearEmptyCells();
+        if constexpr(CollectStats)
+            stats->cells_destroyed += deleted;
+
+        // pick next vertex to number
+        unsigned int v = sets.get();
+
+        // delete cell of vertex from set
+        sets.removeDefinitely(v);
+
+        // assign v to the number i
+        vertex = graph.vertexValue(v);
+        ordered_vertices[v] = true;
+
+        PerfCounters::Scope phase(PerfCounters::PartitionRefinement);
+        unordered_set<Cell*> fixlist;
+
+        // for each w adjacent to v that has not been selected yet
+        for(auto w : graph.neighbors(v))
+            if(!ordered_vertices[w]) {
+                //delete cell of w from set
+                sets.remove(w);
+
+                Cell *prev_cell = sets.getVertexPosition(w);
+                // if h is an old set then create a new set
+                if(fixlist.find(prev_cell) == fixlist.end()) {
+                    sets.addSet(prev_cell, w);
+                    if constexpr(CollectStats)
+                        stats->cells_created++;
+                } else
+                    sets.addCell(prev_cell->next, w);
+                fixlist.insert(prev_cell);
+                if constexpr(CollectStats)
+                    stats->refinements++;
+            }
+        return true;
+    }
+
+    /**
+     * @brief Get the number of vertices not numbered yet.
+     * @return unsigned int number of vertices left.
+     */
+    unsigned int remaining() {
+        return i;
+    }
+
+private:
+    /**
+     * @brief Get the indices of the vertices, used to build the first set.
+     * @param n number of vertices.
+     * @return unordered_set<unsigned int> indices 0, 1, ..., n-1.
+     */
+    static unordered_set<unsigned int> allIndices(unsigned int n) {
+        unordered_set<unsigned int> v_t;
+        for(unsigned int j = 0; j < n; ++j)
+            v_t.insert(j);
+        return v_t;
+    }
+
+    G &graph;
+    OrderingStats *stats;
+    vector<bool> ordered_vertices;
+    Sets sets;
+    unsigned int i;
+};
+
+/**
+ * @brief Lazy version of lex_m on a read-only graph G with dense indices (see OrderingEngines for the interface of G).
+ * Each call of next numbers one vertex, from n-1 down to 0, with its search and the sort of the labels, and returns it
+ * with the fill edges found by its search. As in LexPStream no vertex is numbered before it is asked for and the graph
+ * must not change while the stream is used. OrderingEngines::lex_m is this stream run to the end.
+ */
+template<typename G, bool CollectStats = false>
+struct LexMStream {
+public:
+    /**
+     * @brief Construct a new LexMStream object, all the vertices have label 1.
+     * @param graph graph to be ordered.
+     * @param fill if not null, the fill edges found by each step are appended to it.
+     * @param stats counters of the work done, used only when CollectStats is true; the fill edges are counted as calls
+     * of addEdge.
+     */
+    LexMStream(G &graph, vector<pair<unsigned int, unsigned int>> *fill = nullptr, OrderingStats *stats = nullptr)
+        : graph(graph), fill(fill), stats(stats), vertices_and_label(graph.size()), label(graph.size(), 1),
+          numbered(graph.size(), false), reached(graph.size()), k(1), i(graph.size()), found(0) {
+        for(unsigned int j = 0; j < graph.size(); ++j)
+            vertices_and_label[j] = make_pair(j, 1);
+    }
+
+    LexMStream(const LexMStream &other) = delete;
+    LexMStream& operator=(const LexMStream &other) = delete;
+
+    /**
+     * @brief Number the next vertex.
+     * @param vertex it receives the value of the vertex, whose number is remaining() after the call.
+     * @return true if a vertex has been numbered.
+     * @return false if all the vertices are already numbered.
+     */
+    bool next(unsigned int &vertex) {
+        if(i == 0)
+            return false;
+        --i;
+
+        //pick an unnumbered vertex v with label(v) = k
+        unsigned int v = vertices_and_label[0].first;
+        vertices_and_label.erase(vertices_and_label.begin());
+
+        // assign v the number i
+        vertex = graph.vertexValue(v);
+        numbered[v] = true;
+
+        PerfCounters::Scope phase(PerfCounters::ReachSearch);
+
+        // only the numbered vertices are reached at the beginning of the search
+        reached = numbered;
+        vector<vector<unsigned int>> reach(k+1);
+        vector<unsigned int> reach_head(k+1, 0);
+
+        for(auto w : graph.neighbors(v))
+            if(!reached[w]) {
+                reach[(unsigned int) label[w]].push_back(w);
+                if constexpr(CollectStats)
+                    stats->reachPush((unsigned int) label[w]);
+                reached[w] = true;
+                label[w] += 0.5;
+            }
+
+        for(unsigned int j = 1; j <= k; ++j) {
+            while(reach_head[j] < reach[j].size()) {
+                // delete a vertex w from reach(j)
+                unsigned int w = reach[j][reach_head[j]++];
+
+                for(auto z : graph.neighbors(w))
+                    if(!reached[z]) {
+                        reached[z] = true;
+
+                        if(label[z] > j) {
+                            reach[(unsigned int) label[z]].push_back(z);
+                            if constexpr(CollectStats) {
+                                stats->reachPush((unsigned int) label[z]);
+                                stats->add_edge_calls++;
+                            }
+                            label[z] += 0.5;
+                            found++;
+                            if(fill != nullptr)
+                                fill->push_back(make_pair(vertex, graph.vertexValue(z)));
+                        } else {
+                            reach[j].push_back(z);
+                            if constexpr(CollectStats)
+                                stats->reachPush(j);
+                        }
+                    }
+            }
+        }
+
+        //sort unnumbered vertices by label(w) value
+        phase.next(PerfCounters::LabelSort);
+        if(vertices_and_label.size() != 0) {
+            for(auto &el : vertices_and_label)
+                el.second = label[el.first];
+
+            k = CustomRadixSort::sortByLabel(vertices_and_label, CollectStats ? &stats->label_renumberings : nullptr);
+
+            for(auto &el : vertices_and_label)
+                label[el.first] = el.second;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Get the number of vertices not numbered yet.
+     * @return unsigned int number of vertices left.
+     */
+    unsigned int remaining() {
+        return i;
+    }
+
+    /**
+     * @brief Get the number of fill edges found so far.
+     * @return uint64_t fill edges of the numbered vertices.
+     */
+    uint64_t fillSize() {
+        return found;
+    }
+
+    /**
+     * @brief Give the positions 0, ..., remaining()-1 to the vertices not numbered yet, in the order of their current
+     * labels, i.e. the order in which lex_m would try them next. It completes the ordering of a stream stopped early.
+     * @param alphaInverse ordering whose last positions hold the numbered vertices.
+     */
+    void fallback(vector<unsigned int> &alphaInverse) {
+        for(unsigned int j = 0; j < vertices_and_label.size(); ++j)
+            alphaInverse[i-1-j] = graph.vertexValue(vertices_and_label[j].first);
+    }
+
+private:
+    G &graph;
+    vector<pair<unsigned int, unsigned int>> *fill;
+    OrderingStats *stats;
+    vector<pair<unsigned int, float>> vertices_and_label;
+    vector<float> label;
+    vector<bool> numbered, reached;
+    unsigned int k;
+    unsigned int i;
+    uint64_t found;
+};
+
+#endif
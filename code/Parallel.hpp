@@ -0,0 +1,113 @@
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include "Tracer.hpp"
+#include "ThreadPool.hpp"
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+
+using namespace std;
+
+/**
+ * @brief Auxiliary structure that contains the few parallel primitives used by the library: a parallel loop over independent
+ * tasks and a parallel sort, both run on the shared ThreadPool. The tasks are distributed dynamically, so they can have
+ * different costs. Every task is a span of the Tracer, so the load balance of the threads is visible in the traces.
+ */
+struct Parallel {
+public:
+
+    /**
+     * @brief Get the number of threads to be used.
+     * @param requested number of threads requested by the caller, 0 means one for each hardware thread.
+     * @return unsigned int number of threads, at least 1.
+     */
+    static unsigned int numThreads(unsigned int requested = 0) {
+        if(requested != 0)
+            return requested;
+        return max(1u, thread::hardware_concurrency());
+    }
+
+    /**
+     * @brief Call f(i) for each i in [0, num_tasks), the calls are distributed among the calling thread and the workers
+     * of the shared ThreadPool. The caller spawns a helper for each other thread and then takes tasks itself, so the
+     * loop progresses even when all the workers are busy and the loops can be nested (e.g. inside a job of JobEngine).
+     * The helpers that start after the last task has been taken return at once without touching f.
+     * @param num_tasks number of tasks.
+     * @param f function that executes a task, calls with different i must be independent.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread; at most the workers of
+     * the pool plus the caller are used.
+     */
+    template<typename F>
+    static void forEach(unsigned int num_tasks, F f, unsigned int num_threads = 0) {
+        ThreadPool &pool = ThreadPool::shared();
+        unsigned int t = min(min(numThreads(num_threads), num_tasks), pool.size() + 1);
+        if(t <= 1) {
+            for(unsigned int i = 0; i < num_tasks; ++i) {
+                Tracer::Span span("Parallel::task", "parallel");
+                f(i);
+            }
+            return;
+        }
+
+        struct Loop {
+            atomic<unsigned int> next{0};
+            atomic<unsigned int> done{0};
+        };
+        shared_ptr<Loop> loop = make_shared<Loop>();
+        auto worker = [loop, num_tasks, &f]() {
+            for(unsigned int i = loop->next++; i < num_tasks; i = loop->next++) {
+                {
+                    Tracer::Span span("Parallel::task", "parallel");
+                    f(i);
+                }
+                loop->done++;
+            }
+        };
+
+        for(unsigned int i = 1; i < t; ++i)
+            pool.spawn(worker);
+        worker();
+        while(loop->done.load() < num_tasks)
+            this_thread::yield();
+    }
+
+    /**
+     * @brief Sort a vector in parallel: the blocks of the vector are sorted independently, then they are merged in pairs
+     * until a single block remains.
+     * @param values vector to be sorted.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     */
+    template<typename T>
+    static void sort(vector<T> &values, unsigned int num_threads = 0) {
+        unsigned int t = numThreads(num_threads);
+        size_t n = values.size();
+        if(t <= 1 || n < 4096) {
+            std::sort(values.begin(), values.end());
+            return;
+        }
+
+        vector<size_t> bounds(t + 1);
+        for(unsigned int i = 0; i <= t; ++i)
+            bounds[i] = n * i / t;
+
+        forEach(t, [&](unsigned int i) {
+            std::sort(values.begin() + bounds[i], values.begin() + bounds[i+1]);
+        }, t);
+
+        for(unsigned int width = 1; width < t; width *= 2) {
+            unsigned int pairs = (t + 2*width - 1) / (2*width);
+            forEach(pairs, [&](unsigned int p) {
+                unsigned int first = 2*width*p;
+                unsigned int middle = min(first + width, t), last = min(first + 2*width, t);
+                if(middle < last)
+                    inplace_merge(values.begin() + bounds[first], values.begin() + bounds[middle], values.begin() + bounds[last]);
+            }, t);
+        }
+    }
+};
+
+#endif
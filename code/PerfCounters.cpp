@@ -0,0 +1,218 @@
+#include "PerfCounters.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Counters opened by a thread. The events are opened as a single group, so they are read with one system call
+ * and they are scheduled together on the PMU; position tells where the value of each event is in the group read.
+ */
+struct PerfCounters::Collector {
+    int leader = -1;
+    int fds[NUM_EVENTS];
+    int position[NUM_EVENTS];
+    unsigned int num_open = 0;
+    Stats stats;
+};
+
+#ifdef __linux__
+/**
+ * @brief Open a counter of the calling thread, only the user space is counted, so it works with perf_event_paranoid <= 2.
+ * @param type type of the event (hardware or hardware cache).
+ * @param config configuration of the event.
+ * @param group file descriptor of the leader of the group, -1 to open the leader.
+ * @return int file descriptor of the counter, -1 if it is not available.
+ */
+static int openCounter(uint32_t type, uint64_t config, int group) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+static const uint32_t EVENT_TYPES[PerfCounters::NUM_EVENTS] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE
+};
+
+static const uint64_t EVENT_CONFIGS[PerfCounters::NUM_EVENTS] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+#endif
+
+/**
+ * @brief Read the counters of a collector and the clock.
+ * @param collector counters of the thread.
+ * @param values it receives the value of each event (0 for the unsupported ones) and the time in nanoseconds in the last position.
+ */
+void PerfCounters::readCounters(Collector *collector, uint64_t *values) {
+    for(unsigned int e = 0; e < PerfCounters::NUM_EVENTS; ++e)
+        values[e] = 0;
+#ifdef __linux__
+    if(collector->leader != -1) {
+        uint64_t buffer[PerfCounters::NUM_EVENTS + 1];
+        if(read(collector->leader, buffer, sizeof(buffer)) >= (ssize_t) sizeof(uint64_t))
+            for(unsigned int e = 0; e < PerfCounters::NUM_EVENTS; ++e)
+                if(collector->position[e] != -1 && (uint64_t) collector->position[e] < buffer[0])
+                    values[e] = buffer[1 + collector->position[e]];
+    }
+#endif
+    values[PerfCounters::NUM_EVENTS] = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Close the counters of a collector and delete it.
+ * @param collector collector to be closed.
+ */
+void PerfCounters::closeCollector(Collector *collector) {
+#ifdef __linux__
+    for(unsigned int e = 0; e < PerfCounters::NUM_EVENTS; ++e)
+        if(collector->fds[e] != -1)
+            close(collector->fds[e]);
+#endif
+    delete collector;
+}
+
+PerfCounters::Stats::Stats() {
+    memset(supported, 0, sizeof(supported));
+    memset(values, 0, sizeof(values));
+    memset(nanoseconds, 0, sizeof(nanoseconds));
+    memset(calls, 0, sizeof(calls));
+}
+
+/**
+ * @brief Check if at least an hardware event has been counted.
+ * @return true if the hardware counters were available.
+ */
+bool PerfCounters::Stats::hardware() const {
+    for(unsigned int e = 0; e < NUM_EVENTS; ++e)
+        if(supported[e])
+            return true;
+    return false;
+}
+
+/**
+ * @brief Add the counters of another collection.
+ * @param other counters to be added.
+ */
+void PerfCounters::Stats::merge(const Stats &other) {
+    for(unsigned int e = 0; e < NUM_EVENTS; ++e)
+        supported[e] = supported[e] || other.supported[e];
+    for(unsigned int p = 0; p < NUM_PHASES; ++p) {
+        for(unsigned int e = 0; e < NUM_EVENTS; ++e)
+            values[p][e] += other.values[p][e];
+        nanoseconds[p] += other.nanoseconds[p];
+        calls[p] += other.calls[p];
+    }
+}
+
+/**
+ * @brief Read the counters at the beginning of the scope.
+ */
+void PerfCounters::Scope::begin() {
+    readCounters(collector, start);
+}
+
+/**
+ * @brief Read the counters at the end of the scope and accumulate the difference in the phase.
+ */
+void PerfCounters::Scope::end() {
+    // the collection has been stopped inside the scope
+    if(collector == nullptr)
+        return;
+
+    uint64_t now[NUM_EVENTS + 1];
+    readCounters(collector, now);
+
+    Stats &stats = collector->stats;
+    for(unsigned int e = 0; e < NUM_EVENTS; ++e)
+        stats.values[phase][e] += now[e] - start[e];
+    stats.nanoseconds[phase] += now[NUM_EVENTS] - start[NUM_EVENTS];
+    stats.calls[phase]++;
+}
+
+/**
+ * @brief Begin a collection on the calling thread, an active collection of the thread is restarted.
+ * @return true if the hardware counters are available.
+ * @return false if only the calls and the time of the phases will be measured.
+ */
+bool PerfCounters::start() {
+    if(collector != nullptr)
+        closeCollector(collector);
+    collector = new Collector();
+
+    for(unsigned int e = 0; e < NUM_EVENTS; ++e) {
+        collector->fds[e] = -1;
+        collector->position[e] = -1;
+    }
+
+#ifdef __linux__
+    // the first event that can be opened leads the group, the unsupported events are skipped
+    for(unsigned int e = 0; e < NUM_EVENTS; ++e) {
+        int fd = openCounter(EVENT_TYPES[e], EVENT_CONFIGS[e], collector->leader);
+        if(fd == -1)
+            continue;
+        if(collector->leader == -1)
+            collector->leader = fd;
+        collector->fds[e] = fd;
+        collector->position[e] = collector->num_open++;
+        collector->stats.supported[e] = true;
+    }
+
+    if(collector->leader != -1) {
+        ioctl(collector->leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(collector->leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+    return collector->leader != -1;
+}
+
+/**
+ * @brief End the collection of the calling thread.
+ * @return Stats counters accumulated since start, all zero if no collection was active.
+ */
+PerfCounters::Stats PerfCounters::stop() {
+    if(collector == nullptr)
+        return Stats();
+
+    Stats stats = collector->stats;
+    closeCollector(collector);
+    collector = nullptr;
+    return stats;
+}
+
+/**
+ * @brief Get the name of an event, as used in the benchmark counters.
+ * @param event event.
+ * @return const char* name of the event.
+ */
+const char* PerfCounters::eventName(Event event) {
+    static const char *names[NUM_EVENTS] = {"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+    return event < NUM_EVENTS ? names[event] : "unknown";
+}
+
+/**
+ * @brief Get the name of a phase, as used in the benchmark counters.
+ * @param phase phase.
+ * @return const char* name of the phase.
+ */
+const char* PerfCounters::phaseName(Phase phase) {
+    static const char *names[NUM_PHASES] = {"label_sort", "reach_search", "fill_insertion", "partition_refinement"};
+    return phase < NUM_PHASES ? names[phase] : "unknown";
+}
@@ -0,0 +1,152 @@
+#ifndef PERF_COUNTERS_H_
+#define PERF_COUNTERS_H_
+
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief Auxiliary structure that measures the phases of the ordering algorithms with the hardware performance counters
+ * of the processor (perf_event_open on Linux): cycles, instructions, L1 data cache misses, last level cache misses and
+ * branch mispredictions. The instrumentation is optional and per thread: start opens the counters for the calling
+ * thread, the phases executed by that thread are accumulated until stop, which returns them as Stats. While no
+ * collection is active a phase costs a single check of a thread local pointer.
+ * If the counters are not available (other systems, perf_event_paranoid, virtual machines without a PMU) the collection
+ * falls back to the number of calls and the elapsed time of each phase, and Stats tells which events were read.
+ */
+struct PerfCounters {
+public:
+    /**
+     * @brief Hardware events that are counted.
+     */
+    enum Event { Cycles, Instructions, L1Misses, LLCMisses, BranchMisses, NUM_EVENTS };
+
+    /**
+     * @brief Phases of the algorithms: sorting the vertices by label and the reach search of lex_m, insertion of the fill
+     * edges of lex_m and fill_in, refinement of the partition of lex_p.
+     */
+    enum Phase { LabelSort, ReachSearch, FillInsertion, PartitionRefinement, NUM_PHASES };
+
+    /**
+     * @brief Counters accumulated by a collection.
+     */
+    struct Stats {
+        // True if the event has been counted, false if it is not supported
+        bool supported[NUM_EVENTS];
+        // Value of each event in each phase
+        uint64_t values[NUM_PHASES][NUM_EVENTS];
+        // Elapsed time of each phase, always measured
+        uint64_t nanoseconds[NUM_PHASES];
+        // Number of times each phase has been executed
+        uint64_t calls[NUM_PHASES];
+
+        Stats();
+
+        /**
+         * @brief Check if at least an hardware event has been counted.
+         * @return true if the hardware counters were available.
+         */
+        bool hardware() const;
+
+        /**
+         * @brief Add the counters of another collection.
+         * @param other counters to be added.
+         */
+        void merge(const Stats &other);
+    };
+
+    /**
+     * @brief Scope of a phase: the counters are read when the scope begins and when it ends, the difference is accumulated
+     * in the collection of the thread. It does nothing if no collection was active when it began.
+     */
+    struct Scope {
+    public:
+        Scope(Phase phase) : phase(phase), enabled(collector != nullptr) {
+            if(enabled)
+                begin();
+        }
+
+        ~Scope() {
+            if(enabled)
+                end();
+        }
+
+        /**
+         * @brief End the current phase and begin another one, so consecutive phases of a loop share the same scope.
+         * @param next_phase phase that begins.
+         */
+        void next(Phase next_phase) {
+            if(enabled) {
+                end();
+                phase = next_phase;
+                begin();
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Phase phase;
+        bool enabled;
+        uint64_t start[NUM_EVENTS + 1];
+
+        void begin();
+        void end();
+    };
+
+    /**
+     * @brief Begin a collection on the calling thread, an active collection of the thread is restarted.
+     * @return true if the hardware counters are available.
+     * @return false if only the calls and the time of the phases will be measured.
+     */
+    static bool start();
+
+    /**
+     * @brief End the collection of the calling thread.
+     * @return Stats counters accumulated since start, all zero if no collection was active.
+     */
+    static Stats stop();
+
+    /**
+     * @brief Check if a collection is active on the calling thread.
+     * @return true if it is active.
+     */
+    static bool active() {
+        return collector != nullptr;
+    }
+
+    /**
+     * @brief Get the name of an event, as used in the benchmark counters.
+     * @param event event.
+     * @return const char* name of the event.
+     */
+    static const char* eventName(Event event);
+
+    /**
+     * @brief Get the name of a phase, as used in the benchmark counters.
+     * @param phase phase.
+     * @return const char* name of the phase.
+     */
+    static const char* phaseName(Phase phase);
+
+private:
+    struct Collector;
+
+    /**
+     * @brief Read the counters of a collector and the clock.
+     * @param collector counters of the thread.
+     * @param values it receives the value of each event (0 for the unsupported ones) and the time in nanoseconds in the last position.
+     */
+    static void readCounters(Collector *collector, uint64_t *values);
+
+    /**
+     * @brief Close the counters of a collector and delete it.
+     * @param collector collector to be closed.
+     */
+    static void closeCollector(Collector *collector);
+
+    static inline thread_local Collector *collector = nullptr;
+};
+
+#endif
@@ -1,42 +1,54 @@
 #include "RandomGraphGenerator.hpp"
+#include "ErdosRenyiGenerator.hpp"
+#include "RandomStream.hpp"
 
 /**
  * @brief Construct a new Random Graph Generator object that will have a number of vertices specified in the 
  * first parameter.
  * @param num_vertices integer that specifies the number of vertices of the random graph.
  */
-RandomGraphGenerator::RandomGraphGenerator(unsigned int num_vertices) : num_vertices(num_vertices) {}
+RandomGraphGenerator::RandomGraphGenerator(unsigned int num_vertices) : num_vertices(num_vertices) {
+    random_device rd;
+    seed = ((uint64_t) rd() << 32) | rd();
+}
+
+/**
+ * @brief Construct a new Random Graph Generator object that will have a number of vertices specified in the
+ * first parameter and that will always generate the same graph for the same seed.
+ * @param num_vertices integer that specifies the number of vertices of the random graph.
+ * @param seed seed of the generator.
+ */
+RandomGraphGenerator::RandomGraphGenerator(unsigned int num_vertices, uint64_t seed) : num_vertices(num_vertices), seed(seed) {}
 
 /**
  * @brief Generate the random graph.
  */
 void RandomGraphGenerator::generate() {
-    random_device rd;
-    mt19937 gen(rd());
-    // num of edges in the graph between (n-1) and (n*(n-1) / 2)
-    uniform_int_distribution<> distr_edge(num_vertices-1, (num_vertices*(num_vertices-1))/2);
-
-    unsigned int num_edges = distr_edge(gen);
+    vertices.clear();
+    src_edges.clear();
+    dst_edges.clear();
+    if(num_vertices == 0)
+        return;
 
-    boost::minstd_rand graph_gen;
-    boost::graph_traits<Graph>::vertices_size_type n(num_vertices);
-    boost::graph_traits<Graph>::edges_size_type m(num_edges);
+    // num of edges in the graph between (n-1) and (n*(n-1) / 2)
+    CustomGraph::RandomStream random(seed);
+    uint64_t min_edges = num_vertices - 1;
+    uint64_t num_edges = min_edges + random.below(CustomGraph::ErdosRenyiGenerator::maxEdges(num_vertices) - min_edges + 1);
 
-    boost::adjacency_list<> g(ERGen(graph_gen, n, m, false), ERGen(), n);
+    vector<pair<unsigned int, unsigned int>> edges;
+    CustomGraph::ErdosRenyiGenerator::generateEdges(num_vertices, num_edges, random.next(), edges);
 
-    boost::graph_traits<Graph>::vertex_iterator vi, vi_end;
- 
-    for(boost::tie(vi, vi_end) = boost::vertices(g); vi != vi_end; ++vi)
-        vertices.push_back((unsigned int) (*vi));
+    for(unsigned int v = 0; v < num_vertices; ++v)
+        vertices.push_back(v);
 
-    boost::graph_traits<Graph>::edge_iterator ei, ei_end;
-    for(boost::tie(ei, ei_end) = boost::edges(g); ei != ei_end; ++ei){
-        src_edges.push_back((unsigned int) (*ei).m_source);
-        dst_edges.push_back((unsigned int) (*ei).m_target);
+    src_edges.reserve(edges.size());
+    dst_edges.reserve(edges.size());
+    for(auto &edge : edges) {
+        src_edges.push_back(edge.first);
+        dst_edges.push_back(edge.second);
     }
 }
 
-
 /**
  * @brief Get the Vertices that have been generated randomly.
  * @return vector<unsigned int> that contains the vertices.
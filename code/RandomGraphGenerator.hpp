@@ -1,22 +1,16 @@
 #ifndef RANDOM_GRAPH_GENERATOR_H_
 #define RANDOM_GRAPH_GENERATOR_H_
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/erdos_renyi_generator.hpp>
-#include <boost/random/linear_congruential.hpp>
-
 #include <vector>
 #include <random>
+#include <cstdint>
 
 using namespace std;
 
-typedef boost::adjacency_list<> Graph;
-typedef boost::erdos_renyi_iterator<boost::minstd_rand, Graph> ERGen;
-
 /**
  * @brief auxiliary structure that allows to create undirected connected graphs that will be used for testing.
- * It exploits the Erdos - Renyi model to generate graphs in a random manner, to obtain this solution a BOOST
- * graph library has been used.
+ * It exploits the Erdos - Renyi model to generate graphs in a random manner, the edges are produced by
+ * CustomGraph::ErdosRenyiGenerator, so the graph is connected by construction and it is reproducible from its seed.
  */
 struct RandomGraphGenerator {
     /**
@@ -26,6 +20,14 @@ struct RandomGraphGenerator {
      */
     RandomGraphGenerator(unsigned int num_vertices) ;
 
+    /**
+     * @brief Construct a new Random Graph Generator object that will have a number of vertices specified in the
+     * first parameter and that will always generate the same graph for the same seed.
+     * @param num_vertices integer that specifies the number of vertices of the random graph.
+     * @param seed seed of the generator.
+     */
+    RandomGraphGenerator(unsigned int num_vertices, uint64_t seed);
+
     /**
      * @brief Generate the random graph.
      */
@@ -56,6 +58,11 @@ private:
      */
     unsigned int num_vertices;
 
+    /**
+     * @brief Seed of the generator.
+     */
+    uint64_t seed;
+
     /**
      * @brief Vertices generated after the call of generate function.
      */
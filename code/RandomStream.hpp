@@ -0,0 +1,63 @@
+#ifndef RANDOM_STREAM_H_
+#define RANDOM_STREAM_H_
+
+#include <random>
+#include <cstdint>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Reproducible stream of random numbers used by the graph generators. A generator seeded with s splits its work
+ * in tasks and gives the task i the stream (s, i), so the result depends only on the seed and not on the number of
+ * threads. Bounded integers and reals are derived from the raw 64-bit output without the standard distributions,
+ * whose results differ between standard libraries.
+ */
+struct RandomStream {
+public:
+    /**
+     * @brief Construct a new RandomStream object.
+     * @param seed seed chosen by the user.
+     * @param stream index of the stream, different streams of the same seed are independent.
+     */
+    RandomStream(uint64_t seed, uint64_t stream = 0) {
+        seed_seq sequence{(uint32_t) seed, (uint32_t) (seed >> 32), (uint32_t) stream, (uint32_t) (stream >> 32)};
+        engine.seed(sequence);
+    }
+
+    /**
+     * @brief Get the next raw 64-bit value.
+     * @return uint64_t random value.
+     */
+    uint64_t next() {
+        return engine();
+    }
+
+    /**
+     * @brief Get a random integer in [0, bound) with the multiply-shift reduction.
+     * @param bound upper bound, it must be positive.
+     * @return uint64_t random integer.
+     */
+    uint64_t below(uint64_t bound) {
+        return (uint64_t) (((unsigned __int128) engine() * bound) >> 64);
+    }
+
+    /**
+     * @brief Get a random real in [0, 1) with 53 random bits.
+     * @return double random real.
+     */
+    double uniform() {
+        return (engine() >> 11) * 0x1.0p-53;
+    }
+
+private:
+    /**
+     * @brief Engine that produces the raw values.
+     */
+    mt19937_64 engine;
+};
+
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include "RunControl.hpp"
+
+/**
+ * @brief Construct a new RunControl object without limits.
+ */
+RunControl::RunControl()
+    : hasDeadline(false), fillBudget(UINT64_MAX), cancelled(false), runStatus(Status::Completed), doneSteps(0), clockCountdown(0) {}
+
+/**
+ * @brief Set the time at which the runs have to stop.
+ * @param deadline point in time of the steady clock.
+ */
+void RunControl::setDeadline(chrono::steady_clock::time_point deadline) {
+    this->deadline = deadline;
+    hasDeadline = true;
+}
+
+/**
+ * @brief Set the deadline to a certain time from now.
+ * @param timeout time left to the runs.
+ */
+void RunControl::setTimeout(chrono::nanoseconds timeout) {
+    setDeadline(chrono::steady_clock::now() + timeout);
+}
+
+/**
+ * @brief Set the maximum number of fill edges of a run, the run stops at the first check after the fill goes beyond it.
+ * @param budget number of fill edges allowed.
+ */
+void RunControl::setFillBudget(uint64_t budget) {
+    fillBudget = budget;
+}
+
+/**
+ * @brief Ask the current run (and the next ones) to stop, it can be called by any thread.
+ */
+void RunControl::cancel() {
+    cancelled.store(true, memory_order_relaxed);
+}
+
+/**
+ * @brief Check if cancel has been called.
+ * @return true if the runs are cancelled.
+ */
+bool RunControl::isCancelled() {
+    return cancelled.load(memory_order_relaxed);
+}
+
+/**
+ * @brief Get the outcome of the last run.
+ * @return Status Completed if it has not been stopped, otherwise the limit that stopped it.
+ */
+RunControl::Status RunControl::status() {
+    return runStatus;
+}
+
+/**
+ * @brief Get the number of steps done by the last run before it ended or stopped.
+ * @return unsigned int vertices numbered by lex_m or eliminated by fill_in.
+ */
+unsigned int RunControl::steps() {
+    return doneSteps;
+}
+
+/**
+ * @brief Begin a run, it is called by the algorithms: the status is Completed and no step is done.
+ */
+void RunControl::start() {
+    runStatus = Status::Completed;
+    doneSteps = 0;
+    clockCountdown = 0;
+}
+
+/**
+ * @brief Check the limits before a step, it is called by the algorithms. The first check of a run always reads the
+ * clock, so an expired deadline stops the run before its first step.
+ * @param fill number of fill edges of the run so far.
+ * @return true if the step can be done, it is counted.
+ * @return false if the run has to stop, status tells why.
+ */
+bool RunControl::proceed(uint64_t fill) {
+    if(cancelled.load(memory_order_relaxed))
+        runStatus = Status::Cancelled;
+    else if(fill > fillBudget)
+        runStatus = Status::FillBudgetExceeded;
+    else if(hasDeadline && clockCountdown-- == 0) {
+        clockCountdown = CLOCK_STRIDE - 1;
+        if(chrono::steady_clock::now() >= deadline)
+            runStatus = Status::DeadlineExpired;
+    }
+
+    if(runStatus != Status::Completed)
+        return false;
+    doneSteps++;
+    return true;
+}
+
+/**
+ * @brief Check the fill budget after the last step, it is called by the algorithms that have done all their steps.
+ * @param fill number of fill edges of the whole run.
+ * @return true if the run is Completed.
+ * @return false if the fill went beyond the budget, the status is FillBudgetExceeded.
+ */
+bool RunControl::finish(uint64_t fill) {
+    if(runStatus == Status::Completed && fill > fillBudget)
+        runStatus = Status::FillBudgetExceeded;
+    return runStatus == Status::Completed;
+}
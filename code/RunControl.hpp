@@ -0,0 +1,114 @@
+#ifndef RUN_CONTROL_H_
+#define RUN_CONTROL_H_
+
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * @brief Auxiliary structure that bounds a run of lex_m or fill_in with a deadline, a budget of fill edges and a
+ * cancellation token. The limits are checked cooperatively by the algorithms at the beginning of each iteration of their
+ * outer loop, i.e. after the numbering of a vertex (lex_m) or the elimination of a vertex (fill_in), so a run never stops
+ * in the middle of a step and the latency after the expiry is bounded by one step. The clock is read once every
+ * CLOCK_STRIDE checks, the budget and the token at every check. The budget is checked once more after the last step, so
+ * a run whose last step goes beyond it is not Completed.
+ * A stopped run still returns a result, see the functions that take a RunControl, and status tells why it stopped.
+ * The limits are kept across runs, so the same object can bound several runs; cancel can be called by any thread while
+ * a run is going on.
+ */
+struct RunControl {
+public:
+    /**
+     * @brief Outcome of the last run.
+     * - Completed: the run has not been stopped.
+     * - DeadlineExpired: the deadline passed before the end.
+     * - FillBudgetExceeded: the fill edges added (or found) went beyond the budget.
+     * - Cancelled: cancel was called.
+     */
+    enum class Status { Completed, DeadlineExpired, FillBudgetExceeded, Cancelled };
+
+    /**
+     * @brief Number of checks between two readings of the clock.
+     */
+    static constexpr unsigned int CLOCK_STRIDE = 16;
+
+    /**
+     * @brief Construct a new RunControl object without limits.
+     */
+    RunControl();
+
+    /**
+     * @brief Set the time at which the runs have to stop.
+     * @param deadline point in time of the steady clock.
+     */
+    void setDeadline(chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Set the deadline to a certain time from now.
+     * @param timeout time left to the runs.
+     */
+    void setTimeout(chrono::nanoseconds timeout);
+
+    /**
+     * @brief Set the maximum number of fill edges of a run, the run stops at the first check after the fill goes beyond it.
+     * @param budget number of fill edges allowed.
+     */
+    void setFillBudget(uint64_t budget);
+
+    /**
+     * @brief Ask the current run (and the next ones) to stop, it can be called by any thread.
+     */
+    void cancel();
+
+    /**
+     * @brief Check if cancel has been called.
+     * @return true if the runs are cancelled.
+     */
+    bool isCancelled();
+
+    /**
+     * @brief Get the outcome of the last run.
+     * @return Status Completed if it has not been stopped, otherwise the limit that stopped it.
+     */
+    Status status();
+
+    /**
+     * @brief Get the number of steps done by the last run before it ended or stopped.
+     * @return unsigned int vertices numbered by lex_m or eliminated by fill_in.
+     */
+    unsigned int steps();
+
+    /**
+     * @brief Begin a run, it is called by the algorithms: the status is Completed and no step is done.
+     */
+    void start();
+
+    /**
+     * @brief Check the limits before a step, it is called by the algorithms.
+     * @param fill number of fill edges of the run so far.
+     * @return true if the step can be done, it is counted.
+     * @return false if the run has to stop, status tells why.
+     */
+    bool proceed(uint64_t fill);
+
+    /**
+     * @brief Check the fill budget after the last step, it is called by the algorithms that have done all their steps.
+     * @param fill number of fill edges of the whole run.
+     * @return true if the run is Completed.
+     * @return false if the fill went beyond the budget, the status is FillBudgetExceeded.
+     */
+    bool finish(uint64_t fill);
+
+private:
+    chrono::steady_clock::time_point deadline;
+    bool hasDeadline;
+    uint64_t fillBudget;
+    atomic<bool> cancelled;
+    Status runStatus;
+    unsigned int doneSteps;
+    unsigned int clockCountdown;
+};
+
+#endif
@@ -108,8 +108,10 @@ unsigned int Sets::size() {
 
 /**
  * @brief Delete from the sets object the cells that are empty.
+ * @return unsigned int number of cells deleted.
  */
-void Sets::clearEmptyCells() {
+unsigned int Sets::clearEmptyCells() {
+    unsigned int deleted = empty_cells.size();
     for(auto cell : empty_cells) {
         if(cell == sets) 
             sets = sets->back;
@@ -128,4 +130,5 @@ void Sets::clearEmptyCells() {
         delete cell;
     }
     empty_cells.clear();
+    return deleted;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <list>
+#include <cstddef>
 
 using namespace std;
 
@@ -84,8 +85,9 @@ public:
 
     /**
      * @brief Delete from the sets object the cells that are empty.
+     * @return unsigned int number of cells deleted.
      */
-    void clearEmptyCells();
+    unsigned int clearEmptyCells();
 
 private:
     /**
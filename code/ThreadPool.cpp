@@ -0,0 +1,193 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Pool and index of the worker that is running the thread, null and -1 for the other threads.
+ */
+static thread_local ThreadPool *current_pool = nullptr;
+static thread_local int current_index = -1;
+
+/**
+ * @brief Construct a new ThreadPool object and start its workers.
+ * @param num_threads number of workers, 0 means one for each hardware thread.
+ */
+ThreadPool::ThreadPool(unsigned int num_threads) : lastClient(0), pending(0), stolen(0), stopping(false) {
+    if(num_threads == 0)
+        num_threads = max(1u, thread::hardware_concurrency());
+    for(unsigned int i = 0; i < num_threads; ++i)
+        workers.push_back(make_unique<Worker>());
+    for(unsigned int i = 0; i < num_threads; ++i)
+        threads.emplace_back(&ThreadPool::work, this, i);
+}
+
+/**
+ * @brief Destroy the ThreadPool object, the workers run the pending tasks and then they are joined.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(auto &t : threads)
+        t.join();
+}
+
+/**
+ * @brief Get the pool of the process, it is created at the first call with one worker for each hardware thread.
+ * @return ThreadPool& shared pool.
+ */
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+/**
+ * @brief Get the number of workers.
+ * @return unsigned int number of threads of the pool.
+ */
+unsigned int ThreadPool::size() {
+    return workers.size();
+}
+
+/**
+ * @brief Get the index of the worker that is running the calling thread.
+ * @return int index of the worker in its pool, -1 if the caller is not a worker.
+ */
+int ThreadPool::currentWorker() {
+    return current_index;
+}
+
+/**
+ * @brief Add a task that is part of a larger computation: from a worker of this pool it goes to the back of its
+ * deque, from any other thread to the shared queue.
+ * @param task function to be run.
+ */
+void ThreadPool::spawn(function<void()> task) {
+    if(current_pool == this) {
+        Worker &worker = *workers[current_index];
+        lock_guard<mutex> lock(worker.lock);
+        worker.tasks.push_back(move(task));
+    } else {
+        lock_guard<mutex> lock(queuesLock);
+        injected.push_back(move(task));
+    }
+    notify();
+}
+
+/**
+ * @brief Add an independent task in the queue of a client, the clients with pending tasks are served round robin.
+ * @param task function to be run.
+ * @param client key of the client.
+ */
+void ThreadPool::submit(function<void()> task, unsigned int client) {
+    {
+        lock_guard<mutex> lock(queuesLock);
+        clients[client].push_back(move(task));
+    }
+    notify();
+}
+
+/**
+ * @brief Get the number of tasks stolen from the deque of another worker since the pool was created.
+ * @return uint64_t number of steals.
+ */
+uint64_t ThreadPool::steals() {
+    return stolen.load();
+}
+
+/**
+ * @brief Body of a worker: it runs the tasks it finds and it sleeps while there are none.
+ * @param index index of the worker.
+ */
+void ThreadPool::work(unsigned int index) {
+    current_pool = this;
+    current_index = index;
+    function<void()> task;
+    while(true) {
+        if(take(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        unique_lock<mutex> lock(sleepLock);
+        wake.wait(lock, [this]() { return stopping || pending.load() > 0; });
+        if(stopping && pending.load() == 0)
+            return;
+    }
+}
+
+/**
+ * @brief Take a pending task: the back of the deque of the worker, the front of the other deques, the shared queue and
+ * the next client with pending tasks after the one served last.
+ * @param index index of the worker that looks for it, -1 for the other threads.
+ * @param task it receives the task.
+ * @return true if a task has been taken.
+ */
+bool ThreadPool::take(int index, function<void()> &task) {
+    if(pending.load() == 0)
+        return false;
+
+    if(index >= 0) {
+        Worker &own = *workers[index];
+        lock_guard<mutex> lock(own.lock);
+        if(!own.tasks.empty()) {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            pending--;
+            return true;
+        }
+    }
+
+    unsigned int n = workers.size();
+    unsigned int first = index >= 0 ? index + 1 : 0;
+    for(unsigned int k = 0; k < n; ++k) {
+        unsigned int victim = (first + k) % n;
+        if((int) victim == index)
+            continue;
+        Worker &other = *workers[victim];
+        lock_guard<mutex> lock(other.lock);
+        if(!other.tasks.empty()) {
+            task = move(other.tasks.front());
+            other.tasks.pop_front();
+            pending--;
+            stolen++;
+            return true;
+        }
+    }
+
+    lock_guard<mutex> lock(queuesLock);
+    if(!injected.empty()) {
+        task = move(injected.front());
+        injected.pop_front();
+        pending--;
+        return true;
+    }
+    if(clients.empty())
+        return false;
+
+    auto it = clients.upper_bound(lastClient);
+    if(it == clients.end())
+        it = clients.begin();
+    task = move(it->second.front());
+    it->second.pop_front();
+    lastClient = it->first;
+    if(it->second.empty())
+        clients.erase(it);
+    pending--;
+    return true;
+}
+
+/**
+ * @brief Count a new task and wake up a sleeping worker. The lock is taken before the notification, so a worker that
+ * has just seen no task is already waiting and it does not miss it.
+ */
+void ThreadPool::notify() {
+    pending++;
+    {
+        lock_guard<mutex> lock(sleepLock);
+    }
+    wake.notify_one();
+}
@@ -0,0 +1,129 @@
+#ifndef THREAD_POOL_H_
+#define THREAD_POOL_H_
+
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+using namespace std;
+
+/**
+ * @brief Auxiliary structure that runs tasks on a fixed set of threads with work stealing. Every worker has its own deque:
+ * the tasks spawned by a worker are pushed at its back and popped from there (the most recent first, while its data is
+ * still in cache), an idle worker steals from the front of the deques of the others (the oldest tasks, usually the
+ * largest). The tasks spawned by the other threads go to a shared queue, and the tasks submitted with a client key go to
+ * one queue per client, served round robin so that a client with many tasks cannot starve the others. A worker looks for
+ * work in this order: its deque, the other deques, the shared queue, the client queues; so the tasks of a parallel loop
+ * already started come before new jobs.
+ * shared() is the pool of the process, used by Parallel and by JobEngine.
+ */
+struct ThreadPool {
+public:
+    /**
+     * @brief Construct a new ThreadPool object and start its workers.
+     * @param num_threads number of workers, 0 means one for each hardware thread.
+     */
+    ThreadPool(unsigned int num_threads = 0);
+
+    ThreadPool(const ThreadPool &other) = delete;
+    ThreadPool& operator=(const ThreadPool &other) = delete;
+
+    /**
+     * @brief Destroy the ThreadPool object, the workers run the pending tasks and then they are joined.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief Get the pool of the process, it is created at the first call with one worker for each hardware thread.
+     * @return ThreadPool& shared pool.
+     */
+    static ThreadPool& shared();
+
+    /**
+     * @brief Get the number of workers.
+     * @return unsigned int number of threads of the pool.
+     */
+    unsigned int size();
+
+    /**
+     * @brief Get the index of the worker that is running the calling thread.
+     * @return int index of the worker in its pool, -1 if the caller is not a worker.
+     */
+    static int currentWorker();
+
+    /**
+     * @brief Add a task that is part of a larger computation: from a worker of this pool it goes to the back of its
+     * deque, from any other thread to the shared queue.
+     * @param task function to be run.
+     */
+    void spawn(function<void()> task);
+
+    /**
+     * @brief Add an independent task in the queue of a client, the clients with pending tasks are served round robin.
+     * @param task function to be run.
+     * @param client key of the client.
+     */
+    void submit(function<void()> task, unsigned int client = 0);
+
+    /**
+     * @brief Get the number of tasks stolen from the deque of another worker since the pool was created.
+     * @return uint64_t number of steals.
+     */
+    uint64_t steals();
+
+private:
+    /**
+     * @brief Deque of the tasks spawned by a worker.
+     */
+    struct Worker {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+
+    /**
+     * @brief Body of a worker: it runs the tasks it finds and it sleeps while there are none.
+     * @param index index of the worker.
+     */
+    void work(unsigned int index);
+
+    /**
+     * @brief Take a pending task, in the order described in the structure.
+     * @param index index of the worker that looks for it, -1 for the other threads.
+     * @param task it receives the task.
+     * @return true if a task has been taken.
+     */
+    bool take(int index, function<void()> &task);
+
+    /**
+     * @brief Count a new task and wake up a sleeping worker.
+     */
+    void notify();
+
+    vector<unique_ptr<Worker>> workers;
+    vector<thread> threads;
+
+    /**
+     * @brief Shared queue and queues of the clients, the client served last is lastClient.
+     */
+    mutex queuesLock;
+    deque<function<void()>> injected;
+    map<unsigned int, deque<function<void()>>> clients;
+    unsigned int lastClient;
+
+    /**
+     * @brief Tasks not taken yet, the workers sleep on wake while it is 0.
+     */
+    atomic<size_t> pending;
+    atomic<uint64_t> stolen;
+    mutex sleepLock;
+    condition_variable wake;
+    bool stopping;
+};
+
+#endif
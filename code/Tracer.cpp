@@ -0,0 +1,252 @@
+#include "Tracer.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Span recorded in a buffer.
+ */
+struct TraceEvent {
+    const char *name;
+    const char *category;
+    uint64_t start;
+    uint64_t end;
+};
+
+/**
+ * @brief Ring buffer of a thread. The owner thread is the only writer, the lock is taken only while tracing and it is
+ * contended only when the trace is written or cleared, so the spans can be exported while the threads are running.
+ * The buffers are shared with the registry, so the spans of a thread survive its end: the buffer is marked as exited
+ * and it is dropped from the registry once its spans have been written or cleared.
+ */
+struct TraceBuffer {
+    mutex lock;
+    vector<TraceEvent> events;
+    size_t capacity;
+    // total number of spans written, the last min(written, capacity) are in events
+    uint64_t written = 0;
+    unsigned int tid;
+    bool exited = false;
+};
+
+/**
+ * @brief Buffer of the calling thread, it marks the buffer as exited when the thread ends.
+ */
+struct LocalBuffer {
+    shared_ptr<TraceBuffer> buffer;
+
+    ~LocalBuffer() {
+        if(buffer) {
+            lock_guard<mutex> guard(buffer->lock);
+            buffer->exited = true;
+        }
+    }
+};
+
+/**
+ * @brief Buffers of the threads that recorded a span and have not been dropped, the spans lost by the dropped buffers,
+ * the capacity of the new buffers, the id of the next thread and the time of enable.
+ */
+static mutex registry_lock;
+static vector<shared_ptr<TraceBuffer>> registry;
+static uint64_t dropped_exited = 0;
+static size_t buffer_capacity = Tracer::DEFAULT_CAPACITY;
+static unsigned int next_tid = 1;
+static uint64_t origin = 0;
+
+static thread_local LocalBuffer local_buffer;
+
+/**
+ * @brief Drop from the registry the buffers of the threads that have ended, the caller holds registry_lock and has
+ * written or discarded their spans.
+ */
+static void dropExited() {
+    size_t last = 0;
+    for(size_t i = 0; i < registry.size(); ++i) {
+        lock_guard<mutex> buffer_guard(registry[i]->lock);
+        if(registry[i]->exited)
+            dropped_exited += registry[i]->written - registry[i]->events.size();
+        else
+            registry[last++] = registry[i];
+    }
+    registry.resize(last);
+}
+
+/**
+ * @brief Escape a string for JSON.
+ * @param out stream that receives the string.
+ * @param text text to be escaped.
+ */
+static void writeJSONString(ostream &out, const char *text) {
+    out << '"';
+    for(const char *c = text; *c != '\0'; ++c) {
+        if(*c == '"' || *c == '\\')
+            out << '\\' << *c;
+        else if((unsigned char) *c < 0x20)
+            out << ' ';
+        else
+            out << *c;
+    }
+    out << '"';
+}
+
+/**
+ * @brief Enable the tracing, the spans recorded before are discarded.
+ * @param capacity number of spans kept by each thread.
+ */
+void Tracer::enable(size_t capacity) {
+    {
+        lock_guard<mutex> guard(registry_lock);
+        buffer_capacity = capacity == 0 ? 1 : capacity;
+        origin = now();
+        for(auto &buffer : registry) {
+            lock_guard<mutex> buffer_guard(buffer->lock);
+            buffer->capacity = buffer_capacity;
+            buffer->events.clear();
+            buffer->events.shrink_to_fit();
+            buffer->written = 0;
+        }
+        dropExited();
+        dropped_exited = 0;
+    }
+    enabled.store(true, memory_order_relaxed);
+}
+
+/**
+ * @brief Disable the tracing, the recorded spans are kept until they are written or cleared.
+ */
+void Tracer::disable() {
+    enabled.store(false, memory_order_relaxed);
+}
+
+/**
+ * @brief Discard the recorded spans of all the threads, the buffers of the threads that have ended are dropped.
+ */
+void Tracer::clear() {
+    lock_guard<mutex> guard(registry_lock);
+    for(auto &buffer : registry) {
+        lock_guard<mutex> buffer_guard(buffer->lock);
+        buffer->events.clear();
+        buffer->written = 0;
+    }
+    dropExited();
+    dropped_exited = 0;
+}
+
+/**
+ * @brief Get the number of recorded spans, the ones that have been overwritten are not counted.
+ * @return size_t number of spans available.
+ */
+size_t Tracer::size() {
+    lock_guard<mutex> guard(registry_lock);
+    size_t total = 0;
+    for(auto &buffer : registry) {
+        lock_guard<mutex> buffer_guard(buffer->lock);
+        total += buffer->events.size();
+    }
+    return total;
+}
+
+/**
+ * @brief Get the number of spans overwritten because a buffer was full.
+ * @return uint64_t number of spans lost.
+ */
+uint64_t Tracer::dropped() {
+    lock_guard<mutex> guard(registry_lock);
+    uint64_t total = dropped_exited;
+    for(auto &buffer : registry) {
+        lock_guard<mutex> buffer_guard(buffer->lock);
+        total += buffer->written - buffer->events.size();
+    }
+    return total;
+}
+
+/**
+ * @brief Write the recorded spans as a JSON object in the trace event format, the timestamps are relative to enable.
+ * Every span is a complete event ("ph": "X") with timestamp and duration in microseconds, every thread gets a name.
+ * The buffers of the threads that have ended are dropped after they are written, so their spans are written once.
+ * @param out stream that receives the JSON.
+ */
+void Tracer::writeChromeTrace(ostream &out) {
+    lock_guard<mutex> guard(registry_lock);
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    out.setf(ios::fixed);
+    out.precision(3);
+
+    for(auto &buffer : registry) {
+        lock_guard<mutex> buffer_guard(buffer->lock);
+        if(!first)
+            out << ",";
+        first = false;
+        out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":\"thread " << buffer->tid << "\"}}";
+
+        // the oldest span is the one after the last written when the buffer has wrapped around
+        size_t count = buffer->events.size();
+        size_t oldest = buffer->written > count ? buffer->written % count : 0;
+        for(size_t i = 0; i < count; ++i) {
+            const TraceEvent &event = buffer->events[(oldest + i) % count];
+            out << ",\n{\"name\":";
+            writeJSONString(out, event.name);
+            out << ",\"cat\":";
+            writeJSONString(out, event.category);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"ts\":" << (event.start > origin ? event.start - origin : 0) / 1000.0
+                << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    dropExited();
+}
+
+/**
+ * @brief Write the recorded spans in a file in the trace event format.
+ * @param path path of the file.
+ * @return true if the file has been written.
+ * @return false if the file cannot be written.
+ */
+bool Tracer::writeChromeTrace(const string &path) {
+    ofstream out(path);
+    if(!out)
+        return false;
+    writeChromeTrace(out);
+    return (bool) out;
+}
+
+/**
+ * @brief Get the time of the steady clock.
+ * @return uint64_t nanoseconds since the epoch of the steady clock.
+ */
+uint64_t Tracer::now() {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Record a span in the buffer of the calling thread, the buffer is created at the first span of the thread.
+ * @param name name of the span.
+ * @param category category of the span.
+ * @param start time when the span began.
+ * @param end time when the span ended.
+ */
+void Tracer::record(const char *name, const char *category, uint64_t start, uint64_t end) {
+    if(!local_buffer.buffer) {
+        local_buffer.buffer = make_shared<TraceBuffer>();
+        lock_guard<mutex> guard(registry_lock);
+        local_buffer.buffer->capacity = buffer_capacity;
+        local_buffer.buffer->tid = next_tid++;
+        registry.push_back(local_buffer.buffer);
+    }
+
+    TraceBuffer &buffer = *local_buffer.buffer;
+    lock_guard<mutex> guard(buffer.lock);
+    TraceEvent event = {name, category, start, end};
+    if(buffer.events.size() < buffer.capacity)
+        buffer.events.push_back(event);
+    else
+        buffer.events[buffer.written % buffer.capacity] = event;
+    buffer.written++;
+}
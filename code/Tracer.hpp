@@ -0,0 +1,123 @@
+#ifndef TRACER_H_
+#define TRACER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+using namespace std;
+
+/**
+ * @brief Auxiliary structure that records a timeline of the library: each Span is a named interval of a thread, written
+ * in a ring buffer owned by that thread when it ends. The timeline is exported in the trace event format of Chrome
+ * (chrome://tracing, Perfetto), where the spans of each thread are shown nested.
+ * The tracing is disabled by default and a disabled Span costs one relaxed atomic load, so the spans are left in the
+ * construction of the graphs, the connectivity checks, the ordering engines, the fill computations and the parallel tasks.
+ * When a buffer is full the oldest spans of its thread are overwritten, dropped() tells how many were lost. The buffer
+ * of a thread that has ended is kept until its spans are written or cleared, then it is released.
+ */
+struct Tracer {
+public:
+    /**
+     * @brief Default number of spans kept by each thread.
+     */
+    static const size_t DEFAULT_CAPACITY = 1 << 16;
+
+    /**
+     * @brief Scoped span: it begins when it is constructed and it is recorded when it is destroyed. The name and the
+     * category are not copied, so they must be string literals (or live until the trace is written).
+     */
+    struct Span {
+    public:
+        Span(const char *name, const char *category = "graph") : name(name), category(category), active(isEnabled()) {
+            if(active)
+                start = now();
+        }
+
+        ~Span() {
+            if(active)
+                record(name, category, start, now());
+        }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        const char *name;
+        const char *category;
+        bool active;
+        uint64_t start = 0;
+    };
+
+    /**
+     * @brief Enable the tracing, the spans recorded before are discarded.
+     * @param capacity number of spans kept by each thread.
+     */
+    static void enable(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Disable the tracing, the recorded spans are kept until they are written or cleared.
+     */
+    static void disable();
+
+    /**
+     * @brief Check if the tracing is enabled.
+     * @return true if the spans are recorded.
+     */
+    static bool isEnabled() {
+        return enabled.load(memory_order_relaxed);
+    }
+
+    /**
+     * @brief Discard the recorded spans of all the threads, the buffers of the threads that have ended are dropped.
+     */
+    static void clear();
+
+    /**
+     * @brief Get the number of recorded spans, the ones that have been overwritten are not counted.
+     * @return size_t number of spans available.
+     */
+    static size_t size();
+
+    /**
+     * @brief Get the number of spans overwritten because a buffer was full.
+     * @return uint64_t number of spans lost.
+     */
+    static uint64_t dropped();
+
+    /**
+     * @brief Write the recorded spans as a JSON object in the trace event format, the timestamps are relative to enable.
+     * The buffers of the threads that have ended are dropped after they are written, so their spans are written once.
+     * @param out stream that receives the JSON.
+     */
+    static void writeChromeTrace(ostream &out);
+
+    /**
+     * @brief Write the recorded spans in a file in the trace event format.
+     * @param path path of the file.
+     * @return true if the file has been written.
+     * @return false if the file cannot be written.
+     */
+    static bool writeChromeTrace(const string &path);
+
+private:
+    /**
+     * @brief Get the time of the steady clock.
+     * @return uint64_t nanoseconds since the epoch of the steady clock.
+     */
+    static uint64_t now();
+
+    /**
+     * @brief Record a span in the buffer of the calling thread, the buffer is created at the first span of the thread.
+     * @param name name of the span.
+     * @param category category of the span.
+     * @param start time when the span began.
+     * @param end time when the span ended.
+     */
+    static void record(const char *name, const char *category, uint64_t start, uint64_t end);
+
+    static inline atomic<bool> enabled{false};
+};
+
+#endif
@@ -0,0 +1,422 @@
+#include "VersionedGraph.hpp"
+#include "Tracer.hpp"
+
+#include <algorithm>
+
+/**
+ * @brief Construct a new VersionedGraph object with vertices 0, 1, ..., num_vertices-1 and no edges.
+ * @param num_vertices number of vertices.
+ */
+CustomGraph::VersionedGraph::VersionedGraph(unsigned int num_vertices)
+    : current(emptyVersion(num_vertices, nullptr)), epoch(1), slots(nullptr) {}
+
+/**
+ * @brief Construct a new VersionedGraph object whose first version has the vertices and the edges of a CSRGraph.
+ * @param csr graph to be copied.
+ */
+CustomGraph::VersionedGraph::VersionedGraph(CSRGraph &csr) : epoch(1), slots(nullptr) {
+    Tracer::Span span("VersionedGraph::VersionedGraph", "build");
+    shared_ptr<const vector<unsigned int>> ids;
+    if(csr.hasIds())
+        ids = make_shared<const vector<unsigned int>>(csr.getIds(), csr.getIds() + csr.size());
+
+    Version *version = emptyVersion(csr.size(), ids);
+    for(unsigned int b = 0; b < version->blocks.size(); ++b) {
+        auto block = make_shared<Block>(*version->blocks[b]);
+        for(unsigned int i = 0; i < block->adjacency.size(); ++i) {
+            CSRGraph::NeighborRange range = csr.neighbors(b * BLOCK_SIZE + i);
+            block->adjacency[i].assign(range.begin(), range.end());
+        }
+        version->blocks[b] = block;
+    }
+    version->num_edges = csr.edgeSize();
+    current.store(version);
+}
+
+/**
+ * @brief Destroy the VersionedGraph object with all its versions, no Snapshot must be alive.
+ */
+CustomGraph::VersionedGraph::~VersionedGraph() {
+    delete current.load();
+    for(auto &entry : retired)
+        delete entry.second;
+
+    ReaderSlot *slot = slots.load();
+    while(slot != nullptr) {
+        ReaderSlot *next = slot->next;
+        delete slot;
+        slot = next;
+    }
+}
+
+/**
+ * @brief Pin the current version. It takes a free reader slot (or adds one) without locks.
+ * The epoch is announced before the current version is read, so a writer that retires this version afterwards tags it
+ * with an epoch that is not earlier and it does not delete it. A new slot is read by the writers only once it is in the
+ * list, so the version is read after the slot has been pushed.
+ * @return Snapshot handle of the current version.
+ */
+CustomGraph::VersionedGraph::Snapshot CustomGraph::VersionedGraph::snapshot() {
+    uint64_t announced = epoch.load();
+    ReaderSlot *slot = nullptr;
+    for(ReaderSlot *s = slots.load(); s != nullptr && slot == nullptr; s = s->next) {
+        uint64_t idle = IDLE;
+        if(s->epoch.compare_exchange_strong(idle, announced))
+            slot = s;
+    }
+
+    if(slot == nullptr) {
+        slot = new ReaderSlot;
+        slot->epoch.store(announced);
+        slot->next = slots.load();
+        while(!slots.compare_exchange_weak(slot->next, slot));
+    }
+    return Snapshot(current.load(), slot);
+}
+
+/**
+ * @brief Publish a new version with an edge more.
+ * @param src value of the source vertex.
+ * @param dst value of the destination vertex.
+ * @return true if the edge has been added.
+ * @return false if the edge is already there, it is an auto-ring or an endpoint is not in the graph.
+ */
+bool CustomGraph::VersionedGraph::addEdge(unsigned int src, unsigned int dst) {
+    return update({make_pair(src, dst)}, {}) == 1;
+}
+
+/**
+ * @brief Publish a new version with an edge less.
+ * @param src value of the source vertex.
+ * @param dst value of the destination vertex.
+ * @return true if the edge has been deleted.
+ * @return false if the edge is not in the graph.
+ */
+bool CustomGraph::VersionedGraph::deleteEdge(unsigned int src, unsigned int dst) {
+    return update({}, {make_pair(src, dst)}) == 1;
+}
+
+/**
+ * @brief Publish a single new version with a batch of changes, the deleted edges are removed before the added ones are
+ * inserted. Nothing is published when no edge changes.
+ * The new version shares the blocks of the current one, a block is copied the first time the batch changes one of
+ * its vertices. The replaced version is retired and the versions that no Snapshot can be using are deleted.
+ * @param added edges to be added, the ones already there and the invalid ones are ignored.
+ * @param deleted edges to be deleted, the ones not in the graph are ignored.
+ * @return unsigned int number of edges actually added or deleted.
+ */
+unsigned int CustomGraph::VersionedGraph::update(const vector<pair<unsigned int, unsigned int>> &added, const vector<pair<unsigned int, unsigned int>> &deleted) {
+    Tracer::Span span("VersionedGraph::update", "build");
+    lock_guard<mutex> guard(writeLock);
+    Version *old = current.load();
+    Version *next = new Version(*old);
+    vector<Block*> copied(next->blocks.size(), nullptr);
+
+    // adjacent vertices of a vertex in a block owned by the new version
+    auto writable = [&](unsigned int index) -> vector<unsigned int>& {
+        unsigned int b = index / BLOCK_SIZE;
+        if(copied[b] == nullptr) {
+            auto block = make_shared<Block>(*next->blocks[b]);
+            copied[b] = block.get();
+            next->blocks[b] = block;
+        }
+        return copied[b]->adjacency[index % BLOCK_SIZE];
+    };
+
+    unsigned int changed = 0;
+    for(auto &edge : deleted) {
+        unsigned int i = indexOf(next, edge.first), j = indexOf(next, edge.second);
+        if(i == next->num_vertices || j == next->num_vertices || i == j)
+            continue;
+        const vector<unsigned int> &adj_i = next->neighbors(i);
+        if(!binary_search(adj_i.begin(), adj_i.end(), j))
+            continue;
+
+        vector<unsigned int> &row_i = writable(i), &row_j = writable(j);
+        row_i.erase(lower_bound(row_i.begin(), row_i.end(), j));
+        row_j.erase(lower_bound(row_j.begin(), row_j.end(), i));
+        next->num_edges--;
+        changed++;
+    }
+
+    for(auto &edge : added) {
+        unsigned int i = indexOf(next, edge.first), j = indexOf(next, edge.second);
+        if(i == next->num_vertices || j == next->num_vertices || i == j)
+            continue;
+        const vector<unsigned int> &adj_i = next->neighbors(i);
+        if(binary_search(adj_i.begin(), adj_i.end(), j))
+            continue;
+
+        vector<unsigned int> &row_i = writable(i), &row_j = writable(j);
+        row_i.insert(lower_bound(row_i.begin(), row_i.end(), j), j);
+        row_j.insert(lower_bound(row_j.begin(), row_j.end(), i), i);
+        next->num_edges++;
+        changed++;
+    }
+
+    if(changed == 0) {
+        delete next;
+        return 0;
+    }
+
+    // publish, then retire the old version with the epoch in which it was replaced
+    next->number = old->number + 1;
+    current.store(next);
+    retired.push_back(make_pair(epoch.fetch_add(1), old));
+    reclaimLocked();
+    return changed;
+}
+
+/**
+ * @brief Get the number of the current version.
+ * @return uint64_t number of the last published version.
+ */
+uint64_t CustomGraph::VersionedGraph::version() {
+    return current.load()->number;
+}
+
+/**
+ * @brief Get the number of replaced versions that have not been deleted yet.
+ * @return size_t number of retired versions.
+ */
+size_t CustomGraph::VersionedGraph::retainedVersions() {
+    lock_guard<mutex> guard(writeLock);
+    return retired.size();
+}
+
+/**
+ * @brief Delete the retired versions that no Snapshot can be using, it is also done by every update.
+ * @return size_t number of versions deleted.
+ */
+size_t CustomGraph::VersionedGraph::reclaim() {
+    lock_guard<mutex> guard(writeLock);
+    return reclaimLocked();
+}
+
+/**
+ * @brief Build the first version.
+ * @param num_vertices number of vertices.
+ * @param ids values of the vertices, null when they are their indices.
+ * @return Version* version with the vertices and without edges.
+ */
+CustomGraph::VersionedGraph::Version* CustomGraph::VersionedGraph::emptyVersion(unsigned int num_vertices, shared_ptr<const vector<unsigned int>> ids) {
+    Version *version = new Version;
+    version->number = 0;
+    version->num_vertices = num_vertices;
+    version->num_edges = 0;
+    version->ids = ids;
+    for(unsigned int first = 0; first < num_vertices; first += BLOCK_SIZE) {
+        auto block = make_shared<Block>();
+        block->adjacency.resize(min(BLOCK_SIZE, num_vertices - first));
+        version->blocks.push_back(block);
+    }
+    return version;
+}
+
+/**
+ * @brief Get the dense index of a vertex in a version.
+ * @param version version to be searched.
+ * @param vertex value of the vertex.
+ * @return unsigned int dense index of the vertex, num_vertices if it is not contained.
+ */
+unsigned int CustomGraph::VersionedGraph::indexOf(const Version *version, unsigned int vertex) {
+    if(version->ids == nullptr)
+        return vertex < version->num_vertices ? vertex : version->num_vertices;
+
+    auto it = lower_bound(version->ids->begin(), version->ids->end(), vertex);
+    if(it == version->ids->end() || *it != vertex)
+        return version->num_vertices;
+    return it - version->ids->begin();
+}
+
+/**
+ * @brief Delete the retired versions older than every announced epoch, the write lock must be held.
+ * A version retired in the epoch e can be pinned only by a Snapshot that announced an epoch not later than e.
+ * @return size_t number of versions deleted.
+ */
+size_t CustomGraph::VersionedGraph::reclaimLocked() {
+    uint64_t oldest = IDLE;
+    for(ReaderSlot *s = slots.load(); s != nullptr; s = s->next)
+        oldest = min(oldest, s->epoch.load());
+
+    size_t kept = 0, deleted = 0;
+    for(auto &entry : retired) {
+        if(entry.first < oldest) {
+            delete entry.second;
+            deleted++;
+        } else
+            retired[kept++] = entry;
+    }
+    retired.resize(kept);
+    return deleted;
+}
+
+/**
+ * @brief Construct a new Snapshot object that pins a version.
+ * @param version version to be pinned.
+ * @param slot reader slot that announces the epoch of the Snapshot.
+ */
+CustomGraph::VersionedGraph::Snapshot::Snapshot(const Version *version, ReaderSlot *slot) : pinned(version), slot(slot) {}
+
+/**
+ * @brief Construct a new Snapshot object that takes the version pinned by another one.
+ * @param other Snapshot to be moved, it is left released.
+ */
+CustomGraph::VersionedGraph::Snapshot::Snapshot(Snapshot &&other) : pinned(other.pinned), slot(other.slot) {
+    other.pinned = nullptr;
+    other.slot = nullptr;
+}
+
+/**
+ * @brief Release the pinned version and take the one pinned by another Snapshot.
+ * @param other Snapshot to be moved, it is left released.
+ * @return Snapshot& this Snapshot.
+ */
+CustomGraph::VersionedGraph::Snapshot& CustomGraph::VersionedGraph::Snapshot::operator=(Snapshot &&other) {
+    if(this != &other) {
+        release();
+        pinned = other.pinned;
+        slot = other.slot;
+        other.pinned = nullptr;
+        other.slot = nullptr;
+    }
+    return *this;
+}
+
+/**
+ * @brief Destroy the Snapshot object, the version is unpinned.
+ */
+CustomGraph::VersionedGraph::Snapshot::~Snapshot() {
+    release();
+}
+
+/**
+ * @brief Unpin the version, the Snapshot can not be used anymore. The slot is freed for the next Snapshot, the version
+ * is deleted later by a writer.
+ */
+void CustomGraph::VersionedGraph::Snapshot::release() {
+    if(slot != nullptr)
+        slot->epoch.store(IDLE);
+    slot = nullptr;
+    pinned = nullptr;
+}
+
+/**
+ * @brief Get the number of the pinned version, the first version is 0 and every update increments it.
+ * @return uint64_t number of the version.
+ */
+uint64_t CustomGraph::VersionedGraph::Snapshot::version() {
+    return pinned->number;
+}
+
+/**
+ * @brief Get the number of vertices.
+ * @return unsigned int number of vertices.
+ */
+unsigned int CustomGraph::VersionedGraph::Snapshot::size() {
+    return pinned->num_vertices;
+}
+
+/**
+ * @brief Get the number of edges in the pinned version.
+ * @return unsigned int number of edges.
+ */
+unsigned int CustomGraph::VersionedGraph::Snapshot::edgeSize() {
+    return pinned->num_edges;
+}
+
+/**
+ * @brief Get the value of a vertex.
+ * @param index dense index of the vertex.
+ * @return unsigned int value of the vertex.
+ */
+unsigned int CustomGraph::VersionedGraph::Snapshot::vertexValue(unsigned int index) {
+    return pinned->ids == nullptr ? index : (*pinned->ids)[index];
+}
+
+/**
+ * @brief Get the dense index of a vertex.
+ * @param vertex value of the vertex.
+ * @return unsigned int dense index of the vertex, size() if it is not contained.
+ */
+unsigned int CustomGraph::VersionedGraph::Snapshot::indexOf(unsigned int vertex) {
+    return VersionedGraph::indexOf(pinned, vertex);
+}
+
+/**
+ * @brief Get the indices of the vertices adjacent to a vertex, in ascending order.
+ * @param index dense index of the vertex.
+ * @return const vector<unsigned int>& indices of the adjacent vertices.
+ */
+const vector<unsigned int>& CustomGraph::VersionedGraph::Snapshot::neighbors(unsigned int index) {
+    return pinned->neighbors(index);
+}
+
+/**
+ * @brief Get the number of vertices adjacent to a vertex.
+ * @param index dense index of the vertex.
+ * @return unsigned int degree of the vertex.
+ */
+unsigned int CustomGraph::VersionedGraph::Snapshot::degree(unsigned int index) {
+    return pinned->neighbors(index).size();
+}
+
+/**
+ * @brief Check if two vertices are adjacent in the pinned version.
+ * @param first value of the first vertex.
+ * @param second value of the second vertex.
+ * @return true if the edge {first, second} is in the version.
+ * @return false if the edge is not in the version.
+ */
+bool CustomGraph::VersionedGraph::Snapshot::isAdjacent(unsigned int first, unsigned int second) {
+    unsigned int i = indexOf(first), j = indexOf(second);
+    if(i == size() || j == size())
+        return false;
+    const vector<unsigned int> &adj = pinned->neighbors(i);
+    return binary_search(adj.begin(), adj.end(), j);
+}
+
+/**
+ * @brief Check if the pinned version is connected.
+ * @return true if it is connected.
+ * @return false if it is not connected.
+ */
+bool CustomGraph::VersionedGraph::Snapshot::isConnected() {
+    return OrderingEngines::isConnected(*this);
+}
+
+/**
+ * @brief Same algorithm of Graph::lex_p on the pinned version.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+ */
+vector<unsigned int> CustomGraph::VersionedGraph::Snapshot::lex_p() {
+    return OrderingEngines::lex_p(*this);
+}
+
+/**
+ * @brief Same algorithm of Graph::lex_m on the pinned version, which is not modified.
+ * @param fill if not null, it receives the fill edges with the values of the vertices.
+ * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+ */
+vector<unsigned int> CustomGraph::VersionedGraph::Snapshot::lex_m(vector<pair<unsigned int, unsigned int>> *fill) {
+    return OrderingEngines::lex_m(*this, fill);
+}
+
+/**
+ * @brief Copy the pinned version in a CSRGraph, e.g. to keep it after the Snapshot is released.
+ * @return CSRGraph graph with the vertices and the edges of the version.
+ */
+CustomGraph::CSRGraph CustomGraph::VersionedGraph::Snapshot::toCSR() {
+    vector<uint64_t> offsets(size() + 1, 0);
+    vector<unsigned int> adjacency;
+    adjacency.reserve(2 * (size_t) edgeSize());
+    for(unsigned int i = 0; i < size(); ++i) {
+        const vector<unsigned int> &adj = pinned->neighbors(i);
+        adjacency.insert(adjacency.end(), adj.begin(), adj.end());
+        offsets[i + 1] = adjacency.size();
+    }
+    vector<unsigned int> ids;
+    if(pinned->ids != nullptr)
+        ids = *pinned->ids;
+    return CSRGraph(move(offsets), move(adjacency), move(ids));
+}
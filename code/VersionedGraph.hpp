@@ -0,0 +1,307 @@
+#ifndef VERSIONED_GRAPH_H_
+#define VERSIONED_GRAPH_H_
+
+#include "CSRGraph.hpp"
+#include "OrderingEngines.hpp"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <cstdint>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Graph with multiversion concurrency control: the writers publish a new immutable version for every update, the
+ * readers pin a version with a Snapshot and run the orderings on it while the writers go on.
+ * The vertices are fixed at construction, with dense indices in [0, n) as in CSRGraph. The adjacent vertices are kept
+ * in blocks of BLOCK_SIZE vertices shared by the versions: an update copies the table of the blocks and only the blocks
+ * of the endpoints it touches, the other ones are shared with the previous version.
+ * The versions are reclaimed with epochs: a Snapshot announces the epoch in which it was taken in a reader slot, a
+ * replaced version is retired with the current epoch and it is deleted by the writers once no slot announces an epoch
+ * that is not later. Taking and releasing a Snapshot never waits for a writer and never frees memory, so the latency of
+ * the readers does not depend on the write traffic. The writers are serialized by a mutex.
+ * The Snapshots must be released before the VersionedGraph is destroyed.
+ */
+struct VersionedGraph {
+private:
+    struct Version;
+    struct ReaderSlot;
+
+public:
+    /**
+     * @brief Number of vertices whose adjacent vertices are stored in the same block.
+     */
+    static constexpr unsigned int BLOCK_SIZE = 64;
+
+    /**
+     * @brief Handle of a pinned version, it is read-only and it can be moved but not copied. It provides the interface
+     * used by OrderingEngines, so the orderings of CSRGraph run directly on it. The version stays valid until the
+     * Snapshot is released or destroyed, whatever the writers do in the meantime.
+     */
+    struct Snapshot {
+    public:
+        Snapshot(Snapshot &&other);
+        Snapshot& operator=(Snapshot &&other);
+        Snapshot(const Snapshot &other) = delete;
+        Snapshot& operator=(const Snapshot &other) = delete;
+
+        /**
+         * @brief Destroy the Snapshot object, the version is unpinned.
+         */
+        ~Snapshot();
+
+        /**
+         * @brief Unpin the version, the Snapshot can not be used anymore.
+         */
+        void release();
+
+        /**
+         * @brief Get the number of the pinned version, the first version is 0 and every update increments it.
+         * @return uint64_t number of the version.
+         */
+        uint64_t version();
+
+        /**
+         * @brief Get the number of vertices.
+         * @return unsigned int number of vertices.
+         */
+        unsigned int size();
+
+        /**
+         * @brief Get the number of edges in the pinned version.
+         * @return unsigned int number of edges.
+         */
+        unsigned int edgeSize();
+
+        /**
+         * @brief Get the value of a vertex.
+         * @param index dense index of the vertex.
+         * @return unsigned int value of the vertex.
+         */
+        unsigned int vertexValue(unsigned int index);
+
+        /**
+         * @brief Get the dense index of a vertex.
+         * @param vertex value of the vertex.
+         * @return unsigned int dense index of the vertex, size() if it is not contained.
+         */
+        unsigned int indexOf(unsigned int vertex);
+
+        /**
+         * @brief Get the indices of the vertices adjacent to a vertex, in ascending order.
+         * @param index dense index of the vertex.
+         * @return const vector<unsigned int>& indices of the adjacent vertices.
+         */
+        const vector<unsigned int>& neighbors(unsigned int index);
+
+        /**
+         * @brief Get the number of vertices adjacent to a vertex.
+         * @param index dense index of the vertex.
+         * @return unsigned int degree of the vertex.
+         */
+        unsigned int degree(unsigned int index);
+
+        /**
+         * @brief Check if two vertices are adjacent in the pinned version.
+         * @param first value of the first vertex.
+         * @param second value of the second vertex.
+         * @return true if the edge {first, second} is in the version.
+         * @return false if the edge is not in the version.
+         */
+        bool isAdjacent(unsigned int first, unsigned int second);
+
+        /**
+         * @brief Check if the pinned version is connected.
+         * @return true if it is connected.
+         * @return false if it is not connected.
+         */
+        bool isConnected();
+
+        /**
+         * @brief Same algorithm of Graph::lex_p on the pinned version.
+         * @return vector<unsigned int> structure that contains the ordered vertices of the perfect ordering procedure.
+         */
+        vector<unsigned int> lex_p();
+
+        /**
+         * @brief Same algorithm of Graph::lex_m on the pinned version, which is not modified.
+         * @param fill if not null, it receives the fill edges with the values of the vertices.
+         * @return vector<unsigned int> structure that contains the ordered vertices of the minimal ordering procedure.
+         */
+        vector<unsigned int> lex_m(vector<pair<unsigned int, unsigned int>> *fill = nullptr);
+
+        /**
+         * @brief Copy the pinned version in a CSRGraph, e.g. to keep it after the Snapshot is released.
+         * @return CSRGraph graph with the vertices and the edges of the version.
+         */
+        CSRGraph toCSR();
+
+    private:
+        friend struct VersionedGraph;
+
+        Snapshot(const Version *version, ReaderSlot *slot);
+
+        const Version *pinned;
+        ReaderSlot *slot;
+    };
+
+    /**
+     * @brief Construct a new VersionedGraph object with vertices 0, 1, ..., num_vertices-1 and no edges.
+     * @param num_vertices number of vertices.
+     */
+    VersionedGraph(unsigned int num_vertices);
+
+    /**
+     * @brief Construct a new VersionedGraph object whose first version has the vertices and the edges of a CSRGraph.
+     * @param csr graph to be copied.
+     */
+    VersionedGraph(CSRGraph &csr);
+
+    VersionedGraph(const VersionedGraph &other) = delete;
+    VersionedGraph& operator=(const VersionedGraph &other) = delete;
+
+    /**
+     * @brief Destroy the VersionedGraph object with all its versions, no Snapshot must be alive.
+     */
+    ~VersionedGraph();
+
+    /**
+     * @brief Pin the current version. It takes a free reader slot (or adds one) without locks.
+     * @return Snapshot handle of the current version.
+     */
+    Snapshot snapshot();
+
+    /**
+     * @brief Publish a new version with an edge more.
+     * @param src value of the source vertex.
+     * @param dst value of the destination vertex.
+     * @return true if the edge has been added.
+     * @return false if the edge is already there, it is an auto-ring or an endpoint is not in the graph.
+     */
+    bool addEdge(unsigned int src, unsigned int dst);
+
+    /**
+     * @brief Publish a new version with an edge less.
+     * @param src value of the source vertex.
+     * @param dst value of the destination vertex.
+     * @return true if the edge has been deleted.
+     * @return false if the edge is not in the graph.
+     */
+    bool deleteEdge(unsigned int src, unsigned int dst);
+
+    /**
+     * @brief Publish a single new version with a batch of changes, the deleted edges are removed before the added ones are
+     * inserted. Nothing is published when no edge changes.
+     * @param added edges to be added, the ones already there and the invalid ones are ignored.
+     * @param deleted edges to be deleted, the ones not in the graph are ignored.
+     * @return unsigned int number of edges actually added or deleted.
+     */
+    unsigned int update(const vector<pair<unsigned int, unsigned int>> &added, const vector<pair<unsigned int, unsigned int>> &deleted);
+
+    /**
+     * @brief Get the number of the current version.
+     * @return uint64_t number of the last published version.
+     */
+    uint64_t version();
+
+    /**
+     * @brief Get the number of replaced versions that have not been deleted yet.
+     * @return size_t number of retired versions.
+     */
+    size_t retainedVersions();
+
+    /**
+     * @brief Delete the retired versions that no Snapshot can be using, it is also done by every update.
+     * @return size_t number of versions deleted.
+     */
+    size_t reclaim();
+
+private:
+    /**
+     * @brief Adjacent vertices of BLOCK_SIZE consecutive vertices, sorted. A block is never modified once it is published.
+     */
+    struct Block {
+        vector<vector<unsigned int>> adjacency;
+    };
+
+    /**
+     * @brief Immutable version of the graph.
+     */
+    struct Version {
+        uint64_t number;
+        unsigned int num_vertices;
+        unsigned int num_edges;
+        shared_ptr<const vector<unsigned int>> ids;
+        vector<shared_ptr<const Block>> blocks;
+
+        const vector<unsigned int>& neighbors(unsigned int index) const {
+            return blocks[index / BLOCK_SIZE]->adjacency[index % BLOCK_SIZE];
+        }
+    };
+
+    /**
+     * @brief Epoch announced by a Snapshot, IDLE when the slot is free. The slots are never freed before the graph.
+     */
+    struct ReaderSlot {
+        atomic<uint64_t> epoch;
+        ReaderSlot *next;
+    };
+
+    static constexpr uint64_t IDLE = UINT64_MAX;
+
+    /**
+     * @brief Build the first version.
+     * @param num_vertices number of vertices.
+     * @param ids values of the vertices, null when they are their indices.
+     * @return Version* version with the vertices and without edges.
+     */
+    static Version* emptyVersion(unsigned int num_vertices, shared_ptr<const vector<unsigned int>> ids);
+
+    /**
+     * @brief Get the dense index of a vertex in a version.
+     * @param version version to be searched.
+     * @param vertex value of the vertex.
+     * @return unsigned int dense index of the vertex, num_vertices if it is not contained.
+     */
+    static unsigned int indexOf(const Version *version, unsigned int vertex);
+
+    /**
+     * @brief Delete the retired versions older than every announced epoch, the write lock must be held.
+     * @return size_t number of versions deleted.
+     */
+    size_t reclaimLocked();
+
+    /**
+     * @brief Current version, replaced atomically by the writers.
+     */
+    atomic<Version*> current;
+
+    /**
+     * @brief Epoch incremented by each published version.
+     */
+    atomic<uint64_t> epoch;
+
+    /**
+     * @brief List of the reader slots, new slots are pushed at the head.
+     */
+    atomic<ReaderSlot*> slots;
+
+    /**
+     * @brief Replaced versions with the epoch of their retirement, protected by writeLock.
+     */
+    vector<pair<uint64_t, Version*>> retired;
+
+    /**
+     * @brief Lock that serializes the writers.
+     */
+    mutex writeLock;
+};
+
+}
+
+#endif
@@ -28,7 +28,7 @@ void Vertex::addAdjacentVertex(const Vertex &vertex) {
  * @return false if the input vertex is no adjacent.
  */  
 bool Vertex::isAdjacent(unsigned int vertex) {
-    return find(adjVertices.begin(), adjVertices.end(), vertex) !=adjVertices.end();
+    return adjVertices.count(vertex) != 0;
 }
 
 /**
@@ -58,4 +58,12 @@ void Vertex::printAdjacentVertices() {
  */
 unordered_set<unsigned int>& Vertex::getAdjVertices() {
     return adjVertices;
-} 
\ No newline at end of file
+} 
+
+/**
+ * @brief Get the list of the adjacent vertices of a read-only vertex.
+ * @return const unordered_set<unsigned int>& vertices adjacent to the current one.
+ */
+const unordered_set<unsigned int>& Vertex::getAdjVertices() const {
+    return adjVertices;
+}
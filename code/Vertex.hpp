@@ -67,6 +67,12 @@ public:
      */
     unordered_set<unsigned int>& getAdjVertices();
 
+    /**
+     * @brief Get the list of the adjacent vertices of a read-only vertex.
+     * @return const unordered_set<unsigned int>& vertices adjacent to the current one.
+     */
+    const unordered_set<unsigned int>& getAdjVertices() const;
+
     /**
      * @brief Compare two vertices, they are equal if they have the same value and the
      * same adjacent vertices.
@@ -0,0 +1,308 @@
+#include "WorkloadGenerator.hpp"
+#include "GraphBuilder.hpp"
+#include "RandomStream.hpp"
+#include "Parallel.hpp"
+#include "Tracer.hpp"
+
+#include <cmath>
+#include <numeric>
+
+/**
+ * @brief Number of vertices or edges generated by each parallel task.
+ */
+static const unsigned int WORK_BLOCK = 1 << 16;
+
+/**
+ * @brief First stream of each phase, the phases never share a stream.
+ */
+static const uint64_t LABEL_STREAM = 0;
+static const uint64_t CLIQUE_STREAM = 1;
+static const uint64_t BLOCK_STREAM = 2;
+
+typedef vector<pair<unsigned int, unsigned int>> EdgeList;
+
+/**
+ * @brief Get the number of blocks needed to cover a number of elements.
+ * @param elements number of elements.
+ * @return unsigned int number of blocks of WORK_BLOCK elements.
+ */
+static unsigned int workBlocks(uint64_t elements) {
+    return (elements + WORK_BLOCK - 1) / WORK_BLOCK;
+}
+
+/**
+ * @brief Generate a triangulated 2D grid: the vertices fill the rows of a square grid and each cell is split by a diagonal.
+ * @param num_vertices number of vertices.
+ * @param seed seed of the random streams.
+ * @param csr graph that receives the vertices and the edges.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ */
+void CustomGraph::WorkloadGenerator::mesh2D(unsigned int num_vertices, uint64_t seed, CSRGraph &csr, unsigned int num_threads) {
+    uint64_t cols = max<uint64_t>(1, ceil(sqrt((double) num_vertices)));
+    unsigned int blocks = workBlocks(num_vertices);
+    vector<EdgeList> parts(blocks);
+
+    Parallel::forEach(blocks, [&](unsigned int b) {
+        uint64_t last = min<uint64_t>(num_vertices, (uint64_t) (b + 1) * WORK_BLOCK);
+        for(uint64_t i = (uint64_t) b * WORK_BLOCK; i < last; ++i) {
+            bool right = i % cols + 1 < cols;
+            if(right && i + 1 < num_vertices)
+                parts[b].push_back(make_pair(i, i + 1));
+            if(i + cols < num_vertices)
+                parts[b].push_back(make_pair(i, i + cols));
+            if(right && i + cols + 1 < num_vertices)
+                parts[b].push_back(make_pair(i, i + cols + 1));
+        }
+    }, num_threads);
+
+    EdgeList edges;
+    for(auto &part : parts)
+        edges.insert(edges.end(), part.begin(), part.end());
+    finish(num_vertices, edges, seed, csr, num_threads);
+}
+
+/**
+ * @brief Generate a 3D grid where each vertex is adjacent to its neighbours along the three axes (7-point stencil),
+ * the vertices fill the layers of a cube.
+ * @param num_vertices number of vertices.
+ * @param seed seed of the random streams.
+ * @param csr graph that receives the vertices and the edges.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ */
+void CustomGraph::WorkloadGenerator::mesh3D(unsigned int num_vertices, uint64_t seed, CSRGraph &csr, unsigned int num_threads) {
+    uint64_t side = max<uint64_t>(1, cbrt((double) num_vertices));
+    while(side * side * side < num_vertices)
+        side++;
+    uint64_t layer = side * side;
+
+    unsigned int blocks = workBlocks(num_vertices);
+    vector<EdgeList> parts(blocks);
+
+    Parallel::forEach(blocks, [&](unsigned int b) {
+        uint64_t last = min<uint64_t>(num_vertices, (uint64_t) (b + 1) * WORK_BLOCK);
+        for(uint64_t i = (uint64_t) b * WORK_BLOCK; i < last; ++i) {
+            if(i % side + 1 < side && i + 1 < num_vertices)
+                parts[b].push_back(make_pair(i, i + 1));
+            if(i % layer / side + 1 < side && i + side < num_vertices)
+                parts[b].push_back(make_pair(i, i + side));
+            if(i + layer < num_vertices)
+                parts[b].push_back(make_pair(i, i + layer));
+        }
+    }, num_threads);
+
+    EdgeList edges;
+    for(auto &part : parts)
+        edges.insert(edges.end(), part.begin(), part.end());
+    finish(num_vertices, edges, seed, csr, num_threads);
+}
+
+/**
+ * @brief Generate a recursive matrix (R-MAT) graph: each edge chooses recursively one of the four quadrants of the
+ * adjacency matrix with probabilities a, b, c and 1-a-b-c. Duplicated edges and auto-rings are dropped, so the graph
+ * has at most num_edges edges and it can contain isolated vertices.
+ * @param num_vertices number of vertices.
+ * @param num_edges number of edges that are drawn.
+ * @param seed seed of the random streams.
+ * @param csr graph that receives the vertices and the edges.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ * @param a probability of the top left quadrant.
+ * @param b probability of the top right quadrant.
+ * @param c probability of the bottom left quadrant.
+ * @return true if the graph has been generated.
+ * @return false if the probabilities are not valid.
+ */
+bool CustomGraph::WorkloadGenerator::rmat(unsigned int num_vertices, uint64_t num_edges, uint64_t seed, CSRGraph &csr, unsigned int num_threads,
+                                          double a, double b, double c) {
+    if(a < 0 || b < 0 || c < 0 || a + b + c > 1)
+        return false;
+    if(num_vertices < 2)
+        num_edges = 0;
+
+    unsigned int levels = 0;
+    while(((uint64_t) 1 << levels) < num_vertices)
+        levels++;
+
+    EdgeList edges(num_edges);
+    Parallel::forEach(workBlocks(num_edges), [&](unsigned int block) {
+        RandomStream random(seed, BLOCK_STREAM + block);
+        uint64_t last = min<uint64_t>(num_edges, (uint64_t) (block + 1) * WORK_BLOCK);
+        for(uint64_t i = (uint64_t) block * WORK_BLOCK; i < last; ++i) {
+            // the cells outside the n x n matrix are drawn again
+            uint64_t u, v;
+            do {
+                u = v = 0;
+                for(unsigned int l = 0; l < levels; ++l) {
+                    double r = random.uniform();
+                    u = 2 * u + (r >= a + b);
+                    v = 2 * v + ((r >= a && r < a + b) || r >= a + b + c);
+                }
+            } while(u >= num_vertices || v >= num_vertices);
+            edges[i] = make_pair(u, v);
+        }
+    }, num_threads);
+
+    finish(num_vertices, edges, seed, csr, num_threads);
+    return true;
+}
+
+/**
+ * @brief Generate a connected chordal graph: the vertex v chooses a random previous vertex p and becomes adjacent to p and
+ * to a random subset of the clique formed by p and its previous neighbours, so the reverse of the construction order
+ * is a perfect elimination ordering.
+ * @param num_vertices number of vertices.
+ * @param max_clique maximum size of a clique, at least 2.
+ * @param seed seed of the random streams.
+ * @param csr graph that receives the vertices and the edges.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ * @return true if the graph has been generated.
+ * @return false if max_clique is less than 2.
+ */
+bool CustomGraph::WorkloadGenerator::randomChordal(unsigned int num_vertices, unsigned int max_clique, uint64_t seed, CSRGraph &csr, unsigned int num_threads) {
+    if(max_clique < 2)
+        return false;
+
+    unsigned int width = max_clique - 1;
+    vector<unsigned int> cliques, sizes;
+    growCliques(num_vertices, width, false, seed, cliques, sizes);
+
+    unsigned int blocks = workBlocks(num_vertices);
+    vector<EdgeList> parts(blocks);
+    Parallel::forEach(blocks, [&](unsigned int b) {
+        unsigned int last = min<uint64_t>(num_vertices, (uint64_t) (b + 1) * WORK_BLOCK);
+        for(unsigned int v = b * WORK_BLOCK; v < last; ++v)
+            for(unsigned int j = 0; j < sizes[v]; ++j)
+                parts[b].push_back(make_pair(cliques[(size_t) v * width + j], v));
+    }, num_threads);
+
+    EdgeList edges;
+    for(auto &part : parts)
+        edges.insert(edges.end(), part.begin(), part.end());
+    finish(num_vertices, edges, seed, csr, num_threads);
+    return true;
+}
+
+/**
+ * @brief Generate a connected partial k-tree: a random k-tree is grown from a (k+1)-clique attaching each new vertex to
+ * a k-clique, then every edge is kept with probability keep_probability, except one edge of each vertex that keeps
+ * the graph connected.
+ * @param num_vertices number of vertices.
+ * @param k treewidth of the k-tree, at least 1.
+ * @param keep_probability probability of keeping each edge of the k-tree.
+ * @param seed seed of the random streams.
+ * @param csr graph that receives the vertices and the edges.
+ * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+ * @return true if the graph has been generated.
+ * @return false if k is 0 or the probability is not in [0, 1].
+ */
+bool CustomGraph::WorkloadGenerator::partialKTree(unsigned int num_vertices, unsigned int k, double keep_probability, uint64_t seed, CSRGraph &csr,
+                                                  unsigned int num_threads) {
+    if(k == 0 || keep_probability < 0 || keep_probability > 1)
+        return false;
+
+    vector<unsigned int> cliques, sizes;
+    growCliques(num_vertices, k, true, seed, cliques, sizes);
+
+    unsigned int blocks = workBlocks(num_vertices);
+    vector<EdgeList> parts(blocks);
+    Parallel::forEach(blocks, [&](unsigned int b) {
+        RandomStream random(seed, BLOCK_STREAM + b);
+        unsigned int last = min<uint64_t>(num_vertices, (uint64_t) (b + 1) * WORK_BLOCK);
+        for(unsigned int v = b * WORK_BLOCK; v < last; ++v)
+            for(unsigned int j = 0; j < sizes[v]; ++j)
+                // the edge to the first vertex of the clique is always kept, it links v to the previous vertices
+                if(j == 0 || random.uniform() < keep_probability)
+                    parts[b].push_back(make_pair(cliques[(size_t) v * k + j], v));
+    }, num_threads);
+
+    EdgeList edges;
+    for(auto &part : parts)
+        edges.insert(edges.end(), part.begin(), part.end());
+    finish(num_vertices, edges, seed, csr, num_threads);
+    return true;
+}
+
+/**
+ * @brief Relabel the edges with a random permutation of the vertices and store them in compressed sparse row format.
+ * @param num_vertices number of vertices.
+ * @param edges edges of the graph, auto-rings and duplicates are allowed.
+ * @param seed seed of the random streams.
+ * @param csr graph that receives the vertices and the edges.
+ * @param num_threads number of threads to be used.
+ */
+void CustomGraph::WorkloadGenerator::finish(unsigned int num_vertices, vector<pair<unsigned int, unsigned int>> &edges, uint64_t seed, CSRGraph &csr,
+                                            unsigned int num_threads) {
+    Tracer::Span span("WorkloadGenerator::finish", "build");
+    vector<unsigned int> label(num_vertices);
+    iota(label.begin(), label.end(), 0);
+    RandomStream random(seed, LABEL_STREAM);
+    for(unsigned int i = num_vertices; i > 1; --i)
+        swap(label[i-1], label[random.below(i)]);
+
+    Parallel::forEach(workBlocks(edges.size()), [&](unsigned int b) {
+        size_t last = min<size_t>(edges.size(), (size_t) (b + 1) * WORK_BLOCK);
+        for(size_t i = (size_t) b * WORK_BLOCK; i < last; ++i)
+            edges[i] = make_pair(label[edges[i].first], label[edges[i].second]);
+    }, num_threads);
+
+    GraphBuilder::normalizeEdges(edges, num_threads);
+
+    vector<uint64_t> offsets;
+    vector<unsigned int> adjacency;
+    GraphBuilder::fillRows(num_vertices, edges, offsets, adjacency);
+    csr = CSRGraph(move(offsets), move(adjacency), vector<unsigned int>());
+}
+
+/**
+ * @brief Grow a graph where every vertex v > 0 is attached to a clique of the previous vertices. The clique of v is
+ * chosen among the subsets of {p} and the clique of p, p being a random previous vertex, so v and its clique form a
+ * clique again. The cliques are stored in a flat array with width positions for each vertex.
+ * The growth is sequential, since each vertex reads the clique of a previous one.
+ * @param num_vertices number of vertices.
+ * @param width maximum size of the clique attached to a vertex.
+ * @param exact true to attach cliques of size width to all the vertices after the first width+1 (k-tree), false to
+ * choose their size at random.
+ * @param seed seed of the random streams.
+ * @param cliques clique attached to the vertex v in positions [v*width, v*width + sizes[v]).
+ * @param sizes size of the clique attached to each vertex.
+ */
+void CustomGraph::WorkloadGenerator::growCliques(unsigned int num_vertices, unsigned int width, bool exact, uint64_t seed,
+                                                 vector<unsigned int> &cliques, vector<unsigned int> &sizes) {
+    Tracer::Span span("WorkloadGenerator::growCliques", "build");
+    cliques.assign((size_t) num_vertices * width, 0);
+    sizes.assign(num_vertices, 0);
+    RandomStream random(seed, CLIQUE_STREAM);
+    vector<unsigned int> candidates(width + 1);
+
+    for(unsigned int v = 1; v < num_vertices; ++v) {
+        unsigned int *clique = &cliques[(size_t) v * width];
+
+        // in a k-tree the first k+1 vertices form a clique
+        if(exact && v <= width) {
+            iota(clique, clique + v, 0);
+            sizes[v] = v;
+            continue;
+        }
+
+        unsigned int p = exact ? width + random.below(v - width) : random.below(v);
+        unsigned int available = sizes[p];
+        copy(&cliques[(size_t) p * width], &cliques[(size_t) p * width] + available, candidates.begin());
+
+        if(exact) {
+            // {p} and the clique of p form a (k+1)-clique, one of its vertices is left out
+            candidates[available++] = p;
+            unsigned int left_out = random.below(available);
+            swap(candidates[left_out], candidates[available-1]);
+            copy(candidates.begin(), candidates.begin() + width, clique);
+            sizes[v] = width;
+        } else {
+            unsigned int size = 1 + random.below(min(width, available + 1));
+            clique[0] = p;
+            for(unsigned int j = 1; j < size; ++j) {
+                unsigned int chosen = j - 1 + random.below(available - (j - 1));
+                swap(candidates[j-1], candidates[chosen]);
+                clique[j] = candidates[j-1];
+            }
+            sizes[v] = size;
+        }
+    }
+}
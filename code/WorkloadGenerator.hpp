@@ -0,0 +1,125 @@
+#ifndef WORKLOAD_GENERATOR_H_
+#define WORKLOAD_GENERATOR_H_
+
+#include "CSRGraph.hpp"
+
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+namespace CustomGraph {
+
+/**
+ * @brief Auxiliary structure that generates graphs shaped like the inputs met in practice, to be used next to the
+ * Erdos-Renyi graphs in tests and benchmarks:
+ * - mesh2D and mesh3D: triangulated 2D grids and 7-point 3D grids, the adjacency of linear finite element meshes;
+ * - rmat: recursive matrix graphs with a power-law degree distribution;
+ * - randomChordal: chordal graphs built by attaching each vertex to a random clique;
+ * - partialKTree: random subgraphs of k-trees, graphs of treewidth at most k that are close to chordal.
+ * Every generator takes a seed and a target number of vertices, the vertices are 0, ..., n-1 and their labels are randomly
+ * permuted, so the orderings cannot take advantage of the construction order. The work is split in fixed blocks and each
+ * block draws from its own RandomStream, so the graph depends only on the parameters and the seed, whatever the number
+ * of threads.
+ */
+struct WorkloadGenerator {
+public:
+    /**
+     * @brief Generate a triangulated 2D grid: the vertices fill the rows of a square grid and each cell is split by a diagonal.
+     * @param num_vertices number of vertices.
+     * @param seed seed of the random streams.
+     * @param csr graph that receives the vertices and the edges.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     */
+    static void mesh2D(unsigned int num_vertices, uint64_t seed, CSRGraph &csr, unsigned int num_threads = 0);
+
+    /**
+     * @brief Generate a 3D grid where each vertex is adjacent to its neighbours along the three axes (7-point stencil),
+     * the vertices fill the layers of a cube.
+     * @param num_vertices number of vertices.
+     * @param seed seed of the random streams.
+     * @param csr graph that receives the vertices and the edges.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     */
+    static void mesh3D(unsigned int num_vertices, uint64_t seed, CSRGraph &csr, unsigned int num_threads = 0);
+
+    /**
+     * @brief Generate a recursive matrix (R-MAT) graph: each edge chooses recursively one of the four quadrants of the
+     * adjacency matrix with probabilities a, b, c and 1-a-b-c. Duplicated edges and auto-rings are dropped, so the graph
+     * has at most num_edges edges and it can contain isolated vertices.
+     * @param num_vertices number of vertices.
+     * @param num_edges number of edges that are drawn.
+     * @param seed seed of the random streams.
+     * @param csr graph that receives the vertices and the edges.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     * @param a probability of the top left quadrant.
+     * @param b probability of the top right quadrant.
+     * @param c probability of the bottom left quadrant.
+     * @return true if the graph has been generated.
+     * @return false if the probabilities are not valid.
+     */
+    static bool rmat(unsigned int num_vertices, uint64_t num_edges, uint64_t seed, CSRGraph &csr, unsigned int num_threads = 0,
+                     double a = 0.57, double b = 0.19, double c = 0.19);
+
+    /**
+     * @brief Generate a connected chordal graph: the vertex v chooses a random previous vertex p and becomes adjacent to p and
+     * to a random subset of the clique formed by p and its previous neighbours, so the reverse of the construction order
+     * is a perfect elimination ordering.
+     * @param num_vertices number of vertices.
+     * @param max_clique maximum size of a clique, at least 2.
+     * @param seed seed of the random streams.
+     * @param csr graph that receives the vertices and the edges.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     * @return true if the graph has been generated.
+     * @return false if max_clique is less than 2.
+     */
+    static bool randomChordal(unsigned int num_vertices, unsigned int max_clique, uint64_t seed, CSRGraph &csr, unsigned int num_threads = 0);
+
+    /**
+     * @brief Generate a connected partial k-tree: a random k-tree is grown from a (k+1)-clique attaching each new vertex to
+     * a k-clique, then every edge is kept with probability keep_probability, except one edge of each vertex that keeps
+     * the graph connected.
+     * @param num_vertices number of vertices.
+     * @param k treewidth of the k-tree, at least 1.
+     * @param keep_probability probability of keeping each edge of the k-tree.
+     * @param seed seed of the random streams.
+     * @param csr graph that receives the vertices and the edges.
+     * @param num_threads number of threads to be used, 0 means one for each hardware thread.
+     * @return true if the graph has been generated.
+     * @return false if k is 0 or the probability is not in [0, 1].
+     */
+    static bool partialKTree(unsigned int num_vertices, unsigned int k, double keep_probability, uint64_t seed, CSRGraph &csr,
+                             unsigned int num_threads = 0);
+
+private:
+    /**
+     * @brief Relabel the edges with a random permutation of the vertices and store them in compressed sparse row format.
+     * @param num_vertices number of vertices.
+     * @param edges edges of the graph, auto-rings and duplicates are allowed.
+     * @param seed seed of the random streams.
+     * @param csr graph that receives the vertices and the edges.
+     * @param num_threads number of threads to be used.
+     */
+    static void finish(unsigned int num_vertices, vector<pair<unsigned int, unsigned int>> &edges, uint64_t seed, CSRGraph &csr,
+                       unsigned int num_threads);
+
+    /**
+     * @brief Grow a graph where every vertex v > 0 is attached to a clique of the previous vertices. The clique of v is
+     * chosen among the subsets of {p} and the clique of p, p being a random previous vertex, so v and its clique form a
+     * clique again. The cliques are stored in a flat array with width positions for each vertex.
+     * The growth is sequential, since each vertex reads the clique of a previous one.
+     * @param num_vertices number of vertices.
+     * @param width maximum size of the clique attached to a vertex.
+     * @param exact true to attach cliques of size width to all the vertices after the first width+1 (k-tree), false to
+     * choose their size at random.
+     * @param seed seed of the random streams.
+     * @param cliques clique attached to the vertex v in positions [v*width, v*width + sizes[v]).
+     * @param sizes size of the clique attached to each vertex.
+     */
+    static void growCliques(unsigned int num_vertices, unsigned int width, bool exact, uint64_t seed,
+                            vector<unsigned int> &cliques, vector<unsigned int> &sizes);
+};
+
+}
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef BENCHMARK_COMMON_H_
+#define BENCHMARK_COMMON_H_
+
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+#include "ErdosRenyiGenerator.hpp"
+#include "WorkloadGenerator.hpp"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+// Inputs and engines shared by the time benchmark (test/temporal/ordering_benchmark.cpp) and by the memory benchmark
+// (test/spatial/memory_benchmark.cpp), so the two measure the same calls on the same graphs.
+
+using namespace CustomGraph;
+
+/**
+ * @brief Seed of all the generated inputs, so different runs measure the same graphs.
+ */
+static const uint64_t BENCHMARK_SEED = 20230101;
+
+/**
+ * @brief Input of a benchmark, the Graph version and the ordering are built only by the engines that need them.
+ */
+struct BenchmarkInput {
+    CSRGraph csr;
+    unique_ptr<Graph> graph;
+    vector<unsigned int> ordering;
+
+    Graph& getGraph() {
+        if(!graph) {
+            graph.reset(new Graph());
+            csr.toGraph(*graph);
+        }
+        return *graph;
+    }
+
+    vector<unsigned int>& getOrdering() {
+        if(ordering.empty())
+            ordering = csr.lex_p();
+        return ordering;
+    }
+
+    size_t bytes() {
+        return (csr.size() + 1) * sizeof(uint64_t) + 2 * (size_t) csr.edgeSize() * sizeof(unsigned int);
+    }
+};
+
+/**
+ * @brief Family of graphs, it generates a graph with approximately the requested number of edges.
+ */
+struct GraphFamily {
+    string name;
+    function<void(uint64_t, CSRGraph&)> generate;
+};
+
+static const vector<GraphFamily> families = {
+    {"erdos_renyi", [](uint64_t edges, CSRGraph &csr) {
+        unsigned int n = max<uint64_t>(16, edges / 8);
+        ErdosRenyiGenerator::generate(n, min(edges, ErdosRenyiGenerator::maxEdges(n)), BENCHMARK_SEED, csr);
+    }},
+    {"mesh2d", [](uint64_t edges, CSRGraph &csr) { WorkloadGenerator::mesh2D(edges / 3, BENCHMARK_SEED, csr); }},
+    {"mesh3d", [](uint64_t edges, CSRGraph &csr) { WorkloadGenerator::mesh3D(edges / 3, BENCHMARK_SEED, csr); }},
+    {"rmat", [](uint64_t edges, CSRGraph &csr) { WorkloadGenerator::rmat(edges / 8, edges, BENCHMARK_SEED, csr); }},
+    {"chordal", [](uint64_t edges, CSRGraph &csr) { WorkloadGenerator::randomChordal(edges / 3, 8, BENCHMARK_SEED, csr); }},
+    {"partial_ktree", [](uint64_t edges, CSRGraph &csr) { WorkloadGenerator::partialKTree(edges * 2 / 5, 4, 0.5, BENCHMARK_SEED, csr); }},
+};
+
+/**
+ * @brief Get an input from the cache, it is generated the first time it is requested.
+ * @param family index of the family.
+ * @param edges target number of edges.
+ * @return BenchmarkInput& cached input.
+ */
+static BenchmarkInput& benchmarkInput(unsigned int family, uint64_t edges) {
+    static map<pair<unsigned int, uint64_t>, unique_ptr<BenchmarkInput>> cache;
+    unique_ptr<BenchmarkInput> &entry = cache[make_pair(family, edges)];
+    if(!entry) {
+        entry.reset(new BenchmarkInput());
+        families[family].generate(edges, entry->csr);
+    }
+    return *entry;
+}
+
+/**
+ * @brief Engine to be measured. call runs the engine once and returns the number of fill edges it produced (0 if the
+ * engine does not produce fill). The engines on the Graph version receive it as second argument: a fresh copy when
+ * modifiesGraph is true, the cached one otherwise; the CSR engines receive nullptr. maxEdges is the largest input on
+ * which the engine is measured, needsOrdering tells that the call reads the cached ordering of the input.
+ */
+struct Engine {
+    string name;
+    uint64_t maxEdges;
+    bool needsGraph;
+    bool modifiesGraph;
+    bool needsOrdering;
+    function<uint64_t(BenchmarkInput&, Graph*)> call;
+};
+
+static const vector<Engine> engines = {
+    {"lex_p", 1 << 22, true, false, false, [](BenchmarkInput &in, Graph *g) -> uint64_t {
+        vector<unsigned int> ordering = g->lex_p();
+        return 0;
+    }},
+    {"lex_m", 1 << 12, true, true, false, [](BenchmarkInput &in, Graph *g) -> uint64_t {
+        vector<unsigned int> ordering = g->lex_m();
+        return g->edgeSize() - in.csr.edgeSize();
+    }},
+    {"fill_in", 1 << 16, true, true, true, [](BenchmarkInput &in, Graph *g) -> uint64_t {
+        BijectionFunction bj(in.getOrdering());
+        g->fill_in(bj);
+        return g->edgeSize() - in.csr.edgeSize();
+    }},
+    {"csr_lex_p", 10000000, false, false, false, [](BenchmarkInput &in, Graph *g) -> uint64_t {
+        vector<unsigned int> ordering = in.csr.lex_p();
+        return 0;
+    }},
+    {"csr_lex_m", 1 << 14, false, false, false, [](BenchmarkInput &in, Graph *g) -> uint64_t {
+        vector<pair<unsigned int, unsigned int>> fill;
+        vector<unsigned int> ordering = in.csr.lex_m(&fill);
+        return fill.size();
+    }},
+    {"order", 1 << 14, true, false, false, [](BenchmarkInput &in, Graph *g) -> uint64_t {
+        vector<unsigned int> ordering = g->order();
+        return 0;
+    }},
+};
+
+/**
+ * @brief Build the parts of the input read by an engine, so they are not measured with its first call.
+ * @param engine engine to be run.
+ * @param in input of the engine.
+ */
+static void prepareInput(const Engine &engine, BenchmarkInput &in) {
+    if(engine.needsGraph)
+        in.getGraph();
+    if(engine.needsOrdering)
+        in.getOrdering();
+}
+
+/**
+ * @brief Target numbers of edges of the inputs, up to 10^7.
+ */
+static const vector<uint64_t> benchmarkSizes = {1 << 10, 1 << 12, 1 << 14, 1 << 16, 1 << 18, 1 << 20, 1 << 22, 10000000};
+
+#endif
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include "../benchmark_common.hpp"
+#include "memory_tracker.hpp"
+
+// Memory consumption of all the ordering engines on all the graph families, measured in process by the counting
+// operator new of memory_tracker.hpp. The benchmarks are the same of test/temporal/ordering_benchmark.cpp
+// (<engine>/<family>/<target edges>) and every size is swept in a single run. Only the call of the engine is tracked:
+// the input and the copy of the graph given to the engines that modify it are allocated outside the phase.
+// The counters report the peak of the bytes in use above the input, the total of the allocated bytes and the peak per
+// vertex and per edge, which should stay flat along the sizes for an engine that uses linear memory.
+// The time is measured as well, but the counting operators slow down the engines that allocate often, so the times to
+// be compared are those of the temporal benchmark.
+
+/**
+ * @brief Body shared by all the benchmarks: it runs the engine on the cached input, tracking its allocations.
+ * @param state state of the benchmark, range(0) is the target number of edges.
+ * @param engine engine to be measured.
+ * @param family index of the family of the input.
+ */
+static void BM_memory(benchmark::State &state, const Engine &engine, unsigned int family) {
+    BenchmarkInput &in = benchmarkInput(family, state.range(0));
+    prepareInput(engine, in);
+    uint64_t fill = 0;
+    MemoryTracker::Phase phase = {0, 0, 0};
+    for(auto _ : state) {
+        state.PauseTiming();
+        Graph copy;
+        if(engine.modifiesGraph)
+            copy = in.getGraph();
+        Graph *g = !engine.needsGraph ? nullptr : engine.modifiesGraph ? &copy : in.graph.get();
+        state.ResumeTiming();
+
+        MemoryTracker::beginPhase();
+        fill = engine.call(in, g);
+        phase = MemoryTracker::endPhase();
+
+        // the copy is destroyed outside the timing
+        state.PauseTiming();
+        copy = Graph();
+        state.ResumeTiming();
+    }
+
+    uint64_t edges = in.csr.edgeSize(), vertices = in.csr.size();
+    state.counters["vertices"] = vertices;
+    state.counters["edges"] = edges;
+    state.counters["fill_edges"] = fill;
+    state.counters["peak_bytes"] = phase.peak_bytes;
+    state.counters["allocated_bytes"] = phase.allocated_bytes;
+    state.counters["allocations"] = phase.allocations;
+    state.counters["peak_bytes/vertex"] = vertices ? (double) phase.peak_bytes / vertices : 0;
+    state.counters["peak_bytes/edge"] = edges ? (double) phase.peak_bytes / edges : 0;
+}
+
+int main(int argc, char **argv) {
+    for(auto &engine : engines)
+        for(unsigned int family = 0; family < families.size(); ++family) {
+            auto *bm = benchmark::RegisterBenchmark((engine.name + "/" + families[family].name).c_str(), BM_memory, engine, family);
+            for(auto size : benchmarkSizes)
+                if(size <= engine.maxEdges)
+                    bm->Arg(size);
+            // the allocations do not change between iterations, one is enough
+            bm->Unit(benchmark::kMillisecond)->Iterations(1);
+        }
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
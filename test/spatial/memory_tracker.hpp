@@ -0,0 +1,152 @@
+#ifndef MEMORY_TRACKER_H_
+#define MEMORY_TRACKER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+// Counting replacement of the global operator new and delete. It replaces the operators of the whole program, so it
+// must be included by exactly one translation unit (the main file of the benchmark).
+// Every block carries a header of 16 bytes before the pointer returned to the caller: the pointer returned by malloc
+// and the requested size. So the delete operators know the size of the block without relying on sized deallocation,
+// which is not used by all the standard containers.
+
+using namespace std;
+
+/**
+ * @brief Auxiliary structure that counts the bytes allocated through the global operator new. The allocations are
+ * grouped in phases: beginPhase resets the counters and endPhase returns the peak reached above the memory in use at
+ * the beginning of the phase, the total of the allocated bytes and the number of allocations. The counters are atomic,
+ * so the allocations of all the threads are counted.
+ */
+struct MemoryTracker {
+public:
+    /**
+     * @brief Counters of a phase.
+     */
+    struct Phase {
+        // Maximum number of bytes in use during the phase, minus the bytes in use when it began
+        uint64_t peak_bytes;
+        // Sum of the sizes of all the allocations of the phase
+        uint64_t allocated_bytes;
+        // Number of allocations of the phase
+        uint64_t allocations;
+    };
+
+    /**
+     * @brief Begin a new phase, the counters of the previous one are discarded.
+     */
+    static void beginPhase() {
+        uint64_t now = current_bytes.load(memory_order_relaxed);
+        phase_start.store(now, memory_order_relaxed);
+        peak_bytes.store(now, memory_order_relaxed);
+        allocated_bytes.store(0, memory_order_relaxed);
+        allocations.store(0, memory_order_relaxed);
+    }
+
+    /**
+     * @brief End the current phase.
+     * @return Phase counters of the phase.
+     */
+    static Phase endPhase() {
+        uint64_t start = phase_start.load(memory_order_relaxed), peak = peak_bytes.load(memory_order_relaxed);
+        return {peak > start ? peak - start : 0, allocated_bytes.load(memory_order_relaxed), allocations.load(memory_order_relaxed)};
+    }
+
+    /**
+     * @brief Get the number of bytes in use.
+     * @return uint64_t bytes allocated and not deallocated yet.
+     */
+    static uint64_t current() {
+        return current_bytes.load(memory_order_relaxed);
+    }
+
+    /**
+     * @brief Allocate a block and count it.
+     * @param size number of bytes requested.
+     * @param alignment alignment of the block, at most the size of the header is given by malloc.
+     * @return void* pointer to the block, nullptr if the memory is exhausted.
+     */
+    static void* allocate(size_t size, size_t alignment = HEADER) {
+        if(alignment < HEADER)
+            alignment = HEADER;
+        char *raw = (char*) malloc(size + alignment + HEADER);
+        if(!raw)
+            return nullptr;
+        // first aligned position that leaves room for the header
+        uintptr_t user = ((uintptr_t) raw + HEADER + alignment - 1) & ~(uintptr_t) (alignment - 1);
+        void **header = (void**) (user - HEADER);
+        header[0] = raw;
+        header[1] = (void*) size;
+
+        uint64_t now = current_bytes.fetch_add(size, memory_order_relaxed) + size;
+        uint64_t peak = peak_bytes.load(memory_order_relaxed);
+        while(now > peak && !peak_bytes.compare_exchange_weak(peak, now, memory_order_relaxed));
+        allocated_bytes.fetch_add(size, memory_order_relaxed);
+        allocations.fetch_add(1, memory_order_relaxed);
+        return (void*) user;
+    }
+
+    /**
+     * @brief Deallocate a block returned by allocate.
+     * @param ptr pointer to the block, nullptr is ignored.
+     */
+    static void deallocate(void *ptr) {
+        if(!ptr)
+            return;
+        void **header = (void**) ((char*) ptr - HEADER);
+        current_bytes.fetch_sub((size_t) header[1], memory_order_relaxed);
+        free(header[0]);
+    }
+
+private:
+    static const size_t HEADER = 16;
+
+    static inline atomic<uint64_t> current_bytes{0};
+    static inline atomic<uint64_t> phase_start{0};
+    static inline atomic<uint64_t> peak_bytes{0};
+    static inline atomic<uint64_t> allocated_bytes{0};
+    static inline atomic<uint64_t> allocations{0};
+};
+
+/**
+ * @brief Allocate a block with MemoryTracker, throwing bad_alloc as the standard operators do.
+ * @param size number of bytes requested.
+ * @param alignment alignment of the block.
+ * @return void* pointer to the block.
+ */
+static void* trackedNew(size_t size, size_t alignment) {
+    void *ptr = MemoryTracker::allocate(size ? size : 1, alignment);
+    if(!ptr)
+        throw bad_alloc();
+    return ptr;
+}
+
+void* operator new(size_t size) { return trackedNew(size, 16); }
+void* operator new[](size_t size) { return trackedNew(size, 16); }
+void* operator new(size_t size, align_val_t alignment) { return trackedNew(size, (size_t) alignment); }
+void* operator new[](size_t size, align_val_t alignment) { return trackedNew(size, (size_t) alignment); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return MemoryTracker::allocate(size ? size : 1); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return MemoryTracker::allocate(size ? size : 1); }
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return MemoryTracker::allocate(size ? size : 1, (size_t) alignment);
+}
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return MemoryTracker::allocate(size ? size : 1, (size_t) alignment);
+}
+
+void operator delete(void *ptr) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete[](void *ptr) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete(void *ptr, size_t) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete(void *ptr, align_val_t) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete[](void *ptr, align_val_t) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete(void *ptr, size_t, align_val_t) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete[](void *ptr, size_t, align_val_t) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete(void *ptr, const nothrow_t&) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete[](void *ptr, const nothrow_t&) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete(void *ptr, align_val_t, const nothrow_t&) noexcept { MemoryTracker::deallocate(ptr); }
+void operator delete[](void *ptr, align_val_t, const nothrow_t&) noexcept { MemoryTracker::deallocate(ptr); }
+
+#endif
@@ -0,0 +1,134 @@
+#include <benchmark/benchmark.h>
+#include "../benchmark_common.hpp"
+#include "PerfCounters.hpp"
+#include "Tracer.hpp"
+
+#include <chrono>
+#include <cstring>
+
+// Single benchmark of all the ordering engines on all the graph families.
+// Every benchmark is named <engine>/<family>/<target edges>, each input is generated once and cached, so no timing is
+// paused inside the loops. The engines that modify the graph work on a copy and report the time of the call only.
+// Run with --benchmark_out=<file> --benchmark_out_format=json to keep the results, two runs can be
+// compared with tools/benchmark_compare.py. The inputs and the engines are shared with test/spatial/memory_benchmark.cpp.
+// With --perf_counters every benchmark runs the engine once more outside the timed loop with PerfCounters active and
+// reports the hardware counters of each phase (<phase>.<event>), or only the time of the phases (<phase>.ns) if the
+// counters are not available.
+// With --trace=<file> the spans of the Tracer (graph construction, engines, parallel tasks) are recorded during the run
+// and written to the file in the Chrome trace event format; each thread keeps only its most recent spans.
+
+/**
+ * @brief True if the phases of the engines must be measured with PerfCounters.
+ */
+static bool perfCounters = false;
+
+/**
+ * @brief Measure a call with the wall clock, used with UseManualTime when the setup of every iteration must be excluded.
+ * @param f call to be measured.
+ * @return double seconds spent in the call.
+ */
+template<typename F>
+static double timed(F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Run the engine once with PerfCounters active and report the counters of the phases it executed.
+ * @param state state of the benchmark, it receives the counters.
+ * @param engine engine to be measured.
+ * @param in input of the engine.
+ */
+static void reportPerfCounters(benchmark::State &state, const Engine &engine, BenchmarkInput &in) {
+    Graph copy;
+    if(engine.modifiesGraph)
+        copy = in.getGraph();
+    Graph *g = !engine.needsGraph ? nullptr : engine.modifiesGraph ? &copy : in.graph.get();
+
+    bool hardware = PerfCounters::start();
+    engine.call(in, g);
+    PerfCounters::Stats stats = PerfCounters::stop();
+
+    state.counters["perf_hardware"] = hardware;
+    for(unsigned int p = 0; p < PerfCounters::NUM_PHASES; ++p) {
+        if(stats.calls[p] == 0)
+            continue;
+        string phase = PerfCounters::phaseName((PerfCounters::Phase) p);
+        state.counters[phase + ".ns"] = stats.nanoseconds[p];
+        for(unsigned int e = 0; e < PerfCounters::NUM_EVENTS; ++e)
+            if(stats.supported[e])
+                state.counters[phase + "." + PerfCounters::eventName((PerfCounters::Event) e)] = stats.values[p][e];
+    }
+}
+
+/**
+ * @brief Body shared by all the benchmarks: it runs the engine on the cached input and reports the counters.
+ * @param state state of the benchmark, range(0) is the target number of edges.
+ * @param engine engine to be measured.
+ * @param family index of the family of the input.
+ */
+static void BM_ordering(benchmark::State &state, const Engine &engine, unsigned int family) {
+    BenchmarkInput &in = benchmarkInput(family, state.range(0));
+    prepareInput(engine, in);
+    uint64_t fill = 0;
+    for(auto _ : state) {
+        if(engine.modifiesGraph) {
+            Graph g = in.getGraph();
+            state.SetIterationTime(timed([&]() { fill = engine.call(in, &g); }));
+        }
+        else
+            fill = engine.call(in, engine.needsGraph ? in.graph.get() : nullptr);
+    }
+
+    if(perfCounters)
+        reportPerfCounters(state, engine, in);
+
+    uint64_t edges = in.csr.edgeSize(), vertices = in.csr.size();
+    state.SetComplexityN(vertices + edges);
+    state.SetBytesProcessed(state.iterations() * in.bytes());
+    state.counters["vertices"] = vertices;
+    state.counters["edges"] = edges;
+    state.counters["fill_edges"] = fill;
+    state.counters["input_bytes"] = in.bytes();
+    state.counters["edges/s"] = benchmark::Counter(edges, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+int main(int argc, char **argv) {
+    // remove the option of the benchmark from the ones of the library
+    int kept = 1;
+    string trace;
+    for(int i = 1; i < argc; ++i)
+        if(strcmp(argv[i], "--perf_counters") == 0)
+            perfCounters = true;
+        else if(strncmp(argv[i], "--trace=", 8) == 0)
+            trace = argv[i] + 8;
+        else
+            argv[kept++] = argv[i];
+    argc = kept;
+
+    for(auto &engine : engines)
+        for(unsigned int family = 0; family < families.size(); ++family) {
+            auto *bm = benchmark::RegisterBenchmark((engine.name + "/" + families[family].name).c_str(), BM_ordering, engine, family);
+            for(auto size : benchmarkSizes)
+                if(size <= engine.maxEdges)
+                    bm->Arg(size);
+            bm->Unit(benchmark::kMillisecond)->Complexity();
+            if(engine.modifiesGraph)
+                bm->UseManualTime();
+        }
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    if(!trace.empty())
+        Tracer::enable();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    if(!trace.empty() && !Tracer::writeChromeTrace(trace)) {
+        cerr << "Cannot write the trace in " << trace << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,189 @@
+#include "Graph.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <cstdint>
+
+using namespace boost;
+using namespace CustomGraph;
+namespace bdata = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(Adjacency_matrix_tests)
+
+const unsigned int matrix_dimension[] = {1, 63, 64, 65, 512, 1000};
+
+// Set and clear bits of the matrix, rows must start on a 64-byte boundary.
+
+BOOST_DATA_TEST_CASE(Bit_operations, bdata::make(matrix_dimension), n) {
+    AdjacencyMatrix m(n);
+
+    BOOST_TEST(m.capacity() == n);
+    BOOST_TEST(m.rowWords() % 8 == (unsigned int)0);
+
+    for(unsigned int i = 0; i < n; ++i) {
+        BOOST_TEST(reinterpret_cast<uintptr_t>(m.row(i)) % 64 == (unsigned int)0);
+        m.set(i, n-1-i);
+    }
+
+    for(unsigned int i = 0; i < n; ++i) {
+        BOOST_TEST(m.test(i, n-1-i));
+        BOOST_TEST(m.countRow(i) == (unsigned int)1);
+    }
+
+    m.clearColumn(0);
+    BOOST_TEST(!m.test(n-1, 0));
+
+    m.resize(2*n);
+    BOOST_TEST(m.capacity() == 2*n);
+    for(unsigned int i = 0; i + 1 < n; ++i)
+        BOOST_TEST(m.test(i, n-1-i));
+}
+
+// Merge a row inside another, only the missing bits are reported as added.
+
+BOOST_AUTO_TEST_CASE(Merge_row) {
+    AdjacencyMatrix m(100);
+    m.set(0, 3);
+    m.set(1, 3);
+    m.set(1, 70);
+
+    vector<uint64_t> added(m.rowWords());
+    unsigned int count = m.mergeRow(0, m.row(1), added.data());
+
+    BOOST_TEST(count == (unsigned int)1);
+    BOOST_TEST(m.test(0, 70));
+
+    vector<unsigned int> bits;
+    AdjacencyMatrix::forEachBit(added.data(), nullptr, m.rowWords(), [&](unsigned int j) {
+        bits.push_back(j);
+    });
+    BOOST_TEST(bits.size() == (unsigned int)1);
+    BOOST_TEST(bits[0] == (unsigned int)70);
+}
+
+// Edges, duplicated edges, auto-ring and deletion with the dense backend.
+
+BOOST_AUTO_TEST_CASE(Dense_graph_edges) {
+    vector<unsigned int> vertices = {1,7,4,3,11};
+    CustomGraph::Graph g(vertices, Storage::Dense);
+
+    g.addEdge(1,7);
+    g.addEdge(7,1);
+    g.addEdge(1,1);
+    g.addEdge(1,4);
+    g.addEdge(1,3);
+    g.addEdge(7,3);
+    g.addEdge(7,11);
+    g.addEdge(4,11);
+    g.addEdge(3,11);
+
+    BOOST_TEST((g.getStorage() == Storage::Dense));
+    BOOST_TEST(g.edgeSize() == (unsigned int)7);
+    BOOST_TEST(g.isAdjacent(7,1));
+    BOOST_TEST(!g.isAdjacent(1,1));
+    BOOST_TEST(g.isConnected());
+
+    g.deleteVertex(1);
+
+    BOOST_TEST(g.size() == vertices.size()-1);
+    BOOST_TEST(g.edgeSize() == (unsigned int)4);
+    for(auto v : g.getVertices())
+        BOOST_TEST(!g.isAdjacent(v.first, 1));
+
+    // the released row is assigned to the new vertex without old edges
+    g.addVertex(20);
+    BOOST_TEST(!g.isConnected());
+    unsigned int adjacent = 0;
+    g.forEachAdjacent(20, [&](unsigned int) { adjacent++; });
+    BOOST_TEST(adjacent == (unsigned int)0);
+}
+
+const unsigned int graph_dimension[] = {8, 16, 32, 128, 256};
+
+// The dense backend must produce the same fill-in of the sparse backend for the same ordering.
+
+BOOST_DATA_TEST_CASE(Dense_fill_in, bdata::make(graph_dimension), n) {
+    CustomGraph::Graph sparse;
+    sparse.generateRandomGraphPrecise(n);
+
+    CustomGraph::Graph dense(sparse.getVerticesKeys(), Storage::Dense);
+    for(auto &v : sparse.getVertices())
+        for(auto w : v.second.getAdjVertices())
+            dense.addEdge(v.first, w);
+
+    BOOST_TEST(dense.edgeSize() == sparse.edgeSize());
+
+    vector<unsigned int> ordering = sparse.getVerticesKeys();
+    BijectionFunction bj(ordering);
+    sparse.fill_in(bj);
+    dense.fill_in(bj);
+
+    BOOST_TEST(dense.edgeSize() == sparse.edgeSize());
+    for(auto &v : sparse.getVertices())
+        for(auto w : v.second.getAdjVertices())
+            BOOST_TEST(dense.isAdjacent(v.first, w));
+}
+
+// Lex_m and lex_p with the dense backend, the ordering must be eliminated by the fill produced during lex_m.
+
+BOOST_DATA_TEST_CASE(Dense_orderings, bdata::make(graph_dimension), n) {
+    CustomGraph::Graph sparse;
+    sparse.generateRandomGraphPrecise(n);
+
+    CustomGraph::Graph dense(sparse.getVerticesKeys(), Storage::Dense);
+    for(auto &v : sparse.getVertices())
+        for(auto w : v.second.getAdjVertices())
+            dense.addEdge(v.first, w);
+
+    vector<unsigned int> lex_m_vertices = dense.lex_m();
+    BOOST_TEST(lex_m_vertices.size() == dense.size());
+
+    unsigned int triangulated_edges = dense.edgeSize();
+    BijectionFunction bj(lex_m_vertices);
+    dense.fill_in(bj);
+    BOOST_TEST(dense.edgeSize() == triangulated_edges);
+
+    // the triangulated graph is chordal, so lex_p must find a perfect ordering
+    vector<unsigned int> lex_p_vertices = dense.lex_p();
+    BijectionFunction bj_p(lex_p_vertices);
+    dense.fill_in(bj_p);
+    BOOST_TEST(dense.edgeSize() == triangulated_edges);
+}
+
+// Test case explained in the paper that shows a minimal ordering, using the dense backend.
+
+BOOST_AUTO_TEST_CASE(Dense_paper_example_minimal_ordering) {
+    vector<unsigned int> vertices = {1,2,3,4,5,6,7,8,9};
+    reverse(vertices.begin(), vertices.end());
+    CustomGraph::Graph g(vertices, Storage::Dense);
+
+    g.addEdge(1,2);
+    g.addEdge(1,5);
+    g.addEdge(2,3);
+    g.addEdge(2,4);
+    g.addEdge(2,6);
+    g.addEdge(3,7);
+    g.addEdge(4,5);
+    g.addEdge(4,6);
+    g.addEdge(4,8);
+    g.addEdge(5,8);
+    g.addEdge(6,7);
+    g.addEdge(6,9);
+    g.addEdge(7,9);
+    g.addEdge(8,9);
+
+    unsigned int prev_edges = g.edgeSize();
+    vector<unsigned int> bij_vector = g.lex_m();
+
+    // the grid is not chordal, and the ordering must be perfect for the triangulated graph
+    BOOST_TEST(g.edgeSize() > prev_edges);
+
+    unsigned int triangulated_edges = g.edgeSize();
+    BijectionFunction bf(bij_vector);
+    g.fill_in(bf);
+    BOOST_TEST(g.edgeSize() == triangulated_edges);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+#include "CompressedGraph.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+using namespace boost;
+using namespace CustomGraph;
+namespace bdata = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(Compressed_graph_tests)
+
+// Differences that need 1, 2, 3 and 4 bytes must be decoded correctly.
+
+BOOST_AUTO_TEST_CASE(Codec_lengths) {
+    vector<unsigned int> vertices = {0, 1, 300, 70000, 20000000, 4000000000u};
+    CustomGraph::Graph g(vertices);
+    for(unsigned int i = 1; i < vertices.size(); ++i)
+        g.addEdge(vertices[0], vertices[i]);
+
+    CompressedGraph cg(g);
+
+    BOOST_TEST(cg.size() == vertices.size());
+    BOOST_TEST(cg.edgeSize() == g.edgeSize());
+    BOOST_TEST(cg.degree(cg.indexOf(0)) == (unsigned int)5);
+
+    vector<unsigned int> adjacent;
+    for(auto w : cg.neighbors(cg.indexOf(0)))
+        adjacent.push_back(cg.vertexValue(w));
+
+    vector<unsigned int> expected(vertices.begin()+1, vertices.end());
+    BOOST_TEST(adjacent == expected);
+    BOOST_TEST(cg.indexOf(5) == cg.size());
+}
+
+const unsigned int graph_dimension[] = {8, 16, 32, 128, 256, 1024};
+
+// The compressed lists must contain the same adjacent vertices of the original graph, in ascending order.
+
+BOOST_DATA_TEST_CASE(Same_adjacency, bdata::make(graph_dimension), n) {
+    CustomGraph::Graph g;
+    g.generateRandomGraphPrecise(n);
+
+    CompressedGraph cg(g);
+
+    BOOST_TEST(cg.size() == g.size());
+    BOOST_TEST(cg.isConnected() == g.isConnected());
+
+    for(unsigned int i = 0; i < cg.size(); ++i) {
+        unsigned int v = cg.vertexValue(i);
+        unsigned int count = 0;
+        int previous = -1;
+        for(auto w : cg.neighbors(i)) {
+            BOOST_TEST((int) w > previous);
+            BOOST_TEST(g.isAdjacent(v, cg.vertexValue(w)));
+            previous = w;
+            count++;
+        }
+        BOOST_TEST(count == g.getVertices()[v].getAdjVertices().size());
+        BOOST_TEST(count == cg.degree(i));
+    }
+}
+
+// Lex_p on the compressed graph of a chordal graph must produce a perfect ordering.
+
+BOOST_DATA_TEST_CASE(Compressed_lex_p, bdata::make(graph_dimension), n) {
+    CustomGraph::Graph g;
+    g.generateRandomGraphPrecise(n);
+
+    // the fill-in of any ordering is a chordal graph
+    vector<unsigned int> ordering = g.getVerticesKeys();
+    BijectionFunction bj(ordering);
+    g.fill_in(bj);
+
+    unsigned int chordal_edges = g.edgeSize();
+    CompressedGraph cg(g);
+    vector<unsigned int> lex_p_vertices = cg.lex_p();
+
+    BOOST_TEST(lex_p_vertices.size() == g.size());
+
+    BijectionFunction bj_p(lex_p_vertices);
+    g.fill_in(bj_p);
+    BOOST_TEST(g.edgeSize() == chordal_edges);
+}
+
+// A graph with two components is not connected.
+
+BOOST_AUTO_TEST_CASE(Compressed_not_connected) {
+    vector<unsigned int> vertices = {1,2,3,4};
+    CustomGraph::Graph g(vertices);
+    g.addEdge(1,2);
+    g.addEdge(3,4);
+
+    CompressedGraph cg(g);
+    BOOST_TEST(!cg.isConnected());
+    BOOST_TEST(cg.memoryUsage() > (size_t)0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
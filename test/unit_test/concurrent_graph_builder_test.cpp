@@ -0,0 +1,112 @@
+#include "ConcurrentGraphBuilder.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <thread>
+
+using namespace boost;
+using namespace CustomGraph;
+namespace bdata = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(Concurrent_graph_builder_tests)
+
+// Vertices without edges, duplicates and auto-rings added by a single thread.
+
+BOOST_AUTO_TEST_CASE(Single_producer) {
+    ConcurrentGraphBuilder builder;
+    builder.addVertex(100);
+    builder.addEdge(1, 2);
+    builder.addEdge(2, 1);
+    builder.addEdge(3, 3);
+    builder.addEdge(2, 3);
+    BOOST_TEST(builder.pendingEdges() == (size_t)4);
+
+    CustomGraph::Graph g;
+    builder.finalize(g);
+    BOOST_TEST(g.size() == (unsigned int)4);
+    BOOST_TEST(g.edgeSize() == (unsigned int)2);
+    BOOST_TEST(g.isInside(100));
+    BOOST_TEST(g.isAdjacent(3, 2));
+
+    // the builder keeps its content after finalize, clear removes it
+    CSRGraph csr;
+    builder.finalize(csr);
+    BOOST_TEST(csr.size() == (unsigned int)4);
+    BOOST_TEST(csr.edgeSize() == (unsigned int)2);
+
+    builder.clear();
+    BOOST_TEST(builder.pendingEdges() == (size_t)0);
+    builder.addEdge(5, 6);
+    builder.finalize(g);
+    BOOST_TEST(g.size() == (unsigned int)2);
+    BOOST_TEST(g.edgeSize() == (unsigned int)1);
+}
+
+const unsigned int thread_number[] = {1, 2, 4, 8};
+
+// Many producers add the edges of a random graph, every edge in both directions.
+
+BOOST_DATA_TEST_CASE(Many_producers, bdata::make(thread_number), producers) {
+    CustomGraph::Graph g;
+    g.generateRandomGraphPrecise(4096);
+
+    vector<pair<unsigned int, unsigned int>> edges;
+    for(auto &v : g.getVertices())
+        for(auto w : v.second.getAdjVertices())
+            edges.push_back(make_pair(v.first, w));
+
+    ConcurrentGraphBuilder builder;
+    vector<thread> workers;
+    for(unsigned int t = 0; t < producers; ++t)
+        workers.emplace_back([&, t]() {
+            for(size_t i = t; i < edges.size(); i += producers)
+                builder.addEdge(edges[i].first, edges[i].second);
+        });
+    for(auto &w : workers)
+        w.join();
+
+    BOOST_TEST(builder.pendingEdges() == edges.size());
+
+    CustomGraph::Graph built;
+    builder.finalize(built, 4);
+    BOOST_TEST(built.size() == g.size());
+    BOOST_TEST(built.edgeSize() == g.edgeSize());
+    for(auto &edge : edges)
+        BOOST_TEST(built.isAdjacent(edge.first, edge.second));
+
+    CSRGraph csr;
+    builder.finalize(csr, 4);
+    BOOST_TEST(csr.edgeSize() == g.edgeSize());
+    BOOST_TEST(csr.isConnected() == g.isConnected());
+}
+
+// Producers that alternate between more builders than each thread remembers: every builder receives exactly its edges.
+
+BOOST_AUTO_TEST_CASE(Alternating_builders) {
+    const unsigned int num_builders = 12, num_producers = 4, rounds = 200;
+    vector<unique_ptr<ConcurrentGraphBuilder>> builders;
+    for(unsigned int b = 0; b < num_builders; ++b)
+        builders.push_back(make_unique<ConcurrentGraphBuilder>());
+
+    vector<thread> producers;
+    for(unsigned int t = 0; t < num_producers; ++t)
+        producers.emplace_back([&, t]() {
+            for(unsigned int r = 0; r < rounds; ++r)
+                for(unsigned int b = 0; b < num_builders; ++b)
+                    builders[(b + t) % num_builders]->addEdge(t * rounds + r, 100000 + (b + t) % num_builders);
+        });
+    for(auto &producer : producers)
+        producer.join();
+
+    for(unsigned int b = 0; b < num_builders; ++b) {
+        BOOST_TEST(builders[b]->pendingEdges() == (size_t)(num_producers * rounds));
+        CSRGraph csr;
+        builders[b]->finalize(csr);
+        BOOST_TEST(csr.size() == num_producers * rounds + 1);
+        BOOST_TEST(csr.edgeSize() == num_producers * rounds);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
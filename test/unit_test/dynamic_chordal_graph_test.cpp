@@ -0,0 +1,165 @@
+#include "DynamicChordalGraph.hpp"
+#include "OrderingEngines.hpp"
+#include "WorkloadGenerator.hpp"
+#include "RandomStream.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+using namespace CustomGraph;
+
+BOOST_AUTO_TEST_SUITE(Dynamic_chordal_graph_tests)
+
+/**
+ * @brief Check the chordality of the graph from scratch with lex_p.
+ * @param graph graph to be checked.
+ * @return true if the graph is chordal.
+ */
+static bool chordal(DynamicChordalGraph &graph) {
+    CSRGraph csr = graph.toCSR();
+    return OrderingEngines::isPerfectOrdering(csr, csr.lex_p());
+}
+
+/**
+ * @brief Check that the ordering of the graph is perfect.
+ * @param graph graph to be checked.
+ * @return true if ordering() is a perfect ordering.
+ */
+static bool perfect(DynamicChordalGraph &graph) {
+    CSRGraph csr = graph.toCSR();
+    return OrderingEngines::isPerfectOrdering(csr, graph.ordering());
+}
+
+// The ordering built from a chordal CSRGraph is perfect and it is kept perfect by the edges that do not break it.
+
+BOOST_AUTO_TEST_CASE(From_csr) {
+    CSRGraph csr;
+    BOOST_TEST(WorkloadGenerator::randomChordal(500, 6, 3, csr));
+    DynamicChordalGraph graph(csr);
+    BOOST_TEST(graph.size() == csr.size());
+    BOOST_TEST(graph.edgeSize() == csr.edgeSize());
+    BOOST_TEST(graph.isChordal());
+    BOOST_TEST(perfect(graph));
+
+    CSRGraph copy = graph.toCSR();
+    BOOST_TEST(copy.getVerticesKeys() == csr.getVerticesKeys());
+    BOOST_TEST(copy.lex_p() == csr.lex_p());
+}
+
+// Two cliques joined by a bridge are chordal, a second bridge closes a chordless cycle and deleting it restores
+// chordality.
+
+BOOST_AUTO_TEST_CASE(Bridges) {
+    DynamicChordalGraph graph(8);
+    for(unsigned int i = 0; i < 4; ++i)
+        for(unsigned int j = i + 1; j < 4; ++j) {
+            BOOST_TEST((graph.addEdge(i, j) != DynamicChordalGraph::Update::NotChordal));
+            BOOST_TEST((graph.addEdge(i + 4, j + 4) != DynamicChordalGraph::Update::NotChordal));
+        }
+    BOOST_TEST((graph.addEdge(0, 1) == DynamicChordalGraph::Update::Unchanged));
+    BOOST_TEST((graph.addEdge(3, 3) == DynamicChordalGraph::Update::Unchanged));
+    BOOST_TEST((graph.addEdge(3, 8) == DynamicChordalGraph::Update::Unchanged));
+    BOOST_TEST((graph.deleteEdge(0, 4) == DynamicChordalGraph::Update::Unchanged));
+
+    BOOST_TEST((graph.addEdge(3, 4) != DynamicChordalGraph::Update::NotChordal));
+    BOOST_TEST(graph.isChordal());
+    BOOST_TEST(perfect(graph));
+
+    BOOST_TEST((graph.addEdge(0, 7) == DynamicChordalGraph::Update::NotChordal));
+    BOOST_TEST(!graph.isChordal());
+    BOOST_TEST(graph.ordering().size() == (size_t)8);
+
+    BOOST_TEST((graph.deleteEdge(7, 0) == DynamicChordalGraph::Update::Perfect));
+    BOOST_TEST(graph.isChordal());
+    BOOST_TEST(perfect(graph));
+    BOOST_TEST(graph.edgeSize() == (unsigned int)13);
+}
+
+// Random sequences of insertions and deletions: the chordality is always the one computed from scratch and the
+// ordering is perfect whenever the graph is chordal.
+
+BOOST_AUTO_TEST_CASE(Random_updates) {
+    for(uint64_t seed = 1; seed <= 6; ++seed) {
+        const unsigned int n = 14;
+        RandomStream random(seed);
+        DynamicChordalGraph graph(n);
+        for(unsigned int step = 0; step < 400; ++step) {
+            unsigned int u = random.next() % n, v = random.next() % n;
+            if(graph.isAdjacent(u, v))
+                graph.deleteEdge(u, v);
+            else
+                graph.addEdge(u, v);
+
+            BOOST_TEST(graph.isChordal() == chordal(graph));
+            if(step % 10 == 0 && graph.isChordal())
+                BOOST_TEST(perfect(graph));
+        }
+    }
+}
+
+// The values of the vertices of the CSRGraph are kept by the updates and by the ordering.
+
+BOOST_AUTO_TEST_CASE(Values) {
+    vector<uint64_t> offsets = {0, 1, 2, 2};
+    vector<unsigned int> adjacency = {1, 0};
+    vector<unsigned int> ids = {10, 20, 30};
+    CSRGraph csr(move(offsets), move(adjacency), move(ids));
+    DynamicChordalGraph graph(csr);
+
+    BOOST_TEST(graph.isAdjacent(20, 10));
+    BOOST_TEST((graph.addEdge(20, 30) == DynamicChordalGraph::Update::Perfect));
+    BOOST_TEST((graph.addEdge(0, 1) == DynamicChordalGraph::Update::Unchanged));
+    vector<unsigned int> ordering = graph.ordering();
+    sort(ordering.begin(), ordering.end());
+    BOOST_TEST(ordering == vector<unsigned int>({10, 20, 30}));
+    BOOST_TEST(perfect(graph));
+}
+
+// The work of an update depends on the neighbourhood of the edge, not on the size of the graph: on a long path the
+// triangles added near one end and the chords deleted are checked with a few steps each, also while a chordless cycle
+// elsewhere keeps the graph not chordal.
+
+BOOST_AUTO_TEST_CASE(Locality) {
+    const unsigned int n = 100000;
+    vector<uint64_t> offsets(n + 1, 0);
+    vector<unsigned int> adjacency;
+    for(unsigned int i = 0; i < n; ++i) {
+        if(i > 0)
+            adjacency.push_back(i - 1);
+        if(i + 1 < n)
+            adjacency.push_back(i + 1);
+        offsets[i + 1] = adjacency.size();
+    }
+    CSRGraph csr(move(offsets), move(adjacency), {});
+    DynamicChordalGraph graph(csr);
+    BOOST_TEST(graph.isChordal());
+
+    uint64_t before = graph.work();
+    for(unsigned int i = 0; i < 100; i += 2)
+        BOOST_TEST((graph.addEdge(i, i + 2) != DynamicChordalGraph::Update::NotChordal));
+    for(unsigned int i = 0; i < 100; i += 4)
+        BOOST_TEST((graph.deleteEdge(i, i + 2) != DynamicChordalGraph::Update::NotChordal));
+    BOOST_TEST(graph.work() - before < (uint64_t)10000);
+
+    // a chord between far vertices closes a long chordless cycle, deleting it makes the path chordal again
+    BOOST_TEST((graph.addEdge(200, 1000) == DynamicChordalGraph::Update::NotChordal));
+    BOOST_TEST(!graph.isChordal());
+
+    // the updates away from the cycle keep it chordless, they are decided without checking the whole path again
+    before = graph.work();
+    for(unsigned int i = 50000; i < 50100; i += 2)
+        BOOST_TEST((graph.addEdge(i, i + 2) == DynamicChordalGraph::Update::NotChordal));
+    for(unsigned int i = 50000; i < 50100; i += 4)
+        BOOST_TEST((graph.deleteEdge(i, i + 2) == DynamicChordalGraph::Update::NotChordal));
+    BOOST_TEST(graph.work() - before < (uint64_t)1000);
+    BOOST_TEST(!graph.isChordal());
+
+    // a chord of the cycle breaks the witness, the region is checked again and it is still not chordal
+    BOOST_TEST((graph.addEdge(300, 302) == DynamicChordalGraph::Update::NotChordal));
+    BOOST_TEST((graph.deleteEdge(300, 302) == DynamicChordalGraph::Update::NotChordal));
+    BOOST_TEST((graph.deleteEdge(200, 1000) == DynamicChordalGraph::Update::Perfect));
+    BOOST_TEST(graph.isChordal());
+    BOOST_TEST(graph.ordering().size() == (size_t)n);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
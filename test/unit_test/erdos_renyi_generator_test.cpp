@@ -0,0 +1,84 @@
+#include "ErdosRenyiGenerator.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+using namespace boost;
+using namespace CustomGraph;
+namespace bdata = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(Erdos_renyi_generator_tests)
+
+const unsigned int graph_dimension[] = {1, 2, 10, 100, 1000, 20000};
+
+// Connected graphs with exactly the requested edges, from the tree alone to the complete graph.
+
+BOOST_DATA_TEST_CASE(Exact_edges_and_connected, bdata::make(graph_dimension), n) {
+    uint64_t max_edges = ErdosRenyiGenerator::maxEdges(n);
+    uint64_t tree_edges = n - 1;
+
+    for(uint64_t m : {tree_edges, tree_edges + (max_edges - tree_edges) / 100, tree_edges + (max_edges - tree_edges) / 2, max_edges}) {
+        if(n > 1000 && m > 4 * (uint64_t) n * 100)
+            continue;
+
+        CSRGraph csr;
+        BOOST_TEST(ErdosRenyiGenerator::generate(n, m, 42, csr));
+        BOOST_TEST(csr.size() == n);
+        BOOST_TEST(csr.edgeSize() == m);
+        BOOST_TEST(csr.isConnected());
+        for(unsigned int i = 0; i < csr.size(); ++i)
+            for(auto j : csr.neighbors(i))
+                BOOST_TEST(j != i);
+    }
+
+    vector<pair<unsigned int, unsigned int>> edges;
+    BOOST_TEST(!ErdosRenyiGenerator::generateEdges(n, max_edges + 1, 42, edges));
+    if(n > 2)
+        BOOST_TEST(!ErdosRenyiGenerator::generateEdges(n, n - 2, 42, edges));
+}
+
+// The same seed gives the same graph with any number of threads, a different seed gives a different graph.
+
+BOOST_AUTO_TEST_CASE(Reproducible) {
+    vector<pair<unsigned int, unsigned int>> first, second, other;
+    BOOST_TEST(ErdosRenyiGenerator::generateEdges(30000, 200000, 7, first, 1));
+    BOOST_TEST(ErdosRenyiGenerator::generateEdges(30000, 200000, 7, second, 8));
+    BOOST_TEST(ErdosRenyiGenerator::generateEdges(30000, 200000, 8, other, 8));
+
+    BOOST_TEST((first == second));
+    BOOST_TEST((first != other));
+    BOOST_TEST(is_sorted(first.begin(), first.end()));
+    BOOST_TEST((adjacent_find(first.begin(), first.end()) == first.end()));
+
+    CustomGraph::Graph g, h;
+    g.generateRandomGraphPrecise(500, 3);
+    h.generateRandomGraphPrecise(500, 3);
+    BOOST_TEST(g.size() + g.edgeSize() == (unsigned int)500);
+    BOOST_TEST(g.edgeSize() == h.edgeSize());
+    BOOST_TEST(g.isConnected());
+    for(auto &v : g.getVertices())
+        for(auto w : v.second.getAdjVertices())
+            BOOST_TEST(h.isAdjacent(v.first, w));
+}
+
+// Near the complete graph the missing edges are chosen among the few free pairs: the edges are exact and distinct and
+// the pairs left out depend on the seed.
+
+BOOST_AUTO_TEST_CASE(Near_complete) {
+    const unsigned int n = 2000;
+    uint64_t max_edges = ErdosRenyiGenerator::maxEdges(n);
+    for(uint64_t left_out : {(uint64_t)1, (uint64_t)n, max_edges / 3}) {
+        vector<pair<unsigned int, unsigned int>> edges, other;
+        BOOST_TEST(ErdosRenyiGenerator::generateEdges(n, max_edges - left_out, 3, edges));
+        BOOST_TEST(ErdosRenyiGenerator::generateEdges(n, max_edges - left_out, 4, other));
+        BOOST_TEST(edges.size() == max_edges - left_out);
+        BOOST_TEST(is_sorted(edges.begin(), edges.end()));
+        BOOST_TEST((adjacent_find(edges.begin(), edges.end()) == edges.end()));
+        BOOST_TEST((edges != other));
+        BOOST_TEST(all_of(edges.begin(), edges.end(), [](const pair<unsigned int, unsigned int> &edge) { return edge.first < edge.second; }));
+        BOOST_TEST(edges.back().second < n);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,5 @@
 #include "Graph.hpp"
+#include "RandomStream.hpp"
 
 #include <boost/test/unit_test.hpp>
 
@@ -105,4 +106,88 @@ BOOST_AUTO_TEST_CASE(Chain_graph) {
     BOOST_TEST(g.edgeSize() == (unsigned int)g.size() - 1);
 }
 
+// A new edge in the filled cycle of Cycle_graph: 9 becomes a higher neighbour of 7 and it is added to its parent 11,
+// whose parent 5 is already adjacent to 9 and 20, so the propagation stops there.
+
+BOOST_AUTO_TEST_CASE(Incremental_cycle) {
+    vector<unsigned int> vertices = {7,11,5,9,20};
+    CustomGraph::Graph g(vertices);
+
+    g.addEdge(7,5);
+    g.addEdge(7,11);
+    g.addEdge(5,9);
+    g.addEdge(11,20);
+    g.addEdge(9,20);
+
+    BijectionFunction bf(vertices);
+    g.fill_in(bf);
+
+    vector<pair<unsigned int, unsigned int>> fill = g.fill_in_incremental(bf, {{7,9}, {9,7}, {5,5}, {5,8}});
+    BOOST_TEST(g.isAdjacent(9, 7));
+    BOOST_TEST((fill == vector<pair<unsigned int, unsigned int>>({{11, 9}})));
+    BOOST_TEST(g.edgeSize() == (unsigned int)9);
+    BOOST_TEST(g.fill_in_incremental(bf, {{7,5}}).empty());
+}
+
+/**
+ * @brief Get the sorted list of the edges of a graph, it works with both the storage backends.
+ * @param g graph to be listed.
+ * @return vector<pair<unsigned int, unsigned int>> edges of the graph, each one with the smaller endpoint first.
+ */
+static vector<pair<unsigned int, unsigned int>> edgeList(CustomGraph::Graph &g) {
+    vector<pair<unsigned int, unsigned int>> edges;
+    for(auto v : g.getVerticesKeys())
+        g.forEachAdjacent(v, [&](unsigned int w) {
+            if(v < w)
+                edges.push_back(make_pair(v, w));
+        });
+    sort(edges.begin(), edges.end());
+    return edges;
+}
+
+// Random edges added in batches to a filled random graph give the same graph as fill_in from scratch on the graph with
+// all the edges, and the fill returned is exactly the edges added besides the input ones.
+
+BOOST_AUTO_TEST_CASE(Incremental_random) {
+    for(auto storage : {Storage::Sparse, Storage::Dense})
+        for(uint64_t seed = 1; seed <= 4; ++seed) {
+            const unsigned int n = 120;
+            CustomGraph::Graph random;
+            random.generateRandomGraph(n, seed);
+            vector<unsigned int> ordering = random.getVerticesKeys();
+            RandomStream stream(seed);
+            for(unsigned int i = ordering.size() - 1; i > 0; --i)
+                swap(ordering[i], ordering[stream.next() % (i + 1)]);
+            BijectionFunction bf(ordering);
+
+            CustomGraph::Graph g(random.getVerticesKeys(), storage), scratch(random.getVerticesKeys(), storage);
+            for(auto v : random.getVerticesKeys())
+                random.forEachAdjacent(v, [&](unsigned int w) {
+                    g.addEdge(v, w);
+                    scratch.addEdge(v, w);
+                });
+            g.fill_in(bf);
+
+            for(unsigned int batch = 0; batch < 5; ++batch) {
+                vector<pair<unsigned int, unsigned int>> edges;
+                unsigned int added = 0;
+                for(unsigned int i = 0; i < 3; ++i) {
+                    unsigned int u = ordering[stream.next() % n], v = ordering[stream.next() % n];
+                    if(u != v && !g.isAdjacent(u, v) && find(edges.begin(), edges.end(), make_pair(v, u)) == edges.end() &&
+                       find(edges.begin(), edges.end(), make_pair(u, v)) == edges.end())
+                        added++;
+                    edges.push_back(make_pair(u, v));
+                    scratch.addEdge(u, v);
+                }
+
+                unsigned int before = g.edgeSize();
+                vector<pair<unsigned int, unsigned int>> fill = g.fill_in_incremental(bf, edges);
+                BOOST_TEST(g.edgeSize() == before + added + fill.size());
+            }
+
+            scratch.fill_in(bf);
+            BOOST_TEST(edgeList(g) == edgeList(scratch));
+        }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
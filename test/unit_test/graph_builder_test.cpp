@@ -0,0 +1,78 @@
+#include "GraphBuilder.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+using namespace boost;
+using namespace CustomGraph;
+namespace bdata = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(Graph_builder_tests)
+
+// Duplicates in both directions, auto-rings and unknown endpoints are dropped.
+
+BOOST_AUTO_TEST_CASE(Duplicates_and_auto_rings) {
+    vector<unsigned int> vertices = {10, 20, 30, 40, 20};
+    vector<unsigned int> sources =      {10, 20, 30, 30, 40, 10, 50};
+    vector<unsigned int> destinations = {20, 10, 30, 40, 30, 40, 10};
+
+    CustomGraph::Graph g(vertices, sources, destinations);
+    BOOST_TEST(g.size() == (unsigned int)4);
+    BOOST_TEST(g.edgeSize() == (unsigned int)3);
+    BOOST_TEST(g.isAdjacent(10, 20));
+    BOOST_TEST(g.isAdjacent(40, 30));
+    BOOST_TEST(g.isAdjacent(10, 40));
+    BOOST_TEST(!g.isAdjacent(30, 30));
+
+    CSRGraph csr;
+    BOOST_TEST(GraphBuilder::buildCSR(vertices, sources, destinations, csr));
+    BOOST_TEST(csr.hasIds());
+    BOOST_TEST(csr.size() == (unsigned int)4);
+    BOOST_TEST(csr.edgeSize() == (unsigned int)3);
+    BOOST_TEST(vector<unsigned int>(csr.neighbors(0).begin(), csr.neighbors(0).end()) == vector<unsigned int>({1, 3}));
+
+    // sources and destinations of different sizes only add the vertices
+    sources.pop_back();
+    BOOST_TEST(!GraphBuilder::buildCSR(vertices, sources, destinations, csr));
+    CustomGraph::Graph only_vertices(vertices, sources, destinations);
+    BOOST_TEST(only_vertices.size() == (unsigned int)4);
+    BOOST_TEST(only_vertices.edgeSize() == (unsigned int)0);
+}
+
+const unsigned int graph_dimension[] = {32, 256, 1024, 8192};
+
+// The bulk construction produces the same graph of addEdge, with both backends and any number of threads.
+
+BOOST_DATA_TEST_CASE(Same_as_add_edge, bdata::make(graph_dimension), n) {
+    CustomGraph::Graph g;
+    g.generateRandomGraphPrecise(n);
+
+    vector<unsigned int> sources, destinations;
+    for(auto &v : g.getVertices())
+        for(auto w : v.second.getAdjVertices()) {
+            sources.push_back(v.first);
+            destinations.push_back(w);
+        }
+
+    for(auto storage : {Storage::Sparse, Storage::Dense}) {
+        CustomGraph::Graph built(g.getVerticesKeys(), sources, destinations, storage);
+        BOOST_TEST(built.size() == g.size());
+        BOOST_TEST(built.edgeSize() == g.edgeSize());
+        for(unsigned int i = 0; i < sources.size(); ++i)
+            BOOST_TEST(built.isAdjacent(sources[i], destinations[i]));
+    }
+
+    for(unsigned int threads : {1u, 4u}) {
+        CSRGraph csr;
+        BOOST_TEST(GraphBuilder::buildCSR(g.getVerticesKeys(), sources, destinations, csr, threads));
+        BOOST_TEST(!csr.hasIds());
+        BOOST_TEST(csr.edgeSize() == g.edgeSize());
+        for(unsigned int i = 0; i < csr.size(); ++i) {
+            BOOST_TEST(csr.degree(i) == g.getVertices()[i].getAdjVertices().size());
+            BOOST_TEST(is_sorted(csr.neighbors(i).begin(), csr.neighbors(i).end()));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
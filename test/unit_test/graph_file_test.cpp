@@ -0,0 +1,217 @@
+#include "GraphFile.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+using namespace boost;
+using namespace CustomGraph;
+namespace bdata = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(Graph_file_tests)
+
+const string graph_file_path = (std::filesystem::temp_directory_path() / "graph_file_test.bin").string();
+
+const unsigned int graph_dimension[] = {8, 32, 128, 1024};
+
+// Write a graph, map it back and compare the adjacency of each vertex.
+
+BOOST_DATA_TEST_CASE(Write_and_map, bdata::make(graph_dimension), n) {
+    CustomGraph::Graph g;
+    g.generateRandomGraphPrecise(n);
+
+    BOOST_TEST(GraphFile::write(graph_file_path, g));
+
+    GraphFile file;
+    BOOST_TEST(file.open(graph_file_path));
+    CSRGraph &mapped = file.graph();
+
+    // the generated vertices are 0, ..., n-1 so the ids section is not needed
+    BOOST_TEST(!mapped.hasIds());
+    BOOST_TEST(mapped.size() == g.size());
+    BOOST_TEST(mapped.edgeSize() == g.edgeSize());
+    BOOST_TEST(mapped.isConnected());
+
+    for(unsigned int i = 0; i < mapped.size(); ++i) {
+        BOOST_TEST(mapped.degree(i) == g.getVertices()[mapped.vertexValue(i)].getAdjVertices().size());
+        for(auto j : mapped.neighbors(i))
+            BOOST_TEST(g.isAdjacent(mapped.vertexValue(i), mapped.vertexValue(j)));
+    }
+
+    file.close();
+    BOOST_TEST(!file.isOpen());
+    std::filesystem::remove(graph_file_path);
+}
+
+// Vertices with arbitrary values are stored in the ids section.
+
+BOOST_AUTO_TEST_CASE(External_ids) {
+    vector<unsigned int> vertices = {40, 7, 1000, 3};
+    CustomGraph::Graph g(vertices);
+    g.addEdge(40, 7);
+    g.addEdge(7, 1000);
+    g.addEdge(1000, 3);
+
+    BOOST_TEST(GraphFile::write(graph_file_path, g));
+
+    GraphFile file;
+    BOOST_TEST(file.open(graph_file_path));
+    CSRGraph &mapped = file.graph();
+
+    BOOST_TEST(mapped.hasIds());
+    BOOST_TEST(mapped.getVerticesKeys() == vector<unsigned int>({3, 7, 40, 1000}));
+    BOOST_TEST(mapped.indexOf(40) == (unsigned int)2);
+    BOOST_TEST(mapped.indexOf(41) == mapped.size());
+
+    CustomGraph::Graph loaded;
+    mapped.toGraph(loaded);
+    BOOST_TEST(loaded.edgeSize() == g.edgeSize());
+    BOOST_TEST(loaded.isAdjacent(1000, 7));
+
+    std::filesystem::remove(graph_file_path);
+}
+
+// The ordering engines run on the mapped view, lex_m reports the fill instead of writing it.
+
+BOOST_DATA_TEST_CASE(Orderings_on_mapped_graph, bdata::make(graph_dimension), n) {
+    CustomGraph::Graph g;
+    g.generateRandomGraphPrecise(n);
+    BOOST_TEST(GraphFile::write(graph_file_path, g));
+
+    GraphFile file;
+    BOOST_TEST(file.open(graph_file_path));
+
+    vector<pair<unsigned int, unsigned int>> fill;
+    vector<unsigned int> lex_m_vertices = file.graph().lex_m(&fill);
+    BOOST_TEST(lex_m_vertices.size() == g.size());
+
+    // adding the reported fill, the ordering must be perfect
+    for(auto &edge : fill)
+        g.addEdge(edge.first, edge.second);
+    unsigned int triangulated_edges = g.edgeSize();
+    BOOST_TEST(triangulated_edges == file.graph().edgeSize() + fill.size());
+
+    BijectionFunction bj(lex_m_vertices);
+    g.fill_in(bj);
+    BOOST_TEST(g.edgeSize() == triangulated_edges);
+
+    // lex_p on the triangulated graph written again is perfect too
+    BOOST_TEST(GraphFile::write(graph_file_path, g));
+    BOOST_TEST(file.open(graph_file_path));
+    vector<unsigned int> lex_p_vertices = file.graph().lex_p();
+    BijectionFunction bj_p(lex_p_vertices);
+    g.fill_in(bj_p);
+    BOOST_TEST(g.edgeSize() == triangulated_edges);
+
+    file.close();
+    std::filesystem::remove(graph_file_path);
+}
+
+// Files that are not graph files are refused.
+
+BOOST_AUTO_TEST_CASE(Invalid_file) {
+    {
+        ofstream out(graph_file_path, ios::binary);
+        out << "this is not a graph file, but it is long enough to contain a header";
+    }
+
+    GraphFile file;
+    BOOST_TEST(!file.open(graph_file_path));
+    BOOST_TEST(!file.open(graph_file_path + ".missing"));
+    BOOST_TEST(file.graph().size() == (unsigned int)0);
+
+    std::filesystem::remove(graph_file_path);
+}
+
+/**
+ * @brief Change of the header and of the bytes of a graph file.
+ */
+using FileChange = std::function<void(GraphFileHeader&, vector<char>&)>;
+
+/**
+ * @brief Write a valid graph file, change its bytes and write it back.
+ * @param graph graph to be written.
+ * @param change function that modifies the header and the bytes of the file.
+ */
+static void corruptFile(Graph &graph, const FileChange &change) {
+    BOOST_TEST(GraphFile::write(graph_file_path, graph));
+    vector<char> bytes;
+    {
+        ifstream in(graph_file_path, ios::binary);
+        bytes.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+    GraphFileHeader header;
+    memcpy(&header, bytes.data(), sizeof(header));
+    change(header, bytes);
+    memcpy(bytes.data(), &header, sizeof(header));
+    ofstream out(graph_file_path, ios::binary | ios::trunc);
+    out.write(bytes.data(), bytes.size());
+}
+
+// Files whose header or arrays are inconsistent are refused by open, before any engine reads them out of bounds.
+
+BOOST_AUTO_TEST_CASE(Corrupt_file) {
+    Graph path({10, 20, 30});
+    path.addEdge(10, 20);
+    path.addEdge(20, 30);
+    Graph empty({0, 1});
+    GraphFile file;
+
+    BOOST_TEST(GraphFile::write(graph_file_path, path));
+    BOOST_TEST(file.open(graph_file_path));
+    file.close();
+
+    auto offsets = [](GraphFileHeader &header, vector<char> &bytes) {
+        return reinterpret_cast<uint64_t*>(bytes.data() + header.offsetsPosition);
+    };
+    auto adjacency = [](GraphFileHeader &header, vector<char> &bytes) {
+        return reinterpret_cast<unsigned int*>(bytes.data() + header.adjacencyPosition);
+    };
+    vector<FileChange> changes = {
+        // an offset past the adjacency, with the last one still equal to numAdjacency
+        [&](GraphFileHeader &header, vector<char> &bytes) { offsets(header, bytes)[1] = (uint64_t) 1 << 36; },
+        // sizes whose products overflow
+        [&](GraphFileHeader &header, vector<char> &bytes) { header.numAdjacency = (uint64_t) 1 << 62; },
+        [&](GraphFileHeader &header, vector<char> &bytes) { header.numVertices = 0xFFFFFFFFu; },
+        // sections out of the file
+        [&](GraphFileHeader &header, vector<char> &bytes) { header.offsetsPosition = (uint64_t) 1 << 40; },
+        [&](GraphFileHeader &header, vector<char> &bytes) { header.fileSize = bytes.size() + 64; },
+    };
+    for(auto &change : changes) {
+        corruptFile(empty, change);
+        BOOST_TEST(!file.open(graph_file_path));
+        corruptFile(path, change);
+        BOOST_TEST(!file.open(graph_file_path));
+    }
+
+    vector<FileChange> array_changes = {
+        // decreasing offsets
+        [&](GraphFileHeader &header, vector<char> &bytes) { offsets(header, bytes)[1] = 2; offsets(header, bytes)[2] = 1; },
+        // an index out of range
+        [&](GraphFileHeader &header, vector<char> &bytes) { adjacency(header, bytes)[0] = 7; },
+        // a self-loop
+        [&](GraphFileHeader &header, vector<char> &bytes) { adjacency(header, bytes)[0] = 0; },
+        // an edge stored only in one of its rows
+        [&](GraphFileHeader &header, vector<char> &bytes) { adjacency(header, bytes)[0] = 2; },
+        // ids out of the file
+        [&](GraphFileHeader &header, vector<char> &bytes) { header.idsPosition = header.fileSize; },
+        // ids not ascending
+        [&](GraphFileHeader &header, vector<char> &bytes) {
+            reinterpret_cast<unsigned int*>(bytes.data() + header.idsPosition)[2] = 15;
+        },
+    };
+    for(auto &change : array_changes) {
+        corruptFile(path, change);
+        BOOST_TEST(!file.open(graph_file_path));
+    }
+    BOOST_TEST(!file.isOpen());
+
+    std::filesystem::remove(graph_file_path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
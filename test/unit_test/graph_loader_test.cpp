@@ -0,0 +1,129 @@
+#include "GraphLoader.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace boost;
+using namespace CustomGraph;
+namespace bdata = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(Graph_loader_tests)
+
+const string loader_file_path = (std::filesystem::temp_directory_path() / "graph_loader_test.txt").string();
+
+/**
+ * @brief Write a text file used by the tests.
+ * @param content text of the file.
+ */
+static void writeFile(const string &content) {
+    ofstream out(loader_file_path, ios::binary | ios::trunc);
+    out << content;
+}
+
+const unsigned int thread_number[] = {1, 2, 4, 8};
+
+// Comments, duplicated edges (also reversed), auto-rings and weights in an edge list.
+
+BOOST_DATA_TEST_CASE(Edge_list, bdata::make(thread_number), threads) {
+    writeFile("# comment\n1 2\n2 1\n2\t3 0.5\r\n% other comment\n\n3 3\n10 1\n1 2");
+
+    CustomGraph::Graph g;
+    BOOST_TEST(GraphLoader::loadEdgeList(loader_file_path, g, threads));
+
+    BOOST_TEST(g.size() == (unsigned int)4);
+    BOOST_TEST(g.edgeSize() == (unsigned int)3);
+    BOOST_TEST(g.isAdjacent(1, 2));
+    BOOST_TEST(g.isAdjacent(3, 2));
+    BOOST_TEST(g.isAdjacent(1, 10));
+    BOOST_TEST(!g.isAdjacent(3, 3));
+
+    std::filesystem::remove(loader_file_path);
+}
+
+// A symmetric pattern in Matrix Market format, the diagonal is dropped.
+
+BOOST_DATA_TEST_CASE(Matrix_market, bdata::make(thread_number), threads) {
+    writeFile("%%MatrixMarket matrix coordinate pattern symmetric\n% comment\n5 5 6\n1 1\n2 1\n3 2\n4 3\n5 4\n5 1\n");
+
+    CustomGraph::Graph g;
+    BOOST_TEST(GraphLoader::loadMatrixMarket(loader_file_path, g, threads));
+
+    BOOST_TEST(g.size() == (unsigned int)5);
+    BOOST_TEST(g.edgeSize() == (unsigned int)5);
+    BOOST_TEST(g.isAdjacent(0, 1));
+    BOOST_TEST(g.isAdjacent(4, 0));
+    BOOST_TEST(g.isConnected());
+
+    // non-square matrices and entries out of range are refused
+    writeFile("%%MatrixMarket matrix coordinate real general\n3 4 1\n1 2 1.0\n");
+    BOOST_TEST(!GraphLoader::loadMatrixMarket(loader_file_path, g, threads));
+    writeFile("%%MatrixMarket matrix coordinate real general\n3 3 1\n1 4 1.0\n");
+    BOOST_TEST(!GraphLoader::loadMatrixMarket(loader_file_path, g, threads));
+
+    // the entries must be as many as the header says, a huge count is refused without allocating for it
+    writeFile("%%MatrixMarket matrix coordinate pattern general\n3 3 5\n1 2\n");
+    BOOST_TEST(!GraphLoader::loadMatrixMarket(loader_file_path, g, threads));
+    writeFile("%%MatrixMarket matrix coordinate pattern general\n3 3 1\n1 2\n2 3\n");
+    BOOST_TEST(!GraphLoader::loadMatrixMarket(loader_file_path, g, threads));
+    writeFile("%%MatrixMarket matrix coordinate pattern general\n3 3 4000000000\n1 2\n2 3\n");
+    BOOST_TEST(!GraphLoader::loadMatrixMarket(loader_file_path, g, threads));
+    BOOST_TEST(g.size() == (unsigned int)0);
+
+    std::filesystem::remove(loader_file_path);
+}
+
+// A METIS graph with vertex and edge weights and an isolated vertex.
+
+BOOST_DATA_TEST_CASE(Metis, bdata::make(thread_number), threads) {
+    writeFile("% comment\n5 4 011\n7 2 1 3 1\n1 1 1\n1 1 1 4 2\n1 3 2\n1\n");
+
+    CustomGraph::Graph g;
+    BOOST_TEST(GraphLoader::loadMETIS(loader_file_path, g, threads));
+
+    BOOST_TEST(g.size() == (unsigned int)5);
+    BOOST_TEST(g.edgeSize() == (unsigned int)3);
+    BOOST_TEST(g.isAdjacent(0, 1));
+    BOOST_TEST(g.isAdjacent(0, 2));
+    BOOST_TEST(g.isAdjacent(2, 3));
+    BOOST_TEST(!g.isConnected());
+
+    // the number of vertex lines must match the header
+    writeFile("3 1\n2\n1\n");
+    BOOST_TEST(!GraphLoader::loadMETIS(loader_file_path, g, threads));
+
+    std::filesystem::remove(loader_file_path);
+}
+
+const unsigned int graph_dimension[] = {32, 256, 1024, 4096};
+
+// A random graph written with duplicated edges is loaded back equal to the original one.
+
+BOOST_DATA_TEST_CASE(Random_edge_list, bdata::make(graph_dimension), n) {
+    CustomGraph::Graph g;
+    g.generateRandomGraphPrecise(n);
+
+    {
+        ofstream out(loader_file_path, ios::trunc);
+        for(auto &v : g.getVertices())
+            for(auto w : v.second.getAdjVertices())
+                out << v.first << " " << w << "\n";
+    }
+
+    CustomGraph::Graph loaded;
+    BOOST_TEST(GraphLoader::loadEdgeList(loader_file_path, loaded, 4));
+
+    BOOST_TEST(loaded.size() == g.size());
+    BOOST_TEST(loaded.edgeSize() == g.edgeSize());
+    for(auto &v : g.getVertices())
+        for(auto w : v.second.getAdjVertices())
+            BOOST_TEST(loaded.isAdjacent(v.first, w));
+
+    BOOST_TEST(!GraphLoader::loadEdgeList(loader_file_path + ".missing", loaded));
+    std::filesystem::remove(loader_file_path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -177,4 +177,104 @@ BOOST_DATA_TEST_CASE(Graph_random_creation, bdata::make(random_graph_dimension),
     BOOST_TEST(g.isConnected());
 }
 
+/**
+ * @brief Get the sorted list of the edges of a graph, it works with both the storage backends.
+ * @param g graph to be listed.
+ * @return vector<pair<unsigned int, unsigned int>> edges of the graph, each one with the smaller endpoint first.
+ */
+static vector<pair<unsigned int, unsigned int>> edgeList(CustomGraph::Graph &g) {
+    vector<pair<unsigned int, unsigned int>> edges;
+    for(auto v : g.getVerticesKeys())
+        g.forEachAdjacent(v, [&](unsigned int w) {
+            if(v < w)
+                edges.push_back(make_pair(v, w));
+        });
+    sort(edges.begin(), edges.end());
+    return edges;
+}
+
+// The fill added by lex_m and fill_in is removed by rollback, so several orderings can be tried on the same graph.
+
+BOOST_AUTO_TEST_CASE(Rollback_fill) {
+    for(auto storage : {Storage::Sparse, Storage::Dense}) {
+        CustomGraph::Graph random;
+        random.generateRandomGraph(128, 5);
+        CustomGraph::Graph g(random.getVerticesKeys(), storage);
+        for(auto v : random.getVerticesKeys())
+            random.forEachAdjacent(v, [&](unsigned int w) { g.addEdge(v, w); });
+        vector<pair<unsigned int, unsigned int>> edges = edgeList(g);
+
+        BOOST_TEST(!g.rollback());
+        g.checkpoint();
+        vector<unsigned int> ordering = g.lex_m();
+        unsigned int filled = g.edgeSize();
+        BOOST_TEST(g.rollback());
+        BOOST_TEST(g.checkpoints() == (unsigned int)0);
+        BOOST_TEST(g.edgeSize() == (unsigned int)edges.size());
+        BOOST_TEST(edgeList(g) == edges);
+
+        // the ordering of lex_m and its reverse are eliminated from the same graph
+        BijectionFunction bj(ordering);
+        g.checkpoint();
+        g.fill_in(bj);
+        BOOST_TEST(g.edgeSize() == filled);
+        BOOST_TEST(g.rollback());
+
+        reverse(ordering.begin(), ordering.end());
+        BijectionFunction reversed(ordering);
+        g.checkpoint();
+        g.fill_in(reversed);
+        BOOST_TEST(g.edgeSize() >= (unsigned int)edges.size());
+        BOOST_TEST(g.rollback());
+        BOOST_TEST(edgeList(g) == edges);
+    }
+}
+
+// Added and deleted vertices are restored with their edges, the nested checkpoints are closed in order and the
+// changes committed by an inner checkpoint are reverted by the outer one.
+
+BOOST_AUTO_TEST_CASE(Nested_checkpoints) {
+    for(auto storage : {Storage::Sparse, Storage::Dense}) {
+        vector<unsigned int> vertices = {1,7,4,3,11};
+        CustomGraph::Graph g(vertices, storage);
+        g.addEdge(1,7);
+        g.addEdge(1,4);
+        g.addEdge(7,3);
+        g.addEdge(4,11);
+        vector<pair<unsigned int, unsigned int>> edges = edgeList(g);
+
+        g.checkpoint();
+        g.addVertex(20);
+        g.addEdge(20, 1);
+        vector<pair<unsigned int, unsigned int>> outer = edgeList(g);
+
+        g.checkpoint();
+        g.deleteVertex(1);
+        g.addEdge(7, 4);
+        BOOST_TEST(g.checkpoints() == (unsigned int)2);
+        BOOST_TEST(g.rollback());
+        BOOST_TEST(g.isInside(1));
+        BOOST_TEST(edgeList(g) == outer);
+
+        g.checkpoint();
+        g.deleteVertex(7);
+        BOOST_TEST(g.commit());
+        BOOST_TEST(!g.isInside(7));
+        BOOST_TEST(g.edgeSize() == (unsigned int)3);
+
+        BOOST_TEST(g.rollback());
+        BOOST_TEST(!g.commit());
+        BOOST_TEST(!g.isInside(20));
+        BOOST_TEST(g.size() == vertices.size());
+        BOOST_TEST(g.edgeSize() == (unsigned int)edges.size());
+        BOOST_TEST(edgeList(g) == edges);
+
+        // without a checkpoint the changes are not recorded
+        g.addEdge(3, 11);
+        g.checkpoint();
+        BOOST_TEST(g.rollback());
+        BOOST_TEST(g.isAdjacent(3, 11));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "JobEngine.hpp"
+#include "CSRGraph.hpp"
+#include "WorkloadGenerator.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+using namespace CustomGraph;
+
+BOOST_AUTO_TEST_SUITE(Job_engine_tests)
+
+// The results of the jobs are the results of the direct calls, with the statistics of each job.
+
+BOOST_AUTO_TEST_CASE(Same_results) {
+    CSRGraph csr;
+    WorkloadGenerator::rmat(300, 1200, 7, csr);
+    vector<unsigned int> lex_p = csr.lex_p();
+    vector<pair<unsigned int, unsigned int>> lex_m_fill;
+    vector<unsigned int> lex_m = csr.lex_m(&lex_m_fill);
+
+    JobEngine engine;
+    future<JobEngine::Result> p_job = engine.submit(csr, JobEngine::Engine::LexP);
+    future<JobEngine::Result> m_job = engine.submit(csr, JobEngine::Engine::LexM);
+    future<JobEngine::Result> order_job = engine.submit(csr, JobEngine::Engine::Order);
+    vector<future<JobEngine::Result>> fill_jobs;
+    for(auto storage : {Storage::Sparse, Storage::Dense}) {
+        JobEngine::Options options;
+        options.ordering = lex_p;
+        options.storage = storage;
+        options.client = 3;
+        fill_jobs.push_back(engine.submit(csr, JobEngine::Engine::FillIn, options));
+    }
+
+    JobEngine::Result p = p_job.get();
+    BOOST_TEST(p.ordering == lex_p);
+    BOOST_TEST(p.fill.empty());
+    BOOST_TEST(p.stats.id == (uint64_t)0);
+    BOOST_TEST((p.stats.engine == JobEngine::Engine::LexP));
+    BOOST_TEST(p.stats.worker >= 0);
+    BOOST_TEST(p.stats.counters.cells_created > (uint64_t)0);
+
+    JobEngine::Result m = m_job.get();
+    BOOST_TEST(m.ordering == lex_m);
+    BOOST_TEST((m.fill == lex_m_fill));
+    BOOST_TEST(m.stats.id == (uint64_t)1);
+    BOOST_TEST(m.stats.counters.add_edge_calls == lex_m_fill.size());
+
+    Graph g;
+    csr.toGraph(g);
+    OrderingChoice choice;
+    vector<unsigned int> ordered = g.order(&choice);
+    JobEngine::Result order = order_job.get();
+    BOOST_TEST(order.ordering == ordered);
+    BOOST_TEST(order.choice.chordal == choice.chordal);
+    BOOST_TEST((order.choice.method == choice.method));
+
+    // the fill of the ordering of lex_p, checked against fill_in on a copy of the graph
+    BijectionFunction bf(lex_p);
+    unsigned int edges = g.edgeSize();
+    g.fill_in(bf);
+    for(auto &job : fill_jobs) {
+        JobEngine::Result fill = job.get();
+        BOOST_TEST(fill.ordering == lex_p);
+        BOOST_TEST(fill.stats.client == (unsigned int)3);
+        BOOST_TEST(fill.fill.size() == g.edgeSize() - edges);
+        BOOST_TEST(fill.stats.counters.fill_edges == fill.fill.size());
+        bool in_graph = true, new_edge = true;
+        for(auto &e : fill.fill) {
+            in_graph = in_graph && g.isAdjacent(e.first, e.second);
+            auto adjacent = csr.neighbors(csr.indexOf(e.first));
+            new_edge = new_edge && !binary_search(adjacent.begin(), adjacent.end(), csr.indexOf(e.second));
+        }
+        BOOST_TEST(in_graph);
+        BOOST_TEST(new_edge);
+    }
+
+    engine.wait();
+    BOOST_TEST(engine.submitted() == (uint64_t)5);
+    BOOST_TEST(engine.completed() == (uint64_t)5);
+}
+
+// Many jobs of several clients run at once on a private pool, the destructor of the engine waits for all of them.
+
+BOOST_AUTO_TEST_CASE(Many_jobs) {
+    vector<CSRGraph> graphs(24);
+    vector<vector<unsigned int>> expected;
+    for(unsigned int i = 0; i < graphs.size(); ++i) {
+        WorkloadGenerator::rmat(150 + 10 * i, 600 + 40 * i, i, graphs[i]);
+        expected.push_back(graphs[i].lex_m());
+    }
+
+    ThreadPool pool(3);
+    vector<future<JobEngine::Result>> jobs;
+    {
+        JobEngine engine(pool);
+        for(unsigned int i = 0; i < graphs.size(); ++i) {
+            JobEngine::Options options;
+            options.client = i % 4;
+            jobs.push_back(engine.submit(graphs[i], JobEngine::Engine::LexM, options));
+        }
+    }
+
+    for(auto &job : jobs)
+        BOOST_TEST((job.wait_for(chrono::seconds(0)) == future_status::ready));
+    for(unsigned int i = 0; i < jobs.size(); ++i) {
+        JobEngine::Result result = jobs[i].get();
+        BOOST_TEST(result.ordering == expected[i]);
+        BOOST_TEST(result.stats.id == (uint64_t)i);
+        BOOST_TEST(result.stats.client == i % 4);
+        BOOST_TEST(result.stats.worker >= 0);
+        BOOST_TEST(result.stats.worker < 3);
+    }
+}
+
+// A RunControl bounds the job, its outcome is in the statistics of the result.
+
+BOOST_AUTO_TEST_CASE(Controlled) {
+    CSRGraph csr;
+    WorkloadGenerator::rmat(400, 2400, 3, csr);
+    vector<unsigned int> keys = csr.getVerticesKeys();
+
+    JobEngine engine;
+    RunControl cancelled;
+    cancelled.cancel();
+    JobEngine::Options options;
+    options.control = &cancelled;
+    JobEngine::Result m = engine.submit(csr, JobEngine::Engine::LexM, options).get();
+    BOOST_TEST((m.stats.status == RunControl::Status::Cancelled));
+    BOOST_TEST(m.fill.empty());
+    sort(m.ordering.begin(), m.ordering.end());
+    BOOST_TEST(m.ordering == keys);
+
+    RunControl budget;
+    budget.setFillBudget(10);
+    options.control = &budget;
+    JobEngine::Result fill = engine.submit(csr, JobEngine::Engine::FillIn, options).get();
+    BOOST_TEST((fill.stats.status == RunControl::Status::FillBudgetExceeded));
+    BOOST_TEST(fill.ordering == keys);
+    BOOST_TEST(fill.fill.size() > (size_t)10);
+
+    RunControl unlimited;
+    options.control = &unlimited;
+    JobEngine::Result completed = engine.submit(csr, JobEngine::Engine::LexM, options).get();
+    BOOST_TEST((completed.stats.status == RunControl::Status::Completed));
+    BOOST_TEST(completed.ordering == csr.lex_m());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,5 @@
 #include "Graph.hpp"
+#include "Parallel.hpp"
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/test_case.hpp>
@@ -129,4 +130,58 @@ BOOST_AUTO_TEST_CASE(Sink_vertex_graph) {
 }
 
 
+// The const lex_m gives the ordering of lex_m and its fill as a list, leaving the graph untouched, with both the
+// backends. The same workspace is reused by the calls.
+
+BOOST_AUTO_TEST_CASE(Const_lex_m) {
+    for(auto storage : {CustomGraph::Storage::Sparse, CustomGraph::Storage::Dense}) {
+        CustomGraph::Graph random;
+        random.generateRandomGraph(200, 9);
+        CustomGraph::Graph g(random.getVerticesKeys(), storage);
+        for(auto v : random.getVerticesKeys())
+            random.forEachAdjacent(v, [&](unsigned int w) { g.addEdge(v, w); });
+        CustomGraph::Graph filled = g;
+        unsigned int prev_edges = g.edgeSize();
+
+        LexMWorkspace workspace;
+        vector<pair<unsigned int, unsigned int>> fill = {{1, 2}};
+        vector<unsigned int> ordering = g.lex_m(workspace, fill);
+        BOOST_TEST(g.edgeSize() == prev_edges);
+        BOOST_TEST(ordering == filled.lex_m());
+        BOOST_TEST(filled.edgeSize() == prev_edges + fill.size());
+        for(auto &edge : fill) {
+            BOOST_TEST(!g.isAdjacent(edge.first, edge.second));
+            BOOST_TEST(filled.isAdjacent(edge.first, edge.second));
+        }
+
+        vector<pair<unsigned int, unsigned int>> again;
+        BOOST_TEST(g.lex_m(workspace, again) == ordering);
+        BOOST_TEST(again == fill);
+    }
+}
+
+// Several threads order the same graph at once, each one with its own workspace.
+
+BOOST_AUTO_TEST_CASE(Concurrent_lex_m) {
+    CustomGraph::Graph g;
+    g.generateRandomGraph(150, 4);
+    CustomGraph::Graph filled = g;
+    vector<unsigned int> expected = filled.lex_m();
+
+    const unsigned int num_tasks = 8;
+    vector<vector<unsigned int>> orderings(num_tasks);
+    vector<unsigned int> fill_sizes(num_tasks);
+    Parallel::forEach(num_tasks, [&](unsigned int i) {
+        LexMWorkspace workspace;
+        vector<pair<unsigned int, unsigned int>> fill;
+        orderings[i] = g.lex_m(workspace, fill);
+        fill_sizes[i] = fill.size();
+    }, 4);
+
+    for(unsigned int i = 0; i < num_tasks; ++i) {
+        BOOST_TEST(orderings[i] == expected);
+        BOOST_TEST(fill_sizes[i] == filled.edgeSize() - g.edgeSize());
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+#include "OrderingEngines.hpp"
+#include "WorkloadGenerator.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+using namespace boost;
+using namespace CustomGraph;
+namespace bdata = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(Order_tests)
+
+const unsigned int graph_dimension[] = {10, 100, 400};
+
+/**
+ * @brief Count the fill edges produced by an ordering on a copy of the graph.
+ * @param g graph to be eliminated.
+ * @param ordering ordering used by fill_in.
+ * @return unsigned int number of edges added by fill_in.
+ */
+static unsigned int fillSize(Graph &g, vector<unsigned int> &ordering) {
+    Graph copy = g;
+    BijectionFunction bj(ordering);
+    copy.fill_in(bj);
+    return copy.edgeSize() - g.edgeSize();
+}
+
+// The statistics are computed in one pass: edges, degrees, density and components of a graph made of a path and a
+// triangle.
+
+BOOST_AUTO_TEST_CASE(Profile) {
+    vector<unsigned int> vertices = {1, 2, 3, 4, 5, 6, 7};
+    vector<unsigned int> sources = {1, 2, 3, 5, 6, 7};
+    vector<unsigned int> destinations = {2, 3, 4, 6, 7, 5};
+    Graph g(vertices, sources, destinations);
+    CSRGraph csr(g);
+
+    GraphProfile profile = OrderingEngines::profile(csr);
+    BOOST_TEST(profile.n == (unsigned int)7);
+    BOOST_TEST(profile.m == (uint64_t)6);
+    BOOST_TEST(profile.density == 6.0 / 21);
+    BOOST_TEST(profile.max_degree == (unsigned int)2);
+    BOOST_TEST(profile.mean_degree == 12.0 / 7);
+    BOOST_TEST(profile.components == (unsigned int)2);
+
+    CSRGraph empty;
+    profile = OrderingEngines::profile(empty);
+    BOOST_TEST(profile.components == (unsigned int)0);
+    BOOST_TEST(profile.density == 0.0);
+}
+
+// The check of a perfect ordering agrees with fill_in, and it rejects the orderings that are not permutations.
+
+BOOST_AUTO_TEST_CASE(Perfect_ordering) {
+    vector<unsigned int> vertices = {1, 2, 3, 4};
+    vector<unsigned int> sources = {1, 2, 3, 4, 1};
+    vector<unsigned int> destinations = {2, 3, 4, 1, 3};
+    Graph g(vertices, sources, destinations);
+    CSRGraph csr(g);
+
+    vector<unsigned int> perfect = {2, 1, 3, 4};
+    vector<unsigned int> fill = {1, 2, 3, 4};
+    BOOST_TEST(OrderingEngines::isPerfectOrdering(csr, perfect));
+    BOOST_TEST(fillSize(g, perfect) == (unsigned int)0);
+    BOOST_TEST(!OrderingEngines::isPerfectOrdering(csr, fill));
+    BOOST_TEST(fillSize(g, fill) == (unsigned int)1);
+
+    vector<unsigned int> repeated = {1, 1, 3, 4};
+    vector<unsigned int> unknown = {1, 2, 3, 9};
+    vector<unsigned int> shorter = {1, 2, 3};
+    BOOST_TEST(!OrderingEngines::isPerfectOrdering(csr, repeated));
+    BOOST_TEST(!OrderingEngines::isPerfectOrdering(csr, unknown));
+    BOOST_TEST(!OrderingEngines::isPerfectOrdering(csr, shorter));
+}
+
+// A chordal graph is recognised and ordered by lex_p alone, with no fill.
+
+BOOST_DATA_TEST_CASE(Chordal, bdata::make(graph_dimension), n) {
+    CSRGraph csr;
+    BOOST_TEST(WorkloadGenerator::randomChordal(n, 6, 3, csr));
+    Graph g;
+    csr.toGraph(g);
+
+    OrderingChoice choice;
+    vector<unsigned int> ordering = g.order(&choice);
+    BOOST_TEST(choice.chordal);
+    BOOST_TEST((choice.method == OrderingChoice::Method::LexP));
+    BOOST_TEST(ordering == csr.lex_p());
+    BOOST_TEST(fillSize(g, ordering) == (unsigned int)0);
+    BOOST_TEST(g.edgeSize() == csr.edgeSize());
+}
+
+// A sparse graph that is not chordal is ordered by the CSR engine, a dense one by the dense backend, and the orderings
+// are the ones of those engines. The graph is not modified.
+
+BOOST_DATA_TEST_CASE(Not_chordal, bdata::make(graph_dimension), n) {
+    // a cycle with a chord every other vertex on one half is not chordal, and it is sparse from 100 vertices
+    Graph ring;
+    for(unsigned int i = 0; i < n; ++i)
+        ring.addVertex(i);
+    for(unsigned int i = 0; i < n; ++i)
+        ring.addEdge(i, (i + 1) % n);
+    for(unsigned int i = 0; i + 2 < n / 2; i += 2)
+        ring.addEdge(i, i + 2);
+
+    OrderingChoice choice;
+    unsigned int edges = ring.edgeSize();
+    vector<unsigned int> ordering = ring.order(&choice);
+    BOOST_TEST(!choice.chordal);
+    BOOST_TEST((choice.method == OrderingChoice::Method::LexM));
+    BOOST_TEST(ring.edgeSize() == edges);
+    if(n >= 100) {
+        BOOST_TEST((choice.storage == Storage::Sparse));
+        BOOST_TEST(ordering == CSRGraph(ring).lex_m());
+    } else
+        BOOST_TEST((choice.storage == Storage::Dense));
+
+    // two thirds of the pairs are adjacent
+    vector<unsigned int> vertices, sources, destinations;
+    for(unsigned int i = 0; i < n; ++i) {
+        vertices.push_back(i);
+        for(unsigned int j = i + 1; j < n; ++j)
+            if((i + j) % 3 != 0) {
+                sources.push_back(i);
+                destinations.push_back(j);
+            }
+    }
+    Graph g(vertices, sources, destinations);
+    Graph dense(Storage::Dense);
+    CSRGraph(g).toGraph(dense);
+
+    edges = g.edgeSize();
+    ordering = g.order(&choice);
+    BOOST_TEST(!choice.chordal);
+    BOOST_TEST(choice.profile.density >= Graph::DENSE_ORDER_DENSITY);
+    BOOST_TEST((choice.storage == Storage::Dense));
+    BOOST_TEST(g.edgeSize() == edges);
+    BOOST_TEST(ordering == dense.lex_m());
+}
+
+// The empty graph and a single vertex are chordal.
+
+BOOST_AUTO_TEST_CASE(Small) {
+    Graph empty;
+    OrderingChoice choice;
+    BOOST_TEST(empty.order(&choice).empty());
+    BOOST_TEST(choice.chordal);
+
+    Graph single;
+    single.addVertex(5);
+    BOOST_TEST(single.order() == vector<unsigned int>({5}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
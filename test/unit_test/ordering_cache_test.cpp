@@ -0,0 +1,255 @@
+#include "OrderingCache.hpp"
+#include "GraphFingerprint.hpp"
+#include "JobEngine.hpp"
+#include "CSRGraph.hpp"
+#include "WorkloadGenerator.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <unistd.h>
+
+using namespace boost;
+using namespace CustomGraph;
+
+BOOST_AUTO_TEST_SUITE(Ordering_cache_tests)
+
+/**
+ * @brief Get a cache path that is not used by another test process, the file is removed.
+ * @param name name of the test.
+ * @return string path in the temporary directory.
+ */
+static string cachePath(const string &name) {
+    string path = "/tmp/cgraph_" + name + "_" + to_string(getpid()) + ".cache";
+    unlink(path.c_str());
+    return path;
+}
+
+/**
+ * @brief Get the edges of a graph, each once.
+ * @param csr graph without ids.
+ * @return vector<pair<unsigned int, unsigned int>> edges with the smaller endpoint first.
+ */
+static vector<pair<unsigned int, unsigned int>> edgesOf(CSRGraph &csr) {
+    vector<pair<unsigned int, unsigned int>> edges;
+    for(unsigned int v = 0; v < csr.size(); ++v)
+        for(auto w : csr.neighbors(v))
+            if(v < w)
+                edges.push_back({v, w});
+    return edges;
+}
+
+// The fingerprint depends only on the vertices and the edges: the order of insertion and the representation of the graph
+// do not change it, a missing edge or a relabeled vertex do.
+
+BOOST_AUTO_TEST_CASE(Fingerprint) {
+    CSRGraph csr;
+    WorkloadGenerator::rmat(300, 1500, 11, csr);
+    Graph g;
+    csr.toGraph(g);
+    GraphFingerprint fingerprint = GraphFingerprint::of(csr);
+    BOOST_TEST(fingerprint.vertices == (uint64_t)300);
+    BOOST_TEST(fingerprint.edges == (uint64_t)g.edgeSize());
+    BOOST_TEST((GraphFingerprint::of(g) == fingerprint));
+
+    // the same graph built in another order
+    vector<pair<unsigned int, unsigned int>> edges = edgesOf(csr);
+    shuffle(edges.begin(), edges.end(), mt19937(5));
+    Graph shuffled;
+    for(unsigned int v = 300; v-- > 0;)
+        shuffled.addVertex(v);
+    for(auto &e : edges)
+        if(e.first % 2 == 0)
+            shuffled.addEdge(e.first, e.second);
+        else
+            shuffled.addEdge(e.second, e.first);
+    BOOST_TEST((GraphFingerprint::of(shuffled) == fingerprint));
+    CSRGraph shuffled_csr(shuffled);
+    BOOST_TEST((GraphFingerprint::of(shuffled_csr) == fingerprint));
+    BOOST_TEST(GraphFingerprint::of(shuffled_csr).hash() == fingerprint.hash());
+
+    // an edge less
+    Graph missing(csr.getVerticesKeys());
+    for(size_t i = 1; i < edges.size(); ++i)
+        missing.addEdge(edges[i].first, edges[i].second);
+    BOOST_TEST((GraphFingerprint::of(missing) != fingerprint));
+
+    // the vertices relabeled, the CSR has ids
+    Graph relabeled;
+    for(unsigned int v = 0; v < 300; ++v)
+        relabeled.addVertex(3 * v + 7);
+    for(auto &e : edges)
+        relabeled.addEdge(3 * e.first + 7, 3 * e.second + 7);
+    CSRGraph relabeled_csr(relabeled);
+    BOOST_TEST(relabeled_csr.hasIds());
+    GraphFingerprint relabeled_fingerprint = GraphFingerprint::of(relabeled_csr);
+    BOOST_TEST((GraphFingerprint::of(relabeled) == relabeled_fingerprint));
+    BOOST_TEST(relabeled_fingerprint.edges == fingerprint.edges);
+    BOOST_TEST((relabeled_fingerprint != fingerprint));
+
+    // a single vertex exchanged with a new one
+    Graph moved(csr.getVerticesKeys());
+    moved.deleteVertex(0);
+    moved.addVertex(1000);
+    for(auto &e : edges)
+        moved.addEdge(e.first == 0 ? 1000 : e.first, e.second);
+    BOOST_TEST((GraphFingerprint::of(moved) != fingerprint));
+}
+
+// The results survive the close of the file, a key is stored once and the tail of a file cut while a record was written
+// is dropped.
+
+BOOST_AUTO_TEST_CASE(Persistence) {
+    string path = cachePath("persistence");
+    OrderingCacheKey first, second;
+    first.graph.addVertex(1);
+    first.engine = 1;
+    second.graph = first.graph;
+    second.engine = 2;
+    second.options = 42;
+    OrderingCacheEntry entry;
+    entry.ordering = {3, 1, 2, 0};
+    entry.fill = {{0, 2}, {1, 3}};
+    entry.flags = OrderingCacheEntry::LEX_M;
+
+    {
+        OrderingCache cache;
+        BOOST_TEST(cache.open(path));
+        OrderingCacheEntry found;
+        BOOST_TEST(!cache.lookup(first, found));
+        BOOST_TEST(cache.store(first, entry));
+        BOOST_TEST(cache.store(first, entry));
+        BOOST_TEST(cache.store(second, OrderingCacheEntry()));
+        BOOST_TEST(cache.size() == (size_t)2);
+        BOOST_TEST(cache.lookup(first, found));
+        BOOST_TEST(found.ordering == entry.ordering);
+        BOOST_TEST((found.fill == entry.fill));
+        BOOST_TEST(found.flags == entry.flags);
+        BOOST_TEST(cache.hits() == (uint64_t)1);
+        BOOST_TEST(cache.misses() == (uint64_t)1);
+    }
+
+    OrderingCache cache;
+    BOOST_TEST(cache.open(path));
+    BOOST_TEST(cache.size() == (size_t)2);
+    OrderingCacheEntry found;
+    BOOST_TEST(cache.lookup(first, found));
+    BOOST_TEST(found.ordering == entry.ordering);
+    BOOST_TEST(cache.lookup(second, found));
+    BOOST_TEST(found.ordering.empty());
+    BOOST_TEST(found.fill.empty());
+    cache.close();
+
+    // the last record cut in half
+    off_t size;
+    {
+        ifstream file(path, ios::binary | ios::ate);
+        size = file.tellg();
+    }
+    BOOST_TEST(truncate(path.c_str(), size - 4) == 0);
+    BOOST_TEST(cache.open(path));
+    BOOST_TEST(cache.size() == (size_t)1);
+    BOOST_TEST(cache.lookup(first, found));
+    BOOST_TEST(!cache.lookup(second, found));
+    BOOST_TEST(cache.store(second, entry));
+    cache.close();
+
+    // garbage after the records
+    {
+        ofstream file(path, ios::binary | ios::app);
+        file << "not a record, not a record, not a record, not a record, not a record, not a record";
+    }
+    BOOST_TEST(cache.open(path));
+    BOOST_TEST(cache.size() == (size_t)2);
+    BOOST_TEST(cache.lookup(second, found));
+    BOOST_TEST(found.ordering == entry.ordering);
+    cache.close();
+
+    // a file that is not a cache
+    {
+        ofstream file(path, ios::binary | ios::trunc);
+        file << string(100, 'x');
+    }
+    BOOST_TEST(!cache.open(path));
+    BOOST_TEST(!cache.isOpen());
+    unlink(path.c_str());
+}
+
+// Two caches open on the same file see the records appended by each other.
+
+BOOST_AUTO_TEST_CASE(Shared_file) {
+    string path = cachePath("shared");
+    OrderingCache writer, reader;
+    BOOST_TEST(writer.open(path));
+    BOOST_TEST(reader.open(path));
+    OrderingCacheKey key;
+    key.graph.addEdge(4, 2);
+    OrderingCacheEntry entry, found;
+    entry.ordering = {2, 4};
+    BOOST_TEST(writer.store(key, entry));
+    BOOST_TEST(reader.lookup(key, found));
+    BOOST_TEST(found.ordering == entry.ordering);
+    BOOST_TEST(reader.size() == (size_t)1);
+    unlink(path.c_str());
+}
+
+// A job already run, also by an engine with another cache on the same file, is read from the cache with the same result.
+
+BOOST_AUTO_TEST_CASE(Engine_cache) {
+    string path = cachePath("engine");
+    CSRGraph csr;
+    WorkloadGenerator::rmat(200, 800, 3, csr);
+    vector<pair<unsigned int, unsigned int>> lex_m_fill;
+    vector<unsigned int> lex_m = csr.lex_m(&lex_m_fill);
+
+    OrderingCache cache;
+    BOOST_TEST(cache.open(path));
+    JobEngine engine;
+    JobEngine::Options options;
+    options.cache = &cache;
+    vector<JobEngine::Engine> engines = {JobEngine::Engine::LexP, JobEngine::Engine::LexM, JobEngine::Engine::FillIn,
+                                         JobEngine::Engine::Order};
+    vector<JobEngine::Result> computed;
+    for(auto e : engines) {
+        JobEngine::Result result = engine.submit(csr, e, options).get();
+        BOOST_TEST(!result.stats.cached);
+        computed.push_back(move(result));
+    }
+    BOOST_TEST(computed[1].ordering == lex_m);
+    BOOST_TEST((computed[1].fill == lex_m_fill));
+    BOOST_TEST(cache.size() == engines.size());
+
+    // the fill of another ordering is another key
+    options.ordering = lex_m;
+    JobEngine::Result fill = engine.submit(csr, JobEngine::Engine::FillIn, options).get();
+    BOOST_TEST(!fill.stats.cached);
+    BOOST_TEST(fill.fill.size() == lex_m_fill.size());
+    options.ordering.clear();
+
+    OrderingCache reopened;
+    BOOST_TEST(reopened.open(path));
+    options.cache = &reopened;
+    for(size_t i = 0; i < engines.size(); ++i) {
+        JobEngine::Result result = engine.submit(csr, engines[i], options).get();
+        BOOST_TEST(result.stats.cached);
+        BOOST_TEST(result.ordering == computed[i].ordering);
+        BOOST_TEST((result.fill == computed[i].fill));
+        BOOST_TEST(result.choice.chordal == computed[i].choice.chordal);
+        BOOST_TEST((result.choice.method == computed[i].choice.method));
+    }
+    BOOST_TEST(reopened.hits() == engines.size());
+
+    // a stopped run is not stored
+    RunControl control;
+    control.cancel();
+    options.control = &control;
+    CSRGraph other;
+    WorkloadGenerator::rmat(150, 600, 9, other);
+    JobEngine::Result stopped = engine.submit(other, JobEngine::Engine::LexM, options).get();
+    BOOST_TEST(!stopped.stats.cached);
+    BOOST_TEST(reopened.size() == engines.size() + 1);
+    unlink(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,185 @@
+#include "OrderingDaemon.hpp"
+#include "OrderingClient.hpp"
+#include "GraphFile.hpp"
+#include "WorkloadGenerator.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <fstream>
+#include <unistd.h>
+
+using namespace boost;
+using namespace CustomGraph;
+
+BOOST_AUTO_TEST_SUITE(Ordering_daemon_tests)
+
+/**
+ * @brief Get a socket path that is not used by another test process.
+ * @param name name of the test.
+ * @return string path in the temporary directory.
+ */
+static string socketPath(const string &name) {
+    return "/tmp/cgraph_" + name + "_" + to_string(getpid()) + ".sock";
+}
+
+// The graphs survive the round trip through the payload of Put, both inline and in shared memory, and their key does not
+// depend on the copy.
+
+BOOST_AUTO_TEST_CASE(Graph_payload) {
+    for(unsigned int n : {50u, 20000u}) {
+        CSRGraph csr;
+        WorkloadGenerator::rmat(n, 4 * n, 5, csr);
+        DaemonBuffer payload;
+        BOOST_TEST(DaemonProtocol::writeGraph(csr, payload));
+        BOOST_TEST(payload.isShared() == (n > 50));
+
+        CSRGraph view;
+        BOOST_TEST(DaemonProtocol::readGraph(payload, view));
+        BOOST_TEST(view.size() == csr.size());
+        BOOST_TEST(view.getVerticesKeys() == csr.getVerticesKeys());
+        BOOST_TEST(view.lex_p() == csr.lex_p());
+        BOOST_TEST(DaemonProtocol::contentHash(view) == DaemonProtocol::contentHash(csr));
+    }
+
+    // an edge stored in one row only is rejected
+    vector<uint64_t> offsets = {0, 1, 1};
+    vector<unsigned int> adjacency = {1}, ids;
+    CSRGraph broken(move(offsets), move(adjacency), move(ids));
+    DaemonBuffer payload;
+    BOOST_TEST(DaemonProtocol::writeGraph(broken, payload));
+    CSRGraph view;
+    BOOST_TEST(!DaemonProtocol::readGraph(payload, view));
+}
+
+// The daemon answers with the results of the direct calls, small replies inline and large ones in shared memory.
+
+BOOST_AUTO_TEST_CASE(Orderings) {
+    string path = socketPath("orderings");
+    OrderingDaemon daemon(path);
+    BOOST_TEST(daemon.start());
+
+    OrderingClient client;
+    BOOST_TEST(client.connect(path));
+    CSRGraph csr;
+    WorkloadGenerator::rmat(200, 800, 9, csr);
+    uint64_t key = DaemonProtocol::contentHash(csr);
+    BOOST_TEST((client.has(key) == DaemonStatus::UnknownGraph));
+
+    OrderingReply reply;
+    BOOST_TEST((client.order(csr, DaemonRequest::LexP, reply) == DaemonStatus::Ok));
+    BOOST_TEST((client.has(key) == DaemonStatus::Ok));
+    BOOST_TEST((client.has(key, GraphFingerprint::of(csr)) == DaemonStatus::Ok));
+    vector<unsigned int> lex_p = csr.lex_p();
+    BOOST_TEST(reply.orderingVector() == lex_p);
+    BOOST_TEST(reply.fillSize() == (uint64_t)0);
+
+    vector<pair<unsigned int, unsigned int>> fill;
+    vector<unsigned int> lex_m = csr.lex_m(&fill);
+    BOOST_TEST((client.order(key, DaemonRequest::LexM, reply) == DaemonStatus::Ok));
+    BOOST_TEST(reply.orderingVector() == lex_m);
+    BOOST_TEST((reply.fillVector() == fill));
+    BOOST_TEST(!reply.perfect());
+
+    BOOST_TEST((client.order(key, DaemonRequest::FillIn, reply, &lex_m) == DaemonStatus::Ok));
+    BOOST_TEST(reply.fillSize() == fill.size());
+
+    BOOST_TEST((client.order(key, DaemonRequest::IsPerfect, reply, &lex_p) == DaemonStatus::Ok));
+    BOOST_TEST(!reply.perfect());
+
+    Graph g;
+    csr.toGraph(g);
+    BOOST_TEST((client.order(key, DaemonRequest::Order, reply) == DaemonStatus::Ok));
+    BOOST_TEST(reply.orderingVector() == g.order());
+
+    // the graph, the ordering of IsPerfect and the ordering of the reply are in shared memory
+    CSRGraph large;
+    WorkloadGenerator::rmat(40000, 80000, 9, large);
+    BOOST_TEST((client.order(large, DaemonRequest::LexP, reply) == DaemonStatus::Ok));
+    vector<unsigned int> large_lex_p = reply.orderingVector();
+    BOOST_TEST(large_lex_p == large.lex_p());
+    BOOST_TEST((client.order(large, DaemonRequest::IsPerfect, reply, &large_lex_p) == DaemonStatus::Ok));
+    BOOST_TEST(reply.perfect() == OrderingEngines::isPerfectOrdering(large, large_lex_p));
+    BOOST_TEST(daemon.cachedGraphs() == (size_t)2);
+    // a graph with another fingerprint is not the graph of the key
+    BOOST_TEST((client.has(key, GraphFingerprint::of(large)) == DaemonStatus::UnknownGraph));
+
+    // chordal graph: the ordering of lex_p is perfect
+    CSRGraph chordal;
+    WorkloadGenerator::randomChordal(500, 6, 3, chordal);
+    BOOST_TEST((client.order(chordal, DaemonRequest::Order, reply) == DaemonStatus::Ok));
+    BOOST_TEST(reply.perfect());
+    vector<unsigned int> peo = reply.orderingVector();
+    BOOST_TEST((client.order(chordal, DaemonRequest::IsPerfect, reply, &peo) == DaemonStatus::Ok));
+    BOOST_TEST(reply.perfect());
+
+    // wrong requests are rejected without closing the connection
+    BOOST_TEST((client.order(12345, DaemonRequest::LexP, reply) == DaemonStatus::UnknownGraph));
+    vector<unsigned int> short_ordering(3, 0);
+    BOOST_TEST((client.order(chordal, DaemonRequest::FillIn, reply, &short_ordering) == DaemonStatus::BadRequest));
+    BOOST_TEST(client.isConnected());
+    BOOST_TEST(daemon.served() > (uint64_t)0);
+}
+
+// Several processes (here connections) share the cached graphs, a graph file is mapped by the daemon, the least recently
+// used graphs are evicted beyond the capacity.
+
+BOOST_AUTO_TEST_CASE(Cache) {
+    string path = socketPath("cache");
+    string file = "/tmp/cgraph_cache_" + to_string(getpid()) + ".bin";
+    CSRGraph csr;
+    WorkloadGenerator::mesh2D(3000, 2, csr);
+    BOOST_TEST(GraphFile::write(file, csr));
+
+    OrderingDaemon daemon(path);
+    BOOST_TEST(daemon.start());
+    OrderingClient first, second;
+    BOOST_TEST(first.connect(path));
+    BOOST_TEST(second.connect(path));
+
+    uint64_t key;
+    BOOST_TEST((first.load(file, key) == DaemonStatus::Ok));
+    BOOST_TEST(key == DaemonProtocol::contentHash(csr));
+    OrderingReply reply;
+    BOOST_TEST((second.order(key, DaemonRequest::LexP, reply) == DaemonStatus::Ok));
+    BOOST_TEST(reply.orderingVector() == csr.lex_p());
+    BOOST_TEST((first.load("/tmp/cgraph_missing_file.bin", key) == DaemonStatus::BadRequest));
+
+    // a file with an offset past the adjacency is refused before any engine reads it
+    string crafted = "/tmp/cgraph_crafted_" + to_string(getpid()) + ".bin";
+    BOOST_TEST(GraphFile::write(crafted, csr));
+    {
+        fstream out(crafted, ios::binary | ios::in | ios::out);
+        GraphFileHeader header;
+        out.read(reinterpret_cast<char*>(&header), sizeof(header));
+        uint64_t offset = (uint64_t) 1 << 36;
+        out.seekp(header.offsetsPosition + sizeof(uint64_t));
+        out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    }
+    uint64_t crafted_key;
+    BOOST_TEST((first.load(crafted, crafted_key) == DaemonStatus::BadRequest));
+    BOOST_TEST(first.isConnected());
+    unlink(crafted.c_str());
+
+    CSRGraph other;
+    WorkloadGenerator::rmat(1000, 4000, 1, other);
+    uint64_t other_key;
+    BOOST_TEST((second.put(other, other_key) == DaemonStatus::Ok));
+    BOOST_TEST(daemon.cachedGraphs() == (size_t)2);
+
+    // only the most recent graph fits
+    daemon.setCapacity(1);
+    BOOST_TEST(daemon.cachedGraphs() == (size_t)1);
+    BOOST_TEST((first.has(other_key) == DaemonStatus::Ok));
+    BOOST_TEST((first.has(key) == DaemonStatus::UnknownGraph));
+    BOOST_TEST((first.drop(other_key) == DaemonStatus::Ok));
+    BOOST_TEST(daemon.cachedGraphs() == (size_t)0);
+    BOOST_TEST(daemon.cachedBytes() == (uint64_t)0);
+
+    // stop closes the connections of the clients
+    daemon.stop();
+    BOOST_TEST((first.has(key) == DaemonStatus::ConnectionLost));
+    BOOST_TEST(!first.isConnected());
+    BOOST_TEST(!first.connect(path));
+    unlink(file.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
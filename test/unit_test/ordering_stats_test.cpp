@@ -0,0 +1,105 @@
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+#include "ErdosRenyiGenerator.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+using namespace boost;
+using namespace CustomGraph;
+namespace bdata = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(Ordering_stats_tests)
+
+const unsigned int graph_dimension[] = {2, 10, 100, 400};
+
+/**
+ * @brief Build a random graph with a certain backend.
+ * @param n number of vertices.
+ * @param storage backend of the graph.
+ * @param g graph that receives the vertices and the edges.
+ */
+static void randomGraph(unsigned int n, Storage storage, Graph &g) {
+    vector<pair<unsigned int, unsigned int>> edges;
+    ErdosRenyiGenerator::generateEdges(n, min<uint64_t>(3 * n, ErdosRenyiGenerator::maxEdges(n)), 11, edges);
+    vector<unsigned int> vertices, sources, destinations;
+    for(unsigned int i = 0; i < n; ++i)
+        vertices.push_back(i);
+    for(auto &edge : edges) {
+        sources.push_back(edge.first);
+        destinations.push_back(edge.second);
+    }
+    g = Graph(vertices, sources, destinations, storage);
+}
+
+// The overloads with stats give the same results of the ones without. Every edge moves its second endpoint to a
+// refined cell exactly once, and no more cells are destroyed than created.
+
+BOOST_DATA_TEST_CASE(Lex_p_stats, bdata::make(graph_dimension), n) {
+    Graph g;
+    randomGraph(n, Storage::Sparse, g);
+    CSRGraph csr(g);
+
+    OrderingStats stats, csr_stats;
+    BOOST_TEST(g.lex_p(stats) == g.lex_p());
+    BOOST_TEST(csr.lex_p(csr_stats) == csr.lex_p());
+
+    BOOST_TEST(stats.refinements == (uint64_t)g.edgeSize());
+    BOOST_TEST(csr_stats.refinements == (uint64_t)g.edgeSize());
+    BOOST_TEST(stats.cells_created <= stats.refinements);
+    BOOST_TEST(stats.cells_destroyed <= stats.cells_created + 1);
+    BOOST_TEST(stats.reach_pushes.empty());
+    BOOST_TEST(stats.fill_edges == (uint64_t)0);
+}
+
+// The fill edges reported by the CSR engine are its calls of addEdge, the reach queues receive each unnumbered vertex
+// at most once for each step. The two backends of Graph count only the fill edges they insert, as the CSR engine.
+
+BOOST_DATA_TEST_CASE(Lex_m_stats, bdata::make(graph_dimension), n) {
+    Graph sparse, dense, plain;
+    randomGraph(n, Storage::Sparse, sparse);
+    randomGraph(n, Storage::Dense, dense);
+    randomGraph(n, Storage::Sparse, plain);
+    CSRGraph csr(sparse);
+
+    OrderingStats csr_stats, sparse_stats, dense_stats;
+    vector<pair<unsigned int, unsigned int>> fill;
+    BOOST_TEST(csr.lex_m(csr_stats, &fill) == csr.lex_m());
+    BOOST_TEST(csr_stats.add_edge_calls == (uint64_t)fill.size());
+    BOOST_TEST(csr_stats.totalReachPushes() <= (uint64_t)n * (n - 1) / 2);
+    BOOST_TEST(csr_stats.cells_created == (uint64_t)0);
+
+    BOOST_TEST(sparse.lex_m(sparse_stats) == plain.lex_m());
+    BOOST_TEST(sparse.edgeSize() == plain.edgeSize());
+    BOOST_TEST(sparse_stats.add_edge_calls == (uint64_t)(sparse.edgeSize() - csr.edgeSize()));
+
+    dense.lex_m(dense_stats);
+    BOOST_TEST(dense_stats.totalReachPushes() <= (uint64_t)n * (n - 1) / 2);
+    BOOST_TEST(dense_stats.add_edge_calls == (uint64_t)(dense.edgeSize() - csr.edgeSize()));
+}
+
+// fill_in counts exactly the edges it adds and the same scans of the higher neighbours, with both the backends, and the
+// counters are accumulated between calls.
+
+BOOST_DATA_TEST_CASE(Fill_in_stats, bdata::make(graph_dimension), n) {
+    Graph sparse, dense;
+    randomGraph(n, Storage::Sparse, sparse);
+    randomGraph(n, Storage::Dense, dense);
+    vector<unsigned int> ordering = CSRGraph(sparse).lex_p();
+    BijectionFunction bj(ordering);
+    unsigned int edges = sparse.edgeSize();
+
+    OrderingStats stats;
+    sparse.fill_in(bj, stats);
+    BOOST_TEST(stats.fill_edges == (uint64_t)(sparse.edgeSize() - edges));
+    BOOST_TEST(stats.neighbor_scans >= (uint64_t)edges);
+
+    uint64_t sparse_fill = stats.fill_edges, sparse_scans = stats.neighbor_scans;
+    dense.fill_in(bj, stats);
+    BOOST_TEST(dense.edgeSize() == sparse.edgeSize());
+    BOOST_TEST(stats.fill_edges == 2 * sparse_fill);
+    BOOST_TEST(stats.neighbor_scans == 2 * sparse_scans);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,68 @@
+#include "OrderingStream.hpp"
+#include "CSRGraph.hpp"
+#include "WorkloadGenerator.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+using namespace boost;
+using namespace CustomGraph;
+
+BOOST_AUTO_TEST_SUITE(Ordering_stream_tests)
+
+// The streams run to the end give the orderings of lex_p and lex_m, numbered from n-1 down to 0, and the fill edges
+// of lex_m as they are found.
+
+BOOST_AUTO_TEST_CASE(Same_orderings) {
+    CSRGraph csr;
+    WorkloadGenerator::rmat(400, 1600, 11, csr);
+    vector<unsigned int> lex_p = csr.lex_p();
+    vector<pair<unsigned int, unsigned int>> lex_m_fill;
+    vector<unsigned int> lex_m = csr.lex_m(&lex_m_fill);
+
+    LexPStream<CSRGraph> p_stream(csr);
+    vector<unsigned int> p_ordering(csr.size());
+    unsigned int vertex;
+    BOOST_TEST(p_stream.remaining() == csr.size());
+    while(p_stream.next(vertex))
+        p_ordering[p_stream.remaining()] = vertex;
+    BOOST_TEST(!p_stream.next(vertex));
+    BOOST_TEST(p_ordering == lex_p);
+
+    vector<pair<unsigned int, unsigned int>> fill;
+    LexMStream<CSRGraph> m_stream(csr, &fill);
+    vector<unsigned int> m_ordering(csr.size());
+    size_t found = 0;
+    bool from_vertex = true;
+    while(m_stream.next(vertex)) {
+        m_ordering[m_stream.remaining()] = vertex;
+        // the fill found by a step starts from the vertex just numbered
+        for(; found < fill.size(); ++found)
+            from_vertex = from_vertex && fill[found].first == vertex;
+    }
+    BOOST_TEST(from_vertex);
+    BOOST_TEST(m_ordering == lex_m);
+    BOOST_TEST(fill == lex_m_fill);
+}
+
+// A stream stopped after the first vertices has done only their work: the first vertex of lex_p refines the sets once
+// for each of its neighbours.
+
+BOOST_AUTO_TEST_CASE(Early_stop) {
+    CSRGraph csr;
+    WorkloadGenerator::mesh2D(10000, 3, csr);
+
+    OrderingStats stats;
+    LexPStream<CSRGraph, true> stream(csr, &stats);
+    unsigned int first;
+    BOOST_TEST(stream.next(first));
+    BOOST_TEST(stream.remaining() == csr.size() - 1);
+    BOOST_TEST(first == csr.lex_p()[csr.size() - 1]);
+    CSRGraph::NeighborRange range = csr.neighbors(csr.indexOf(first));
+    BOOST_TEST(stats.refinements == (uint64_t)(range.end() - range.begin()));
+
+    OrderingStats full;
+    csr.lex_p(full);
+    BOOST_TEST(stats.refinements < full.refinements);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
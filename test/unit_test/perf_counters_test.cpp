@@ -0,0 +1,86 @@
+#include "PerfCounters.hpp"
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace boost;
+using namespace CustomGraph;
+
+BOOST_AUTO_TEST_SUITE(Perf_counters_tests)
+
+// Without an active collection the phases are not recorded and stop returns empty counters.
+
+BOOST_AUTO_TEST_CASE(Inactive) {
+    BOOST_TEST(!PerfCounters::active());
+    {
+        PerfCounters::Scope scope(PerfCounters::ReachSearch);
+    }
+    PerfCounters::Stats stats = PerfCounters::stop();
+    BOOST_TEST(!stats.hardware());
+    for(unsigned int p = 0; p < PerfCounters::NUM_PHASES; ++p)
+        BOOST_TEST(stats.calls[p] == (uint64_t)0);
+}
+
+// lex_m records one reach search, one fill insertion and one label sort for each vertex, lex_p one refinement for each
+// vertex. The hardware events are counted only if they are available, the calls are counted in any case.
+
+BOOST_AUTO_TEST_CASE(Phases) {
+    CustomGraph::Graph g;
+    g.generateRandomGraph(200, 7);
+    unsigned int n = g.size();
+
+    bool hardware = PerfCounters::start();
+    BOOST_TEST(PerfCounters::active());
+    g.lex_p();
+    g.lex_m();
+    PerfCounters::Stats stats = PerfCounters::stop();
+
+    BOOST_TEST(!PerfCounters::active());
+    BOOST_TEST(stats.hardware() == hardware);
+    BOOST_TEST(stats.calls[PerfCounters::PartitionRefinement] == (uint64_t)n);
+    BOOST_TEST(stats.calls[PerfCounters::ReachSearch] == (uint64_t)n);
+    BOOST_TEST(stats.calls[PerfCounters::FillInsertion] == (uint64_t)n);
+    BOOST_TEST(stats.calls[PerfCounters::LabelSort] == (uint64_t)n);
+    BOOST_TEST(stats.nanoseconds[PerfCounters::ReachSearch] > (uint64_t)0);
+
+    if(hardware) {
+        BOOST_TEST(stats.supported[PerfCounters::Cycles]);
+        BOOST_TEST(stats.values[PerfCounters::ReachSearch][PerfCounters::Cycles] > (uint64_t)0);
+    }
+    for(unsigned int e = 0; e < PerfCounters::NUM_EVENTS; ++e)
+        if(!stats.supported[e])
+            for(unsigned int p = 0; p < PerfCounters::NUM_PHASES; ++p)
+                BOOST_TEST(stats.values[p][e] == (uint64_t)0);
+}
+
+// The collections are per thread: the phases of another thread are not counted, and the stats of the threads can be merged.
+
+BOOST_AUTO_TEST_CASE(Threads) {
+    CustomGraph::Graph g;
+    g.generateRandomGraph(100, 3);
+    CSRGraph csr(g);
+
+    PerfCounters::start();
+    PerfCounters::Stats other;
+    thread worker([&]() {
+        PerfCounters::start();
+        csr.lex_p();
+        other = PerfCounters::stop();
+    });
+    worker.join();
+    csr.lex_m();
+    PerfCounters::Stats stats = PerfCounters::stop();
+
+    BOOST_TEST(stats.calls[PerfCounters::PartitionRefinement] == (uint64_t)0);
+    BOOST_TEST(stats.calls[PerfCounters::ReachSearch] == (uint64_t)csr.size());
+    BOOST_TEST(other.calls[PerfCounters::PartitionRefinement] == (uint64_t)csr.size());
+    BOOST_TEST(other.calls[PerfCounters::ReachSearch] == (uint64_t)0);
+
+    stats.merge(other);
+    BOOST_TEST(stats.calls[PerfCounters::PartitionRefinement] == (uint64_t)csr.size());
+    BOOST_TEST(stats.calls[PerfCounters::ReachSearch] == (uint64_t)csr.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
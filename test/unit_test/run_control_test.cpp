@@ -0,0 +1,191 @@
+#include "RunControl.hpp"
+#include "Graph.hpp"
+#include "CSRGraph.hpp"
+#include "WorkloadGenerator.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <thread>
+
+using namespace boost;
+using namespace CustomGraph;
+
+BOOST_AUTO_TEST_SUITE(Run_control_tests)
+
+/**
+ * @brief Check that an ordering contains every vertex of a graph once.
+ * @param ordering ordering to be checked.
+ * @param vertices values of the vertices of the graph.
+ * @return true if the ordering is a permutation of the vertices.
+ */
+static bool isPermutation(vector<unsigned int> ordering, vector<unsigned int> vertices) {
+    sort(ordering.begin(), ordering.end());
+    sort(vertices.begin(), vertices.end());
+    return ordering == vertices;
+}
+
+// Without limits the bounded runs are the plain ones and they count all their steps.
+
+BOOST_AUTO_TEST_CASE(Unlimited) {
+    for(auto storage : {Storage::Sparse, Storage::Dense}) {
+        CustomGraph::Graph random;
+        random.generateRandomGraph(100, 9);
+        CustomGraph::Graph g(random.getVerticesKeys(), storage);
+        for(auto v : random.getVerticesKeys())
+            random.forEachAdjacent(v, [&](unsigned int w) { g.addEdge(v, w); });
+
+        RunControl control;
+        g.checkpoint();
+        vector<unsigned int> ordering = g.lex_m(control);
+        unsigned int filled = g.edgeSize();
+        BOOST_TEST(g.rollback());
+        BOOST_TEST((control.status() == RunControl::Status::Completed));
+        BOOST_TEST(control.steps() == g.size());
+        BOOST_TEST(g.lex_m() == ordering);
+        BOOST_TEST(g.edgeSize() == filled);
+
+        BijectionFunction bf(ordering);
+        BOOST_TEST(g.fill_in(bf, control));
+        BOOST_TEST(control.steps() == g.size() - 1);
+        BOOST_TEST(g.edgeSize() == filled);
+    }
+
+    CSRGraph csr;
+    WorkloadGenerator::rmat(300, 1200, 5, csr);
+    RunControl control;
+    vector<pair<unsigned int, unsigned int>> fill, plain_fill;
+    BOOST_TEST(csr.lex_m(control, &fill) == csr.lex_m(&plain_fill));
+    BOOST_TEST(fill == plain_fill);
+    BOOST_TEST(control.steps() == csr.size());
+}
+
+// A cancelled control or an expired deadline stop the run before its first step, the result is still an ordering of
+// all the vertices and no fill is added.
+
+BOOST_AUTO_TEST_CASE(Stopped_before_start) {
+    for(auto storage : {Storage::Sparse, Storage::Dense}) {
+        CustomGraph::Graph random;
+        random.generateRandomGraph(80, 4);
+        CustomGraph::Graph g(random.getVerticesKeys(), storage);
+        for(auto v : random.getVerticesKeys())
+            random.forEachAdjacent(v, [&](unsigned int w) { g.addEdge(v, w); });
+        unsigned int edges = g.edgeSize();
+
+        RunControl expired;
+        expired.setTimeout(chrono::nanoseconds(0));
+        BOOST_TEST(isPermutation(g.lex_m(expired), g.getVerticesKeys()));
+        BOOST_TEST((expired.status() == RunControl::Status::DeadlineExpired));
+        BOOST_TEST(expired.steps() == (unsigned int)0);
+        BOOST_TEST(g.edgeSize() == edges);
+
+        RunControl cancelled;
+        cancelled.cancel();
+        BOOST_TEST(cancelled.isCancelled());
+        vector<unsigned int> vertices = random.getVerticesKeys();
+        BijectionFunction bf(vertices);
+        BOOST_TEST(!g.fill_in(bf, cancelled));
+        BOOST_TEST((cancelled.status() == RunControl::Status::Cancelled));
+        BOOST_TEST(g.edgeSize() == edges);
+    }
+}
+
+// With a fill budget the run stops after the step that goes beyond it: the numbered vertices are the last ones of
+// lex_m and the fill found is the fill of lex_m up to that step.
+
+BOOST_AUTO_TEST_CASE(Fill_budget) {
+    CSRGraph csr;
+    WorkloadGenerator::rmat(400, 2400, 3, csr);
+    vector<pair<unsigned int, unsigned int>> plain_fill;
+    vector<unsigned int> plain = csr.lex_m(&plain_fill);
+    BOOST_TEST(plain_fill.size() > (size_t)50);
+
+    RunControl control;
+    control.setFillBudget(50);
+    vector<pair<unsigned int, unsigned int>> fill;
+    vector<unsigned int> ordering = csr.lex_m(control, &fill);
+    BOOST_TEST((control.status() == RunControl::Status::FillBudgetExceeded));
+    BOOST_TEST(fill.size() > (size_t)50);
+    BOOST_TEST(control.steps() < csr.size());
+    BOOST_TEST(isPermutation(ordering, csr.getVerticesKeys()));
+
+    unsigned int numbered = csr.size() - control.steps();
+    BOOST_TEST(vector<unsigned int>(ordering.begin() + numbered, ordering.end()) == vector<unsigned int>(plain.begin() + numbered, plain.end()));
+    BOOST_TEST(equal(fill.begin(), fill.end(), plain_fill.begin()));
+
+    // the partial fill of fill_in is discarded by a rollback
+    for(auto storage : {Storage::Sparse, Storage::Dense}) {
+        CustomGraph::Graph g(storage);
+        csr.toGraph(g);
+        unsigned int edges = g.edgeSize();
+        BijectionFunction bf(plain);
+        control.setFillBudget(10);
+        g.checkpoint();
+        BOOST_TEST(!g.fill_in(bf, control));
+        BOOST_TEST((control.status() == RunControl::Status::FillBudgetExceeded));
+        BOOST_TEST(g.edgeSize() > edges + 10);
+        BOOST_TEST(g.rollback());
+        BOOST_TEST(g.edgeSize() == edges);
+    }
+}
+
+// The budget is checked again after the last step: a run whose last step goes beyond it is not Completed, a run
+// that ends with the fill equal to the budget is.
+
+BOOST_AUTO_TEST_CASE(Last_step) {
+    RunControl control;
+    control.setFillBudget(10);
+    control.start();
+    BOOST_TEST(control.proceed(0));
+    BOOST_TEST(control.proceed(10));
+    BOOST_TEST(!control.finish(11));
+    BOOST_TEST((control.status() == RunControl::Status::FillBudgetExceeded));
+    BOOST_TEST(control.steps() == (unsigned int)2);
+
+    control.start();
+    BOOST_TEST(control.proceed(0));
+    BOOST_TEST(control.finish(10));
+    BOOST_TEST((control.status() == RunControl::Status::Completed));
+
+    CSRGraph csr;
+    WorkloadGenerator::rmat(300, 1500, 7, csr);
+    for(auto storage : {Storage::Sparse, Storage::Dense}) {
+        CustomGraph::Graph g(storage);
+        csr.toGraph(g);
+        unsigned int edges = g.edgeSize();
+        g.checkpoint();
+        vector<unsigned int> plain = g.lex_m();
+        uint64_t fill = g.edgeSize() - edges;
+        BOOST_TEST(g.rollback());
+        BOOST_TEST(fill > (uint64_t)0);
+
+        control.setFillBudget(fill);
+        g.checkpoint();
+        BOOST_TEST(g.lex_m(control) == plain);
+        BOOST_TEST((control.status() == RunControl::Status::Completed));
+        BOOST_TEST(g.rollback());
+
+        control.setFillBudget(fill - 1);
+        g.lex_m(control);
+        BOOST_TEST((control.status() == RunControl::Status::FillBudgetExceeded));
+    }
+}
+
+// Another thread cancels a long run, which stops at the next step.
+
+BOOST_AUTO_TEST_CASE(Cancel_from_thread) {
+    CSRGraph csr;
+    WorkloadGenerator::mesh2D(4000, 1, csr);
+    RunControl control;
+
+    thread canceller([&]() {
+        this_thread::sleep_for(chrono::milliseconds(20));
+        control.cancel();
+    });
+    vector<unsigned int> ordering = csr.lex_m(control);
+    canceller.join();
+
+    BOOST_TEST((control.status() == RunControl::Status::Cancelled));
+    BOOST_TEST(control.steps() < csr.size());
+    BOOST_TEST(isPermutation(ordering, csr.getVerticesKeys()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
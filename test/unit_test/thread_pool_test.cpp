@@ -0,0 +1,103 @@
+#include "ThreadPool.hpp"
+#include "Parallel.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <future>
+#include <set>
+
+using namespace boost;
+
+BOOST_AUTO_TEST_SUITE(Thread_pool_tests)
+
+// The destructor runs the tasks still queued before joining the workers.
+
+BOOST_AUTO_TEST_CASE(Drain_on_destruction) {
+    atomic<unsigned int> count(0);
+    {
+        ThreadPool pool(3);
+        BOOST_TEST(pool.size() == (unsigned int)3);
+        for(unsigned int i = 0; i < 1000; ++i)
+            pool.submit([&]() { count++; }, i % 5);
+        for(unsigned int i = 0; i < 100; ++i)
+            pool.spawn([&]() { count++; });
+    }
+    BOOST_TEST(count.load() == (unsigned int)1100);
+}
+
+// The tasks spawned by a worker go to its deque, the idle workers steal them and they run on several threads.
+
+BOOST_AUTO_TEST_CASE(Stealing) {
+    ThreadPool pool(4);
+    mutex lock;
+    set<int> workers;
+    atomic<unsigned int> count(0);
+    promise<void> spawned;
+
+    pool.submit([&]() {
+        BOOST_TEST(ThreadPool::currentWorker() >= 0);
+        for(unsigned int i = 0; i < 64; ++i)
+            pool.spawn([&]() {
+                this_thread::sleep_for(chrono::milliseconds(1));
+                lock_guard<mutex> guard(lock);
+                workers.insert(ThreadPool::currentWorker());
+                count++;
+            });
+        spawned.set_value();
+    });
+    spawned.get_future().wait();
+    while(count.load() < 64)
+        this_thread::yield();
+
+    BOOST_TEST(pool.steals() > (uint64_t)0);
+    BOOST_TEST(workers.size() > (size_t)1);
+    BOOST_TEST(ThreadPool::currentWorker() == -1);
+}
+
+// The clients are served round robin: with a single worker the two tasks of the second client run between the first
+// tasks of the other client, not after all of them.
+
+BOOST_AUTO_TEST_CASE(Fair_clients) {
+    vector<unsigned int> order;
+    {
+        ThreadPool pool(1);
+        promise<void> release;
+        shared_future<void> released = release.get_future().share();
+        pool.submit([released]() { released.wait(); }, 0);
+
+        for(unsigned int i = 0; i < 10; ++i)
+            pool.submit([&]() { order.push_back(1); }, 1);
+        for(unsigned int i = 0; i < 2; ++i)
+            pool.submit([&]() { order.push_back(2); }, 2);
+        release.set_value();
+    }
+    BOOST_TEST(order.size() == (size_t)12);
+    BOOST_TEST(order == vector<unsigned int>({1, 2, 1, 2, 1, 1, 1, 1, 1, 1, 1, 1}));
+}
+
+// Parallel loops can be nested in the tasks of the shared pool, every loop ends even when all the workers are busy.
+
+BOOST_AUTO_TEST_CASE(Nested_loops) {
+    ThreadPool &pool = ThreadPool::shared();
+    unsigned int num_jobs = 2 * pool.size() + 1;
+    vector<promise<uint64_t>> sums(num_jobs);
+
+    for(unsigned int j = 0; j < num_jobs; ++j)
+        pool.submit([&, j]() {
+            vector<uint64_t> partial(100, 0);
+            Parallel::forEach(100, [&](unsigned int i) {
+                Parallel::forEach(10, [&](unsigned int k) {
+                    if(k == 0)
+                        partial[i] = i + j;
+                });
+            });
+            uint64_t sum = 0;
+            for(auto p : partial)
+                sum += p;
+            sums[j].set_value(sum);
+        }, j);
+
+    for(unsigned int j = 0; j < num_jobs; ++j)
+        BOOST_TEST(sums[j].get_future().get() == (uint64_t)(4950 + 100 * j));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
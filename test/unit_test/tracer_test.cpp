@@ -0,0 +1,141 @@
+#include "Tracer.hpp"
+#include "Parallel.hpp"
+#include "CSRGraph.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <sstream>
+#include <thread>
+
+using namespace boost;
+using namespace CustomGraph;
+
+BOOST_AUTO_TEST_SUITE(Tracer_tests)
+
+/**
+ * @brief Count the occurrences of a string in a text.
+ * @param text text to be searched.
+ * @param pattern string to be counted.
+ * @return unsigned int number of occurrences.
+ */
+static unsigned int occurrences(const string &text, const string &pattern) {
+    unsigned int count = 0;
+    for(size_t pos = text.find(pattern); pos != string::npos; pos = text.find(pattern, pos + 1))
+        count++;
+    return count;
+}
+
+// Disabled spans are not recorded.
+
+BOOST_AUTO_TEST_CASE(Disabled) {
+    Tracer::disable();
+    Tracer::clear();
+    {
+        Tracer::Span span("disabled");
+    }
+    CSRGraph csr;
+    csr.lex_p();
+    BOOST_TEST(Tracer::size() == (size_t)0);
+}
+
+// The construction of a graph, the check of connectivity and the engines appear in the trace, written in the trace
+// event format.
+
+BOOST_AUTO_TEST_CASE(Engines) {
+    CustomGraph::Graph g;
+    g.generateRandomGraph(50, 5);
+
+    Tracer::enable();
+    CSRGraph csr(g);
+    csr.isConnected();
+    csr.lex_m();
+    g.lex_p();
+    Tracer::disable();
+
+    stringstream out;
+    Tracer::writeChromeTrace(out);
+    string json = out.str();
+    BOOST_TEST(json.find("{\"traceEvents\":[") == (size_t)0);
+    BOOST_TEST(occurrences(json, "\"name\":\"CSRGraph::CSRGraph\"") == (unsigned int)1);
+    BOOST_TEST(occurrences(json, "\"name\":\"OrderingEngines::isConnected\"") == (unsigned int)1);
+    BOOST_TEST(occurrences(json, "\"name\":\"OrderingEngines::lex_m\"") == (unsigned int)1);
+    BOOST_TEST(occurrences(json, "\"name\":\"Graph::lex_p\"") == (unsigned int)1);
+    BOOST_TEST(occurrences(json, "\"ph\":\"X\"") == (unsigned int)Tracer::size());
+    BOOST_TEST(Tracer::dropped() == (uint64_t)0);
+
+    // spans recorded after disable are ignored
+    csr.lex_p();
+    BOOST_TEST(occurrences(json, "\"ph\":\"X\"") == (unsigned int)Tracer::size());
+}
+
+// When a buffer is full the oldest spans are overwritten.
+
+BOOST_AUTO_TEST_CASE(Ring_buffer) {
+    static const char *names[] = {"s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7", "s8", "s9"};
+    Tracer::enable(4);
+    for(auto name : names)
+        Tracer::Span span(name, "test");
+    Tracer::disable();
+
+    BOOST_TEST(Tracer::size() == (size_t)4);
+    BOOST_TEST(Tracer::dropped() == (uint64_t)6);
+
+    stringstream out;
+    Tracer::writeChromeTrace(out);
+    string json = out.str();
+    BOOST_TEST(json.find("\"s5\"") == string::npos);
+    BOOST_TEST(json.find("\"s6\"") < json.find("\"s7\""));
+    BOOST_TEST(json.find("\"s8\"") < json.find("\"s9\""));
+
+    Tracer::clear();
+    BOOST_TEST(Tracer::size() == (size_t)0);
+    BOOST_TEST(Tracer::dropped() == (uint64_t)0);
+}
+
+// Every parallel task is a span, recorded by the thread that executed it.
+
+BOOST_AUTO_TEST_CASE(Parallel_tasks) {
+    Tracer::enable();
+    Parallel::forEach(16, [](unsigned int i) {}, 4);
+    Tracer::disable();
+
+    stringstream out;
+    Tracer::writeChromeTrace(out);
+    BOOST_TEST(occurrences(out.str(), "\"name\":\"Parallel::task\"") == (unsigned int)16);
+    BOOST_TEST(!Tracer::writeChromeTrace("/nonexistent/trace.json"));
+    Tracer::clear();
+}
+
+// The spans of a thread that has ended are kept until they are written, then its buffer is dropped and they are not
+// written again.
+
+BOOST_AUTO_TEST_CASE(Exited_threads) {
+    Tracer::enable(2);
+    for(unsigned int i = 0; i < 8; ++i)
+        thread([]() {
+            for(unsigned int j = 0; j < 3; ++j)
+                Tracer::Span span("exited", "test");
+        }).join();
+    Tracer::Span("main", "test");
+    BOOST_TEST(Tracer::size() == (size_t)17);
+    BOOST_TEST(Tracer::dropped() == (uint64_t)8);
+
+    stringstream out;
+    Tracer::writeChromeTrace(out);
+    BOOST_TEST(occurrences(out.str(), "\"name\":\"exited\"") == (unsigned int)16);
+    BOOST_TEST(Tracer::size() == (size_t)1);
+    BOOST_TEST(Tracer::dropped() == (uint64_t)8);
+
+    thread([]() { Tracer::Span span("late", "test"); }).join();
+    Tracer::disable();
+    stringstream again;
+    Tracer::writeChromeTrace(again);
+    BOOST_TEST(occurrences(again.str(), "\"name\":\"exited\"") == (unsigned int)0);
+    BOOST_TEST(occurrences(again.str(), "\"name\":\"late\"") == (unsigned int)1);
+    BOOST_TEST(occurrences(again.str(), "\"thread_name\"") == occurrences(out.str(), "\"thread_name\"") - 7);
+
+    Tracer::clear();
+    BOOST_TEST(Tracer::size() == (size_t)0);
+    BOOST_TEST(Tracer::dropped() == (uint64_t)0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
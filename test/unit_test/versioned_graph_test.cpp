@@ -0,0 +1,162 @@
+#include "VersionedGraph.hpp"
+#include "WorkloadGenerator.hpp"
+#include "RandomStream.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <thread>
+#include <atomic>
+
+using namespace boost;
+using namespace CustomGraph;
+
+BOOST_AUTO_TEST_SUITE(Versioned_graph_tests)
+
+/**
+ * @brief Check that a snapshot is a consistent undirected graph: the adjacent vertices are sorted, every edge is in
+ * the lists of both its endpoints and the number of edges matches the degrees.
+ * @param snapshot snapshot to be checked.
+ * @return true if the snapshot is consistent.
+ */
+static bool consistent(VersionedGraph::Snapshot &snapshot) {
+    uint64_t degrees = 0;
+    for(unsigned int i = 0; i < snapshot.size(); ++i) {
+        const vector<unsigned int> &adj = snapshot.neighbors(i);
+        if(!is_sorted(adj.begin(), adj.end()))
+            return false;
+        for(auto j : adj)
+            if(!snapshot.isAdjacent(snapshot.vertexValue(j), snapshot.vertexValue(i)))
+                return false;
+        degrees += adj.size();
+    }
+    return degrees == 2 * (uint64_t) snapshot.edgeSize();
+}
+
+// The first version is a copy of the CSRGraph, the orderings of a snapshot are the ones of the CSR engines.
+
+BOOST_AUTO_TEST_CASE(From_csr) {
+    CSRGraph csr;
+    WorkloadGenerator::rmat(300, 1200, 7, csr);
+    VersionedGraph graph(csr);
+
+    VersionedGraph::Snapshot snapshot = graph.snapshot();
+    BOOST_TEST(snapshot.version() == (uint64_t)0);
+    BOOST_TEST(snapshot.size() == csr.size());
+    BOOST_TEST(snapshot.edgeSize() == csr.edgeSize());
+    BOOST_TEST(consistent(snapshot));
+    BOOST_TEST(snapshot.isConnected() == csr.isConnected());
+    BOOST_TEST(snapshot.lex_p() == csr.lex_p());
+
+    vector<pair<unsigned int, unsigned int>> fill, csr_fill;
+    BOOST_TEST(snapshot.lex_m(&fill) == csr.lex_m(&csr_fill));
+    BOOST_TEST(fill == csr_fill);
+
+    CSRGraph copy = snapshot.toCSR();
+    BOOST_TEST(copy.getVerticesKeys() == csr.getVerticesKeys());
+    BOOST_TEST(copy.edgeSize() == csr.edgeSize());
+    BOOST_TEST(copy.lex_p() == csr.lex_p());
+}
+
+// A pinned version does not see the following updates, a new snapshot sees all of them. The invalid changes do not
+// publish any version.
+
+BOOST_AUTO_TEST_CASE(Updates) {
+    VersionedGraph graph(200);
+    VersionedGraph::Snapshot empty = graph.snapshot();
+
+    BOOST_TEST(graph.addEdge(0, 1));
+    BOOST_TEST(graph.addEdge(1, 150));
+    BOOST_TEST(!graph.addEdge(150, 1));
+    BOOST_TEST(!graph.addEdge(3, 3));
+    BOOST_TEST(!graph.addEdge(3, 200));
+    BOOST_TEST(!graph.deleteEdge(0, 2));
+    BOOST_TEST(graph.version() == (uint64_t)2);
+
+    VersionedGraph::Snapshot two = graph.snapshot();
+    BOOST_TEST(graph.update({{2, 3}, {0, 1}, {4, 5}}, {{0, 1}, {1, 150}}) == (unsigned int)5);
+    BOOST_TEST(graph.version() == (uint64_t)3);
+
+    VersionedGraph::Snapshot three = graph.snapshot();
+    BOOST_TEST(empty.edgeSize() == (unsigned int)0);
+    BOOST_TEST(two.edgeSize() == (unsigned int)2);
+    BOOST_TEST(two.isAdjacent(150, 1));
+    BOOST_TEST(three.edgeSize() == (unsigned int)3);
+    BOOST_TEST(three.isAdjacent(0, 1));
+    BOOST_TEST(!three.isAdjacent(1, 150));
+    BOOST_TEST(three.neighbors(1) == vector<unsigned int>({0}));
+    BOOST_TEST(consistent(two));
+    BOOST_TEST(consistent(three));
+}
+
+// The retired versions are kept while a snapshot that could use them is alive and deleted afterwards. Moving a
+// snapshot keeps its version pinned.
+
+BOOST_AUTO_TEST_CASE(Reclamation) {
+    VersionedGraph graph(100);
+    graph.addEdge(0, 1);
+    BOOST_TEST(graph.retainedVersions() == (size_t)0);
+
+    VersionedGraph::Snapshot first = graph.snapshot();
+    for(unsigned int i = 2; i < 6; ++i)
+        graph.addEdge(0, i);
+    BOOST_TEST(graph.retainedVersions() == (size_t)4);
+
+    VersionedGraph::Snapshot moved = move(first);
+    BOOST_TEST(graph.reclaim() == (size_t)0);
+    BOOST_TEST(moved.edgeSize() == (unsigned int)1);
+
+    // a later snapshot does not pin the older versions
+    VersionedGraph::Snapshot last = graph.snapshot();
+    moved.release();
+    BOOST_TEST(graph.reclaim() == (size_t)4);
+    BOOST_TEST(graph.retainedVersions() == (size_t)0);
+    BOOST_TEST(last.edgeSize() == (unsigned int)5);
+
+    graph.deleteEdge(0, 1);
+    BOOST_TEST(graph.retainedVersions() == (size_t)1);
+    last.release();
+    BOOST_TEST(graph.reclaim() == (size_t)1);
+}
+
+// A writer keeps updating the graph while readers take snapshots and order them: every snapshot is consistent and
+// keeps its content while it is pinned.
+
+BOOST_AUTO_TEST_CASE(Concurrent_readers) {
+    const unsigned int n = 256;
+    VersionedGraph graph(n);
+    atomic<bool> done(false);
+    atomic<unsigned int> failures(0), snapshots(0);
+
+    thread writer([&]() {
+        RandomStream random(13);
+        for(unsigned int i = 0; i < 2000; ++i) {
+            unsigned int u = random.next() % n, v = random.next() % n;
+            if(!graph.addEdge(u, v))
+                graph.deleteEdge(u, v);
+        }
+        done = true;
+    });
+
+    vector<thread> readers;
+    for(unsigned int r = 0; r < 4; ++r)
+        readers.emplace_back([&]() {
+            while(!done) {
+                VersionedGraph::Snapshot snapshot = graph.snapshot();
+                unsigned int edges = snapshot.edgeSize();
+                vector<unsigned int> ordering = snapshot.lex_p();
+                if(ordering.size() != n || !consistent(snapshot) || snapshot.edgeSize() != edges)
+                    failures++;
+                snapshots++;
+            }
+        });
+
+    writer.join();
+    for(auto &reader : readers)
+        reader.join();
+
+    BOOST_TEST(failures.load() == (unsigned int)0);
+    BOOST_TEST(snapshots.load() > (unsigned int)0);
+    graph.reclaim();
+    BOOST_TEST(graph.retainedVersions() == (size_t)0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
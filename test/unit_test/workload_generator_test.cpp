@@ -0,0 +1,112 @@
+#include "WorkloadGenerator.hpp"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+using namespace boost;
+using namespace CustomGraph;
+namespace bdata = boost::unit_test::data;
+
+BOOST_AUTO_TEST_SUITE(Workload_generator_tests)
+
+const unsigned int graph_dimension[] = {1, 7, 64, 1000, 100000};
+// dimensions of the chordal generators, whose chordality is checked on a Graph with lex_p and fill_in
+const unsigned int chordal_dimension[] = {1, 7, 64, 1000};
+
+/**
+ * @brief Check that lex_p applied to a graph gives a perfect ordering, i.e. that the graph is chordal.
+ * @param csr graph to be checked.
+ * @return true if the graph is chordal.
+ */
+static bool isChordal(CSRGraph &csr) {
+    CustomGraph::Graph g;
+    csr.toGraph(g);
+    unsigned int edges = g.edgeSize();
+    vector<unsigned int> ordering = g.lex_p();
+    BijectionFunction bj(ordering);
+    g.fill_in(bj);
+    return g.edgeSize() == edges;
+}
+
+// The meshes have the requested vertices, they are connected and their degrees are bounded by the stencil.
+
+BOOST_DATA_TEST_CASE(Meshes, bdata::make(graph_dimension), n) {
+    CSRGraph mesh;
+    WorkloadGenerator::mesh2D(n, 1, mesh);
+    BOOST_TEST(mesh.size() == n);
+    BOOST_TEST(mesh.isConnected());
+    for(unsigned int i = 0; i < mesh.size(); ++i)
+        BOOST_TEST(mesh.degree(i) <= (unsigned int)6);
+
+    WorkloadGenerator::mesh3D(n, 1, mesh);
+    BOOST_TEST(mesh.size() == n);
+    BOOST_TEST(mesh.isConnected());
+    for(unsigned int i = 0; i < mesh.size(); ++i)
+        BOOST_TEST(mesh.degree(i) <= (unsigned int)6);
+
+    // a complete 10 x 10 grid has 2*10*9 axis edges and 9*9 diagonals
+    if(n == 1000) {
+        WorkloadGenerator::mesh2D(100, 1, mesh);
+        BOOST_TEST(mesh.edgeSize() == (unsigned int)(180 + 81));
+        WorkloadGenerator::mesh3D(1000, 1, mesh);
+        BOOST_TEST(mesh.edgeSize() == (unsigned int)(3 * 10 * 10 * 9));
+    }
+}
+
+// R-MAT graphs have at most the drawn edges and a skewed degree distribution.
+
+BOOST_AUTO_TEST_CASE(Rmat) {
+    CSRGraph graph;
+    BOOST_TEST(WorkloadGenerator::rmat(1 << 14, 200000, 5, graph));
+    BOOST_TEST(graph.size() == (unsigned int)(1 << 14));
+    BOOST_TEST(graph.edgeSize() <= (unsigned int)200000);
+    BOOST_TEST(graph.edgeSize() > (unsigned int)100000);
+
+    unsigned int max_degree = 0;
+    for(unsigned int i = 0; i < graph.size(); ++i)
+        max_degree = max(max_degree, graph.degree(i));
+    BOOST_TEST(max_degree > 20 * 2 * graph.edgeSize() / graph.size());
+
+    BOOST_TEST(!WorkloadGenerator::rmat(100, 10, 5, graph, 0, 0.6, 0.3, 0.3));
+}
+
+// Random chordal graphs and full k-trees are chordal, thinned k-trees stay connected.
+
+BOOST_DATA_TEST_CASE(Chordal_and_k_trees, bdata::make(chordal_dimension), n) {
+    CSRGraph graph;
+    BOOST_TEST(WorkloadGenerator::randomChordal(n, 6, 3, graph));
+    BOOST_TEST(graph.size() == n);
+    BOOST_TEST(graph.isConnected());
+    BOOST_TEST(isChordal(graph));
+
+    BOOST_TEST(WorkloadGenerator::partialKTree(n, 3, 1.0, 3, graph));
+    BOOST_TEST(graph.isConnected());
+    BOOST_TEST(isChordal(graph));
+    // a 3-tree with n >= 4 vertices has 3n - 6 edges
+    if(n >= 4)
+        BOOST_TEST(graph.edgeSize() == 3 * n - 6);
+
+    BOOST_TEST(WorkloadGenerator::partialKTree(n, 3, 0.3, 3, graph));
+    BOOST_TEST(graph.isConnected());
+
+    BOOST_TEST(!WorkloadGenerator::randomChordal(n, 1, 3, graph));
+    BOOST_TEST(!WorkloadGenerator::partialKTree(n, 0, 0.5, 3, graph));
+}
+
+// The graphs depend only on the seed, not on the number of threads.
+
+BOOST_AUTO_TEST_CASE(Reproducible) {
+    CSRGraph first, second;
+    WorkloadGenerator::rmat(1 << 16, 500000, 9, first, 1);
+    WorkloadGenerator::rmat(1 << 16, 500000, 9, second, 8);
+    BOOST_TEST(first.edgeSize() == second.edgeSize());
+    BOOST_TEST(equal(first.getAdjacency(), first.getAdjacency() + 2 * (size_t) first.edgeSize(), second.getAdjacency()));
+
+    WorkloadGenerator::partialKTree(200000, 4, 0.5, 9, first, 1);
+    WorkloadGenerator::partialKTree(200000, 4, 0.5, 9, second, 8);
+    BOOST_TEST(first.edgeSize() == second.edgeSize());
+    BOOST_TEST(equal(first.getAdjacency(), first.getAdjacency() + 2 * (size_t) first.edgeSize(), second.getAdjacency()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
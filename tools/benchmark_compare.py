@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""Compare two runs of the ordering benchmark and fail on performance regressions.
+
+Both files are the JSON written by test/temporal/ordering_benchmark with --benchmark_out_format=json, preferably run with
+--benchmark_repetitions=N (N >= 5) so every benchmark has several samples. Two checks are performed:
+
+- time: for every benchmark <engine>/<family>/<size> the samples of the two runs are compared with the Mann-Whitney U test;
+  it is a regression if the median of the new run is slower than the threshold and the difference is significant;
+- complexity: for every <engine>/<family> the exponent k of time ~ N^k (N = vertices + edges) is fitted by least squares
+  on the log-log medians of the sizes; it is a regression if the exponent grows more than the threshold, or if it
+  exceeds the limit given with --max-exponent (this makes the complexity of an engine an enforceable claim).
+
+The exit status is 1 if at least one regression is found, 2 if the input is not valid, 0 otherwise.
+
+Example:
+    python3 tools/benchmark_compare.py old.json new.json --time-threshold 0.10 --max-exponent csr_lex_p=1.2
+"""
+
+import argparse
+import json
+import math
+import sys
+from collections import defaultdict
+
+TIME_UNITS = {"ns": 1e-9, "us": 1e-6, "ms": 1e-3, "s": 1.0}
+
+
+def load_samples(path):
+    """Read the iteration runs of a benchmark file.
+
+    Returns a dict run_name -> {"times": [seconds], "n": complexity size, "size": target size, "group": engine/family}.
+    """
+    with open(path) as f:
+        data = json.load(f)
+
+    runs = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("run_type", "iteration") != "iteration" or bench.get("error_occurred"):
+            continue
+        name = bench["run_name"]
+        parts = [p for p in name.split("/") if p != "manual_time" and not p.startswith("min_time")]
+        if len(parts) < 3 or not parts[2].isdigit():
+            continue
+
+        run = runs.setdefault(name, {"times": [], "group": parts[0] + "/" + parts[1], "size": int(parts[2]), "n": None})
+        run["times"].append(bench["real_time"] * TIME_UNITS[bench.get("time_unit", "ns")])
+        if "vertices" in bench and "edges" in bench:
+            run["n"] = bench["vertices"] + bench["edges"]
+    for run in runs.values():
+        if run["n"] is None:
+            run["n"] = run["size"]
+    return runs
+
+
+def median(values):
+    values = sorted(values)
+    middle = len(values) // 2
+    return values[middle] if len(values) % 2 else (values[middle - 1] + values[middle]) / 2
+
+
+def mann_whitney(first, second):
+    """Two-sided p-value of the Mann-Whitney U test, exact for small samples without ties, normal approximation otherwise."""
+    n1, n2 = len(first), len(second)
+    if n1 == 0 or n2 == 0:
+        return 1.0
+
+    # ranks of the pooled samples, ties get the average rank
+    pooled = sorted([(v, 0) for v in first] + [(v, 1) for v in second])
+    ranks = [0.0] * len(pooled)
+    tie_term = 0.0
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+        tie_term += (j - i + 1) ** 3 - (j - i + 1)
+        i = j + 1
+
+    r1 = sum(r for r, (_, side) in zip(ranks, pooled) if side == 0)
+    u = r1 - n1 * (n1 + 1) / 2
+    u = min(u, n1 * n2 - u)
+
+    if tie_term == 0 and n1 * n2 <= 400:
+        # exact distribution of U: counts[k] = number of arrangements with U = k
+        counts = [[[0] * (n1 * n2 + 1) for _ in range(n2 + 1)] for _ in range(n1 + 1)]
+        for a in range(n1 + 1):
+            for b in range(n2 + 1):
+                if a == 0 or b == 0:
+                    counts[a][b][0] = 1
+                    continue
+                for k in range(a * b + 1):
+                    counts[a][b][k] = (counts[a - 1][b][k - b] if k >= b else 0) + counts[a][b - 1][k]
+        total = math.comb(n1 + n2, n1)
+        tail = sum(counts[n1][n2][k] for k in range(int(u) + 1)) / total
+        return min(1.0, 2 * tail)
+
+    n = n1 + n2
+    sigma = math.sqrt(n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1))))
+    if sigma == 0:
+        return 1.0
+    z = (abs(u - n1 * n2 / 2) - 0.5) / sigma
+    return min(1.0, math.erfc(max(z, 0) / math.sqrt(2)))
+
+
+def fit_exponent(points):
+    """Least squares slope of log(time) against log(n), None if there are less than two distinct sizes."""
+    points = [(math.log(n), math.log(t)) for n, t in points if n > 0 and t > 0]
+    if len({x for x, _ in points}) < 2:
+        return None
+    mean_x = sum(x for x, _ in points) / len(points)
+    mean_y = sum(y for _, y in points) / len(points)
+    sxx = sum((x - mean_x) ** 2 for x, _ in points)
+    sxy = sum((x - mean_x) * (y - mean_y) for x, y in points)
+    return sxy / sxx
+
+
+def parse_limits(values):
+    limits = {}
+    for value in values:
+        engine, _, limit = value.partition("=")
+        try:
+            limits[engine] = float(limit)
+        except ValueError:
+            raise SystemExit("invalid --max-exponent '%s', expected engine=value" % value)
+    return limits
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="benchmark JSON of the reference run")
+    parser.add_argument("contender", help="benchmark JSON of the run to be checked")
+    parser.add_argument("--time-threshold", type=float, default=0.10, help="relative slowdown of the median allowed (default 0.10)")
+    parser.add_argument("--exponent-threshold", type=float, default=0.15, help="growth of the fitted exponent allowed (default 0.15)")
+    parser.add_argument("--alpha", type=float, default=0.05, help="significance level of the Mann-Whitney test (default 0.05)")
+    parser.add_argument("--min-samples", type=int, default=3,
+                        help="below this number of samples per side the test is skipped and only the threshold is applied (default 3)")
+    parser.add_argument("--max-exponent", action="append", default=[], metavar="ENGINE=VALUE",
+                        help="absolute limit of the fitted exponent of an engine, it can be repeated")
+    args = parser.parse_args()
+
+    try:
+        old, new = load_samples(args.baseline), load_samples(args.contender)
+    except (OSError, ValueError, KeyError) as error:
+        print("cannot read the benchmark files: %s" % error, file=sys.stderr)
+        return 2
+    limits = parse_limits(args.max_exponent)
+
+    regressions = []
+    common = sorted(set(old) & set(new), key=lambda name: (old[name]["group"], old[name]["size"]))
+    if not common:
+        print("the two runs have no benchmark in common", file=sys.stderr)
+        return 2
+
+    print("%-48s %12s %12s %9s %9s" % ("benchmark", "old median", "new median", "change", "p-value"))
+    for name in common:
+        old_times, new_times = old[name]["times"], new[name]["times"]
+        old_median, new_median = median(old_times), median(new_times)
+        change = new_median / old_median - 1
+        enough = min(len(old_times), len(new_times)) >= args.min_samples
+        p_value = mann_whitney(old_times, new_times) if enough else None
+
+        slower = change > args.time_threshold and (p_value is None or p_value < args.alpha)
+        print("%-48s %11.4gs %11.4gs %+8.1f%% %9s%s" % (name, old_median, new_median, 100 * change,
+              "n/a" if p_value is None else "%.4f" % p_value, "  REGRESSION" if slower else ""))
+        if slower:
+            regressions.append("%s: median %+.1f%%" % (name, 100 * change))
+
+    print()
+    print("%-48s %10s %10s" % ("engine/family", "old k", "new k"))
+    groups = defaultdict(lambda: ([], []))
+    for name in common:
+        groups[old[name]["group"]][0].append((old[name]["n"], median(old[name]["times"])))
+        groups[old[name]["group"]][1].append((new[name]["n"], median(new[name]["times"])))
+
+    for group in sorted(groups):
+        old_k, new_k = fit_exponent(groups[group][0]), fit_exponent(groups[group][1])
+        if new_k is None:
+            continue
+        engine = group.split("/")[0]
+        problems = []
+        if old_k is not None and new_k > old_k + args.exponent_threshold:
+            problems.append("exponent %.2f -> %.2f" % (old_k, new_k))
+        if engine in limits and new_k > limits[engine]:
+            problems.append("exponent %.2f above the limit %.2f" % (new_k, limits[engine]))
+
+        print("%-48s %10s %10.2f%s" % (group, "n/a" if old_k is None else "%.2f" % old_k, new_k, "  REGRESSION" if problems else ""))
+        regressions.extend("%s: %s" % (group, problem) for problem in problems)
+
+    print()
+    if regressions:
+        print("%d regression(s):" % len(regressions))
+        for regression in regressions:
+            print("  " + regression)
+        return 1
+    print("no regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
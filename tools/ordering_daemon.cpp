@@ -0,0 +1,67 @@
+#include "OrderingDaemon.hpp"
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <pthread.h>
+
+// Ordering daemon: keeps the graphs sent by the local processes resident and orders them on request (see OrderingDaemon
+// and OrderingClient for the protocol).
+// Usage: ordering_daemon <socket path> [--capacity=<MiB>] [--threads=<workers>] [--cache=<file>]
+// With --cache the results are kept in a persistent OrderingCache, shared with the next runs of the daemon.
+// It runs until SIGINT or SIGTERM, then it closes the connections and removes the socket.
+
+int main(int argc, char **argv) {
+    if(argc < 2) {
+        cerr << "usage: " << argv[0] << " <socket path> [--capacity=<MiB>] [--threads=<workers>] [--cache=<file>]" << endl;
+        return 1;
+    }
+    uint64_t capacity = 0;
+    unsigned int threads = 0;
+    string cache_path;
+    for(int i = 2; i < argc; ++i) {
+        if(strncmp(argv[i], "--capacity=", 11) == 0)
+            capacity = strtoull(argv[i] + 11, nullptr, 10) << 20;
+        else if(strncmp(argv[i], "--threads=", 10) == 0)
+            threads = strtoul(argv[i] + 10, nullptr, 10);
+        else if(strncmp(argv[i], "--cache=", 8) == 0)
+            cache_path = argv[i] + 8;
+        else {
+            cerr << "unknown option " << argv[i] << endl;
+            return 1;
+        }
+    }
+
+    // the signals are blocked in every thread and received here
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    OrderingCache results;
+    if(!cache_path.empty() && !results.open(cache_path)) {
+        cerr << "cannot open the cache " << cache_path << endl;
+        return 1;
+    }
+
+    ThreadPool pool(threads);
+    OrderingDaemon daemon(argv[1], pool);
+    if(capacity != 0)
+        daemon.setCapacity(capacity);
+    if(results.isOpen())
+        daemon.setResultCache(&results);
+    if(!daemon.start()) {
+        cerr << "cannot listen on " << argv[1] << endl;
+        return 1;
+    }
+    cerr << "listening on " << argv[1] << " with " << pool.size() << " workers" << endl;
+
+    int received;
+    sigwait(&signals, &received);
+    daemon.stop();
+    cerr << "served " << daemon.served() << " requests, " << daemon.cachedGraphs() << " graphs cached, " << results.hits()
+         << " results found in the cache" << endl;
+    return 0;
+}